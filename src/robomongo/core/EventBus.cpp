@@ -87,7 +87,39 @@ namespace Robomongo
         QThread *thread = receiver->thread();
         EventBusDispatcher *dis = dispatcher(thread);
 
-        sendEvent(dis, new EventWrapper(event, receiver));
+        EventWrapper *wrapper = new EventWrapper(event, receiver);
+        if (thread != QThread::currentThread() && _pendingEvents.contains(receiver)) {
+            ++_pendingEvents[receiver];
+            wrapper->setPendingIn(this);
+        }
+
+        sendEvent(dis, wrapper);
+    }
+
+    void EventBus::countPendingEvents(QObject *receiver)
+    {
+        QMutexLocker lock(&_lock);
+        if (_pendingEvents.contains(receiver))
+            return;
+
+        _pendingEvents.insert(receiver, 0);
+        // Direct connection: entry is gone before the address can be reused by other object
+        VERIFY(connect(receiver, SIGNAL(destroyed(QObject*)), this, SLOT(unsubscibe(QObject*)), 
+                       Qt::DirectConnection));
+    }
+
+    int EventBus::pendingEvents(QObject *receiver)
+    {
+        QMutexLocker lock(&_lock);
+        return _pendingEvents.value(receiver, 0);
+    }
+
+    void EventBus::eventHandled(QObject *receiver)
+    {
+        QMutexLocker lock(&_lock);
+        auto const it = _pendingEvents.find(receiver);
+        if (it != _pendingEvents.end() && it.value() > 0)
+            --it.value();
     }
 
     void EventBus::send(QList<QObject *> receivers, Event *event)
@@ -123,6 +155,7 @@ namespace Robomongo
         QMutexLocker lock(&_lock);
         _subscribersByEventType.erase(std::remove_if(_subscribersByEventType.begin(), _subscribersByEventType.end(),
             RemoveIfReciver(receiver)), _subscribersByEventType.end());
+        _pendingEvents.remove(receiver);
     }
 
     /**
@@ -2,6 +2,7 @@
 
 #include <QObject>
 #include <QEvent>
+#include <QHash>
 #include <QMutex>
 #include <vector>
 
@@ -49,6 +50,18 @@ namespace Robomongo
          */
         void subscribe(QObject *receiver, QEvent::Type type, QObject *sender = NULL);
 
+        /**
+         * @brief Starts counting events sent to 'receiver' from other threads (see pendingEvents()).
+         * Counting stops when 'receiver' is destroyed or unsubscribed.
+         */
+        void countPendingEvents(QObject *receiver);
+
+        /**
+         * @brief Number of events sent to counted 'receiver' from other threads with send(), 
+         * that are not yet handled or dropped (i.e. queue depth of a worker).
+         */
+        int pendingEvents(QObject *receiver);
+
     public Q_SLOTS:
         void unsubscibe(QObject *receiver);
 
@@ -62,8 +75,15 @@ namespace Robomongo
 
         void sendEvent(EventBusDispatcher *dispatcher, EventWrapper *wrapper);
 
+        /**
+         * @brief Called when event counted in pendingEvents() is handled or dropped unhandled
+         */
+        void eventHandled(QObject *receiver);
+        friend class EventWrapper;
+
     private:
         QMutex _lock;
+        QHash<QObject *, int> _pendingEvents;
         std::vector<EventTypeAndSubscriber> _subscribersByEventType;
         std::vector<ThreadAndDispatcher> _dispatchersByThread;
     };
@@ -1,4 +1,5 @@
 #include "robomongo/core/EventBusDispatcher.h"
+#include "robomongo/core/EventBus.h"
 #include "robomongo/core/EventWrapper.h"
 
 namespace Robomongo
@@ -1,4 +1,5 @@
 #include "robomongo/core/EventWrapper.h"
+#include "robomongo/core/EventBus.h"
 namespace Robomongo
 {
     EventWrapper::EventWrapper(Event *event, QList<QObject *> receivers) 
@@ -7,6 +8,12 @@ namespace Robomongo
     EventWrapper::EventWrapper(Event *event, QObject * receiver)
         : QEvent(event->type()), _event(event), _receivers(QList<QObject *>() << receiver ) {}
 
+    EventWrapper::~EventWrapper()
+    {
+        if (_pendingIn)
+            _pendingIn->eventHandled(_receivers.front());
+    }
+
     Event *EventWrapper::event() const 
     {
         return _event.get(); 
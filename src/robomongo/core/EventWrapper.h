@@ -4,16 +4,27 @@
 
 namespace Robomongo
 {
+    class EventBus;
+
     class EventWrapper : public QEvent
     {
     public:
         EventWrapper(Event *event, QList<QObject *> receivers);
         EventWrapper(Event *event, QObject * receiver);
+        ~EventWrapper();
         Event *event() const;
         const QList<QObject *> &receivers() const;
 
+        /**
+         * @brief Bus which counts this event in its pending events of the receiver until the 
+         *        event is destroyed, after it is handled or dropped with the receiver's thread
+         */
+        EventBus *pendingIn() const { return _pendingIn; }
+        void setPendingIn(EventBus *bus) { _pendingIn = bus; }
+
     private:
         const boost::scoped_ptr<Event> _event;
         const QList<QObject *> _receivers;
+        EventBus *_pendingIn = nullptr;
     };
 }
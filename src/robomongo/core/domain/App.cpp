@@ -3,12 +3,15 @@
 #include <QHash>
 #include <QInputDialog>
 #include <QMessageBox>
+#include <QTimerEvent>
 
+#include "robomongo/core/AppRegistry.h"
 #include "robomongo/core/domain/MongoServer.h"
 #include "robomongo/core/domain/MongoShell.h"
 #include "robomongo/core/domain/MongoCollection.h"
 #include "robomongo/core/settings/ConnectionSettings.h"
 #include "robomongo/core/settings/ReplicaSetSettings.h"
+#include "robomongo/core/settings/SettingsManager.h"
 #include "robomongo/core/settings/SshSettings.h"
 #include "robomongo/core/settings/SslSettings.h"
 #include "robomongo/core/mongodb/SshTunnelWorker.h"
@@ -17,6 +20,12 @@
 #include "robomongo/core/utils/StdUtils.h"
 #include "robomongo/core/utils/Logger.h"
 
+namespace
+{
+    // Warm servers not leased by a new shell for this long are closed
+    constexpr int WARM_SERVER_IDLE_TIMEOUT_MSEC { 5 * 60 * 1000 };
+}
+
 namespace Robomongo
 {
     namespace detail
@@ -41,10 +50,21 @@ namespace Robomongo
     {}
 
     App::App(EventBus *const bus) : QObject(),
-        _bus(bus), _lastServerHandle(0) {
+        _bus(bus), _lastServerHandle(0), _warmServersTimerId(-1), _warmServerHits(0), _warmServerMisses(0) {
         _bus->subscribe(this, EstablishSshConnectionResponse::Type);
         _bus->subscribe(this, ListenSshConnectionResponse::Type);
         _bus->subscribe(this, LogEvent::Type);
+        _warmServersTimerId = startTimer(60 * 1000);
+    }
+
+    void App::timerEvent(QTimerEvent *event)
+    {
+        if (_warmServersTimerId == event->timerId()) {
+            reapIdleWarmServers();
+            return;
+        }
+
+        QObject::timerEvent(event);
     }
 
     std::unique_ptr<MongoServer>
@@ -170,6 +190,10 @@ namespace Robomongo
      */
     void App::closeServer(MongoServer *server)
     {
+        // Warm servers of explorer server are not needed anymore
+        _warmServers.erase(std::remove_if(_warmServers.begin(), _warmServers.end(),
+            [&](auto const& el) { return el.explorerServer == server; }), _warmServers.end());
+
         _servers.erase(std::remove_if(_servers.begin(), _servers.end(), 
             [&](auto const& el) { return el.get() == server; }), _servers.end());
     }
@@ -211,7 +235,19 @@ namespace Robomongo
 
     void App::openShell(MongoServer* server, ConnectionSettings* connection, const ScriptInfo &scriptInfo)
     {
-        auto serverClone{ openServerInternal(connection, ConnectionSecondary) };
+        auto serverClone{ leaseWarmServer(server, connection->defaultDatabase()) };
+        bool const isWarm = serverClone != nullptr;
+        if (isWarm)
+            ++_warmServerHits;
+        else {
+            ++_warmServerMisses;
+            serverClone = openServerInternal(connection, ConnectionSecondary);
+        }
+
+        LOG_MSG(QString("Opening shell with %1 connection (warm connection hits: %2, misses: %3).")
+            .arg(isWarm ? "warm" : "new").arg(_warmServerHits).arg(_warmServerMisses), 
+            mongo::logger::LogSeverity::Info());
+
         if (!serverClone || !server)
             return;
 
@@ -222,7 +258,63 @@ namespace Robomongo
         _bus->publish(new OpeningShellEvent(this, shell.get()));
         shell->execute();
         _shells.push_back(move(shell));
-        return;
+
+        // Next shell of this server and database will lease it
+        warmUpServer(server, connection);
+    }
+
+    std::unique_ptr<MongoServer> App::leaseWarmServer(MongoServer *explorerServer, const std::string &dbName)
+    {
+        auto const itr = std::find_if(_warmServers.begin(), _warmServers.end(), [&](auto const& el) {
+            return el.explorerServer == explorerServer;
+        });
+
+        if (itr == _warmServers.end())
+            return nullptr;
+
+        // Failed server is of no use, and server of other database is replaced by warmUpServer()
+        if (itr->server->connectionFailed() || itr->dbName != dbName) {
+            _warmServers.erase(itr);
+            return nullptr;
+        }
+
+        // Still connecting, stays warm for the next shell
+        if (!itr->server->isConnected())
+            return nullptr;
+
+        auto server { move(itr->server) };
+        _warmServers.erase(itr);
+        return server;
+    }
+
+    void App::warmUpServer(MongoServer *explorerServer, ConnectionSettings *connSettings)
+    {
+        if (!AppRegistry::instance().settingsManager()->warmShellConnections())
+            return;
+
+        bool const isWarm = std::any_of(_warmServers.begin(), _warmServers.end(), [&](auto const& el) {
+            return el.explorerServer == explorerServer;
+        });
+
+        if (isWarm)
+            return;
+
+        std::string const dbName = connSettings->defaultDatabase();
+
+        auto server { openServerInternal(connSettings, ConnectionSecondary) };
+        if (!server)
+            return;
+
+        WarmServer warm { explorerServer, dbName, move(server), QElapsedTimer() };
+        warm.idle.start();
+        _warmServers.push_back(move(warm));
+    }
+
+    void App::reapIdleWarmServers()
+    {
+        _warmServers.erase(std::remove_if(_warmServers.begin(), _warmServers.end(), [](auto const& el) {
+            return el.idle.hasExpired(WARM_SERVER_IDLE_TIMEOUT_MSEC) || el.server->connectionFailed();
+        }), _warmServers.end());
     }
 
     /**
@@ -243,6 +335,11 @@ namespace Robomongo
         _shells.erase(itr);
     }
 
+    void App::openServerMonitor(MongoServer *server)
+    {
+        _bus->publish(new OpeningServerMonitorEvent(this, server));
+    }
+
     void App::handle(EstablishSshConnectionResponse *event) {
         if (event->isError()) {
             _bus->publish(new ConnectionFailedEvent(
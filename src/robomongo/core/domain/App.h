@@ -1,5 +1,6 @@
 #pragma once
 #include <QObject>
+#include <QElapsedTimer>
 #include <vector>
 #include <robomongo/core/events/MongoEvents.h>
 
@@ -82,18 +83,50 @@ namespace Robomongo
          */
         void closeShell(MongoShell *shell);
 
+        /**
+         * @brief Opens Server Monitor tab of explorer's 'server', or activates it if already open
+         */
+        void openServerMonitor(MongoServer *server);
+
         void fireConnectionFailedEvent(int serverHandle, ConnectionType type, std::string errormsg, 
             ConnectionFailedEvent::Reason reason);
 
         int getLastServerHandle() const { return _lastServerHandle; };
 
+        /**
+         * @brief Number of shells opened with a warm server (hits) and with a new one (misses)
+         */
+        int warmServerHits() const { return _warmServerHits; }
+        int warmServerMisses() const { return _warmServerMisses; }
+
     public Q_SLOTS:
         void handle(EstablishSshConnectionResponse *event);
         void handle(ListenSshConnectionResponse *event);
         void handle(LogEvent *event);
 
+    protected:
+        void timerEvent(QTimerEvent *event) override;
+
     private:
         std::unique_ptr<MongoServer> openServerInternal(ConnectionSettings* connSettings, ConnectionType type);
+
+        /**
+         * @brief Takes connected warm server started for shells of 'explorerServer' and 'dbName', 
+         *        if any. Failed warm server, or one of other database, is closed.
+         */
+        std::unique_ptr<MongoServer> leaseWarmServer(MongoServer *explorerServer, const std::string &dbName);
+
+        /**
+         * @brief Starts secondary server for the next shell of 'explorerServer' and database
+         *        'connSettings->defaultDatabase()' if warm shell connections are enabled in 
+         *        settings, unless one is already started for 'explorerServer'
+         */
+        void warmUpServer(MongoServer *explorerServer, ConnectionSettings *connSettings);
+
+        /**
+         * @brief Closes warm servers not leased for WARM_SERVER_IDLE_TIMEOUT_MSEC
+         */
+        void reapIdleWarmServers();
         
         std::unique_ptr<MongoServer> 
         continueOpenServer(int serverHandle, ConnectionSettings* connSettings, ConnectionType type, int localport = 0);
@@ -115,6 +148,28 @@ namespace Robomongo
          */
         std::vector<std::unique_ptr<MongoShell>> _shells;
 
+        /**
+         * @brief Secondary server with connected worker and initialized shell scope, 
+         *        started in advance so that the next shell tab opens without connection 
+         *        handshake (and SSH tunnel / TLS / auth round trips).
+         *        Only never used servers are kept, so shells do not share scope state.
+         */
+        struct WarmServer
+        {
+            MongoServer *explorerServer;
+            std::string dbName;
+            std::unique_ptr<MongoServer> server;
+            QElapsedTimer idle;
+        };
+
+        /**
+         * Warm servers, at most one per explorer server.
+         */
+        std::vector<WarmServer> _warmServers;
+        int _warmServersTimerId;
+        int _warmServerHits;
+        int _warmServerMisses;
+
         EventBus *const _bus;
 
         // Increase monotonically when new MongoServer is created
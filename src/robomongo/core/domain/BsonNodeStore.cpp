@@ -0,0 +1,217 @@
+#include "robomongo/core/domain/BsonNodeStore.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    // Children of smaller objects are looked up by name one by one
+    const uint32_t LINEAR_LOOKUP_MAX = 16;
+}
+
+namespace Robomongo
+{
+    const uint32_t BsonNodeStore::NoNode;
+
+    uint32_t BsonNodeStore::addDocument(const mongo::BSONObj &document)
+    {
+        uint32_t const node = _nodes.size();
+        BsonNode const root = { NoNode, _removedDocuments + static_cast<uint32_t>(_documents.size()), NoNode, 0, 0,
+                                static_cast<int8_t>(document.isArray() ? mongo::Array : mongo::Object), 0 };
+        _nodes.push_back(root);
+        _documents.push_back(document);
+        _roots.push_back(node);
+
+        expand(node);
+        return node;
+    }
+
+    void BsonNodeStore::expand(uint32_t node, uint32_t count)
+    {
+        if (!isExpanded(node)) {
+            // Reserve slots for all children at once, so they stay one after another
+            // however many windows they are created in
+            uint32_t const total = elementsCount(node);
+            uint32_t const first = _nodes.size();
+            BsonNode const slot = { node, 0, NoNode, 0, 0, static_cast<int8_t>(mongo::EOO), 0 };
+            _nodes.resize(first + total, slot);
+            _nodes[node].firstChild = first;
+            _nodes[node].elementsCount = total;
+            _elementsCounts.erase(node);
+        }
+
+        BsonNode &parent = _nodes[node];
+        uint32_t const created = parent.childrenCount;
+        uint32_t const last = std::min(parent.elementsCount, count);
+        if (created >= last)
+            return;
+
+        // Elements are found one after another starting from the end of the last created one
+        const char *const documentData = document(node).objdata();
+        const char *data = created == 0
+            ? object(node).objdata() + 4
+            : element(parent.firstChild + created - 1).rawdata() + element(parent.firstChild + created - 1).size();
+
+        for (uint32_t i = created; i < last; ++i) {
+            mongo::BSONElement const elem(data);
+            BsonNode &child = _nodes[parent.firstChild + i];
+            child.offset = static_cast<uint32_t>(data - documentData);
+            child.type = static_cast<int8_t>(elem.type());
+            child.binType = static_cast<uint8_t>(elem.type() == mongo::BinData ? elem.binDataType() : 0);
+            data += elem.size();
+        }
+
+        parent.childrenCount = last;
+        _childrenByName.erase(node);
+    }
+
+    uint32_t BsonNodeStore::elementsCount(uint32_t node) const
+    {
+        if (isExpanded(node))
+            return _nodes[node].elementsCount;
+
+        auto const cached = _elementsCounts.find(node);
+        if (cached != _elementsCounts.end())
+            return cached->second;
+
+        uint32_t count = 0;
+        for (mongo::BSONObjIterator it(object(node)); it.more(); it.next())
+            ++count;
+
+        _elementsCounts.emplace(node, count);
+        return count;
+    }
+
+    uint32_t BsonNodeStore::findChild(uint32_t node, const char *fieldName) const
+    {
+        if (!isExpanded(node))
+            return NoNode;
+
+        BsonNode const& parent = _nodes[node];
+        if (parent.childrenCount <= LINEAR_LOOKUP_MAX) {
+            for (uint32_t child = parent.firstChild; child < parent.firstChild + parent.childrenCount; ++child) {
+                if (std::strcmp(element(child).fieldName(), fieldName) == 0)
+                    return child;
+            }
+            return NoNode;
+        }
+
+        std::vector<uint32_t> &byName = _childrenByName[node];
+        if (byName.empty()) {
+            byName.resize(parent.childrenCount);
+            for (uint32_t i = 0; i < parent.childrenCount; ++i)
+                byName[i] = parent.firstChild + i;
+            std::stable_sort(byName.begin(), byName.end(), [this](uint32_t a, uint32_t b) {
+                return std::strcmp(element(a).fieldName(), element(b).fieldName()) < 0;
+            });
+        }
+
+        // The first one of duplicated names, like lookup by iteration would find
+        auto const it = std::lower_bound(byName.begin(), byName.end(), fieldName, 
+            [this](uint32_t child, const char *name) {
+                return std::strcmp(element(child).fieldName(), name) < 0;
+            });
+        if (it == byName.end() || std::strcmp(element(*it).fieldName(), fieldName) != 0)
+            return NoNode;
+
+        return *it;
+    }
+
+    uint32_t BsonNodeStore::row(uint32_t node) const
+    {
+        BsonNode const& item = _nodes[node];
+        if (item.parent == NoNode)
+            return item.offset - _removedDocuments;
+
+        return node - _nodes[item.parent].firstChild;
+    }
+
+    uint32_t BsonNodeStore::documentOf(uint32_t node) const
+    {
+        while (_nodes[node].parent != NoNode)
+            node = _nodes[node].parent;
+
+        return node;
+    }
+
+    const mongo::BSONObj &BsonNodeStore::document(uint32_t node) const
+    {
+        return _documents[_nodes[documentOf(node)].offset - _removedDocuments];
+    }
+
+    mongo::BSONElement BsonNodeStore::element(uint32_t node) const
+    {
+        if (isDocument(node))
+            return mongo::BSONElement();
+
+        return mongo::BSONElement(document(node).objdata() + _nodes[node].offset);
+    }
+
+    mongo::BSONObj BsonNodeStore::object(uint32_t node) const
+    {
+        if (isDocument(node))
+            return document(node);
+
+        mongo::BSONElement const elem = element(node);
+        return elem.isABSONObj() ? elem.embeddedObject() : mongo::BSONObj();
+    }
+
+    void BsonNodeStore::removeFirstDocuments(size_t count)
+    {
+        count = std::min(count, _roots.size());
+        _documents.erase(_documents.begin(), _documents.begin() + count);
+        _roots.erase(_roots.begin(), _roots.begin() + count);
+        _removedDocuments += count;
+        _removedSinceCompaction += count;
+    }
+
+    bool BsonNodeStore::needsCompaction() const
+    {
+        return _removedSinceCompaction > 0 && _removedSinceCompaction >= _roots.size();
+    }
+
+    std::vector<uint32_t> BsonNodeStore::compact()
+    {
+        std::vector<uint32_t> moved(_nodes.size(), NoNode);
+        std::vector<BsonNode> nodes;
+        nodes.reserve(_nodes.size() / 2);
+
+        for (uint32_t &root : _roots) {
+            moved[root] = nodes.size();
+            nodes.push_back(_nodes[root]);
+            root = moved[root];
+        }
+
+        // Reserved children slots of every moved node are moved together, so they stay one after another
+        for (uint32_t node = 0; node < nodes.size(); ++node) {
+            uint32_t const first = nodes[node].firstChild;
+            if (first == NoNode)
+                continue;
+
+            nodes[node].firstChild = nodes.size();
+            for (uint32_t i = first; i < first + nodes[node].elementsCount; ++i) {
+                moved[i] = nodes.size();
+                BsonNode child = _nodes[i];
+                child.parent = node;
+                nodes.push_back(child);
+            }
+        }
+
+        _nodes.swap(nodes);
+        _elementsCounts.clear();
+        _childrenByName.clear();
+        _removedSinceCompaction = 0;
+        return moved;
+    }
+
+    void BsonNodeStore::clear()
+    {
+        std::vector<BsonNode>().swap(_nodes);
+        _documents.clear();
+        _roots.clear();
+        _elementsCounts.clear();
+        _childrenByName.clear();
+        _removedDocuments = 0;
+        _removedSinceCompaction = 0;
+    }
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include <mongo/bson/bsonobj.h>
+#include <mongo/bson/bsonelement.h>
+
+namespace Robomongo
+{
+    /**
+     * @brief Node of BSON tree: top-level document or element of a document.
+     *        Keeps no copy of data, element is found by its offset in the document.
+     */
+    struct BsonNode
+    {
+        uint32_t parent;        // index of parent node, BsonNodeStore::NoNode for documents
+        uint32_t offset;        // of element from the start of document data, sequence number for documents
+        uint32_t firstChild;    // children are stored one after another, NoNode until they are created
+        uint32_t childrenCount; // number of created children
+        uint32_t elementsCount; // number of slots reserved for children, all elements of object once expanded
+        int8_t type;            // mongo::BSONType, MinKey is negative
+        uint8_t binType;        // mongo::BinDataType of BinData elements
+    };
+
+    static_assert(std::is_pod<BsonNode>::value, "BsonNode must stay plain data");
+
+    /**
+     * @brief Nodes of all documents of a result set, kept in one contiguous arena and addressed
+     *        by index. Fields of documents get nodes when document is added, elements of embedded
+     *        objects and arrays only when they are expanded. Slots for all children of a node are
+     *        reserved one after another with the first expansion, so they are accessed by position
+     *        in O(1) while large objects are filled in by windows.
+     *        All nodes are freed at once with the store.
+     */
+    class BsonNodeStore
+    {
+    public:
+        static const uint32_t NoNode = std::numeric_limits<uint32_t>::max();
+
+        /**
+         * @brief Adds top-level document and nodes of its fields.
+         * @returns node of the document
+         */
+        uint32_t addDocument(const mongo::BSONObj &document);
+
+        /**
+         * @brief Creates nodes of the first 'count' elements of object or array 'node'
+         *        which are not created yet, all of them by default.
+         */
+        void expand(uint32_t node, uint32_t count = NoNode);
+        bool isExpanded(uint32_t node) const { return _nodes[node].firstChild != NoNode; }
+
+        /**
+         * @brief True when 'node' is expanded but not all of its elements got nodes yet
+         */
+        bool hasMoreChildren(uint32_t node) const
+        {
+            return isExpanded(node) && _nodes[node].childrenCount < _nodes[node].elementsCount;
+        }
+
+        size_t documentsCount() const { return _roots.size(); }
+        uint32_t documentNode(size_t row) const { return _roots[row]; }
+
+        const BsonNode &node(uint32_t node) const { return _nodes[node]; }
+        uint32_t child(uint32_t node, uint32_t row) const { return _nodes[node].firstChild + row; }
+
+        /**
+         * @brief Number of elements of document, object or array 'node', whether they are expanded or not.
+         *        Counted once for not expanded nodes.
+         */
+        uint32_t elementsCount(uint32_t node) const;
+
+        /**
+         * @brief Child of expanded 'node' with 'fieldName', NoNode if there is none.
+         *        Children of large objects are looked up by binary search in index sorted by name,
+         *        built with the first lookup.
+         */
+        uint32_t findChild(uint32_t node, const char *fieldName) const;
+
+        /**
+         * @brief Position of node among children of its parent, or among documents
+         */
+        uint32_t row(uint32_t node) const;
+
+        /**
+         * @brief Node of top-level document containing 'node'
+         */
+        uint32_t documentOf(uint32_t node) const;
+
+        /**
+         * @brief Top-level document containing 'node'
+         */
+        const mongo::BSONObj &document(uint32_t node) const;
+
+        /**
+         * @brief Element of 'node', EOO element for documents
+         */
+        mongo::BSONElement element(uint32_t node) const;
+
+        /**
+         * @brief Document itself, or embedded object or array of the element of 'node'
+         */
+        mongo::BSONObj object(uint32_t node) const;
+
+        bool isDocument(uint32_t node) const { return _nodes[node].parent == NoNode; }
+
+        /**
+         * @brief Number of document counted from the first document ever added, starting from 0
+         */
+        uint32_t documentNumber(uint32_t node) const { return _nodes[documentOf(node)].offset; }
+
+        /**
+         * @brief Removes 'count' oldest documents. Their nodes stay in arena until compact().
+         */
+        void removeFirstDocuments(size_t count);
+
+        /**
+         * @brief True when at least half of documents whose nodes are in arena are removed
+         */
+        bool needsCompaction() const;
+
+        /**
+         * @brief Moves nodes of remaining documents to a new arena.
+         * @returns new index of every old node, NoNode for nodes of removed documents
+         */
+        std::vector<uint32_t> compact();
+
+        size_t size() const { return _nodes.size(); }
+        void clear();
+
+    private:
+        std::vector<BsonNode> _nodes;
+        std::deque<mongo::BSONObj> _documents;
+        std::deque<uint32_t> _roots;
+
+        // Caches built on first use, dropped when nodes are moved by compact()
+        mutable std::unordered_map<uint32_t, uint32_t> _elementsCounts;
+        mutable std::unordered_map<uint32_t, std::vector<uint32_t> > _childrenByName;
+        uint32_t _removedDocuments = 0;
+        size_t _removedSinceCompaction = 0;
+    };
+}
@@ -0,0 +1,175 @@
+#include "gtest/gtest.h"
+#include "robomongo/core/domain/BsonNodeStore.h"
+
+#include <mongo/bson/bsonobjbuilder.h>
+
+using namespace Robomongo;
+
+namespace
+{
+    mongo::BSONObj document(int id)
+    {
+        return BSON("_id" << id << "name" << "doc" << "tags" << BSON_ARRAY("a" << "b" << "c") 
+                    << "address" << BSON("city" << "Oslo" << "zip" << 150));
+    }
+}
+
+TEST(bson_node_store_tests, addDocument_CreatesNodesOfTopLevelFields)
+{
+    BsonNodeStore store;
+    uint32_t const doc = store.addDocument(document(1));
+
+    ASSERT_EQ(1u, store.documentsCount());
+    EXPECT_EQ(doc, store.documentNode(0));
+    EXPECT_TRUE(store.isDocument(doc));
+    EXPECT_EQ(mongo::Object, store.node(doc).type);
+    ASSERT_EQ(4u, store.node(doc).childrenCount);
+    EXPECT_EQ(5u, store.size());
+
+    uint32_t const name = store.child(doc, 1);
+    EXPECT_EQ(doc, store.node(name).parent);
+    EXPECT_EQ(1u, store.row(name));
+    EXPECT_EQ(std::string("name"), store.element(name).fieldName());
+    EXPECT_EQ("doc", store.element(name).String());
+    EXPECT_EQ(mongo::Array, store.node(store.child(doc, 2)).type);
+    EXPECT_FALSE(store.isExpanded(store.child(doc, 2)));
+}
+
+TEST(bson_node_store_tests, expand_CreatesNodesOfEmbeddedElementsOnce)
+{
+    BsonNodeStore store;
+    uint32_t const doc = store.addDocument(document(1));
+    uint32_t const address = store.child(doc, 3);
+
+    store.expand(address);
+    store.expand(address);
+    ASSERT_EQ(2u, store.node(address).childrenCount);
+    EXPECT_EQ(7u, store.size());
+
+    uint32_t const zip = store.child(address, 1);
+    EXPECT_EQ(150, store.element(zip).numberInt());
+    EXPECT_EQ(doc, store.documentOf(zip));
+    EXPECT_EQ(BSON("city" << "Oslo" << "zip" << 150), store.object(address));
+    EXPECT_EQ(document(1), store.document(zip));
+}
+
+TEST(bson_node_store_tests, expand_OfScalarCreatesNoChildren)
+{
+    BsonNodeStore store;
+    uint32_t const id = store.child(store.addDocument(document(1)), 0);
+
+    store.expand(id);
+    EXPECT_TRUE(store.isExpanded(id));
+    EXPECT_EQ(0u, store.node(id).childrenCount);
+}
+
+TEST(bson_node_store_tests, expand_CreatesNodesOfLargeArrayByWindows)
+{
+    mongo::BSONArrayBuilder numbers;
+    for (int i = 0; i < 10; ++i)
+        numbers.append(i);
+
+    BsonNodeStore store;
+    uint32_t const doc = store.addDocument(BSON("values" << numbers.arr() << "next" << 1));
+    uint32_t values = store.child(doc, 0);
+
+    store.expand(values, 4);
+    ASSERT_EQ(4u, store.node(values).childrenCount);
+    EXPECT_TRUE(store.hasMoreChildren(values));
+    EXPECT_EQ(10u, store.elementsCount(values));
+    EXPECT_EQ(3, store.element(store.child(values, 3)).numberInt());
+
+    store.addDocument(document(2));
+    store.expand(values, 8);
+    ASSERT_EQ(8u, store.node(values).childrenCount);
+    EXPECT_EQ(7, store.element(store.child(values, 7)).numberInt());
+    EXPECT_EQ(values, store.node(store.child(values, 7)).parent);
+
+    values = store.compact()[values];
+    store.expand(values);
+    ASSERT_EQ(10u, store.node(values).childrenCount);
+    EXPECT_FALSE(store.hasMoreChildren(values));
+    EXPECT_EQ(9, store.element(store.child(values, 9)).numberInt());
+    EXPECT_EQ(7u, store.row(store.child(values, 7)));
+}
+
+TEST(bson_node_store_tests, removeFirstDocuments_KeepsNumbersOfRemainingDocuments)
+{
+    BsonNodeStore store;
+    for (int i = 0; i < 3; ++i)
+        store.addDocument(document(i));
+
+    store.removeFirstDocuments(2);
+    ASSERT_EQ(1u, store.documentsCount());
+
+    uint32_t const doc = store.documentNode(0);
+    EXPECT_EQ(0u, store.row(doc));
+    EXPECT_EQ(2u, store.documentNumber(doc));
+    EXPECT_EQ(2, store.document(doc)["_id"].numberInt());
+}
+
+TEST(bson_node_store_tests, compact_MovesNodesOfRemainingDocuments)
+{
+    BsonNodeStore store;
+    for (int i = 0; i < 4; ++i)
+        store.addDocument(document(i));
+
+    uint32_t const oldTags = store.child(store.documentNode(3), 2);
+    store.expand(oldTags);
+    uint32_t const oldFirst = store.child(store.documentNode(0), 0);
+
+    store.removeFirstDocuments(1);
+    EXPECT_FALSE(store.needsCompaction());
+    store.removeFirstDocuments(1);
+    ASSERT_TRUE(store.needsCompaction());
+
+    size_t const before = store.size();
+    std::vector<uint32_t> const moved = store.compact();
+    ASSERT_EQ(before, moved.size());
+    EXPECT_EQ(BsonNodeStore::NoNode, moved[oldFirst]);
+    EXPECT_FALSE(store.needsCompaction());
+    EXPECT_EQ(13u, store.size());
+
+    uint32_t const tags = moved[oldTags];
+    ASSERT_NE(BsonNodeStore::NoNode, tags);
+    EXPECT_EQ(store.documentNode(1), store.node(tags).parent);
+    EXPECT_EQ(2u, store.row(tags));
+    ASSERT_EQ(3u, store.node(tags).childrenCount);
+    EXPECT_EQ("c", store.element(store.child(tags, 2)).String());
+    EXPECT_EQ(3u, store.documentNumber(tags));
+}
+
+TEST(bson_node_store_tests, elementsCount_CountsNotExpandedElements)
+{
+    BsonNodeStore store;
+    uint32_t const doc = store.addDocument(document(1));
+    uint32_t const tags = store.child(doc, 2);
+
+    EXPECT_EQ(4u, store.elementsCount(doc));
+    EXPECT_EQ(3u, store.elementsCount(tags));
+    EXPECT_EQ(5u, store.size());
+
+    store.expand(tags);
+    EXPECT_EQ(3u, store.elementsCount(tags));
+}
+
+TEST(bson_node_store_tests, findChild_FindsFieldsOfSmallAndLargeObjects)
+{
+    mongo::BSONObjBuilder builder;
+    for (int i = 99; i >= 0; --i)
+        builder.append("f" + std::to_string(i), i);
+
+    BsonNodeStore store;
+    uint32_t const small = store.addDocument(document(1));
+    uint32_t const large = store.addDocument(builder.obj());
+
+    EXPECT_EQ(store.child(small, 3), store.findChild(small, "address"));
+    EXPECT_EQ(BsonNodeStore::NoNode, store.findChild(small, "missing"));
+
+    uint32_t const found = store.findChild(large, "f42");
+    ASSERT_NE(BsonNodeStore::NoNode, found);
+    EXPECT_EQ(42, store.element(found).numberInt());
+    EXPECT_EQ(57u, store.row(found));
+    EXPECT_EQ(BsonNodeStore::NoNode, store.findChild(large, "f100"));
+    EXPECT_EQ(BsonNodeStore::NoNode, store.findChild(store.child(small, 3), "city"));
+}
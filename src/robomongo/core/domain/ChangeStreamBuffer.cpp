@@ -0,0 +1,95 @@
+#include "robomongo/core/domain/ChangeStreamBuffer.h"
+
+#include <algorithm>
+
+#include <mongo/bson/bsonobjbuilder.h>
+
+namespace
+{
+    // Options of $changeStream that choose where stream starts
+    bool isStartOption(const std::string &name)
+    {
+        return name == "resumeAfter" || name == "startAfter" || name == "startAtOperationTime";
+    }
+}
+
+namespace Robomongo
+{
+    ChangeStreamBuffer::ChangeStreamBuffer(size_t capacity) :
+        _capacity(std::max<size_t>(capacity, 1)) {}
+
+    mongo::BSONObj ChangeStreamBuffer::pipeline(const mongo::BSONObj &stages, const mongo::BSONObj &options,
+                                                const mongo::BSONObj &match, const mongo::BSONObj &resumeToken,
+                                                const mongo::Timestamp &startTime /* = mongo::Timestamp() */)
+    {
+        mongo::BSONObjBuilder changeStream;
+        if (!options.hasField("fullDocument"))
+            changeStream.append("fullDocument", "updateLookup");
+        bool hasStartOption = false;
+        for (mongo::BSONObjIterator it(options); it.more(); ) {
+            mongo::BSONElement const option = it.next();
+            bool const isStart = isStartOption(option.fieldName());
+            hasStartOption = hasStartOption || isStart;
+            if (resumeToken.isEmpty() || !isStart)
+                changeStream.append(option);
+        }
+        if (!resumeToken.isEmpty())
+            changeStream.append("resumeAfter", resumeToken);
+        else if (!hasStartOption && !startTime.isNull())
+            changeStream.append("startAtOperationTime", startTime);
+
+        mongo::BSONArrayBuilder pipeline;
+        pipeline.append(BSON("$changeStream" << changeStream.obj()));
+        for (mongo::BSONObjIterator it(stages); it.more(); ) {
+            mongo::BSONElement const stage = it.next();
+            if (stage.isABSONObj())
+                pipeline.append(stage.Obj());
+        }
+        if (!match.isEmpty())
+            pipeline.append(BSON("$match" << match));
+
+        return pipeline.arr();
+    }
+
+    void ChangeStreamBuffer::push(const std::vector<mongo::BSONObj> &events, const mongo::BSONObj &resumeToken)
+    {
+        for (auto const& event : events)
+            _pending.push_back(event.getOwned());
+        _received += events.size();
+
+        if (!resumeToken.isEmpty())
+            _resumeToken = resumeToken.getOwned();
+        else if (!events.empty() && events.back()["_id"].isABSONObj())
+            _resumeToken = events.back()["_id"].Obj().getOwned();
+    }
+
+    void ChangeStreamBuffer::setStartTime(const mongo::Timestamp &operationTime)
+    {
+        if (_startTime.isNull())
+            _startTime = operationTime;
+    }
+
+    ChangeStreamFlush ChangeStreamBuffer::flush()
+    {
+        ChangeStreamFlush result;
+
+        // Events that would be dropped in the same flush are never shown
+        size_t const skipped = _pending.size() > _capacity ? _pending.size() - _capacity : 0;
+        result.appended.assign(_pending.begin() + skipped, _pending.end());
+        _pending.clear();
+
+        size_t const total = _shown.size() + result.appended.size();
+        result.dropped = total > _capacity ? total - _capacity : 0;
+        _shown.erase(_shown.begin(), _shown.begin() + result.dropped);
+        _shown.insert(_shown.end(), result.appended.begin(), result.appended.end());
+
+        return result;
+    }
+
+    void ChangeStreamBuffer::clear()
+    {
+        _shown.clear();
+        _pending.clear();
+        _received = 0;
+    }
+}
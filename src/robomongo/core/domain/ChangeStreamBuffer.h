@@ -0,0 +1,78 @@
+#pragma once
+
+#include <deque>
+#include <vector>
+
+#include <mongo/bson/bsonobj.h>
+#include <mongo/bson/timestamp.h>
+
+namespace Robomongo
+{
+    /**
+     * @brief Change events to be applied to a view at once: 'dropped' oldest shown events are 
+     *        removed, then 'appended' events are added after the remaining ones
+     */
+    struct ChangeStreamFlush
+    {
+        size_t dropped = 0;
+        std::vector<mongo::BSONObj> appended;
+    };
+
+    /**
+     * @brief Change events of a watched collection or database. Received events wait until the 
+     *        view flushes them, so many small batches are shown with one update. At most 
+     *        'capacity' newest events are shown, the oldest ones are dropped first.
+     *        Keeps resume token of the last received batch, so that stream can be reopened 
+     *        after pause where it stopped.
+     */
+    class ChangeStreamBuffer
+    {
+    public:
+        explicit ChangeStreamBuffer(size_t capacity);
+
+        /**
+         * @brief Change stream aggregation pipeline:
+         *        [ { $changeStream: options }, stages..., { $match: match } ].
+         *        Full documents of updates are looked up unless 'options' say otherwise.
+         *        Stream resumes after 'resumeToken' if it is not empty, start options of 
+         *        'options' are ignored then. Otherwise, if 'options' have no start option, 
+         *        stream starts at 'startTime' unless it is null. $match is omitted if 'match' is empty.
+         */
+        static mongo::BSONObj pipeline(const mongo::BSONObj &stages, const mongo::BSONObj &options,
+                                       const mongo::BSONObj &match, const mongo::BSONObj &resumeToken,
+                                       const mongo::Timestamp &startTime = mongo::Timestamp());
+
+        /**
+         * @brief Adds received 'events'. 'resumeToken' is postBatchResumeToken of the batch, 
+         *        if it is empty _id of the last event is used.
+         */
+        void push(const std::vector<mongo::BSONObj> &events, const mongo::BSONObj &resumeToken);
+
+        /**
+         * @brief Keeps operation time of the reply that opened the stream first, so that stream 
+         *        reopened before any resume token is received does not miss events
+         */
+        void setStartTime(const mongo::Timestamp &operationTime);
+
+        /**
+         * @brief Moves received events to shown ones
+         */
+        ChangeStreamFlush flush();
+
+        bool hasPending() const { return !_pending.empty(); }
+        size_t size() const { return _shown.size(); }
+        const mongo::BSONObj &at(size_t index) const { return _shown[index]; }
+        const mongo::BSONObj &resumeToken() const { return _resumeToken; }
+        const mongo::Timestamp &startTime() const { return _startTime; }
+        long long received() const { return _received; }
+        void clear();
+
+    private:
+        size_t const _capacity;
+        std::deque<mongo::BSONObj> _shown;
+        std::vector<mongo::BSONObj> _pending;
+        mongo::BSONObj _resumeToken;
+        mongo::Timestamp _startTime;
+        long long _received = 0;
+    };
+}
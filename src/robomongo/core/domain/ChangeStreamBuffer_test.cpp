@@ -0,0 +1,124 @@
+#include "gtest/gtest.h"
+#include "robomongo/core/domain/ChangeStreamBuffer.h"
+
+#include <mongo/bson/bsonobjbuilder.h>
+
+using namespace Robomongo;
+
+namespace
+{
+    std::vector<mongo::BSONObj> events(int first, int count)
+    {
+        std::vector<mongo::BSONObj> result;
+        for (int i = first; i < first + count; ++i)
+            result.push_back(BSON("_id" << BSON("_data" << i) << "operationType" << "insert"));
+        return result;
+    }
+
+    int eventNumber(const mongo::BSONObj &event)
+    {
+        return event["_id"].Obj()["_data"].numberInt();
+    }
+}
+
+TEST(change_stream_buffer_tests, flush_AppendsPendingEvents)
+{
+    ChangeStreamBuffer buffer(10);
+    buffer.push(events(0, 2), mongo::BSONObj());
+    buffer.push(events(2, 1), mongo::BSONObj());
+    EXPECT_TRUE(buffer.hasPending());
+    EXPECT_EQ(0u, buffer.size());
+
+    ChangeStreamFlush const flush = buffer.flush();
+    EXPECT_EQ(0u, flush.dropped);
+    ASSERT_EQ(3u, flush.appended.size());
+    EXPECT_EQ(0, eventNumber(flush.appended[0]));
+    EXPECT_EQ(2, eventNumber(flush.appended[2]));
+    EXPECT_FALSE(buffer.hasPending());
+    EXPECT_EQ(3u, buffer.size());
+    EXPECT_EQ(3, buffer.received());
+}
+
+TEST(change_stream_buffer_tests, flush_DropsOldestEventsOverCapacity)
+{
+    ChangeStreamBuffer buffer(4);
+    buffer.push(events(0, 3), mongo::BSONObj());
+    buffer.flush();
+
+    buffer.push(events(3, 3), mongo::BSONObj());
+    ChangeStreamFlush const flush = buffer.flush();
+    EXPECT_EQ(2u, flush.dropped);
+    EXPECT_EQ(3u, flush.appended.size());
+    ASSERT_EQ(4u, buffer.size());
+    EXPECT_EQ(2, eventNumber(buffer.at(0)));
+    EXPECT_EQ(5, eventNumber(buffer.at(3)));
+}
+
+TEST(change_stream_buffer_tests, flush_ShowsOnlyNewestWhenBatchExceedsCapacity)
+{
+    ChangeStreamBuffer buffer(3);
+    buffer.push(events(0, 2), mongo::BSONObj());
+    buffer.flush();
+
+    buffer.push(events(2, 5), mongo::BSONObj());
+    ChangeStreamFlush const flush = buffer.flush();
+    EXPECT_EQ(2u, flush.dropped);
+    ASSERT_EQ(3u, flush.appended.size());
+    EXPECT_EQ(4, eventNumber(flush.appended[0]));
+    EXPECT_EQ(6, eventNumber(buffer.at(2)));
+    EXPECT_EQ(7, buffer.received());
+}
+
+TEST(change_stream_buffer_tests, push_KeepsResumeTokenOfLastBatch)
+{
+    ChangeStreamBuffer buffer(10);
+    EXPECT_TRUE(buffer.resumeToken().isEmpty());
+
+    buffer.push(events(0, 2), mongo::BSONObj());
+    EXPECT_TRUE(buffer.resumeToken().binaryEqual(BSON("_data" << 1)));
+
+    // Post batch resume token moves on even if batch is empty
+    buffer.push(std::vector<mongo::BSONObj>(), BSON("_data" << 9));
+    EXPECT_TRUE(buffer.resumeToken().binaryEqual(BSON("_data" << 9)));
+
+    buffer.clear();
+    EXPECT_TRUE(buffer.resumeToken().binaryEqual(BSON("_data" << 9)));
+}
+
+TEST(change_stream_buffer_tests, pipeline_PushesMatchAndResumeTokenIntoPipeline)
+{
+    mongo::BSONObj const stages = BSON_ARRAY(BSON("$project" << BSON("ns" << 0)));
+    mongo::BSONObj const match = BSON("operationType" << "update");
+
+    mongo::BSONObj const fresh = ChangeStreamBuffer::pipeline(stages, mongo::BSONObj(), match, mongo::BSONObj());
+    EXPECT_TRUE(fresh.binaryEqual(BSON_ARRAY(
+        BSON("$changeStream" << BSON("fullDocument" << "updateLookup")) <<
+        BSON("$project" << BSON("ns" << 0)) <<
+        BSON("$match" << match))));
+
+    mongo::BSONObj const options = BSON("fullDocument" << "default" << "startAfter" << BSON("_data" << 1));
+    mongo::BSONObj const resumed = ChangeStreamBuffer::pipeline(mongo::BSONObj(), options, mongo::BSONObj(),
+                                                                BSON("_data" << 5));
+    EXPECT_TRUE(resumed.binaryEqual(BSON_ARRAY(
+        BSON("$changeStream" << BSON("fullDocument" << "default" << "resumeAfter" << BSON("_data" << 5))))));
+}
+
+TEST(change_stream_buffer_tests, pipeline_StartsAtOperationTimeWithoutResumeToken)
+{
+    ChangeStreamBuffer buffer(10);
+    buffer.setStartTime(mongo::Timestamp(100, 1));
+    buffer.setStartTime(mongo::Timestamp(200, 1));  // reopened stream keeps the first start time
+    EXPECT_EQ(mongo::Timestamp(100, 1), buffer.startTime());
+
+    mongo::BSONObj const reopened = ChangeStreamBuffer::pipeline(mongo::BSONObj(), mongo::BSONObj(), 
+        mongo::BSONObj(), buffer.resumeToken(), buffer.startTime());
+    EXPECT_TRUE(reopened.binaryEqual(BSON_ARRAY(BSON("$changeStream" << 
+        BSON("fullDocument" << "updateLookup" << "startAtOperationTime" << mongo::Timestamp(100, 1))))));
+
+    // Start option given by user is kept until resume token is received
+    mongo::BSONObj const options = BSON("startAfter" << BSON("_data" << 1));
+    mongo::BSONObj const userStart = ChangeStreamBuffer::pipeline(mongo::BSONObj(), options, 
+        mongo::BSONObj(), mongo::BSONObj(), buffer.startTime());
+    EXPECT_TRUE(userStart.binaryEqual(BSON_ARRAY(BSON("$changeStream" << 
+        BSON("fullDocument" << "updateLookup" << "startAfter" << BSON("_data" << 1))))));
+}
@@ -0,0 +1,48 @@
+#include "robomongo/core/domain/CurrentOpsTracker.h"
+
+namespace Robomongo
+{
+    std::string CurrentOpsTracker::opKey(const mongo::BSONObj &op)
+    {
+        mongo::BSONElement const opid = op.getField("opid");
+        if (opid.type() == mongo::String)
+            return opid.String();
+
+        if (opid.isNumber())
+            return std::to_string(opid.safeNumberLong());
+
+        return "cursor:" + std::to_string(op.getObjectField("cursor").getField("cursorId").safeNumberLong());
+    }
+
+    mongo::BSONObj CurrentOpsTracker::op(const std::string &key) const
+    {
+        auto const it = _ops.find(key);
+        return it == _ops.end() ? mongo::BSONObj() : it->second;
+    }
+
+    CurrentOpsDiff CurrentOpsTracker::update(const std::vector<mongo::BSONObj> &snapshot)
+    {
+        CurrentOpsDiff diff;
+        std::unordered_map<std::string, mongo::BSONObj> ops;
+        ops.reserve(snapshot.size());
+
+        for (auto const& op : snapshot) {
+            std::string key = opKey(op);
+            auto const previous = _ops.find(key);
+            if (previous == _ops.end())
+                diff.added.push_back(op);
+            else if (!previous->second.binaryEqual(op))
+                diff.changed.push_back(op);
+
+            ops.emplace(std::move(key), op);
+        }
+
+        for (auto const& previous : _ops) {
+            if (ops.find(previous.first) == ops.end())
+                diff.removed.push_back(previous.first);
+        }
+
+        _ops.swap(ops);
+        return diff;
+    }
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <mongo/bson/bsonobj.h>
+
+namespace Robomongo
+{
+    /**
+     * @brief Changes between two consecutive currentOp snapshots
+     */
+    struct CurrentOpsDiff
+    {
+        std::vector<mongo::BSONObj> added;
+        std::vector<mongo::BSONObj> changed;
+        std::vector<std::string> removed;   // keys, see CurrentOpsTracker::opKey()
+
+        bool isEmpty() const { return added.empty() && changed.empty() && removed.empty(); }
+    };
+
+    /**
+     * @brief Keeps last currentOp snapshot, so that views can be updated 
+     *        with changed operations only instead of being rebuilt every sample
+     */
+    class CurrentOpsTracker
+    {
+    public:
+        /**
+         * @brief Identity of operation across snapshots: its 'opid' as text, or "cursor:<id>"
+         *        for idle cursors that have no operation id
+         */
+        static std::string opKey(const mongo::BSONObj &op);
+
+        /**
+         * @brief Replaces tracked snapshot with 'snapshot' and returns what changed. Operations
+         *        with equal key and identical document are not reported.
+         */
+        CurrentOpsDiff update(const std::vector<mongo::BSONObj> &snapshot);
+
+        /**
+         * @brief Tracked operation with key 'key', empty if it is not in last snapshot
+         */
+        mongo::BSONObj op(const std::string &key) const;
+
+        void clear() { _ops.clear(); }
+        size_t size() const { return _ops.size(); }
+
+    private:
+        std::unordered_map<std::string, mongo::BSONObj> _ops;
+    };
+}
@@ -0,0 +1,42 @@
+#include "gtest/gtest.h"
+#include "robomongo/core/domain/CurrentOpsTracker.h"
+
+#include <mongo/bson/bsonobjbuilder.h>
+
+using namespace Robomongo;
+
+TEST(current_ops_tracker_tests, opKey)
+{
+    EXPECT_EQ("42", CurrentOpsTracker::opKey(BSON("opid" << 42)));
+    EXPECT_EQ("42", CurrentOpsTracker::opKey(BSON("opid" << 42LL)));
+    EXPECT_EQ("shard01:42", CurrentOpsTracker::opKey(BSON("opid" << "shard01:42")));
+    EXPECT_EQ("cursor:7", CurrentOpsTracker::opKey(BSON("type" << "idleCursor" << "cursor" << BSON("cursorId" << 7LL))));
+}
+
+TEST(current_ops_tracker_tests, update_ReportsAddedChangedAndRemoved)
+{
+    CurrentOpsTracker tracker;
+
+    auto diff = tracker.update({ BSON("opid" << 1 << "secs_running" << 0), BSON("opid" << 2 << "secs_running" << 5) });
+    EXPECT_EQ(2u, diff.added.size());
+    EXPECT_TRUE(diff.changed.empty());
+    EXPECT_TRUE(diff.removed.empty());
+
+    diff = tracker.update({ BSON("opid" << 2 << "secs_running" << 5), BSON("opid" << 3 << "secs_running" << 0),
+                            BSON("opid" << 1 << "secs_running" << 1) });
+    ASSERT_EQ(1u, diff.added.size());
+    EXPECT_EQ(3, diff.added[0].getIntField("opid"));
+    ASSERT_EQ(1u, diff.changed.size());
+    EXPECT_EQ(1, diff.changed[0].getIntField("opid"));
+    EXPECT_TRUE(diff.removed.empty());
+
+    diff = tracker.update({ BSON("opid" << 3 << "secs_running" << 0) });
+    EXPECT_TRUE(diff.added.empty());
+    EXPECT_TRUE(diff.changed.empty());
+    ASSERT_EQ(2u, diff.removed.size());
+    EXPECT_EQ(1u, tracker.size());
+    EXPECT_EQ(3, tracker.op("3").getIntField("opid"));
+    EXPECT_TRUE(tracker.op("1").isEmpty());
+
+    EXPECT_TRUE(tracker.update({ BSON("opid" << 3 << "secs_running" << 0) }).isEmpty());
+}
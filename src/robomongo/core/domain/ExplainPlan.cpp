@@ -0,0 +1,165 @@
+#include "robomongo/core/domain/ExplainPlan.h"
+
+#include <mongo/bson/bsonobjbuilder.h>
+
+namespace
+{
+    using namespace Robomongo;
+
+    long long numberOr(const mongo::BSONObj &obj, const char *field, long long defaultValue = -1)
+    {
+        mongo::BSONElement const elem = obj.getField(field);
+        return elem.isNumber() ? elem.safeNumberLong() : defaultValue;
+    }
+
+    std::string stageDetails(const mongo::BSONObj &stage)
+    {
+        if (stage.hasField("indexName"))
+            return stage.getStringField("indexName");
+
+        if (stage.hasField("sortPattern") && stage.getField("sortPattern").isABSONObj())
+            return stage.getObjectField("sortPattern").jsonString();
+
+        if (stage.hasField("filter") && stage.getField("filter").isABSONObj())
+            return stage.getObjectField("filter").jsonString();
+
+        return "";
+    }
+
+    void parseBody(const mongo::BSONObj &body, ExplainPlan &plan);
+
+    // Plan stage: { stage: "FETCH", nReturned: 1, ..., inputStage: { stage: "IXSCAN", ... } }
+    ExplainStage parseStage(const mongo::BSONObj &stage)
+    {
+        ExplainStage result;
+        result.name = stage.hasField("shardName") ? stage.getStringField("shardName") 
+                                                  : stage.getStringField("stage");
+        result.details = stageDetails(stage);
+        result.nReturned = numberOr(stage, "nReturned");
+        result.docsExamined = numberOr(stage, "docsExamined", numberOr(stage, "totalDocsExamined"));
+        result.keysExamined = numberOr(stage, "keysExamined", numberOr(stage, "totalKeysExamined"));
+        result.timeMs = numberOr(stage, "executionTimeMillisEstimate", numberOr(stage, "executionTimeMillis"));
+        result.usedDisk = stage.getField("usedDisk").trueValue();
+
+        // Shard of sharded find: { shardName: "rs0", executionStages: { ... } }
+        for (char const *field : { "executionStages", "winningPlan" }) {
+            if (stage.hasField("shardName") && stage.getField(field).isABSONObj()) {
+                result.children.push_back(parseStage(stage.getObjectField(field)));
+                return result;
+            }
+        }
+
+        for (char const *field : { "inputStage", "thenStage", "elseStage", "outerStage", "innerStage" }) {
+            if (stage.getField(field).isABSONObj())
+                result.children.push_back(parseStage(stage.getObjectField(field)));
+        }
+
+        for (char const *field : { "inputStages", "shards" }) {
+            mongo::BSONElement const children = stage.getField(field);
+            if (children.type() != mongo::Array)
+                continue;
+
+            for (auto const& child : children.Array()) {
+                if (child.isABSONObj())
+                    result.children.push_back(parseStage(child.Obj()));
+            }
+        }
+
+        return result;
+    }
+
+    // Aggregation stage: { $group: { ... }, nReturned: 1, executionTimeMillisEstimate: 0 }
+    ExplainStage parsePipelineStage(const mongo::BSONObj &stage)
+    {
+        ExplainStage result;
+        mongo::BSONElement const spec = stage.firstElement();
+        result.name = spec.fieldName();
+        result.nReturned = numberOr(stage, "nReturned");
+        result.timeMs = numberOr(stage, "executionTimeMillisEstimate");
+        result.usedDisk = stage.getField("usedDisk").trueValue();
+
+        if (result.name == "$cursor" && spec.isABSONObj()) {
+            // Query part of pipeline that is executed as find
+            ExplainPlan cursorPlan;
+            parseBody(spec.Obj(), cursorPlan);
+            result.children = cursorPlan.stages;
+            result.docsExamined = cursorPlan.docsExamined;
+            result.keysExamined = cursorPlan.keysExamined;
+            if (result.nReturned < 0)
+                result.nReturned = cursorPlan.nReturned;
+        }
+        else if (spec.isABSONObj()) {
+            result.details = spec.Obj().jsonString();
+        }
+
+        return result;
+    }
+
+    void parseBody(const mongo::BSONObj &body, ExplainPlan &plan)
+    {
+        // Aggregation that was not (completely) turned into find
+        if (body.getField("stages").type() == mongo::Array) {
+            for (auto const& stage : body.getField("stages").Array()) {
+                if (stage.isABSONObj())
+                    plan.stages.push_back(parsePipelineStage(stage.Obj()));
+            }
+
+            if (!plan.stages.empty() && plan.stages.front().name == "$cursor") {
+                plan.docsExamined = plan.stages.front().docsExamined;
+                plan.keysExamined = plan.stages.front().keysExamined;
+            }
+            if (!plan.stages.empty())
+                plan.nReturned = plan.stages.back().nReturned;
+            return;
+        }
+
+        // Aggregation on sharded collection: { shards: { rs0: { stages: [ ... ] }, ... } }
+        if (body.getField("shards").type() == mongo::Object) {
+            for (auto const& shard : body.getObjectField("shards")) {
+                if (!shard.isABSONObj())
+                    continue;
+
+                ExplainPlan shardPlan;
+                parseBody(shard.Obj(), shardPlan);
+
+                ExplainStage shardStage;
+                shardStage.name = shard.fieldName();
+                shardStage.nReturned = shardPlan.nReturned;
+                shardStage.docsExamined = shardPlan.docsExamined;
+                shardStage.keysExamined = shardPlan.keysExamined;
+                shardStage.timeMs = shardPlan.timeMs;
+                shardStage.children = shardPlan.stages;
+                plan.stages.push_back(shardStage);
+            }
+            return;
+        }
+
+        mongo::BSONObj const stats = body.getObjectField("executionStats");
+        if (!stats.isEmpty()) {
+            plan.nReturned = numberOr(stats, "nReturned");
+            plan.docsExamined = numberOr(stats, "totalDocsExamined");
+            plan.keysExamined = numberOr(stats, "totalKeysExamined");
+            plan.timeMs = numberOr(stats, "executionTimeMillis");
+        }
+
+        // Since 5.0 queries run by slot based engine describe their plan in 'queryPlan',
+        // their execution stages do not follow plan stages
+        mongo::BSONObj const winningPlan = body.getObjectField("queryPlanner").getObjectField("winningPlan");
+        if (winningPlan.hasField("queryPlan"))
+            plan.stages.push_back(parseStage(winningPlan.getObjectField("queryPlan")));
+        else if (stats.getField("executionStages").isABSONObj())
+            plan.stages.push_back(parseStage(stats.getObjectField("executionStages")));
+        else if (!winningPlan.isEmpty())
+            plan.stages.push_back(parseStage(winningPlan));
+    }
+}
+
+namespace Robomongo
+{
+    ExplainPlan ExplainPlan::fromBson(const mongo::BSONObj &explain)
+    {
+        ExplainPlan plan;
+        parseBody(explain, plan);
+        return plan;
+    }
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <mongo/bson/bsonobj.h>
+
+namespace Robomongo
+{
+    /**
+     * @brief Stage of query plan (or aggregation pipeline) with its execution statistics.
+     *        Statistics not reported by server are -1.
+     */
+    struct ExplainStage
+    {
+        std::string name;       // i.e. "IXSCAN", "$group" or name of shard
+        std::string details;    // index, filter or sort pattern of the stage
+        long long nReturned = -1;
+        long long docsExamined = -1;
+        long long keysExamined = -1;
+        long long timeMs = -1;
+        bool usedDisk = false;
+        std::vector<ExplainStage> children;
+
+        bool isCollectionScan() const { return name == "COLLSCAN"; }
+
+        /**
+         * @brief Blocking sort of documents in memory, sort that follows index order has no stage
+         */
+        bool isInMemorySort() const { return name == "SORT" || name == "$sort"; }
+    };
+
+    /**
+     * @brief Winning plan of find or aggregate command, parsed from 'explain' output
+     *        of "executionStats" (or "queryPlanner") verbosity.
+     */
+    struct ExplainPlan
+    {
+        // Totals of the whole query
+        long long nReturned = -1;
+        long long docsExamined = -1;
+        long long keysExamined = -1;
+        long long timeMs = -1;
+
+        // Root stage of find plan, or pipeline stages in order
+        std::vector<ExplainStage> stages;
+
+        static ExplainPlan fromBson(const mongo::BSONObj &explain);
+    };
+}
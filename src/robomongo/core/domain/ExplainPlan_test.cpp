@@ -0,0 +1,85 @@
+#include "gtest/gtest.h"
+#include "robomongo/core/domain/ExplainPlan.h"
+
+#include <mongo/bson/bsonobjbuilder.h>
+
+using namespace Robomongo;
+
+TEST(explain_plan_tests, fromBson_FindExecutionStats_UsesExecutionStages)
+{
+    auto const explain = BSON(
+        "queryPlanner" << BSON("winningPlan" << BSON("stage" << "FETCH")) <<
+        "executionStats" << BSON(
+            "nReturned" << 2 << "executionTimeMillis" << 5 <<
+            "totalKeysExamined" << 2 << "totalDocsExamined" << 2 <<
+            "executionStages" << BSON(
+                "stage" << "FETCH" << "nReturned" << 2 << "executionTimeMillisEstimate" << 4 << 
+                "docsExamined" << 2 <<
+                "inputStage" << BSON(
+                    "stage" << "IXSCAN" << "nReturned" << 2 << "executionTimeMillisEstimate" << 1 << 
+                    "keysExamined" << 2 << "indexName" << "a_1"))));
+
+    auto const plan = ExplainPlan::fromBson(explain);
+
+    EXPECT_EQ(2, plan.nReturned);
+    EXPECT_EQ(2, plan.docsExamined);
+    EXPECT_EQ(2, plan.keysExamined);
+    EXPECT_EQ(5, plan.timeMs);
+    ASSERT_EQ(1u, plan.stages.size());
+
+    auto const& fetch = plan.stages.front();
+    EXPECT_EQ("FETCH", fetch.name);
+    EXPECT_EQ(2, fetch.docsExamined);
+    EXPECT_EQ(-1, fetch.keysExamined);
+    ASSERT_EQ(1u, fetch.children.size());
+
+    auto const& ixscan = fetch.children.front();
+    EXPECT_EQ("IXSCAN", ixscan.name);
+    EXPECT_EQ("a_1", ixscan.details);
+    EXPECT_EQ(2, ixscan.keysExamined);
+    EXPECT_FALSE(ixscan.isCollectionScan());
+}
+
+TEST(explain_plan_tests, fromBson_QueryPlannerOnly_UsesWinningPlan)
+{
+    auto const explain = BSON(
+        "queryPlanner" << BSON("winningPlan" << BSON(
+            "stage" << "SORT" << "sortPattern" << BSON("b" << 1) <<
+            "inputStage" << BSON("stage" << "COLLSCAN"))));
+
+    auto const plan = ExplainPlan::fromBson(explain);
+
+    EXPECT_EQ(-1, plan.nReturned);
+    ASSERT_EQ(1u, plan.stages.size());
+    EXPECT_TRUE(plan.stages.front().isInMemorySort());
+    EXPECT_EQ(-1, plan.stages.front().nReturned);
+    ASSERT_EQ(1u, plan.stages.front().children.size());
+    EXPECT_TRUE(plan.stages.front().children.front().isCollectionScan());
+}
+
+TEST(explain_plan_tests, fromBson_Aggregate_ListsPipelineStagesWithCursorPlan)
+{
+    auto const explain = BSON("stages" << BSON_ARRAY(
+        BSON("$cursor" << BSON(
+            "queryPlanner" << BSON("winningPlan" << BSON("stage" << "COLLSCAN")) <<
+            "executionStats" << BSON(
+                "nReturned" << 10 << "totalKeysExamined" << 0 << "totalDocsExamined" << 10 <<
+                "executionStages" << BSON("stage" << "COLLSCAN" << "nReturned" << 10 << "docsExamined" << 10))) <<
+             "nReturned" << 10 << "executionTimeMillisEstimate" << 3) <<
+        BSON("$group" << BSON("_id" << "$a") << "nReturned" << 3 << "executionTimeMillisEstimate" << 4)));
+
+    auto const plan = ExplainPlan::fromBson(explain);
+
+    ASSERT_EQ(2u, plan.stages.size());
+    EXPECT_EQ("$cursor", plan.stages[0].name);
+    EXPECT_EQ(10, plan.stages[0].docsExamined);
+    ASSERT_EQ(1u, plan.stages[0].children.size());
+    EXPECT_TRUE(plan.stages[0].children.front().isCollectionScan());
+
+    EXPECT_EQ("$group", plan.stages[1].name);
+    EXPECT_EQ(3, plan.stages[1].nReturned);
+    EXPECT_EQ(4, plan.stages[1].timeMs);
+
+    EXPECT_EQ(3, plan.nReturned);
+    EXPECT_EQ(10, plan.docsExamined);
+}
@@ -0,0 +1,96 @@
+#include "robomongo/core/domain/HyperLogLog.h"
+
+#include <cmath>
+#include <stdexcept>
+
+namespace
+{
+    // Finalizer of splitmix64, spreads FNV-1a bits over the whole word
+    uint64_t mix(uint64_t x)
+    {
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebULL;
+        x ^= x >> 31;
+        return x;
+    }
+}
+
+namespace Robomongo
+{
+    HyperLogLog::HyperLogLog(int precision /* = 12 */) :
+        _precision(precision),
+        _registers(size_t(1) << precision, 0)
+    {
+        if (precision < 4 || precision > 18)
+            throw std::invalid_argument("HyperLogLog precision must be between 4 and 18");
+    }
+
+    void HyperLogLog::add(uint64_t hash)
+    {
+        size_t const index = hash >> (64 - _precision);
+
+        // Rank is position of the first 1 bit in remaining bits
+        uint64_t rest = hash << _precision;
+        uint8_t rank = 1;
+        int const maxRank = 64 - _precision + 1;
+        while (rank < maxRank && !(rest & 0x8000000000000000ULL)) {
+            rest <<= 1;
+            ++rank;
+        }
+
+        if (rank > _registers[index])
+            _registers[index] = rank;
+    }
+
+    void HyperLogLog::merge(const HyperLogLog &other)
+    {
+        if (other._precision != _precision)
+            throw std::invalid_argument("Cannot merge HyperLogLog sketches of different precision");
+
+        for (size_t i = 0; i < _registers.size(); ++i) {
+            if (other._registers[i] > _registers[i])
+                _registers[i] = other._registers[i];
+        }
+    }
+
+    long long HyperLogLog::estimate() const
+    {
+        double const m = static_cast<double>(_registers.size());
+        double sum = 0;
+        int zeros = 0;
+        for (uint8_t reg : _registers) {
+            sum += std::ldexp(1.0, -reg);
+            if (reg == 0)
+                ++zeros;
+        }
+
+        double const alpha = 0.7213 / (1 + 1.079 / m);
+        double estimate = alpha * m * m / sum;
+
+        // Small cardinalities are estimated better by counting empty registers (linear counting)
+        if (estimate <= 2.5 * m && zeros > 0)
+            estimate = m * std::log(m / zeros);
+
+        return std::llround(estimate);
+    }
+
+    uint64_t HyperLogLog::hash(const mongo::BSONElement &elem)
+    {
+        // FNV-1a over type byte and value bytes
+        uint64_t hash = 0xcbf29ce484222325ULL;
+        auto const addByte = [&hash](unsigned char byte) {
+            hash ^= byte;
+            hash *= 0x100000001b3ULL;
+        };
+
+        addByte(static_cast<unsigned char>(elem.type()));
+        char const *value = elem.value();
+        int const size = elem.valuesize();
+        for (int i = 0; i < size; ++i)
+            addByte(static_cast<unsigned char>(value[i]));
+
+        return mix(hash);
+    }
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <mongo/bson/bsonelement.h>
+
+namespace Robomongo
+{
+    /**
+     * @brief Estimates number of distinct values added to it in fixed memory 
+     *        (2^precision one-byte registers). Standard error is about 1.04 / sqrt(2^precision),
+     *        1.6% for default precision. Sketches of same precision can be merged, 
+     *        so values can be added from several threads into separate sketches.
+     */
+    class HyperLogLog
+    {
+    public:
+        explicit HyperLogLog(int precision = 12);
+
+        void add(uint64_t hash);
+
+        /**
+         * @brief Adds value of 'elem', field name is ignored
+         */
+        void add(const mongo::BSONElement &elem) { add(hash(elem)); }
+
+        /**
+         * @brief Adds all values of 'other', precisions must be equal
+         */
+        void merge(const HyperLogLog &other);
+
+        long long estimate() const;
+
+        /**
+         * @brief 64-bit hash of type and value bytes of 'elem'
+         */
+        static uint64_t hash(const mongo::BSONElement &elem);
+
+    private:
+        int _precision;
+        std::vector<uint8_t> _registers;
+    };
+}
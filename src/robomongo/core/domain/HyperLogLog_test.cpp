@@ -0,0 +1,54 @@
+#include "gtest/gtest.h"
+#include "robomongo/core/domain/HyperLogLog.h"
+
+#include <cstdlib>
+
+#include <mongo/bson/bsonobjbuilder.h>
+
+using namespace Robomongo;
+
+TEST(hyper_log_log_tests, estimate_SmallCardinalityIsNearlyExact)
+{
+    HyperLogLog hll;
+    EXPECT_EQ(0, hll.estimate());
+
+    for (int repeat = 0; repeat < 3; ++repeat) {
+        for (int i = 0; i < 10; ++i)
+            hll.add(BSON("" << i).firstElement());
+    }
+    EXPECT_NEAR(10, hll.estimate(), 1);
+}
+
+TEST(hyper_log_log_tests, estimate_LargeCardinalityWithinError)
+{
+    HyperLogLog hll;
+    for (int i = 0; i < 100000; ++i)
+        hll.add(BSON("" << i).firstElement());
+
+    EXPECT_LT(std::abs(hll.estimate() - 100000), 100000 * 5 / 100);
+}
+
+TEST(hyper_log_log_tests, hash_DependsOnTypeAndValueOnly)
+{
+    EXPECT_EQ(HyperLogLog::hash(BSON("a" << "x").firstElement()), 
+              HyperLogLog::hash(BSON("b" << "x").firstElement()));
+    EXPECT_NE(HyperLogLog::hash(BSON("a" << 1).firstElement()), 
+              HyperLogLog::hash(BSON("a" << 1LL).firstElement()));
+}
+
+TEST(hyper_log_log_tests, merge_EqualsUnion)
+{
+    HyperLogLog first;
+    HyperLogLog second;
+    for (int i = 0; i < 3000; ++i)
+        first.add(BSON("" << i).firstElement());
+    for (int i = 2000; i < 5000; ++i)
+        second.add(BSON("" << i).firstElement());
+
+    HyperLogLog all;
+    for (int i = 0; i < 5000; ++i)
+        all.add(BSON("" << i).firstElement());
+
+    first.merge(second);
+    EXPECT_EQ(all.estimate(), first.estimate());
+}
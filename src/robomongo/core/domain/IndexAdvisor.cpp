@@ -0,0 +1,391 @@
+#include "robomongo/core/domain/IndexAdvisor.h"
+
+#include <algorithm>
+#include <set>
+
+#include <mongo/bson/bsonobjbuilder.h>
+
+namespace
+{
+    using Robomongo::IndexAdvisor;
+
+    bool contains(const std::vector<std::string> &fields, const std::string &field)
+    {
+        return std::find(fields.begin(), fields.end(), field) != fields.end();
+    }
+
+    void addField(std::vector<std::string> &fields, const std::string &field)
+    {
+        if (!contains(fields, field))
+            fields.push_back(field);
+    }
+
+    bool isOperatorObject(const mongo::BSONElement &elem)
+    {
+        return elem.type() == mongo::Object && elem.Obj().firstElementFieldName()[0] == '$';
+    }
+
+    // Returns false if filter has predicates that single compound index cannot serve
+    bool collectPredicates(const mongo::BSONObj &filter, IndexAdvisor::QueryKeys &keys)
+    {
+        mongo::BSONObjIterator it(filter);
+        while (it.more()) {
+            mongo::BSONElement const elem = it.next();
+            std::string const name = elem.fieldName();
+
+            if (name[0] == '$') {
+                if (name == "$comment")
+                    continue;
+
+                if (name != "$and" || elem.type() != mongo::Array)
+                    return false;   // $or, $nor, $text, $where, $expr
+
+                for (auto const& clause : elem.Array()) {
+                    if (clause.type() != mongo::Object || !collectPredicates(clause.Obj(), keys))
+                        return false;
+                }
+                continue;
+            }
+
+            bool isEquality = elem.type() != mongo::RegEx;
+            if (isOperatorObject(elem)) {
+                mongo::BSONObjIterator ops(elem.Obj());
+                while (ops.more()) {
+                    std::string const op = ops.next().fieldName();
+                    if (op != "$eq" && op != "$in" && op != "$options")
+                        isEquality = false;
+                }
+            }
+
+            addField(isEquality ? keys.equality : keys.range, name);
+        }
+
+        return true;
+    }
+
+    // Numeric key pattern fields, special indexes (text, 2dsphere, hashed) end the pattern
+    std::vector<mongo::BSONElement> orderedKeys(const mongo::BSONObj &indexKeys)
+    {
+        std::vector<mongo::BSONElement> keys;
+        mongo::BSONObjIterator it(indexKeys);
+        while (it.more()) {
+            mongo::BSONElement const key = it.next();
+            if (!key.isNumber())
+                break;
+            keys.push_back(key);
+        }
+        return keys;
+    }
+
+    int direction(const mongo::BSONElement &key)
+    {
+        return key.number() < 0 ? -1 : 1;
+    }
+
+    // True if all fields of 'prefix' start 'keys' with the same directions and 'keys' is longer
+    bool isStrictPrefix(const mongo::BSONObj &prefix, const mongo::BSONObj &keys)
+    {
+        auto const prefixKeys = orderedKeys(prefix);
+        auto const longerKeys = orderedKeys(keys);
+        if (prefixKeys.empty() || prefixKeys.size() != static_cast<size_t>(prefix.nFields()) ||
+            prefixKeys.size() >= longerKeys.size())
+            return false;
+
+        for (size_t i = 0; i < prefixKeys.size(); ++i) {
+            if (std::string(prefixKeys[i].fieldName()) != longerKeys[i].fieldName() ||
+                direction(prefixKeys[i]) != direction(longerKeys[i]))
+                return false;
+        }
+        return true;
+    }
+
+    // Index options that change which documents index holds or how it compares them (TTL, 
+    // sparse, partial, collation, hidden...), in field name order. Index with other options 
+    // than the longer one does not serve the same queries and is not redundant.
+    mongo::BSONObj significantOptions(const mongo::BSONObj &spec)
+    {
+        static std::set<std::string> const ignored { "v", "key", "name", "ns", "background", "unique" };
+
+        std::map<std::string, mongo::BSONElement> sorted;
+        mongo::BSONObjIterator it(spec);
+        while (it.more()) {
+            mongo::BSONElement const option = it.next();
+            if (ignored.count(option.fieldName()) == 0)
+                sorted.emplace(option.fieldName(), option);
+        }
+
+        mongo::BSONObjBuilder options;
+        for (auto const& option : sorted)
+            options.append(option.second);
+        return options.obj();
+    }
+
+    std::string join(const std::vector<std::string> &fields)
+    {
+        std::string result;
+        for (auto const& field : fields)
+            result += (result.empty() ? "" : ", ") + field;
+        return result;
+    }
+
+    std::string describe(const IndexAdvisor::QueryKeys &keys)
+    {
+        std::vector<std::string> parts;
+        if (!keys.equality.empty())
+            parts.push_back("equality on " + join(keys.equality));
+
+        if (!keys.sort.empty()) {
+            std::vector<std::string> sortFields;
+            for (auto const& field : keys.sort)
+                sortFields.push_back(field.first);
+            parts.push_back("sort by " + join(sortFields));
+        }
+
+        if (!keys.range.empty())
+            parts.push_back("range on " + join(keys.range));
+
+        return "No index serves " + join(parts);
+    }
+}
+
+namespace Robomongo
+{
+    IndexAdvisor::QueryKeys IndexAdvisor::queryKeys(const mongo::BSONObj &filter, const mongo::BSONObj &sort)
+    {
+        QueryKeys keys;
+        if (!collectPredicates(filter, keys))
+            return QueryKeys();
+
+        // Field compared for equality and range is bound by equality
+        keys.range.erase(std::remove_if(keys.range.begin(), keys.range.end(), 
+            [&keys](std::string const& field) { return contains(keys.equality, field); }), keys.range.end());
+
+        mongo::BSONObjIterator it(sort);
+        while (it.more()) {
+            mongo::BSONElement const field = it.next();
+            if (field.isNumber())   // { $meta: "textScore" } is not index sort
+                keys.sort.emplace_back(field.fieldName(), direction(field));
+        }
+
+        return keys;
+    }
+
+    mongo::BSONObj IndexAdvisor::esrIndex(const QueryKeys &keys)
+    {
+        mongo::BSONObjBuilder index;
+        std::set<std::string> added;
+
+        for (auto const& field : keys.equality) {
+            if (added.insert(field).second)
+                index.append(field, 1);
+        }
+
+        for (auto const& field : keys.sort) {
+            if (added.insert(field.first).second)
+                index.append(field.first, field.second);
+        }
+
+        for (auto const& field : keys.range) {
+            if (added.insert(field).second)
+                index.append(field, 1);
+        }
+
+        return index.obj();
+    }
+
+    bool IndexAdvisor::serves(const mongo::BSONObj &indexKeys, const QueryKeys &keys)
+    {
+        std::vector<mongo::BSONElement> const index = orderedKeys(indexKeys);
+        size_t i = 0;
+
+        // Equality fields in any order
+        std::set<std::string> equality(keys.equality.begin(), keys.equality.end());
+        while (i < index.size() && equality.erase(index[i].fieldName()) > 0)
+            ++i;
+
+        if (!equality.empty())
+            return false;
+
+        // Sort fields in order, index may be walked forward or backward
+        int orientation = 0;
+        for (auto const& field : keys.sort) {
+            if (contains(keys.equality, field.first))
+                continue;
+
+            if (i >= index.size() || field.first != index[i].fieldName())
+                return false;
+
+            int const relative = direction(index[i]) * field.second;
+            if (orientation != 0 && relative != orientation)
+                return false;
+
+            orientation = relative;
+            ++i;
+        }
+
+        return keys.range.empty() || (i < index.size() && contains(keys.range, index[i].fieldName()));
+    }
+
+    void IndexAdvisor::addProfileEntry(const mongo::BSONObj &entry)
+    {
+        std::string const op = entry.getStringField("op");
+        if (op == "getmore" || op == "insert")
+            return;
+
+        mongo::BSONObj const command = entry.getObjectField("command");
+        mongo::BSONObj filter;
+        mongo::BSONObj sort;
+
+        if (command.hasField("find")) {
+            filter = command.getObjectField("filter");
+            sort = command.getObjectField("sort");
+        }
+        else if (command.hasField("aggregate") && command.getField("pipeline").type() == mongo::Array) {
+            // Leading $match and $sort stages run before anything else and can use index
+            for (auto const& stage : command.getField("pipeline").Array()) {
+                mongo::BSONObj const stageObj = stage.Obj();
+                if (stageObj.hasField("$match") && filter.isEmpty() && sort.isEmpty())
+                    filter = stageObj.getObjectField("$match");
+                else if (stageObj.hasField("$sort") && sort.isEmpty())
+                    sort = stageObj.getObjectField("$sort");
+                else
+                    break;
+            }
+        }
+        else if (command.hasField("count") || command.hasField("distinct")) {
+            filter = command.getObjectField("query");
+        }
+        else if (command.hasField("findAndModify") || command.hasField("findandmodify")) {
+            filter = command.getObjectField("query");
+            sort = command.getObjectField("sort");
+        }
+        else if (command.hasField("q")) {
+            filter = command.getObjectField("q");   // single update or delete statement
+        }
+        else if (command.isEmpty()) {
+            // Before 3.6 find filter is in 'query', possibly wrapped with $query / $orderby
+            mongo::BSONObj const query = entry.getObjectField("query");
+            if (query.hasField("$query")) {
+                filter = query.getObjectField("$query");
+                sort = query.getObjectField("$orderby");
+            }
+            else if (query.hasField("find")) {
+                filter = query.getObjectField("filter");
+                sort = query.getObjectField("sort");
+            }
+            else {
+                filter = query;
+            }
+        }
+
+        addQuery(entry.getStringField("ns"), filter, sort, entry.getIntField("millis") > 0 ? entry.getIntField("millis") : 0);
+    }
+
+    void IndexAdvisor::addQuery(const std::string &ns, const mongo::BSONObj &filter, const mongo::BSONObj &sort,
+                                long long millis /* = 0 */)
+    {
+        QueryKeys const keys = queryKeys(filter, sort);
+        if (keys.isEmpty())
+            return;
+
+        Query &query = _queries[ns][esrIndex(keys).toString()];
+        query.keys = keys;
+        ++query.count;
+        query.totalMillis += millis;
+    }
+
+    void IndexAdvisor::addIndex(const std::string &ns, const std::string &name, const mongo::BSONObj &keys,
+                                const mongo::BSONObj &options /* = mongo::BSONObj() */, 
+                                long long accesses /* = -1 */)
+    {
+        Index index;
+        index.name = name;
+        index.keys = keys.getOwned();
+        index.options = significantOptions(options);
+        index.unique = options["unique"].trueValue();
+        index.accesses = accesses;
+        _indexes[ns].push_back(index);
+    }
+
+    std::vector<IndexAdvice> IndexAdvisor::advise() const
+    {
+        static std::vector<Index> const noIndexes;
+        std::vector<IndexAdvice> creates;
+
+        for (auto const& nsQueries : _queries) {
+            auto const nsIndexes = _indexes.find(nsQueries.first);
+            auto const& indexes = nsIndexes == _indexes.end() ? noIndexes : nsIndexes->second;
+
+            std::vector<Query> unserved;
+            for (auto const& query : nsQueries.second) {
+                bool const isServed = std::any_of(indexes.begin(), indexes.end(), 
+                    [&query](Index const& index) { return serves(index.keys, query.second.keys); });
+                if (!isServed)
+                    unserved.push_back(query.second);
+            }
+
+            // Longer suggestion may also serve shorter ones, that are merged into it
+            std::sort(unserved.begin(), unserved.end(), [](Query const& a, Query const& b) {
+                return esrIndex(a.keys).nFields() > esrIndex(b.keys).nFields();
+            });
+
+            std::vector<IndexAdvice> nsCreates;
+            for (auto const& query : unserved) {
+                auto const merged = std::find_if(nsCreates.begin(), nsCreates.end(),
+                    [&query](IndexAdvice const& advice) { return serves(advice.keys, query.keys); });
+
+                if (merged != nsCreates.end()) {
+                    merged->queries += query.count;
+                    merged->totalMillis += query.totalMillis;
+                    continue;
+                }
+
+                IndexAdvice advice;
+                advice.kind = IndexAdvice::Create;
+                advice.ns = nsQueries.first;
+                advice.keys = esrIndex(query.keys);
+                advice.reason = describe(query.keys);
+                advice.queries = query.count;
+                advice.totalMillis = query.totalMillis;
+                nsCreates.push_back(advice);
+            }
+            creates.insert(creates.end(), nsCreates.begin(), nsCreates.end());
+        }
+
+        std::sort(creates.begin(), creates.end(), [](IndexAdvice const& a, IndexAdvice const& b) {
+            return a.totalMillis != b.totalMillis ? a.totalMillis > b.totalMillis : a.queries > b.queries;
+        });
+
+        std::vector<IndexAdvice> result = creates;
+        for (auto const& nsIndexes : _indexes) {
+            for (auto const& index : nsIndexes.second) {
+                // _id and unique indexes enforce constraints and are never suggested to drop
+                if (index.name == "_id_" || index.unique)
+                    continue;
+
+                IndexAdvice advice;
+                advice.ns = nsIndexes.first;
+                advice.indexName = index.name;
+                advice.keys = index.keys;
+
+                auto const longer = std::find_if(nsIndexes.second.begin(), nsIndexes.second.end(),
+                    [&index](Index const& other) { 
+                        return isStrictPrefix(index.keys, other.keys) && index.options.binaryEqual(other.options);
+                    });
+
+                if (longer != nsIndexes.second.end()) {
+                    advice.kind = IndexAdvice::Redundant;
+                    advice.reason = "Prefix of index " + longer->name + ", which serves the same queries";
+                    result.push_back(advice);
+                }
+                else if (index.accesses == 0) {
+                    advice.kind = IndexAdvice::Unused;
+                    advice.reason = "Not used since server restart or index creation ($indexStats)";
+                    result.push_back(advice);
+                }
+            }
+        }
+
+        return result;
+    }
+}
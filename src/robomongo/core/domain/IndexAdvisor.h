@@ -0,0 +1,93 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <mongo/bson/bsonobj.h>
+
+#include "robomongo/core/events/MongoEventsInfo.h"
+
+namespace Robomongo
+{
+    /**
+     * @brief Suggests indexes for profiled queries using equality-sort-range rule and flags
+     *        existing indexes that are prefixes of other indexes or are not used.
+     */
+    class IndexAdvisor
+    {
+    public:
+        /**
+         * @brief Fields of a query split by the way index should serve them
+         */
+        struct QueryKeys
+        {
+            std::vector<std::string> equality;
+            std::vector<std::pair<std::string, int>> sort;
+            std::vector<std::string> range;
+
+            bool isEmpty() const { return equality.empty() && sort.empty() && range.empty(); }
+        };
+
+        /**
+         * @brief Splits top level fields of 'filter' ($and clauses included) into equality 
+         *        and range predicates. Queries with $or, $text, $where or $expr cannot be 
+         *        served by a single compound index and give empty keys.
+         */
+        static QueryKeys queryKeys(const mongo::BSONObj &filter, const mongo::BSONObj &sort);
+
+        /**
+         * @brief Key pattern of index for 'keys': equality fields, then sort fields, then range fields
+         */
+        static mongo::BSONObj esrIndex(const QueryKeys &keys);
+
+        /**
+         * @brief True if index with 'indexKeys' key pattern starts with all equality fields, 
+         *        continues with sort fields in order (or all reversed) and then with a range field
+         */
+        static bool serves(const mongo::BSONObj &indexKeys, const QueryKeys &keys);
+
+        /**
+         * @brief Adds filter and sort of 'system.profile' entry, entries without them are ignored
+         */
+        void addProfileEntry(const mongo::BSONObj &entry);
+
+        void addQuery(const std::string &ns, const mongo::BSONObj &filter, const mongo::BSONObj &sort,
+                      long long millis = 0);
+
+        /**
+         * @brief Adds existing index, 'options' is its specification as listed by listIndexes
+         *        (unique, sparse, expireAfterSeconds, partialFilterExpression, collation etc.),
+         *        'accesses' is number of uses reported by $indexStats or -1 if unknown
+         */
+        void addIndex(const std::string &ns, const std::string &name, const mongo::BSONObj &keys,
+                      const mongo::BSONObj &options = mongo::BSONObj(), long long accesses = -1);
+
+        /**
+         * @brief Suggested indexes (most profiled time first), then redundant and unused indexes
+         */
+        std::vector<IndexAdvice> advise() const;
+
+    private:
+        struct Query
+        {
+            QueryKeys keys;
+            long long count = 0;
+            long long totalMillis = 0;
+        };
+
+        struct Index
+        {
+            std::string name;
+            mongo::BSONObj keys;
+            mongo::BSONObj options;     // Options that change what index holds, see addIndex()
+            bool unique = false;
+            long long accesses = -1;
+        };
+
+        // Queries by namespace and ESR key pattern
+        std::map<std::string, std::map<std::string, Query>> _queries;
+        std::map<std::string, std::vector<Index>> _indexes;
+    };
+}
@@ -0,0 +1,116 @@
+#include "gtest/gtest.h"
+#include "robomongo/core/domain/IndexAdvisor.h"
+
+#include <mongo/bson/bsonobjbuilder.h>
+
+using namespace Robomongo;
+
+TEST(index_advisor_tests, esrIndex_EqualitySortRange)
+{
+    auto const keys = IndexAdvisor::queryKeys(
+        BSON("status" << "A" << "age" << BSON("$gt" << 30) << "city" << BSON("$in" << BSON_ARRAY("X" << "Y"))),
+        BSON("name" << -1));
+
+    EXPECT_TRUE(IndexAdvisor::esrIndex(keys).binaryEqual(BSON("status" << 1 << "city" << 1 << "name" << -1 << "age" << 1)));
+}
+
+TEST(index_advisor_tests, queryKeys_UnsupportedOperators)
+{
+    EXPECT_TRUE(IndexAdvisor::queryKeys(BSON("$or" << BSON_ARRAY(BSON("a" << 1) << BSON("b" << 1))), 
+                                        mongo::BSONObj()).isEmpty());
+
+    auto const keys = IndexAdvisor::queryKeys(
+        BSON("$and" << BSON_ARRAY(BSON("a" << 1) << BSON("b" << BSON("$ne" << 2)))), mongo::BSONObj());
+    EXPECT_TRUE(IndexAdvisor::esrIndex(keys).binaryEqual(BSON("a" << 1 << "b" << 1)));
+}
+
+TEST(index_advisor_tests, serves)
+{
+    auto const keys = IndexAdvisor::queryKeys(BSON("a" << 1 << "b" << 2 << "c" << BSON("$lt" << 5)), BSON("d" << 1));
+
+    EXPECT_TRUE(IndexAdvisor::serves(BSON("b" << 1 << "a" << -1 << "d" << 1 << "c" << 1), keys));
+    EXPECT_TRUE(IndexAdvisor::serves(BSON("a" << 1 << "b" << 1 << "d" << -1 << "c" << 1 << "e" << 1), keys));
+    EXPECT_FALSE(IndexAdvisor::serves(BSON("a" << 1 << "b" << 1 << "c" << 1 << "d" << 1), keys));
+    EXPECT_FALSE(IndexAdvisor::serves(BSON("a" << 1 << "d" << 1 << "c" << 1), keys));
+    EXPECT_FALSE(IndexAdvisor::serves(BSON("a" << 1 << "b" << 1 << "d" << 1), keys));
+
+    auto const twoSorts = IndexAdvisor::queryKeys(mongo::BSONObj(), BSON("x" << 1 << "y" << -1));
+    EXPECT_TRUE(IndexAdvisor::serves(BSON("x" << -1 << "y" << 1), twoSorts));
+    EXPECT_FALSE(IndexAdvisor::serves(BSON("x" << 1 << "y" << 1), twoSorts));
+}
+
+TEST(index_advisor_tests, advise_SuggestsMissingIndexesOnce)
+{
+    IndexAdvisor advisor;
+    advisor.addIndex("test.users", "_id_", BSON("_id" << 1));
+    advisor.addIndex("test.users", "email_1", BSON("email" << 1), BSON("unique" << true));
+
+    // Served by existing index
+    advisor.addProfileEntry(BSON("op" << "query" << "ns" << "test.users" << "millis" << 100 <<
+        "command" << BSON("find" << "users" << "filter" << BSON("email" << "a@b.c"))));
+
+    // Merged into { status: 1, age: 1 }
+    advisor.addProfileEntry(BSON("op" << "query" << "ns" << "test.users" << "millis" << 30 <<
+        "command" << BSON("find" << "users" << "filter" << BSON("status" << "A"))));
+    advisor.addProfileEntry(BSON("op" << "command" << "ns" << "test.users" << "millis" << 70 <<
+        "command" << BSON("aggregate" << "users" << "pipeline" << BSON_ARRAY(
+            BSON("$match" << BSON("status" << "A" << "age" << BSON("$gte" << 18))) << BSON("$group" << BSON("_id" << 1))))));
+
+    advisor.addProfileEntry(BSON("op" << "insert" << "ns" << "test.users" << "millis" << 500 <<
+        "command" << BSON("insert" << "users")));
+
+    auto const advice = advisor.advise();
+    ASSERT_EQ(1u, advice.size());
+    EXPECT_EQ(IndexAdvice::Create, advice[0].kind);
+    EXPECT_EQ("test.users", advice[0].ns);
+    EXPECT_TRUE(advice[0].keys.binaryEqual(BSON("status" << 1 << "age" << 1)));
+    EXPECT_EQ(2, advice[0].queries);
+    EXPECT_EQ(100, advice[0].totalMillis);
+}
+
+TEST(index_advisor_tests, advise_FlagsRedundantAndUnusedIndexes)
+{
+    IndexAdvisor advisor;
+    advisor.addIndex("test.orders", "_id_", BSON("_id" << 1), mongo::BSONObj(), 0);
+    advisor.addIndex("test.orders", "customer_1", BSON("customer" << 1), mongo::BSONObj(), 10);
+    advisor.addIndex("test.orders", "customer_1_date_-1", BSON("customer" << 1 << "date" << -1), mongo::BSONObj(), 10);
+    advisor.addIndex("test.orders", "customer_-1_total_1", BSON("customer" << -1 << "total" << 1), 
+                     BSON("unique" << true), 0);
+    advisor.addIndex("test.orders", "status_1", BSON("status" << 1), mongo::BSONObj(), 0);
+
+    auto const advice = advisor.advise();
+    ASSERT_EQ(2u, advice.size());
+    EXPECT_EQ(IndexAdvice::Redundant, advice[0].kind);
+    EXPECT_EQ("customer_1", advice[0].indexName);
+    EXPECT_EQ(IndexAdvice::Unused, advice[1].kind);
+    EXPECT_EQ("status_1", advice[1].indexName);
+}
+
+TEST(index_advisor_tests, advise_PrefixWithOtherOptions_NotRedundant)
+{
+    IndexAdvisor advisor;
+    advisor.addIndex("test.sessions", "created_1", BSON("created" << 1), 
+                     BSON("v" << 2 << "name" << "created_1" << "expireAfterSeconds" << 3600), 10);
+    advisor.addIndex("test.sessions", "user_1", BSON("user" << 1),
+                     BSON("partialFilterExpression" << BSON("active" << true)), 10);
+    advisor.addIndex("test.sessions", "created_1_user_1", BSON("created" << 1 << "user" << 1), 
+                     mongo::BSONObj(), 10);
+    advisor.addIndex("test.sessions", "user_1_created_1", BSON("user" << 1 << "created" << 1), 
+                     BSON("v" << 1 << "name" << "user_1_created_1" << "background" << true), 10);
+
+    EXPECT_TRUE(advisor.advise().empty());
+}
+
+TEST(index_advisor_tests, advise_PrefixWithSameOptions_Redundant)
+{
+    IndexAdvisor advisor;
+    advisor.addIndex("test.sessions", "user_1", BSON("user" << 1), 
+                     BSON("sparse" << true << "collation" << BSON("locale" << "fr")), 10);
+    advisor.addIndex("test.sessions", "user_1_created_1", BSON("user" << 1 << "created" << 1), 
+                     BSON("collation" << BSON("locale" << "fr") << "sparse" << true), 10);
+
+    auto const advice = advisor.advise();
+    ASSERT_EQ(1u, advice.size());
+    EXPECT_EQ(IndexAdvice::Redundant, advice[0].kind);
+    EXPECT_EQ("user_1", advice[0].indexName);
+}
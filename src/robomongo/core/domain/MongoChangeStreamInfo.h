@@ -0,0 +1,29 @@
+#pragma once
+
+#include <string>
+
+#include <mongo/bson/bsonobj.h>
+
+namespace Robomongo
+{
+    /**
+     * @brief Change stream requested by watch() of shell script. Collection name is empty 
+     *        when whole database is watched.
+     */
+    struct ChangeStreamInfo
+    {
+        ChangeStreamInfo() {}
+
+        ChangeStreamInfo(const std::string &dbName, const std::string &collectionName,
+                         mongo::BSONObj const& pipeline, mongo::BSONObj const& options) :
+            dbName(dbName), collectionName(collectionName), pipeline(pipeline), options(options), 
+            isValid(true)
+        {}
+
+        std::string dbName = "";
+        std::string collectionName = "";
+        mongo::BSONObj pipeline;
+        mongo::BSONObj options;
+        bool isValid = false;
+    };
+}
@@ -17,6 +17,11 @@ namespace Robomongo
         std::string fullName() const { return _ns.toString(); }
         MongoDatabase *database() const { return _database; }
 
+        /**
+         * @brief Replaces info with the one with loaded statistics
+         */
+        void setInfo(const MongoCollectionInfo &info) { _info = info; }
+
 //        std::string sizeString() const;
 //        QString storageSizeString() const;
 
@@ -9,46 +9,60 @@ namespace Robomongo
     public:
         MongoCollectionInfo() {}
         MongoCollectionInfo(const std::string &ns);
-//        MongoCollectionInfo(mongo::BSONObj stats);
+
+        /**
+         * @param stats: result of { collStats: <collection> } command
+         */
+        MongoCollectionInfo(const std::string &ns, const mongo::BSONObj &stats);
 
         std::string name() const { return _ns.collectionName(); }
         std::string fullName() const { return _ns.toString(); }
         MongoNamespace ns() const { return _ns; }
 
+        /**
+         * @brief Statistics below are loaded in background after collection names,
+         * they are zero until then (or if collStats failed).
+         */
+        bool hasStats() const { return _hasStats; }
+
         /**
          * @brief Size in bytes
          * It is double, because db.stats()'s "size" field may be double
          * for large values, while Int32 for small.
          */
-//        double sizeBytes() const { return _sizeBytes; }
+        double sizeBytes() const { return _sizeBytes; }
 
         /**
          * @brief Storage size in bytes
          * It is double, because db.stats()'s "storageSize" field may be double
          * for large values, while Int32 for small.
          */
-//        double storageSizeBytes() const { return _storageSizeBytes; }
+        double storageSizeBytes() const { return _storageSizeBytes; }
+
+        double totalIndexSizeBytes() const { return _totalIndexSizeBytes; }
 
-//        long long count() const { return _count; }
+        long long count() const { return _count; }
 
     private:
         MongoNamespace _ns;
+        bool _hasStats = false;
 
         /**
          * @brief Size in bytes
          * It is double, because db.stats()'s "size" field may be double
          * for large values, while Int32 for small.
          */
-        double _sizeBytes;
+        double _sizeBytes = 0;
 
         /**
          * @brief Storage size in bytes
          * It is double, because db.stats()'s "storageSize" field may be double
          * for large values, while Int32 for small.
          */
-        double _storageSizeBytes;
+        double _storageSizeBytes = 0;
 
-        long long _count;
+        double _totalIndexSizeBytes = 0;
+
+        long long _count = 0;
     };
 }
-
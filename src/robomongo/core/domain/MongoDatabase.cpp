@@ -1,8 +1,12 @@
 #include "robomongo/core/domain/MongoDatabase.h"
 
+#include <algorithm>
+
 #include "robomongo/core/domain/MongoServer.h"
 #include "robomongo/core/domain/MongoCollection.h"
+#include "robomongo/core/domain/CurrentOpsTracker.h"
 #include "robomongo/core/mongodb/MongoWorker.h"
+#include "robomongo/core/settings/ConnectionSettings.h"
 #include "robomongo/core/AppRegistry.h"
 #include "robomongo/core/EventBus.h"
 #include "robomongo/core/utils/Logger.h"
@@ -39,46 +43,108 @@ namespace Robomongo
     void MongoDatabase::loadCollections()
     {
         _bus->publish(new MongoDatabaseCollectionsLoadingEvent(this));
-        _bus->send(_server->worker(), new LoadCollectionNamesRequest(this, _name));
+
+        // Statistics are published in background after collection names by the worker 
+        // of metadata lane, which is started on first use
+        if (!_isSubscribedToStats) {
+            _bus->subscribe(this, CollectionStatsLoadedEvent::Type, _server->worker(WorkerLane::Metadata));
+            _isSubscribedToStats = true;
+        }
+
+        _server->send(new LoadCollectionNamesRequest(this, _name));
     }
 
     void MongoDatabase::loadUsers()
     {
         _bus->publish(new MongoDatabaseUsersLoadingEvent(this));
-        _bus->send(_server->worker(), new LoadUsersRequest(this, _name));
+        _server->send(new LoadUsersRequest(this, _name));
     }
 
     void MongoDatabase::loadFunctions()
     {
         _bus->publish(new MongoDatabaseFunctionsLoadingEvent(this));
-        _bus->send(_server->worker(), new LoadFunctionsRequest(this, _name));
+        _server->send(new LoadFunctionsRequest(this, _name));
     }
 
     void MongoDatabase::createCollection(const std::string &collection, long long size, bool capped, int maxDocNum, const mongo::BSONObj& extraOptions)
     {
-        _bus->send(_server->worker(), 
+        _server->send(
             new CreateCollectionRequest(this, MongoNamespace(_name, collection), extraOptions, size, capped, maxDocNum));
     }
 
     void MongoDatabase::dropCollection(const std::string &collection)
     {
-        _bus->send(_server->worker(), new DropCollectionRequest(this, MongoNamespace(_name, collection)));
+        _server->send(new DropCollectionRequest(this, MongoNamespace(_name, collection)));
     }
 
     void MongoDatabase::renameCollection(const std::string &collection, const std::string &newCollection)
     {
-        _bus->send(_server->worker(), new RenameCollectionRequest(this, MongoNamespace(_name, collection), 
-                                                                  newCollection));
+        _server->send(new RenameCollectionRequest(this, MongoNamespace(_name, collection), newCollection));
     }
 
     void MongoDatabase::duplicateCollection(const std::string &collection, const std::string &newCollection)
     {
-        _bus->send(_server->worker(), new DuplicateCollectionRequest(this, MongoNamespace(_name, collection), newCollection));
+        _server->send(new DuplicateCollectionRequest(this, MongoNamespace(_name, collection), newCollection));
+    }
+
+    std::shared_ptr<std::atomic<bool>> MongoDatabase::copyCollection(MongoServer *server, 
+                                                                     const std::string &sourceDatabase, 
+                                                                     const std::string &collection,
+                                                                     int readers /* = 1 */, int writers /* = 1 */)
+    {
+        // Source is connected by the target worker, it gets its own copy of the source settings
+        std::shared_ptr<ConnectionSettings> const source(server->connectionRecord()->clone());
+        auto const cancelled = std::make_shared<std::atomic<bool>>(false);
+        _server->send(new CopyCollectionToDiffServerRequest(this, source, sourceDatabase, collection, _name, 
+                                                            cancelled, readers, writers));
+        return cancelled;
+    }
+
+    void MongoDatabase::profilingLevel(int level /* = -1 */, int slowMs /* = 100 */)
+    {
+        _server->send(new ProfilingLevelRequest(this, _name, level, slowMs));
+    }
+
+    void MongoDatabase::analyzeProfile(int maxEntries)
+    {
+        _server->send(new AnalyzeProfileRequest(this, _name, maxEntries));
+    }
+
+    void MongoDatabase::adviseIndexes(int maxEntries)
+    {
+        _server->send(new AdviseIndexesRequest(this, _name, maxEntries));
+    }
+
+    void MongoDatabase::createIndex(const IndexInfo &index)
+    {
+        _bus->send(_server->worker(), new AddEditIndexRequest(this, IndexInfo(index._collection), index));
+    }
+
+    void MongoDatabase::analyzeSchema(const std::string &collection, int sampleSize)
+    {
+        _server->send(new AnalyzeSchemaRequest(this, MongoNamespace(_name, collection), sampleSize));
+    }
+
+    const CollectionSchema *MongoDatabase::schema(const std::string &collection) const
+    {
+        auto const it = _schemas.find(collection);
+        return it == _schemas.end() ? NULL : &it->second;
+    }
+
+    void MongoDatabase::previewPipeline(const std::string &collection, const std::vector<mongo::BSONObj> &prefixes,
+                                        const mongo::BSONObj &explainPipeline)
+    {
+        _server->send(new PreviewPipelineRequest(this, MongoNamespace(_name, collection), prefixes, explainPipeline));
+    }
+
+    void MongoDatabase::loadCurrentOps()
+    {
+        _server->send(new CurrentOpsRequest(this));
     }
 
-    void MongoDatabase::copyCollection(MongoServer *server, const std::string &sourceDatabase, const std::string &collection)
+    void MongoDatabase::killOp(const mongo::BSONObj &op)
     {
-        _bus->send(_server->worker(), new CopyCollectionToDiffServerRequest(this, server->worker(), sourceDatabase, collection, _name));
+        _server->send(new KillOpRequest(this, op));
     }
 
     void MongoDatabase::createUser(const MongoUser &user)
@@ -123,6 +189,23 @@ namespace Robomongo
         LOG_MSG("'Collections' refreshed.", mongo::logger::LogSeverity::Info());
     }
 
+    void MongoDatabase::handle(CollectionStatsLoadedEvent *event)
+    {
+        if (event->databaseName != _name)
+            return;
+
+        for (auto const& info : event->collectionInfos) {
+            auto const collection = std::find_if(_collections.begin(), _collections.end(), 
+                [&info](MongoCollection *coll) { return coll->fullName() == info.fullName(); });
+
+            if (collection != _collections.end())
+                (*collection)->setInfo(info);
+        }
+
+        // Explorer items of this database are subscribed to this database only
+        _bus->publish(new CollectionStatsLoadedEvent(this, _name, event->collectionInfos));
+    }
+
     void MongoDatabase::handle(CreateFunctionResponse *event)
     {
         if (event->isError()) {
@@ -266,6 +349,131 @@ namespace Robomongo
         }
     }
 
+    void MongoDatabase::handle(CopyCollectionProgressEvent *event)
+    {
+        _bus->publish(new CopyCollectionProgressEvent(this, event->progress));
+    }
+
+    void MongoDatabase::handle(CopyCollectionToDiffServerResponse *event)
+    {
+        if (event->isError()) {
+            handleIfReplicaSetUnreachable(event);
+            genericEventErrorHandler(event, "Failed to copy collection.", _bus, this);
+            _bus->publish(new CopyCollectionToDiffServerResponse(this, event->error()));
+            return;
+        }
+
+        loadCollections();
+        _bus->publish(new CopyCollectionToDiffServerResponse(this, event->result));
+        LOG_MSG("Collection copied to database \'" + _name + "\': " + std::to_string(event->result.docsCopied) + 
+                " documents copied, " + std::to_string(event->result.docsSkipped) + " existing documents skipped.",
+                mongo::logger::LogSeverity::Info());
+    }
+
+    void MongoDatabase::handle(ProfilingLevelResponse *event)
+    {
+        if (event->isError()) {
+            handleIfReplicaSetUnreachable(event);
+            genericEventErrorHandler(event, "Failed to change profiling level.", _bus, this);
+            _bus->publish(new ProfilingLevelResponse(this, event->error()));
+            return;
+        }
+
+        _bus->publish(new ProfilingLevelResponse(this, event->level, event->slowMs));
+    }
+
+    void MongoDatabase::handle(ProfileAnalyzedEvent *event)
+    {
+        if (event->isError()) {
+            genericEventErrorHandler(event, "Failed to analyze 'system.profile'.", _bus, this);
+            _bus->publish(new ProfileAnalyzedEvent(this, event->error()));
+            return;
+        }
+
+        _bus->publish(new ProfileAnalyzedEvent(this, event->entries, event->shapes, event->finished));
+    }
+
+    void MongoDatabase::handle(AdviseIndexesResponse *event)
+    {
+        if (event->isError()) {
+            genericEventErrorHandler(event, "Failed to advise indexes.", _bus, this);
+            _bus->publish(new AdviseIndexesResponse(this, event->error()));
+            return;
+        }
+
+        _bus->publish(new AdviseIndexesResponse(this, event->advice));
+    }
+
+    void MongoDatabase::handle(AddEditIndexResponse *event)
+    {
+        if (event->isError()) {
+            handleIfReplicaSetUnreachable(event);
+            genericEventErrorHandler(event, "Failed to create index \'" + event->newIndex_._name + "\'.", _bus, this);
+            _bus->publish(new AddEditIndexResponse(this, event->error(), event->oldIndex_, event->newIndex_));
+            return;
+        }
+
+        _bus->publish(new AddEditIndexResponse(this, event->oldIndex_, event->newIndex_));
+        LOG_MSG("Index \'" + event->newIndex_._name + "\' created.", mongo::logger::LogSeverity::Info());
+    }
+
+    void MongoDatabase::handle(SchemaAnalyzedEvent *event)
+    {
+        if (event->isError()) {
+            genericEventErrorHandler(event, "Failed to analyze schema.", _bus, this);
+            _bus->publish(new SchemaAnalyzedEvent(this, event->ns, event->error()));
+            return;
+        }
+
+        _schemas[MongoNamespace(event->schema.ns).collectionName()] = event->schema;
+        _bus->publish(new SchemaAnalyzedEvent(this, event->schema));
+    }
+
+    void MongoDatabase::handle(PipelineStagePreviewEvent *event)
+    {
+        // Failing stages are expected while pipeline is edited, they are shown by builder only
+        if (event->isError()) {
+            _bus->publish(new PipelineStagePreviewEvent(this, event->ns, event->pipeline, event->error()));
+            return;
+        }
+
+        _bus->publish(new PipelineStagePreviewEvent(this, event->ns, event->pipeline, event->documents, 
+                                                    event->elapsedMs));
+    }
+
+    void MongoDatabase::handle(PipelineExplainedEvent *event)
+    {
+        if (event->isError()) {
+            _bus->publish(new PipelineExplainedEvent(this, event->ns, event->pipeline, event->error()));
+            return;
+        }
+
+        _bus->publish(new PipelineExplainedEvent(this, event->ns, event->pipeline, event->explain));
+    }
+
+    void MongoDatabase::handle(CurrentOpsResponse *event)
+    {
+        // Sampling errors are shown by monitor, not logged every sample
+        if (event->isError()) {
+            _bus->publish(new CurrentOpsResponse(this, event->error()));
+            return;
+        }
+
+        _bus->publish(new CurrentOpsResponse(this, event->ops));
+    }
+
+    void MongoDatabase::handle(KillOpResponse *event)
+    {
+        if (event->isError()) {
+            genericEventErrorHandler(event, "Failed to kill operation.", _bus, this);
+            _bus->publish(new KillOpResponse(this, event->error()));
+            return;
+        }
+
+        _bus->publish(new KillOpResponse(this, event->op));
+        LOG_MSG("Operation " + CurrentOpsTracker::opKey(event->op) + " killed.", mongo::logger::LogSeverity::Info());
+    }
+
     void MongoDatabase::handleIfReplicaSetUnreachable(Event *event)
     {
         if (!_server->connectionRecord()->isReplicaSet())
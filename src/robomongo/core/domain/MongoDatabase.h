@@ -1,5 +1,9 @@
 #pragma once
 
+#include <atomic>
+#include <map>
+#include <memory>
+
 #include <QObject>
 #include <mongo/bson/bsonobj.h>
 
@@ -60,7 +64,71 @@ namespace Robomongo
         void dropCollection(const std::string &collection);
         void renameCollection(const std::string &collection, const std::string &newCollection);
         void duplicateCollection(const std::string &collection, const std::string &newCollection);
-        void copyCollection(MongoServer *server, const std::string &sourceDatabase, const std::string &collection);
+        /**
+         * @brief Copies collection of 'server' into this database, reading it with 'readers' _id ranges 
+         *        in parallel and writing with 'writers' connections. Progress is published with 
+         *        CopyCollectionProgressEvent, completion with CopyCollectionToDiffServerResponse.
+         *        Setting the returned flag cancels the copy.
+         */
+        std::shared_ptr<std::atomic<bool>> copyCollection(MongoServer *server, const std::string &sourceDatabase, 
+                                                          const std::string &collection,
+                                                          int readers = 1, int writers = 1);
+
+        /**
+         * @brief Reads profiling level, or sets it if 'level' is not -1. 
+         *        Result is published with ProfilingLevelResponse.
+         */
+        void profilingLevel(int level = -1, int slowMs = 100);
+
+        /**
+         * @brief Groups up to 'maxEntries' newest profiled operations by query shape. Statistics
+         *        are published with ProfileAnalyzedEvent while 'system.profile' is read.
+         */
+        void analyzeProfile(int maxEntries);
+
+        /**
+         * @brief Suggests indexes for up to 'maxEntries' newest profiled operations, published 
+         *        with AdviseIndexesResponse
+         */
+        void adviseIndexes(int maxEntries);
+
+        /**
+         * @brief Creates index 'index' of a collection of this database, published with AddEditIndexResponse
+         */
+        void createIndex(const IndexInfo &index);
+
+        /**
+         * @brief Infers fields of 'collection' from 'sampleSize' random documents. Result is 
+         *        published with SchemaAnalyzedEvent and kept by schema().
+         */
+        void analyzeSchema(const std::string &collection, int sampleSize);
+
+        /**
+         * @brief Schema of 'collection' inferred last time, NULL if it was not analyzed
+         */
+        const CollectionSchema *schema(const std::string &collection) const;
+
+        /**
+         * @brief Schemas of analyzed collections by collection name
+         */
+        const std::map<std::string, CollectionSchema> &schemas() const { return _schemas; }
+
+        /**
+         * @brief Runs pipeline prefixes 'prefixes' on 'collection' and explains 'explainPipeline'. 
+         *        Results are published with PipelineStagePreviewEvent and PipelineExplainedEvent.
+         */
+        void previewPipeline(const std::string &collection, const std::vector<mongo::BSONObj> &prefixes,
+                             const mongo::BSONObj &explainPipeline);
+
+        /**
+         * @brief Samples operations in progress on server, published with CurrentOpsResponse
+         */
+        void loadCurrentOps();
+
+        /**
+         * @brief Kills operation described by currentOp document 'op', published with KillOpResponse
+         */
+        void killOp(const mongo::BSONObj &op);
 
         void createUser(const MongoUser &user);
         void dropUser(std::string const& userName);
@@ -81,6 +149,7 @@ namespace Robomongo
 
     protected Q_SLOTS:
         void handle(LoadCollectionNamesResponse *event);
+        void handle(CollectionStatsLoadedEvent *event);
         void handle(LoadUsersResponse *event);
         void handle(LoadFunctionsResponse *event);
         void handle(CreateFunctionResponse *event);
@@ -91,6 +160,17 @@ namespace Robomongo
         void handle(DropUserResponse *event);
         void handle(RenameCollectionResponse *event);
         void handle(DuplicateCollectionResponse *event);
+        void handle(CopyCollectionProgressEvent *event);
+        void handle(CopyCollectionToDiffServerResponse *event);
+        void handle(ProfilingLevelResponse *event);
+        void handle(ProfileAnalyzedEvent *event);
+        void handle(AdviseIndexesResponse *event);
+        void handle(AddEditIndexResponse *event);
+        void handle(SchemaAnalyzedEvent *event);
+        void handle(PipelineStagePreviewEvent *event);
+        void handle(PipelineExplainedEvent *event);
+        void handle(CurrentOpsResponse *event);
+        void handle(KillOpResponse *event);
 
     private:
         void clearCollections();
@@ -102,6 +182,8 @@ namespace Robomongo
         std::vector<MongoCollection *> _collections;
         const std::string _name;
         const bool _system;
+        bool _isSubscribedToStats = false;
+        std::map<std::string, CollectionSchema> _schemas;
         EventBus *_bus;
     };
 
@@ -2,6 +2,53 @@
 
 #include <mongo/client/dbclient_base.h>
 
+namespace
+{
+    bool isQueryField(mongo::StringData const& name)
+    {
+        return name == "query" || name == "$query";
+    }
+
+    bool isOrderByField(mongo::StringData const& name)
+    {
+        return name == "orderby" || name == "$orderby";
+    }
+
+    // Legacy query modifiers and their find command counterparts
+    char const *findCommandOption(mongo::StringData const& name)
+    {
+        if (name == "$hint")        return "hint";
+        if (name == "$maxTimeMS")   return "maxTimeMS";
+        if (name == "$comment")     return "comment";
+        if (name == "$min")         return "min";
+        if (name == "$max")         return "max";
+        if (name == "$returnKey")   return "returnKey";
+        if (name == "$showDiskLoc") return "showRecordId";
+        return nullptr;
+    }
+
+    // Filter of the query and its special fields other than query and orderby
+    mongo::BSONObj splitQuery(mongo::BSONObj const& query, bool special, mongo::BSONObjBuilder &specials)
+    {
+        if (!special)
+            return query;
+
+        mongo::BSONObj filter;
+        mongo::BSONObjIterator it(query);
+        while (it.more()) {
+            mongo::BSONElement const elem = it.next();
+            if (isQueryField(elem.fieldNameStringData())) {
+                if (elem.isABSONObj())
+                    filter = elem.Obj();
+            }
+            else if (!isOrderByField(elem.fieldNameStringData())) {
+                specials.append(elem);
+            }
+        }
+        return filter;
+    }
+}
+
 namespace Robomongo
 {
     namespace detail
@@ -42,4 +89,156 @@ namespace Robomongo
         _options(options),
         _special(special)
         {}
+
+    mongo::BSONObj MongoQueryInfo::keysetSortPattern(bool idTieBreaker /* = true */) const
+    {
+        mongo::BSONObj orderBy;
+        if (_special) {
+            mongo::BSONObjIterator it(_query);
+            while (it.more()) {
+                mongo::BSONElement const elem = it.next();
+                if (isOrderByField(elem.fieldNameStringData()) && elem.isABSONObj())
+                    orderBy = elem.Obj();
+            }
+        }
+
+        mongo::BSONObjBuilder pattern;
+        bool hasId = false;
+        mongo::BSONObjIterator it(orderBy);
+        while (it.more()) {
+            mongo::BSONElement const elem = it.next();
+            // i.e. { score: { $meta: "textScore" } } cannot be expressed as a range
+            if (!elem.isNumber())
+                return mongo::BSONObj();
+
+            pattern.append(elem.fieldName(), elem.number() < 0 ? -1 : 1);
+            if (elem.fieldNameStringData() == "_id")
+                hasId = true;
+        }
+
+        if (!hasId && (idTieBreaker || orderBy.isEmpty()))
+            pattern.append("_id", 1);
+
+        return pattern.obj();
+    }
+
+    bool MongoQueryInfo::keysetNextPage(const mongo::BSONObj &lastDocument, int limit, int position,
+                                        MongoQueryInfo &nextPage, bool idTieBreaker /* = true */) const
+    {
+        mongo::BSONObj const sortPattern = keysetSortPattern(idTieBreaker);
+        if (sortPattern.isEmpty() || lastDocument.isEmpty())
+            return false;
+
+        // { $or: [ { k1: { $gt: v1 } }, { k1: v1, k2: { $gt: v2 } }, ... ] }
+        mongo::BSONArrayBuilder orClauses;
+        mongo::BSONObjBuilder equalKeys; // { k1: v1, k2: v2, ... } of already processed keys
+        mongo::BSONObjIterator keys(sortPattern);
+        while (keys.more()) {
+            mongo::BSONElement const key = keys.next();
+            mongo::BSONElement const value = lastDocument.getFieldDotted(key.fieldName());
+
+            // Missing, array (multikey) and regex values do not give a total order or 
+            // cannot be used with equality match
+            if (value.eoo() || value.type() == mongo::Array || value.type() == mongo::RegEx)
+                return false;
+
+            mongo::BSONObjBuilder clause;
+            clause.appendElements(equalKeys.asTempObj());
+            clause.append(key.fieldName(), 
+                BSON((key.number() < 0 ? "$lt" : "$gt") << value)
+            );
+            orClauses.append(clause.obj());
+
+            equalKeys.appendAs(value, key.fieldName());
+        }
+
+        mongo::BSONObj const keysetFilter = BSON("$or" << orClauses.arr());
+
+        // Original filter and the rest of special fields (hint, comment etc.)
+        mongo::BSONObjBuilder specials;
+        mongo::BSONObj const filter = splitQuery(_query, _special, specials);
+
+        mongo::BSONObjBuilder query;
+        if (filter.isEmpty())
+            query.append("query", keysetFilter);
+        else
+            query.append("query", BSON("$and" << BSON_ARRAY(filter << keysetFilter)));
+        query.append("orderby", sortPattern);
+        query.appendElements(specials.obj());
+
+        nextPage = *this;
+        nextPage._query = query.obj();
+        nextPage._special = true;
+        nextPage._skip = 0;
+        nextPage._limit = limit;
+        nextPage._keysetPosition = position;
+        nextPage._keysetAfter = mongo::BSONObj();
+        return true;
+    }
+
+    MongoQueryInfo MongoQueryInfo::keysetBoundary(const std::string &key, int direction) const
+    {
+        // Hint and other specials are left out, they may not suit the single key sort
+        mongo::BSONObjBuilder specials;
+        mongo::BSONObj const filter = splitQuery(_query, _special, specials);
+
+        return MongoQueryInfo(_info, 
+            BSON("query" << filter << "orderby" << BSON(key << (direction < 0 ? -1 : 1))),
+            BSON(key << 1), 1, 0, 1, _options, true);
+    }
+
+    bool MongoQueryInfo::indexServesSort(const mongo::BSONObj &indexKey, const mongo::BSONObj &sortPattern)
+    {
+        if (sortPattern.isEmpty() || indexKey.nFields() < sortPattern.nFields())
+            return false;
+
+        bool forward = true;
+        bool backward = true;
+        mongo::BSONObjIterator index(indexKey);
+        mongo::BSONObjIterator sort(sortPattern);
+        while (sort.more()) {
+            mongo::BSONElement const sortKey = sort.next();
+            mongo::BSONElement const indexField = index.next();
+            // i.e. hashed, text and 2dsphere indexes do not keep order of values
+            if (!indexField.isNumber() || sortKey.fieldNameStringData() != indexField.fieldNameStringData())
+                return false;
+
+            bool const sameDirection = (sortKey.number() < 0) == (indexField.number() < 0);
+            forward = forward && sameDirection;
+            backward = backward && !sameDirection;
+        }
+        return forward || backward;
+    }
+
+    mongo::BSONObj MongoQueryInfo::findCommand() const
+    {
+        mongo::BSONObjBuilder command;
+        command.append("find", _info._ns.collectionName());
+
+        if (!_special) {
+            command.append("filter", _query);
+        }
+        else {
+            mongo::BSONObjIterator it(_query);
+            while (it.more()) {
+                mongo::BSONElement const elem = it.next();
+                mongo::StringData const name = elem.fieldNameStringData();
+                if (isQueryField(name))
+                    command.appendAs(elem, "filter");
+                else if (isOrderByField(name))
+                    command.appendAs(elem, "sort");
+                else if (char const *option = findCommandOption(name))
+                    command.appendAs(elem, option);
+            }
+        }
+
+        if (!_fields.isEmpty())
+            command.append("projection", _fields);
+        if (_skip > 0)
+            command.append("skip", _skip);
+        if (_limit > 0)
+            command.append("limit", _limit);
+
+        return command.obj();
+    }
 }
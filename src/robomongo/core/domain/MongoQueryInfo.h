@@ -37,6 +37,50 @@ namespace Robomongo
         int _options;
         bool _special; // flag, indicating that `query` contains special fields on
                       // first level, and query data in `query` field.
-        
+
+        // Keyset (range-based) page: absolute position of the first document of the page,
+        // -1 for regular skip-based queries.
+        int _keysetPosition = -1;
+
+        // Last document of the previous page. Query worker continues after it instead of 
+        // skipping '_skip' documents when keyset paging is safe for the query (see MongoWorker).
+        mongo::BSONObj _keysetAfter;
+
+        /**
+         * @brief Sort pattern used for keyset paging: sort of the query (or { _id: 1 } for
+         *        unsorted queries) with _id appended as a tie breaker when 'idTieBreaker' is true.
+         *        Returns empty object if query is sorted in a way keyset paging cannot follow.
+         */
+        mongo::BSONObj keysetSortPattern(bool idTieBreaker = true) const;
+
+        /**
+         * @brief Builds query for the page that follows 'lastDocument' without using skip:
+         *        { $or: [ { k1: { $gt: v1 } }, { k1: v1, k2: { $gt: v2 } }, ... ] } is added to the 
+         *        filter, where k1, k2.. are keys of keysetSortPattern() and v1, v2.. their values 
+         *        in 'lastDocument' ($lt is used for descending keys).
+         * @return false if keyset paging is not possible for this query or document, 
+         *         'nextPage' is not modified in this case.
+         */
+        bool keysetNextPage(const mongo::BSONObj &lastDocument, int limit, int position,
+                            MongoQueryInfo &nextPage, bool idTieBreaker = true) const;
+
+        /**
+         * @brief Query for the document with the smallest ('direction' 1) or the largest (-1) 
+         *        value of 'key' among documents of this query. Range filters of keyset paging 
+         *        match values of one BSON type only, boundaries tell whether all values are alike.
+         */
+        MongoQueryInfo keysetBoundary(const std::string &key, int direction) const;
+
+        /**
+         * @brief True if index with 'indexKey' pattern returns documents in 'sortPattern' 
+         *        order, read forwards or backwards.
+         */
+        static bool indexServesSort(const mongo::BSONObj &indexKey, const mongo::BSONObj &sortPattern);
+
+        /**
+         * @brief Builds { find: <collection>, filter: ..., sort: ..., ... } command of this query,
+         *        special fields (orderby, $hint, $maxTimeMS etc.) are turned into command options.
+         */
+        mongo::BSONObj findCommand() const;
     };
 }
@@ -0,0 +1,129 @@
+#include "gtest/gtest.h"
+#include "robomongo/core/domain/MongoQueryInfo.h"
+
+#include <mongo/client/dbclient_base.h>
+
+using namespace Robomongo;
+
+namespace
+{
+    MongoQueryInfo makeQueryInfo(mongo::BSONObj const& query, bool special)
+    {
+        return MongoQueryInfo(CollectionInfo("localhost", "test", "items"), query, mongo::BSONObj(), 
+                              50, 100, 50, 0, special);
+    }
+}
+
+TEST(mongo_query_info_tests, keysetSortPattern_UnsortedQuery_SortsById)
+{
+    auto const info = makeQueryInfo(BSON("a" << 1), false);
+    EXPECT_TRUE(info.keysetSortPattern().binaryEqual(BSON("_id" << 1)));
+}
+
+TEST(mongo_query_info_tests, keysetSortPattern_SortedQuery_AppendsIdTieBreaker)
+{
+    auto const info = makeQueryInfo(BSON("query" << mongo::BSONObj() << "orderby" << BSON("age" << -1)), true);
+    EXPECT_TRUE(info.keysetSortPattern().binaryEqual(BSON("age" << -1 << "_id" << 1)));
+}
+
+TEST(mongo_query_info_tests, keysetSortPattern_MetaSort_ReturnsEmpty)
+{
+    auto const info = makeQueryInfo(
+        BSON("query" << mongo::BSONObj() << "orderby" << BSON("score" << BSON("$meta" << "textScore"))), true);
+    EXPECT_TRUE(info.keysetSortPattern().isEmpty());
+}
+
+TEST(mongo_query_info_tests, keysetNextPage_UnsortedQuery_RangeOnId)
+{
+    auto const info = makeQueryInfo(mongo::BSONObj(), false);
+    MongoQueryInfo next;
+    ASSERT_TRUE(info.keysetNextPage(BSON("_id" << 7 << "a" << 1), 50, 150, next));
+
+    EXPECT_TRUE(next._special);
+    EXPECT_EQ(0, next._skip);
+    EXPECT_EQ(50, next._limit);
+    EXPECT_EQ(150, next._keysetPosition);
+    EXPECT_TRUE(next._query.binaryEqual(
+        BSON("query" << BSON("$or" << BSON_ARRAY(BSON("_id" << BSON("$gt" << 7)))) <<
+             "orderby" << BSON("_id" << 1))));
+}
+
+TEST(mongo_query_info_tests, keysetNextPage_SortedFilteredQuery_KeepsFilterAndSpecials)
+{
+    auto const info = makeQueryInfo(
+        BSON("query" << BSON("a" << 1) << "orderby" << BSON("age" << -1) << "$comment" << "c"), true);
+    MongoQueryInfo next;
+    ASSERT_TRUE(info.keysetNextPage(BSON("_id" << 7 << "age" << 30), 50, 150, next));
+
+    auto const range = BSON("$or" << BSON_ARRAY(BSON("age" << BSON("$lt" << 30)) <<
+                                                BSON("age" << 30 << "_id" << BSON("$gt" << 7))));
+    EXPECT_TRUE(next._query.binaryEqual(
+        BSON("query" << BSON("$and" << BSON_ARRAY(BSON("a" << 1) << range)) <<
+             "orderby" << BSON("age" << -1 << "_id" << 1) << "$comment" << "c")));
+}
+
+TEST(mongo_query_info_tests, keysetNextPage_MissingSortKey_ReturnsFalse)
+{
+    auto const info = makeQueryInfo(BSON("query" << mongo::BSONObj() << "orderby" << BSON("age" << 1)), true);
+    MongoQueryInfo next;
+    EXPECT_FALSE(info.keysetNextPage(BSON("_id" << 7), 50, 150, next));
+}
+
+TEST(mongo_query_info_tests, keysetSortPattern_NoTieBreaker_KeepsUserSort)
+{
+    auto const sorted = makeQueryInfo(BSON("query" << mongo::BSONObj() << "orderby" << BSON("age" << -1)), true);
+    EXPECT_TRUE(sorted.keysetSortPattern(false).binaryEqual(BSON("age" << -1)));
+
+    auto const unsorted = makeQueryInfo(BSON("a" << 1), false);
+    EXPECT_TRUE(unsorted.keysetSortPattern(false).binaryEqual(BSON("_id" << 1)));
+}
+
+TEST(mongo_query_info_tests, keysetNextPage_NoTieBreaker_RangeOnSortKeysOnly)
+{
+    auto const info = makeQueryInfo(BSON("query" << mongo::BSONObj() << "orderby" << BSON("email" << 1)), true);
+    MongoQueryInfo next;
+    ASSERT_TRUE(info.keysetNextPage(BSON("_id" << 7 << "email" << "a@b"), 50, 150, next, false));
+    EXPECT_TRUE(next._query.binaryEqual(
+        BSON("query" << BSON("$or" << BSON_ARRAY(BSON("email" << BSON("$gt" << "a@b")))) <<
+             "orderby" << BSON("email" << 1))));
+}
+
+TEST(mongo_query_info_tests, keysetBoundary_SortsByKeyWithFilter)
+{
+    auto const info = makeQueryInfo(
+        BSON("query" << BSON("a" << 1) << "orderby" << BSON("age" << -1) << "$hint" << "age_-1"), true);
+    auto const boundary = info.keysetBoundary("age", -1);
+
+    EXPECT_EQ(1, boundary._limit);
+    EXPECT_EQ(0, boundary._skip);
+    EXPECT_TRUE(boundary._fields.binaryEqual(BSON("age" << 1)));
+    EXPECT_TRUE(boundary._query.binaryEqual(
+        BSON("query" << BSON("a" << 1) << "orderby" << BSON("age" << -1))));
+}
+
+TEST(mongo_query_info_tests, indexServesSort_PrefixInEitherDirection)
+{
+    auto const index = BSON("age" << -1 << "_id" << 1);
+    EXPECT_TRUE(MongoQueryInfo::indexServesSort(index, BSON("age" << -1)));
+    EXPECT_TRUE(MongoQueryInfo::indexServesSort(index, BSON("age" << 1 << "_id" << -1)));
+    EXPECT_FALSE(MongoQueryInfo::indexServesSort(index, BSON("age" << -1 << "_id" << -1)));
+    EXPECT_FALSE(MongoQueryInfo::indexServesSort(BSON("age" << -1), BSON("age" << -1 << "_id" << 1)));
+    EXPECT_FALSE(MongoQueryInfo::indexServesSort(BSON("age" << "hashed"), BSON("age" << 1)));
+}
+
+TEST(mongo_query_info_tests, findCommand_PlainQuery_FilterSkipLimit)
+{
+    auto const info = makeQueryInfo(BSON("a" << 1), false);
+    EXPECT_TRUE(info.findCommand().binaryEqual(
+        BSON("find" << "items" << "filter" << BSON("a" << 1) << "skip" << 100 << "limit" << 50)));
+}
+
+TEST(mongo_query_info_tests, findCommand_SpecialQuery_ModifiersBecomeOptions)
+{
+    auto const info = makeQueryInfo(
+        BSON("query" << BSON("a" << 1) << "orderby" << BSON("b" << -1) << 
+             "$hint" << "a_1" << "$maxTimeMS" << 1000), true);
+    EXPECT_TRUE(info.findCommand().binaryEqual(
+        BSON("find" << "items" << "filter" << BSON("a" << 1) << "sort" << BSON("b" << -1) << 
+             "hint" << "a_1" << "maxTimeMS" << 1000 << "skip" << 100 << "limit" << 50)));
+}
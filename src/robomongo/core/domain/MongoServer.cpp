@@ -19,6 +19,60 @@
 
 #include <QApplication>
 
+namespace
+{
+    // Lane queue depth from which every routed request is logged
+    constexpr int LANE_QUEUE_DEPTH_WARNING { 10 };
+
+    Robomongo::WorkerLane laneOf(QEvent::Type type)
+    {
+        using namespace Robomongo;
+
+        if (type == ExecuteQueryRequest::Type || type == ReleaseQueryCursorsRequest::Type ||
+            type == ExplainQueryRequest::Type || type == ProfilingLevelRequest::Type ||
+            type == AnalyzeProfileRequest::Type || type == AdviseIndexesRequest::Type ||
+            type == AnalyzeSchemaRequest::Type || type == PreviewPipelineRequest::Type)
+            return WorkerLane::Query;
+
+        if (type == LoadDatabaseNamesRequest::Type || type == LoadCollectionNamesRequest::Type ||
+            type == LoadUsersRequest::Type || type == LoadCollectionIndexesRequest::Type ||
+            type == StopScriptRequest::Type || type == CurrentOpsRequest::Type ||
+            type == KillOpRequest::Type ||
+            // Metadata worker keeps created databases, which are empty until something is stored in them
+            type == CreateDatabaseRequest::Type || type == DropDatabaseRequest::Type ||
+            // and statistics of collections, which these requests make stale
+            type == CreateCollectionRequest::Type || type == DropCollectionRequest::Type ||
+            type == RenameCollectionRequest::Type || type == DuplicateCollectionRequest::Type)
+            return WorkerLane::Metadata;
+
+        // LoadFunctionsRequest stays on Script lane: it falls back to the script engine, which 
+        // only Script lane worker has
+        if (type == ServerStatusRequest::Type)
+            return WorkerLane::Monitor;
+
+        if (type == WatchChangesRequest::Type || type == ChangeStreamGetMoreRequest::Type ||
+            type == CloseChangeStreamRequest::Type)
+            return WorkerLane::ChangeStream;
+
+        if (type == CopyCollectionToDiffServerRequest::Type)
+            return WorkerLane::Copy;
+
+        return WorkerLane::Script;
+    }
+
+    const char *laneName(Robomongo::WorkerLane lane)
+    {
+        switch (lane) {
+        case Robomongo::WorkerLane::Query:      return "query";
+        case Robomongo::WorkerLane::Metadata:   return "metadata";
+        case Robomongo::WorkerLane::Monitor:    return "monitor";
+        case Robomongo::WorkerLane::ChangeStream: return "change stream";
+        case Robomongo::WorkerLane::Copy:       return "copy";
+        default:                                return "script";
+        }
+    }
+}
+
 namespace Robomongo {
     R_REGISTER_EVENT(MongoServerLoadingDatabasesEvent)
 
@@ -28,6 +82,7 @@ namespace Robomongo {
         _connectionType(connectionType),
         _worker(nullptr),
         _isConnected(false),
+        _connectionFailed(false),
         _connSettings(settings),
         _handle(handle),
         _bus(AppRegistry::instance().bus()),
@@ -50,6 +105,9 @@ namespace Robomongo {
             _worker->stopAndDelete();
         }
 
+        for (auto const& laneWorker : _laneWorkers)
+            laneWorker.second->stopAndDelete();
+
         // MongoWorker "_worker" is not deleted here, because it is now owned by
         // another thread (call to moveToThread() made in MongoWorker constructor).
         // It will be deleted by this thread by means of "deleteLater()", which
@@ -98,7 +156,7 @@ namespace Robomongo {
 
     void MongoServer::createDatabase(const std::string &dbName) 
     {
-        _bus->send(_worker, new CreateDatabaseRequest(this, dbName));
+        send(new CreateDatabaseRequest(this, dbName));
     }
 
     MongoDatabase *MongoServer::findDatabaseByName(const std::string &dbName) const 
@@ -113,14 +171,12 @@ namespace Robomongo {
     }
 
     void MongoServer::dropDatabase(const std::string &dbName) {
-        _bus->send(_worker, new DropDatabaseRequest(this, dbName));
+        send(new DropDatabaseRequest(this, dbName));
     }
 
     void MongoServer::insertDocuments(const std::vector<mongo::BSONObj> &objCont,
                                       const MongoNamespace &ns) {
-        for (std::vector<mongo::BSONObj>::const_iterator it = objCont.begin(); it != objCont.end(); it++) {
-            insertDocument(*it, ns);
-        }
+        _bus->send(_worker, new BulkWriteRequest(this, objCont, ns));
     }
 
     void MongoServer::insertDocument(const mongo::BSONObj &obj, const MongoNamespace &ns) {
@@ -128,9 +184,7 @@ namespace Robomongo {
     }
 
     void MongoServer::saveDocuments(const std::vector<mongo::BSONObj> &objCont, const MongoNamespace &ns) {
-        for (std::vector<mongo::BSONObj>::const_iterator it = objCont.begin(); it != objCont.end(); it++) {
-            saveDocument(*it, ns);
-        }
+        _bus->send(_worker, new BulkWriteRequest(this, objCont, ns, true));
     }
 
     void MongoServer::saveDocument(const mongo::BSONObj &obj, const MongoNamespace &ns) {
@@ -150,7 +204,7 @@ namespace Robomongo {
             tryRefreshReplicaSetConnection();
         }
         else {  // single server
-            _bus->send(_worker, new LoadDatabaseNamesRequest(this));
+            send(new LoadDatabaseNamesRequest(this));
         }
     }
 
@@ -180,6 +234,7 @@ namespace Robomongo {
         _version = info._version;
         _storageEngineType = info._storageEngineType;
         _isConnected = true;
+        _connectionFailed = false;
 
         // ConnectionRefresh is used just to update connection view (_version, _storageEngineType, _repPrimary etc..)
         // So we return here after updating(refreshing) information related to connection view.
@@ -278,6 +333,18 @@ namespace Robomongo {
         }
     }
 
+    void MongoServer::handle(BulkWriteResponse *event) 
+    {
+        // Listeners of single document writes are notified once for the whole bulk
+        InsertDocumentResponse insertResponse(event->sender(), event->error());
+        handle(&insertResponse);
+
+        if (!event->isError() && event->nDocs > 1) {
+            LOG_MSG(std::to_string(event->result.nWritten) + " documents " + 
+                    (event->overwrite ? "saved." : "inserted."), mongo::logger::LogSeverity::Info());
+        }
+    }
+
     void MongoServer::handle(RemoveDocumentResponse *event) 
     {        
         if (event->removeCount == RemoveDocumentCount::MULTI && event->index > 0)
@@ -313,6 +380,108 @@ namespace Robomongo {
                                   AppRegistry::instance().settingsManager()->batchSize(),
                                   AppRegistry::instance().settingsManager()->mongoTimeoutSec(),
                                   AppRegistry::instance().settingsManager()->shellTimeoutSec());
+        _bus->countPendingEvents(_worker);
+    }
+
+    MongoWorker *MongoServer::worker(WorkerLane lane)
+    {
+        if (lane == WorkerLane::Script)
+            return _worker;
+
+        auto const laneWorker = _laneWorkers.find(lane);
+        if (laneWorker != _laneWorkers.end())
+            return laneWorker->second;
+
+        auto const settings = AppRegistry::instance().settingsManager();
+        MongoWorker *newWorker = new MongoWorker(_connSettings->clone(), false, settings->batchSize(),
+                                                 settings->mongoTimeoutSec(), settings->shellTimeoutSec(), lane);
+        _laneWorkers[lane] = newWorker;
+        _bus->countPendingEvents(newWorker);
+        return newWorker;
+    }
+
+    void MongoServer::send(Event *request)
+    {
+        WorkerLane const lane = laneOf(request->type());
+        MongoWorker *const laneWorker = worker(lane);
+
+        int const depth = _bus->pendingEvents(laneWorker);
+        if (depth >= LANE_QUEUE_DEPTH_WARNING) {
+            LOG_MSG(QString("%1 requests are waiting in %2 lane of %3.").arg(depth).arg(laneName(lane))
+                    .arg(QtUtils::toQString(_connSettings->connectionName())), 
+                    mongo::logger::LogSeverity::Warning());
+        }
+
+        _bus->send(laneWorker, request);
+    }
+
+    int MongoServer::queueDepth(WorkerLane lane) const
+    {
+        MongoWorker *laneWorker = _worker;
+        if (lane != WorkerLane::Script) {
+            auto const it = _laneWorkers.find(lane);
+            if (it == _laneWorkers.end())
+                return 0;
+
+            laneWorker = it->second;
+        }
+
+        return _bus->pendingEvents(laneWorker);
+    }
+
+    void MongoServer::releaseQueryCursors(QObject *shell)
+    {
+        // Nothing is cached if query lane was not used yet
+        if (_laneWorkers.count(WorkerLane::Query))
+            send(new ReleaseQueryCursorsRequest(shell));
+    }
+
+    void MongoServer::stopScript(QObject *shell)
+    {
+        // Script worker is busy with the script, so stop is sent to another lane
+        send(new StopScriptRequest(shell, _worker));
+    }
+
+    void MongoServer::sampleServerStatus()
+    {
+        send(new ServerStatusRequest(this));
+    }
+
+    void MongoServer::handle(ServerStatusResponse *event)
+    {
+        // Server Monitor tabs of this server are subscribed to this server only
+        if (event->isError()) {
+            _bus->publish(new ServerStatusResponse(this, event->error()));
+            return;
+        }
+
+        _bus->publish(new ServerStatusResponse(this, event->status, event->replicationLagSecs));
+    }
+
+    void MongoServer::watchChanges(int watchId, const MongoNamespace &ns, const mongo::BSONObj &pipeline)
+    {
+        send(new WatchChangesRequest(this, watchId, ns, pipeline));
+    }
+
+    void MongoServer::changeStreamGetMore(int watchId, const MongoNamespace &ns, long long cursorId)
+    {
+        send(new ChangeStreamGetMoreRequest(this, watchId, ns, cursorId));
+    }
+
+    void MongoServer::closeChangeStream(int watchId)
+    {
+        send(new CloseChangeStreamRequest(this, watchId));
+    }
+
+    void MongoServer::handle(ChangeStreamResponse *event)
+    {
+        // Views watching changes are subscribed to this server, each one picks batches of its watchId
+        if (event->isError()) {
+            _bus->publish(new ChangeStreamResponse(this, event->watchId, event->error()));
+            return;
+        }
+
+        _bus->publish(new ChangeStreamResponse(this, event->watchId, event->batch));
     }
 
     void MongoServer::handle(CreateDatabaseResponse *event) 
@@ -422,6 +591,7 @@ namespace Robomongo {
     void MongoServer::handleConnectionFailure(EstablishConnectionResponse* event)
     {
         _isConnected = false;
+        _connectionFailed = true;
 
         std::stringstream ss("Unknown error");
         auto eventErrorReason = event->errorReason;
@@ -1,5 +1,6 @@
 #pragma once
 #include <QObject>
+#include <map>
 
 #include "robomongo/core/settings/ConnectionSettings.h"
 #include "robomongo/core/events/MongoEvents.h"
@@ -7,6 +8,7 @@
 namespace Robomongo
 {
     class MongoWorker;
+    enum class WorkerLane;
     class MongoDatabase;
     class EventBus;
     class App;
@@ -16,8 +18,11 @@ namespace Robomongo
     struct RefreshReplicaSetFolderResponse;
     class LoadDatabaseNamesResponse;
     class InsertDocumentResponse;
+    class BulkWriteResponse;
     struct CreateDatabaseResponse;
     struct DropDatabaseResponse;
+    class ServerStatusResponse;
+    class ChangeStreamResponse;
 
     /**
      * @brief MongoServer represents active connection to MongoDB server.
@@ -74,6 +79,11 @@ namespace Robomongo
 
         bool isConnected() const;
 
+        /**
+         * @brief True if the last connection attempt of this server failed
+         */
+        bool connectionFailed() const { return _connectionFailed; }
+
         void addDatabase(MongoDatabase *database);
         void createDatabase(const std::string &dbName);
         void dropDatabase(const std::string &dbName);
@@ -101,6 +111,56 @@ namespace Robomongo
         void loadDatabases();
         MongoWorker *const worker() const { return _worker; }
 
+        /**
+         * @brief Worker of 'lane', started on first use. Script lane worker is worker().
+         */
+        MongoWorker *worker(WorkerLane lane);
+
+        /**
+         * @brief Sends 'request' to the worker lane that serves requests of its type, so that
+         *        explorer and paging requests do not wait behind long running scripts.
+         */
+        void send(Event *request);
+
+        /**
+         * @brief Number of requests waiting in 'lane', zero if lane is not started
+         */
+        int queueDepth(WorkerLane lane) const;
+
+        /**
+         * @brief Kills query cursors cached for paging of 'shell' results
+         */
+        void releaseQueryCursors(QObject *shell);
+
+        /**
+         * @brief Stops script of 'shell': interrupts shell scope and kills its operations 
+         *        and cursors on server
+         */
+        void stopScript(QObject *shell);
+
+        /**
+         * @brief Runs serverStatus on Monitor lane, result is published with ServerStatusResponse
+         */
+        void sampleServerStatus();
+
+        /**
+         * @brief Opens change stream 'pipeline' of 'ns' (of database if collection name is empty)
+         *        on ChangeStream lane. Batches are published with ChangeStreamResponse, 
+         *        'watchId' tells which view they belong to.
+         */
+        void watchChanges(int watchId, const MongoNamespace &ns, const mongo::BSONObj &pipeline);
+
+        /**
+         * @brief Requests next batch of change stream opened by watchChanges()
+         */
+        void changeStreamGetMore(int watchId, const MongoNamespace &ns, long long cursorId);
+
+        /**
+         * @brief Closes change stream 'watchId', including the one whose watchChanges() 
+         *        response is still in flight
+         */
+        void closeChangeStream(int watchId);
+
         ReplicaSet* replicaSetInfo() const { return _replicaSetInfo.get(); }
 
         void handle(ReplicaSetRefreshed *event);
@@ -112,9 +172,12 @@ namespace Robomongo
         void handle(RefreshReplicaSetFolderResponse *event);
         void handle(LoadDatabaseNamesResponse *event);
         void handle(InsertDocumentResponse *event);
+        void handle(BulkWriteResponse *event);
         void handle(RemoveDocumentResponse *event);
         void handle(CreateDatabaseResponse *event);
         void handle(DropDatabaseResponse *event);
+        void handle(ServerStatusResponse *event);
+        void handle(ChangeStreamResponse *event);
 
     private:                 
         void clearDatabases();
@@ -125,6 +188,10 @@ namespace Robomongo
         void hideProgressBar() const;
 
         MongoWorker *_worker;
+
+        // Workers of Query, Metadata, Monitor and ChangeStream lanes, see worker(WorkerLane)
+        std::map<WorkerLane, MongoWorker *> _laneWorkers;
+
         std::unique_ptr<ConnectionSettings> _connSettings;
         EventBus *_bus;
         App *_app;
@@ -133,6 +200,7 @@ namespace Robomongo
         std::string _storageEngineType;
         ConnectionType _connectionType;
         bool _isConnected;
+        bool _connectionFailed;
         int _handle;
 
         QList<MongoDatabase *> _databases;
@@ -3,6 +3,7 @@
 #include "mongo/scripting/engine.h"
 
 #include "robomongo/core/domain/MongoServer.h"
+#include "robomongo/core/domain/MongoDatabase.h"
 #include "robomongo/core/mongodb/MongoWorker.h"
 #include "robomongo/core/AppRegistry.h"
 #include "robomongo/core/EventBus.h"
@@ -25,7 +26,8 @@ namespace Robomongo
     {
         eventBus()->publish(new ScriptExecutingEvent(this));
         _scriptInfo.setScript(QtUtils::toQString(script));
-        eventBus()->send(_server->worker(), new ExecuteScriptRequest(this, query(), dbName));
+        _server->releaseQueryCursors(this);
+        eventBus()->send(_server->worker(), new ExecuteScriptRequest(this, query(), dbName, AggrInfo(), _maxTimeMS));
         LOG_MSG(_scriptInfo.script(), mongo::logger::LogSeverity::Info());
     }
 
@@ -41,16 +43,27 @@ namespace Robomongo
             return;
 
         std::string const finalScript = script.empty() ? query() : script;
+
+        // New results replace all parts of the output, except for aggregation paging
+        if (!_aggrInfo.isValid)
+            _server->releaseQueryCursors(this);
+
         eventBus()->publish(new ScriptExecutingEvent(this));
         eventBus()->send(_server->worker(), 
-            new ExecuteScriptRequest(this, finalScript, dbName, _aggrInfo));
+            new ExecuteScriptRequest(this, finalScript, dbName, _aggrInfo, _maxTimeMS));
         if (!_scriptInfo.script().isEmpty())
             LOG_MSG(_scriptInfo.script(), mongo::logger::LogSeverity::Info());
     }
 
     void MongoShell::query(int resultIndex, const MongoQueryInfo &info)
     {
-        eventBus()->send(_server->worker(), new ExecuteQueryRequest(this, resultIndex, info));
+        bool const streamed = AppRegistry::instance().settingsManager()->streamQueryResults();
+        _server->send(new ExecuteQueryRequest(this, resultIndex, info, streamed));
+    }
+
+    void MongoShell::explain(const std::string &dbName, const MongoQueryInfo &info, const AggrInfo &aggrInfo)
+    {
+        _server->send(new ExplainQueryRequest(this, dbName, info, aggrInfo));
     }
 
     void MongoShell::autocomplete(const std::string &prefix)
@@ -68,8 +81,8 @@ namespace Robomongo
 
     void MongoShell::stop()
     {
-        // _server->worker()->interrupt();
-        // mongo::Scope::setInterruptFlag(true);
+        _server->stopScript(this);
+        _server->releaseQueryCursors(this);
     }
 
     bool MongoShell::loadFromFile()
@@ -96,10 +109,21 @@ namespace Robomongo
 
         eventBus()->publish(
             new DocumentListLoadedEvent(this, 
-                event->resultIndex, event->queryInfo, query(), event->documents)
+                event->resultIndex, event->queryInfo, query(), event->documents,
+                event->firstChunk, event->lastChunk)
         );
     }
 
+    void MongoShell::handle(ExplainQueryResponse *event)
+    {
+        if (event->isError()) {
+            eventBus()->publish(new QueryExplainedEvent(this, event->error()));
+            return;
+        }
+
+        eventBus()->publish(new QueryExplainedEvent(this, event->explain, event->elapsedMs));
+    }
+
     void MongoShell::handle(ExecuteScriptResponse *event)
     {
         if (!event->isError()) {
@@ -134,6 +158,23 @@ namespace Robomongo
             return;
         }
 
-        eventBus()->publish(new AutocompleteResponse(this, event->list, event->prefix));
+        // Field paths of analyzed collections complete names in query documents
+        QStringList list = event->list;
+        std::string const& prefix = event->prefix;
+        MongoDatabase *database = _server->findDatabaseByName(dbname());
+        if (database && !prefix.empty() && prefix.compare(0, 3, "db.") != 0) {
+            for (auto const& schema : database->schemas()) {
+                for (auto const& field : schema.second.fields) {
+                    if (field.path.compare(0, prefix.size(), prefix) != 0)
+                        continue;
+
+                    QString const path = QtUtils::toQString(field.path);
+                    if (!list.contains(path))
+                        list.append(path);
+                }
+            }
+        }
+
+        eventBus()->publish(new AutocompleteResponse(this, list, prefix));
     }
 }
@@ -17,6 +17,12 @@ namespace Robomongo
 
         void open(const std::string &script, const std::string &dbName = std::string());
         void query(int resultIndex, const MongoQueryInfo &info);
+
+        /**
+         * @brief Explains find 'info' or, if it is not valid, aggregation 'aggrInfo'
+         *        run on 'dbName'. Result is published as QueryExplainedEvent.
+         */
+        void explain(const std::string &dbName, const MongoQueryInfo &info, const AggrInfo &aggrInfo);
         void autocomplete(const std::string &prefix);
         void stop();
         MongoServer *server() const { return _server; }
@@ -29,6 +35,12 @@ namespace Robomongo
         void setScript(const QString &script) { return _scriptInfo.setScript(script); }
         void setScriptExecutable(bool execute) { _scriptInfo.setExecutable(execute); }
         void setAggrInfo(AggrInfo const& aggrInfo) { _aggrInfo = aggrInfo; }
+
+        /**
+         * @brief Time limit of queries run by this shell, 0 for no limit
+         */
+        int maxTimeMS() const { return _maxTimeMS; }
+        void setMaxTimeMS(int maxTimeMS) { _maxTimeMS = maxTimeMS; }
         QString filePath() const { return _scriptInfo.filePath(); }
 
         bool saveToFile();
@@ -37,6 +49,7 @@ namespace Robomongo
 
     protected Q_SLOTS:
         void handle(ExecuteQueryResponse *event);
+        void handle(ExplainQueryResponse *event);
         void handle(ExecuteScriptResponse *event);
         void handle(AutocompleteResponse *event);
 
@@ -44,6 +57,7 @@ namespace Robomongo
         ScriptInfo _scriptInfo;
         AggrInfo _aggrInfo;
         MongoServer *_server;
+        int _maxTimeMS = 0;
     };
 
 }
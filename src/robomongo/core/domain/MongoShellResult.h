@@ -1,6 +1,7 @@
 #pragma once
 #include "robomongo/core/domain/MongoQueryInfo.h"
 #include "robomongo/core/domain/MongoAggregateInfo.h"
+#include "robomongo/core/domain/MongoChangeStreamInfo.h"
 #include "robomongo/core/domain/MongoDocument.h"
 
 namespace Robomongo
@@ -13,14 +14,16 @@ namespace Robomongo
             const std::string &type, const std::string &response,
             const std::vector<MongoDocumentPtr> &documents,
             const MongoQueryInfo &queryInfo, const std::string &statement,
-            qint64 elapsedms, AggrInfo aggrInfo = AggrInfo()) :
+            qint64 elapsedms, AggrInfo aggrInfo = AggrInfo(),
+            ChangeStreamInfo changeStreamInfo = ChangeStreamInfo()) :
             _type(type),
             _response(response),
             _documents(documents),
             _queryInfo(queryInfo),
             _statement(statement),
             _elapsedms(elapsedms),
-            _aggrInfo(aggrInfo)
+            _aggrInfo(aggrInfo),
+            _changeStreamInfo(changeStreamInfo)
         { }
 
         std::string response() const { return _response; }
@@ -37,6 +40,7 @@ namespace Robomongo
 
         qint64 elapsedMs() const { return _elapsedms; }
         AggrInfo const& aggrInfo() const { return _aggrInfo; }
+        ChangeStreamInfo const& changeStreamInfo() const { return _changeStreamInfo; }
 
     private:
         std::string _type;
@@ -46,6 +50,7 @@ namespace Robomongo
         std::string const _statement;
         qint64 _elapsedms;
         AggrInfo _aggrInfo = AggrInfo();
+        ChangeStreamInfo _changeStreamInfo = ChangeStreamInfo();
     };
 
     /* --------------  MongoShellExecResult Class --------- */
@@ -19,7 +19,7 @@
 #include "robomongo/shell/db/ptimeutil.h"
 
 #include "robomongo/gui/MainWindow.h"
-#include "robomongo/gui/widgets/workarea/BsonTreeItem.h"
+#include "robomongo/gui/widgets/workarea/BsonTreeModel.h"
 #include "robomongo/gui/dialogs/DocumentTextEditor.h"
 #include "robomongo/gui/utils/DialogUtils.h"
 #include "robomongo/gui/GuiRegistry.h"
@@ -29,15 +29,15 @@ namespace Robomongo
 {
     namespace detail
     {
-        bool isSimpleType(Robomongo::BsonTreeItem const *item)
+        bool isSimpleType(const BsonTreeItem &item)
         {
-            return BsonUtils::isSimpleType(item->type()) ||
-                   BsonUtils::isUuidType(item->type(), item->binType());
+            return BsonUtils::isSimpleType(item.type()) ||
+                   BsonUtils::isUuidType(item.type(), item.binType());
         }
 
-        bool isObjectIdType(Robomongo::BsonTreeItem *item)
+        bool isObjectIdType(const BsonTreeItem &item)
         {
-            return mongo::jstOID == item->type();
+            return mongo::jstOID == item.type();
         }
 
         bool isMultiSelection(const QModelIndexList &indexes)
@@ -45,19 +45,19 @@ namespace Robomongo
             return indexes.count() > 1;
         }
 
-        bool isDocumentType(BsonTreeItem const *item)
+        bool isDocumentType(const BsonTreeItem &item)
         {
-            return BsonUtils::isDocument(item->type());
+            return BsonUtils::isDocument(item.type());
         }
 
-        bool isArrayChild(BsonTreeItem const *item)
+        bool isArrayChild(const BsonTreeItem &item)
         {
-            return BsonUtils::isArray(dynamic_cast<BsonTreeItem*>(item->parent())->type());
+            return !item.isSuperParent() && BsonUtils::isArray(item.parent().type());
         }
 
-        bool isDocumentRoot(BsonTreeItem const *item)
+        bool isDocumentRoot(const BsonTreeItem &item)
         {
-            return ( item == item->superParent() );
+            return item.isSuperParent();
         }
 
         /**
@@ -72,12 +72,12 @@ namespace Robomongo
             for (QModelIndexList::const_iterator it = indexes.begin(); it != indexes.end(); ++it)
             {
                 QModelIndex isUnique = *it;
-                Robomongo::BsonTreeItem *item = Robomongo::QtUtils::item<Robomongo::BsonTreeItem*>(isUnique);
-                if (item) {
+                BsonTreeItem const item = BsonTreeModel::item(isUnique);
+                if (item.isValid()) {
                     for (QModelIndexList::const_iterator jt = result.begin(); jt != result.end(); ++jt)
                     {
-                        Robomongo::BsonTreeItem *jItem = Robomongo::QtUtils::item<Robomongo::BsonTreeItem*>(*jt);
-                        if (jItem && jItem->superParent() == item->superParent()) {
+                        BsonTreeItem const jItem = BsonTreeModel::item(*jt);
+                        if (jItem.isValid() && jItem.superParent() == item.superParent()) {
                             isUnique = QModelIndex();
                             break;
                         }
@@ -140,11 +140,11 @@ namespace Robomongo
         VERIFY(connect(_copyJsonAction, SIGNAL(triggered()), SLOT(onCopyJson())));        
     }
 
-    void Notifier::initMenu(QMenu *const menu, BsonTreeItem *const item)
+    void Notifier::initMenu(QMenu *const menu, const BsonTreeItem &item)
     {
         bool const isProjection = !_queryInfo._fields.isEmpty();
         bool const isEditable = _queryInfo._info.isValid() && !isProjection;
-        bool const onItem = item ? true : false;
+        bool const onItem = item.isValid();
         
         bool isSimple = false;
         bool isDocument = false;
@@ -152,7 +152,7 @@ namespace Robomongo
         bool isNotArrayChild = false;
         bool isRoot = false;
 
-        if (item) {
+        if (onItem) {
             isSimple = detail::isSimpleType(item);
             isDocument = detail::isDocumentType(item);
             isObjectId = detail::isObjectIdType(item);
@@ -186,16 +186,16 @@ namespace Robomongo
         if (isEditable) menu->addAction(_deleteDocumentsAction);
     }
 
-    void Notifier::deleteDocuments(std::vector<BsonTreeItem*> const& items, bool force)
+    void Notifier::deleteDocuments(std::vector<BsonTreeItem> const& items, bool force)
     {
         bool isNeededRefresh = false;
 
         int index = 0;
-        for (auto const * const documentItem : items) {
-            if (!documentItem)
+        for (auto const& documentItem : items) {
+            if (!documentItem.isValid())
                 break;
 
-            mongo::BSONObj obj = documentItem->superRoot();
+            mongo::BSONObj obj = documentItem.superRoot();
             mongo::BSONElement id = obj.getField("_id");
 
             if (id.eoo()) {
@@ -269,8 +269,8 @@ namespace Robomongo
         if (!selectedInd.isValid())
             return;
 
-        BsonTreeItem const *documentItem = QtUtils::item<BsonTreeItem*>(selectedInd);
-        if (!documentItem)
+        BsonTreeItem const documentItem = BsonTreeModel::item(selectedInd);
+        if (!documentItem.isValid())
             return;
 
         if (!(detail::isSimpleType(documentItem) || detail::isDocumentType(documentItem) ||
@@ -278,7 +278,7 @@ namespace Robomongo
             return;
 
         QClipboard *clipboard = QApplication::clipboard();
-        clipboard->setText(QString::fromStdString(documentItem->fieldName()));
+        clipboard->setText(QString::fromStdString(documentItem.fieldName()));
     }
 
     void Notifier::onCopyPathDocument()
@@ -287,8 +287,8 @@ namespace Robomongo
         if (!selectedInd.isValid())
             return;
 
-        BsonTreeItem const *documentItem = QtUtils::item<BsonTreeItem*>(selectedInd);
-        if (!documentItem)
+        BsonTreeItem const documentItem = BsonTreeModel::item(selectedInd);
+        if (!documentItem.isValid())
             return;
 
         if (!(detail::isSimpleType(documentItem) || detail::isDocumentType(documentItem) ||
@@ -296,14 +296,14 @@ namespace Robomongo
             return;
 
         QStringList namesList;
-        BsonTreeItem const *documentItemHelper = documentItem;
+        BsonTreeItem documentItemHelper = documentItem;
 
         while (!detail::isDocumentRoot(documentItemHelper)) {
             if (!detail::isArrayChild(documentItemHelper)) {
-                namesList.push_front(QString::fromStdString(documentItemHelper->fieldName()));
+                namesList.push_front(QString::fromStdString(documentItemHelper.fieldName()));
             }
 
-            documentItemHelper = dynamic_cast<BsonTreeItem*>(documentItemHelper->parent());
+            documentItemHelper = documentItemHelper.parent();
         }
 
         QClipboard *clipboard = QApplication::clipboard();
@@ -342,9 +342,9 @@ namespace Robomongo
                                            arg(selectedIndexes.count()));
 
         if (QMessageBox::Yes == answer) {
-            std::vector<BsonTreeItem*> items;
+            std::vector<BsonTreeItem> items;
             for (auto index : selectedIndexes) 
-                items.push_back(QtUtils::item<BsonTreeItem*>(index));
+                items.push_back(BsonTreeModel::item(index));
             
             deleteDocuments(items, true);
         }
@@ -359,8 +359,8 @@ namespace Robomongo
         if (!selectedIndex.isValid())
             return;
 
-        BsonTreeItem *documentItem = QtUtils::item<BsonTreeItem*>(selectedIndex);
-        std::vector<BsonTreeItem*> vec;
+        BsonTreeItem const documentItem = BsonTreeModel::item(selectedIndex);
+        std::vector<BsonTreeItem> vec;
         vec.push_back(documentItem);
         return deleteDocuments(vec, false);
     }
@@ -374,11 +374,11 @@ namespace Robomongo
         if (!selectedInd.isValid())
             return;
 
-        BsonTreeItem *documentItem = QtUtils::item<BsonTreeItem*>(selectedInd);
-        if (!documentItem)
+        BsonTreeItem const documentItem = BsonTreeModel::item(selectedInd);
+        if (!documentItem.isValid())
             return;
 
-        std::string str = BsonUtils::jsonString(documentItem->superRoot(), mongo::TenGen, 1,
+        std::string str = BsonUtils::jsonString(documentItem.superRoot(), mongo::TenGen, 1,
                                                 AppRegistry::instance().settingsManager()->uuidEncoding(),
                                                 AppRegistry::instance().settingsManager()->timeZone());
 
@@ -401,11 +401,11 @@ namespace Robomongo
         if (!selectedIndex.isValid())
             return;
 
-        BsonTreeItem *documentItem = QtUtils::item<BsonTreeItem*>(selectedIndex);
-        if (!documentItem)
+        BsonTreeItem const documentItem = BsonTreeModel::item(selectedIndex);
+        if (!documentItem.isValid())
             return;
 
-        mongo::BSONObj obj = documentItem->superRoot();
+        mongo::BSONObj obj = documentItem.superRoot();
 
         std::string str = BsonUtils::jsonString(obj, mongo::TenGen, 1,
             AppRegistry::instance().settingsManager()->uuidEncoding(),
@@ -435,11 +435,8 @@ namespace Robomongo
         if (result != QDialog::Accepted)
             return;
 
-        DocumentTextEditor::ReturnType obj = editor.bsonObj();
-        for (DocumentTextEditor::ReturnType::const_iterator it = obj.begin(); it != obj.end(); ++it) {
-            _shell->server()->insertDocument(*it, _queryInfo._info._ns);
-            mainWindow()->showQueryWidgetProgressBar();
-        }
+        _shell->server()->insertDocuments(editor.bsonObj(), _queryInfo._info._ns);
+        mainWindow()->showQueryWidgetProgressBar();
     }
 
     void Notifier::onCopyDocument()
@@ -448,15 +445,15 @@ namespace Robomongo
         if (!selectedInd.isValid())
             return;
 
-        BsonTreeItem *documentItem = QtUtils::item<BsonTreeItem*>(selectedInd);
-        if (!documentItem)
+        BsonTreeItem const documentItem = BsonTreeModel::item(selectedInd);
+        if (!documentItem.isValid())
             return;
 
         if (!detail::isSimpleType(documentItem))
             return;
 
         QClipboard *clipboard = QApplication::clipboard();
-        clipboard->setText(documentItem->value());
+        clipboard->setText(documentItem.value());
     }
 
     void Notifier::onCopyTimestamp()
@@ -465,8 +462,8 @@ namespace Robomongo
         if (!selectedInd.isValid())
             return;
 
-        BsonTreeItem *documentItem = QtUtils::item<BsonTreeItem*>(selectedInd);
-        if (!documentItem)
+        BsonTreeItem const documentItem = BsonTreeModel::item(selectedInd);
+        if (!documentItem.isValid())
             return;
 
         if (!detail::isObjectIdType(documentItem))
@@ -475,7 +472,7 @@ namespace Robomongo
         QClipboard *clipboard = QApplication::clipboard();
 
         // new Date(parseInt(this.valueOf().slice(0,8), 16)*1000);
-        QString hexTimestamp = documentItem->value().mid(10, 8);
+        QString hexTimestamp = documentItem.value().mid(10, 8);
         bool ok;
         long long milliTimestamp = (long long)hexTimestamp.toLongLong(&ok, 16)*1000;
 
@@ -501,19 +498,16 @@ namespace Robomongo
          if (!selectedInd.isValid())
              return;
 
-         BsonTreeItem *documentItem = QtUtils::item<BsonTreeItem*>(selectedInd);
-         if (!documentItem)
+         BsonTreeItem const documentItem = BsonTreeModel::item(selectedInd);
+         if (!documentItem.isValid())
              return;
 
          if (!detail::isDocumentType(documentItem))
              return;
 
          QClipboard *clipboard = QApplication::clipboard();
-         mongo::BSONObj obj = documentItem->root();
-         if (documentItem != documentItem->superParent()) {
-             obj = obj[documentItem->fieldName()].Obj();
-         }
-         bool isArray = BsonUtils::isArray(documentItem->type());
+         mongo::BSONObj obj = documentItem.object();
+         bool isArray = BsonUtils::isArray(documentItem.type());
          std::string str = BsonUtils::jsonString(obj, mongo::TenGen, 1,
                  AppRegistry::instance().settingsManager()->uuidEncoding(),
                  AppRegistry::instance().settingsManager()->timeZone(), isArray);
@@ -19,10 +19,10 @@ namespace Robomongo
 
     namespace detail
     {
-        bool isSimpleType(BsonTreeItem const *item);
-        bool isObjectIdType(BsonTreeItem *item);
+        bool isSimpleType(const BsonTreeItem &item);
+        bool isObjectIdType(const BsonTreeItem &item);
         bool isMultiSelection(const QModelIndexList &indexes);
-        bool isDocumentType(BsonTreeItem const *item);
+        bool isDocumentType(const BsonTreeItem &item);
         QModelIndexList uniqueRows(QModelIndexList indexes, bool returnSuperParents = false);
     }
 
@@ -43,10 +43,10 @@ namespace Robomongo
     public:
         typedef QObject BaseClass;
         Notifier(INotifierObserver *const observer, MongoShell *shell, const MongoQueryInfo &queryInfo, QObject *parent = NULL);
-        void initMenu(QMenu *const menu, BsonTreeItem *const item);
+        void initMenu(QMenu *const menu, const BsonTreeItem &item);
         void initMultiSelectionMenu(QMenu *const menu);
 
-        void deleteDocuments(std::vector<BsonTreeItem*> const& items, bool force);
+        void deleteDocuments(std::vector<BsonTreeItem> const& items, bool force);
         void handleDeleteCommand();
 
     public Q_SLOTS:
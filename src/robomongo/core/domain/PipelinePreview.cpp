@@ -0,0 +1,134 @@
+#include "robomongo/core/domain/PipelinePreview.h"
+
+#include <algorithm>
+
+#include <mongo/bson/bsonobjbuilder.h>
+
+#include "robomongo/core/domain/ExplainPlan.h"
+
+namespace
+{
+    // Stages which are valid only as the first stage of pipeline
+    bool mustBeFirst(const std::string &name)
+    {
+        static char const *const names[] = { "$geoNear", "$collStats", "$indexStats", "$search", "$searchMeta",
+                                             "$currentOp", "$listSessions", "$changeStream", "$planCacheStats",
+                                             "$documents" };
+        return std::find(std::begin(names), std::end(names), name) != std::end(names);
+    }
+}
+
+namespace Robomongo
+{
+    PipelinePreview::PipelinePreview(size_t capacity /* = 256 */) :
+        _capacity(capacity) {}
+
+    std::string PipelinePreview::stageName(const mongo::BSONObj &stage)
+    {
+        return stage.isEmpty() ? std::string() : stage.firstElementFieldName();
+    }
+
+    bool PipelinePreview::isWriteStage(const mongo::BSONObj &stage)
+    {
+        std::string const name = stageName(stage);
+        return name == "$out" || name == "$merge";
+    }
+
+    mongo::BSONObj PipelinePreview::prefixPipeline(const std::vector<mongo::BSONObj> &stages, size_t count, 
+                                                   int sampleSize, int previewSize /* = 0 */)
+    {
+        count = std::min(count, stages.size());
+        bool const keepFirst = count > 0 && mustBeFirst(stageName(stages[0]));
+
+        mongo::BSONArrayBuilder pipeline;
+        if (keepFirst)
+            pipeline.append(stages[0]);
+        pipeline.append(BSON("$limit" << sampleSize));
+        for (size_t i = keepFirst ? 1 : 0; i < count; ++i)
+            pipeline.append(stages[i]);
+        if (previewSize > 0)
+            pipeline.append(BSON("$limit" << previewSize));
+
+        return pipeline.arr();
+    }
+
+    std::vector<long long> PipelinePreview::stageTimes(const ExplainPlan &plan, 
+                                                       const std::vector<mongo::BSONObj> &stages)
+    {
+        std::vector<long long> times(stages.size(), -1);
+        std::vector<ExplainStage> const& explained = plan.stages;
+        if (explained.empty())
+            return times;
+
+        // First explained stage is the query part of pipeline ($cursor, or plan of find 
+        // if whole pipeline was turned into find), unless pipeline cannot start with a query
+        size_t const first = (explained.front().name == "$cursor" || explained.front().name[0] != '$') ? 1 : 0;
+
+        // Shards of sharded collection are reported instead of stages
+        for (size_t j = first; j < explained.size(); ++j) {
+            if (explained[j].name.empty() || explained[j].name[0] != '$')
+                return times;
+        }
+
+        // Stages are matched by name from the end
+        size_t i = stages.size();
+        size_t j = explained.size();
+        while (i > 0 && j > first) {
+            std::string const& name = explained[j - 1].name;
+            bool const isStage = std::any_of(stages.begin(), stages.begin() + i, [&name](const mongo::BSONObj &stage) {
+                return stageName(stage) == name;
+            });
+
+            // Stage added by server, i.e. $group of $count
+            if (!isStage) {
+                --j;
+                continue;
+            }
+
+            if (stageName(stages[i - 1]) == name) {
+                long long const time = explained[j - 1].timeMs;
+                long long const previous = j >= 2 ? std::max(0LL, explained[j - 2].timeMs) : 0;
+                times[i - 1] = time < 0 ? -1 : std::max(0LL, time - previous);
+                --j;
+            }
+            --i;
+        }
+
+        if (first == 1 && i > 0) {
+            long long const queryTime = explained.front().timeMs;
+            times[i - 1] = queryTime >= 0 ? queryTime : plan.timeMs;
+        }
+
+        return times;
+    }
+
+    const StagePreview *PipelinePreview::find(const mongo::BSONObj &pipeline) const
+    {
+        auto const it = _previews.find(key(pipeline));
+        return it == _previews.end() ? NULL : &it->second;
+    }
+
+    void PipelinePreview::insert(const mongo::BSONObj &pipeline, const StagePreview &preview)
+    {
+        std::string const pipelineKey = key(pipeline);
+        if (_previews.count(pipelineKey) == 0)
+            _order.push_back(pipelineKey);
+        _previews[pipelineKey] = preview;
+
+        while (_previews.size() > _capacity) {
+            _previews.erase(_order.front());
+            _order.pop_front();
+        }
+    }
+
+    void PipelinePreview::clear()
+    {
+        _previews.clear();
+        _order.clear();
+    }
+
+    std::string PipelinePreview::key(const mongo::BSONObj &pipeline)
+    {
+        return std::string(pipeline.objdata(), pipeline.objsize());
+    }
+}
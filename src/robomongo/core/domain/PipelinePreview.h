@@ -0,0 +1,78 @@
+#pragma once
+
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <mongo/bson/bsonobj.h>
+
+namespace Robomongo
+{
+    struct ExplainPlan;
+
+    /**
+     * @brief Output of aggregation pipeline prefix run on sampled documents
+     */
+    struct StagePreview
+    {
+        std::vector<mongo::BSONObj> documents;
+        long long elapsedMs = 0;
+        std::string error;      // empty if prefix ran successfully
+    };
+
+    /**
+     * @brief Outputs of pipeline prefixes keyed by prefix pipeline, so that after stage 'k' 
+     *        is edited only prefixes that end at stage 'k' or later have to be run again.
+     *        Keeps at most 'capacity' outputs, the oldest ones are dropped first.
+     */
+    class PipelinePreview
+    {
+    public:
+        explicit PipelinePreview(size_t capacity = 256);
+
+        /**
+         * @brief Name of 'stage' operator, i.e. "$match"
+         */
+        static std::string stageName(const mongo::BSONObj &stage);
+
+        /**
+         * @brief Stages that write to collections ($out, $merge) are never run by preview
+         */
+        static bool isWriteStage(const mongo::BSONObj &stage);
+
+        /**
+         * @brief First 'count' stages that read only 'sampleSize' documents of collection:
+         *        [ { $limit: sampleSize }, stage 1, ..., stage 'count', { $limit: previewSize } ].
+         *        Stages that must be first in pipeline ($geoNear, $collStats etc.) stay first.
+         *        Last $limit is omitted if 'previewSize' is 0.
+         */
+        static mongo::BSONObj prefixPipeline(const std::vector<mongo::BSONObj> &stages, size_t count, 
+                                             int sampleSize, int previewSize = 0);
+
+        /**
+         * @brief Own execution time of each of 'stages' from explain 'plan' of pipeline 'stages'.
+         *        Server reports cumulative times and merges some stages into the query or into 
+         *        neighbouring stages: time of stages run as query is given to the last of them,
+         *        other merged stages and stages with unknown time get -1.
+         */
+        static std::vector<long long> stageTimes(const ExplainPlan &plan, const std::vector<mongo::BSONObj> &stages);
+
+        /**
+         * @brief Output of 'pipeline', NULL if it is not known
+         */
+        const StagePreview *find(const mongo::BSONObj &pipeline) const;
+
+        void insert(const mongo::BSONObj &pipeline, const StagePreview &preview);
+
+        size_t size() const { return _previews.size(); }
+        void clear();
+
+    private:
+        static std::string key(const mongo::BSONObj &pipeline);
+
+        size_t const _capacity;
+        std::map<std::string, StagePreview> _previews;
+        std::deque<std::string> _order;     // keys in order of insertion
+    };
+}
@@ -0,0 +1,72 @@
+#include "gtest/gtest.h"
+#include "robomongo/core/domain/PipelinePreview.h"
+#include "robomongo/core/domain/ExplainPlan.h"
+
+#include <mongo/bson/bsonobjbuilder.h>
+
+using namespace Robomongo;
+
+TEST(pipeline_preview_tests, prefixPipeline_LimitsSampleAndPreview)
+{
+    std::vector<mongo::BSONObj> const stages { BSON("$match" << BSON("a" << 1)), BSON("$sort" << BSON("b" << 1)) };
+
+    EXPECT_TRUE(PipelinePreview::prefixPipeline(stages, 1, 1000, 20).binaryEqual(
+        BSON_ARRAY(BSON("$limit" << 1000) << BSON("$match" << BSON("a" << 1)) << BSON("$limit" << 20))));
+    EXPECT_TRUE(PipelinePreview::prefixPipeline(stages, 5, 1000).binaryEqual(
+        BSON_ARRAY(BSON("$limit" << 1000) << BSON("$match" << BSON("a" << 1)) << BSON("$sort" << BSON("b" << 1)))));
+}
+
+TEST(pipeline_preview_tests, prefixPipeline_KeepsFirstOnlyStageFirst)
+{
+    std::vector<mongo::BSONObj> const stages { BSON("$geoNear" << BSON("near" << BSON_ARRAY(0 << 0))), 
+                                               BSON("$project" << BSON("a" << 1)) };
+
+    EXPECT_TRUE(PipelinePreview::prefixPipeline(stages, 2, 100, 10).binaryEqual(
+        BSON_ARRAY(stages[0] << BSON("$limit" << 100) << stages[1] << BSON("$limit" << 10))));
+}
+
+TEST(pipeline_preview_tests, isWriteStage)
+{
+    EXPECT_TRUE(PipelinePreview::isWriteStage(BSON("$out" << "other")));
+    EXPECT_TRUE(PipelinePreview::isWriteStage(BSON("$merge" << BSON("into" << "other"))));
+    EXPECT_FALSE(PipelinePreview::isWriteStage(BSON("$match" << mongo::BSONObj())));
+}
+
+TEST(pipeline_preview_tests, insert_DropsOldestOverCapacity)
+{
+    PipelinePreview cache(2);
+    StagePreview preview;
+    preview.elapsedMs = 7;
+
+    cache.insert(BSON_ARRAY(BSON("$limit" << 1)), preview);
+    cache.insert(BSON_ARRAY(BSON("$limit" << 2)), preview);
+    cache.insert(BSON_ARRAY(BSON("$limit" << 3)), preview);
+
+    EXPECT_EQ(2u, cache.size());
+    EXPECT_TRUE(cache.find(BSON_ARRAY(BSON("$limit" << 1))) == nullptr);
+    ASSERT_TRUE(cache.find(BSON_ARRAY(BSON("$limit" << 3))) != nullptr);
+    EXPECT_EQ(7, cache.find(BSON_ARRAY(BSON("$limit" << 3)))->elapsedMs);
+}
+
+TEST(pipeline_preview_tests, stageTimes_SubtractsCumulativeTimesAndSkipsMergedStages)
+{
+    // $limit and $match run as query, $limit after $sort is merged into $sort, 
+    // $count is run as $group and $project
+    std::vector<mongo::BSONObj> const stages { BSON("$limit" << 1000), BSON("$match" << BSON("a" << 1)),
+                                               BSON("$sort" << BSON("b" << 1)), BSON("$limit" << 5),
+                                               BSON("$count" << "n") };
+    auto const explain = BSON("stages" << BSON_ARRAY(
+        BSON("$cursor" << BSON("queryPlanner" << mongo::BSONObj()) << "executionTimeMillisEstimate" << 10) <<
+        BSON("$sort" << BSON("sortKey" << BSON("b" << 1)) << "executionTimeMillisEstimate" << 25) <<
+        BSON("$group" << BSON("_id" << 1) << "executionTimeMillisEstimate" << 26) <<
+        BSON("$project" << BSON("n" << 1) << "executionTimeMillisEstimate" << 26)));
+
+    auto const times = PipelinePreview::stageTimes(ExplainPlan::fromBson(explain), stages);
+
+    ASSERT_EQ(5u, times.size());
+    EXPECT_EQ(-1, times[0]);
+    EXPECT_EQ(10, times[1]);
+    EXPECT_EQ(15, times[2]);
+    EXPECT_EQ(-1, times[3]);
+    EXPECT_EQ(-1, times[4]);
+}
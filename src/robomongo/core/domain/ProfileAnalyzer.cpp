@@ -0,0 +1,199 @@
+#include "robomongo/core/domain/ProfileAnalyzer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <set>
+
+namespace
+{
+    // Fields of a command that differ between executions of the same query
+    bool isVolatileField(const std::string &name)
+    {
+        static std::set<std::string> const fields {
+            "lsid", "$db", "$clusterTime", "txnNumber", "autocommit", "startTransaction",
+            "$readPreference", "readConcern", "writeConcern", "comment", "$comment", "maxTimeMS",
+            "batchSize", "cursor", "singleBatch", "ordered", "shardVersion", "databaseVersion", 
+            "$audit", "$client", "$configServerState", "$topologyTime", "$queryOptions",
+            "apiVersion", "apiStrict", "apiDeprecationErrors", "mayBypassWriteBlocking",
+            "needsMerge", "fromMongos"
+        };
+        return fields.count(name) > 0;
+    }
+
+    // Fields whose values are part of the shape: they choose the plan rather than filter data
+    bool keepsValues(const std::string &name)
+    {
+        return name == "sort" || name == "orderby" || name == "$orderby" || name == "$sort" ||
+               name == "projection" || name == "fields" || name == "$project" ||
+               name == "hint" || name == "$hint";
+    }
+
+    void appendObject(std::string &out, const mongo::BSONObj &obj, bool keepValues, bool isCommand);
+
+    void appendValue(std::string &out, const mongo::BSONElement &elem, bool keepValues)
+    {
+        switch (elem.type()) {
+        case mongo::Object:
+            appendObject(out, elem.Obj(), keepValues, false);
+            return;
+
+        case mongo::Array: {
+            std::vector<mongo::BSONElement> const items = elem.Array();
+            bool const allObjects = !items.empty() && std::all_of(items.begin(), items.end(), 
+                [](mongo::BSONElement const& item) { return item.type() == mongo::Object; });
+
+            // $and / $or clauses and pipeline stages are shaped one by one, 
+            // while list of values ($in, $all etc.) is a single literal
+            if (allObjects) {
+                out += "[ ";
+                for (size_t i = 0; i < items.size(); ++i) {
+                    if (i > 0)
+                        out += ", ";
+                    appendObject(out, items[i].Obj(), keepValues, false);
+                }
+                out += " ]";
+            }
+            else {
+                out += keepValues ? elem.toString(false) : "[?]";
+            }
+            return;
+        }
+
+        case mongo::String:
+            // Field paths of aggregation expressions ("$field") are not literals
+            if (keepValues || elem.valueStringData().startsWith("$")) {
+                out += elem.toString(false);
+                return;
+            }
+            break;
+
+        default:
+            if (keepValues) {
+                out += elem.toString(false);
+                return;
+            }
+            break;
+        }
+
+        out += "?";
+    }
+
+    void appendObject(std::string &out, const mongo::BSONObj &obj, bool keepValues, bool isCommand)
+    {
+        out += "{";
+        bool first = true;
+        mongo::BSONObjIterator it(obj);
+        while (it.more()) {
+            mongo::BSONElement const elem = it.next();
+            std::string const name = elem.fieldName();
+            if (isCommand && isVolatileField(name))
+                continue;
+
+            // Command name is followed by collection name, except for getMore that has cursor id
+            bool const isCollectionName = isCommand && first && elem.type() == mongo::String;
+
+            out += first ? " " : ", ";
+            out += name + ": ";
+            appendValue(out, elem, keepValues || isCollectionName || keepsValues(name));
+            first = false;
+        }
+        out += first ? "}" : " }";
+    }
+
+    long long percentile(const std::vector<int> &sorted, int p)
+    {
+        if (sorted.empty())
+            return 0;
+
+        // Nearest rank
+        size_t const rank = static_cast<size_t>(std::ceil(p / 100.0 * sorted.size()));
+        return sorted[std::max<size_t>(rank, 1) - 1];
+    }
+}
+
+namespace Robomongo
+{
+    std::string ProfileAnalyzer::queryShape(const mongo::BSONObj &entry)
+    {
+        std::string const op = entry.getStringField("op");
+
+        // Since 3.6 operation is in 'command', getMore has the command that opened the cursor.
+        // Before 3.6 find filter and update document are in 'query' and 'updateobj'.
+        mongo::BSONObj command = entry.getObjectField("command");
+        if (op == "getmore" && entry.getField("originatingCommand").isABSONObj())
+            command = entry.getObjectField("originatingCommand");
+        if (command.isEmpty())
+            command = entry.getObjectField("query");
+
+        std::string shape = op + " " + entry.getStringField("ns") + " ";
+        appendObject(shape, command, false, true);
+
+        if (entry.getField("updateobj").isABSONObj()) {
+            shape += " ";
+            appendObject(shape, entry.getObjectField("updateobj"), false, false);
+        }
+
+        return shape;
+    }
+
+    void ProfileAnalyzer::add(const mongo::BSONObj &entry)
+    {
+        Accumulator &shape = _shapes[queryShape(entry)];
+        if (shape.millis.empty()) {
+            shape.op = entry.getStringField("op");
+            shape.ns = entry.getStringField("ns");
+        }
+
+        shape.millis.push_back(entry.getIntField("millis") > 0 ? entry.getIntField("millis") : 0);
+        shape.docsExamined += entry.getField("docsExamined").safeNumberLong();
+        shape.nReturned += entry.getField("nreturned").safeNumberLong();
+
+        std::string const plan = entry.getStringField("planSummary");
+        if (!plan.empty())
+            ++shape.plans[plan];
+
+        ++_entries;
+    }
+
+    std::vector<ProfileShapeStats> ProfileAnalyzer::shapes() const
+    {
+        std::vector<ProfileShapeStats> result;
+        result.reserve(_shapes.size());
+
+        for (auto const& item : _shapes) {
+            Accumulator const& acc = item.second;
+            std::vector<int> millis = acc.millis;
+            std::sort(millis.begin(), millis.end());
+
+            ProfileShapeStats stats;
+            stats.shape = item.first;
+            stats.op = acc.op;
+            stats.ns = acc.ns;
+            stats.count = static_cast<long long>(millis.size());
+            stats.p50Millis = percentile(millis, 50);
+            stats.p95Millis = percentile(millis, 95);
+            stats.maxMillis = millis.empty() ? 0 : millis.back();
+            for (int ms : millis)
+                stats.totalMillis += ms;
+            stats.docsExamined = acc.docsExamined;
+            stats.nReturned = acc.nReturned;
+
+            auto const plan = std::max_element(acc.plans.begin(), acc.plans.end(),
+                [](std::pair<const std::string, int> const& a, std::pair<const std::string, int> const& b) {
+                    return a.second < b.second;
+                });
+            if (plan != acc.plans.end()) {
+                stats.planSummary = plan->first;
+                if (acc.plans.size() > 1)
+                    stats.planSummary += " (+" + std::to_string(acc.plans.size() - 1) + " more)";
+            }
+
+            result.push_back(stats);
+        }
+
+        std::sort(result.begin(), result.end(), [](ProfileShapeStats const& a, ProfileShapeStats const& b) {
+            return a.totalMillis > b.totalMillis;
+        });
+        return result;
+    }
+}
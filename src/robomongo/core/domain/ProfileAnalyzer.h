@@ -0,0 +1,52 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <mongo/bson/bsonobj.h>
+
+#include "robomongo/core/events/MongoEventsInfo.h"
+
+namespace Robomongo
+{
+    /**
+     * @brief Groups documents of 'system.profile' collection by query shape and computes
+     *        statistics of every shape. Not thread safe, meant to be fed by a single worker.
+     */
+    class ProfileAnalyzer
+    {
+    public:
+        /**
+         * @brief Shape of profiled operation: operation type, namespace and command with literal
+         *        values replaced by '?'. Field names, operators, collection name, sort, projection
+         *        and hint are kept, session and other per-request fields are dropped.
+         *        I.e. "query test.users { find: "users", filter: { age: { $gt: ? } } }"
+         */
+        static std::string queryShape(const mongo::BSONObj &entry);
+
+        void add(const mongo::BSONObj &entry);
+
+        /**
+         * @brief Statistics of all shapes, shape with the highest total time first
+         */
+        std::vector<ProfileShapeStats> shapes() const;
+
+        long long entries() const { return _entries; }
+
+    private:
+        struct Accumulator
+        {
+            std::string op;
+            std::string ns;
+            std::vector<int> millis;
+            long long docsExamined = 0;
+            long long nReturned = 0;
+            std::map<std::string, int> plans;
+        };
+
+        std::unordered_map<std::string, Accumulator> _shapes;
+        long long _entries = 0;
+    };
+}
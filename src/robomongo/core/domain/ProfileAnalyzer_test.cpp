@@ -0,0 +1,60 @@
+#include "gtest/gtest.h"
+#include "robomongo/core/domain/ProfileAnalyzer.h"
+
+#include <mongo/bson/bsonobjbuilder.h>
+
+using namespace Robomongo;
+
+namespace
+{
+    mongo::BSONObj findEntry(int age, int millis, const char *plan = "IXSCAN { age: 1 }")
+    {
+        return BSON("op" << "query" << "ns" << "test.users" <<
+                    "command" << BSON("find" << "users" << "filter" << BSON("age" << BSON("$gt" << age)) <<
+                                      "sort" << BSON("name" << 1) << "lsid" << BSON("id" << age) << 
+                                      "$db" << "test") <<
+                    "docsExamined" << 10 << "nreturned" << 5 << "millis" << millis << "planSummary" << plan);
+    }
+}
+
+TEST(profile_analyzer_tests, queryShape_StripsLiteralsAndVolatileFields)
+{
+    EXPECT_EQ("query test.users { find: \"users\", filter: { age: { $gt: ? } }, sort: { name: 1 } }",
+              ProfileAnalyzer::queryShape(findEntry(30, 1)));
+}
+
+TEST(profile_analyzer_tests, queryShape_KeepsClausesAndFieldPaths)
+{
+    auto const entry = BSON("op" << "command" << "ns" << "test.users" << "command" << BSON(
+        "aggregate" << "users" << "pipeline" << BSON_ARRAY(
+            BSON("$match" << BSON("$or" << BSON_ARRAY(BSON("a" << 1) << BSON("b" << BSON("$in" << BSON_ARRAY(1 << 2)))))) <<
+            BSON("$group" << BSON("_id" << "$city")))));
+
+    EXPECT_EQ("command test.users { aggregate: \"users\", pipeline: [ { $match: { $or: [ { a: ? }, "
+              "{ b: { $in: [?] } } ] } }, { $group: { _id: \"$city\" } } ] }",
+              ProfileAnalyzer::queryShape(entry));
+}
+
+TEST(profile_analyzer_tests, shapes_GroupsEntriesOfSameShape)
+{
+    ProfileAnalyzer analyzer;
+    for (int i = 1; i <= 20; ++i)
+        analyzer.add(findEntry(i, i, i == 20 ? "COLLSCAN" : "IXSCAN { age: 1 }"));
+    analyzer.add(BSON("op" << "insert" << "ns" << "test.users" << "command" << BSON("insert" << "users") << "millis" << 1));
+
+    auto const shapes = analyzer.shapes();
+    EXPECT_EQ(21, analyzer.entries());
+    ASSERT_EQ(2u, shapes.size());
+
+    auto const& find = shapes.front();
+    EXPECT_EQ("query", find.op);
+    EXPECT_EQ(20, find.count);
+    EXPECT_EQ(10, find.p50Millis);
+    EXPECT_EQ(19, find.p95Millis);
+    EXPECT_EQ(20, find.maxMillis);
+    EXPECT_EQ(210, find.totalMillis);
+    EXPECT_DOUBLE_EQ(2.0, find.examinedPerReturned());
+    EXPECT_EQ("IXSCAN { age: 1 } (+1 more)", find.planSummary);
+
+    EXPECT_EQ(-1, shapes.back().examinedPerReturned());
+}
@@ -0,0 +1,237 @@
+#include "robomongo/core/domain/SchemaAnalyzer.h"
+
+#include <algorithm>
+#include <map>
+#include <thread>
+#include <unordered_map>
+
+#include <mongo/bson/bsonobjbuilder.h>
+
+#include "robomongo/core/domain/HyperLogLog.h"
+
+namespace
+{
+    // 1KB per path and thread, about 3% error is enough to tell keys from enums
+    const int SketchPrecision = 10;
+
+    mongo::BSONObj ownedValue(const mongo::BSONElement &elem)
+    {
+        mongo::BSONObjBuilder builder;
+        builder.appendAs(elem, "");
+        return builder.obj();
+    }
+}
+
+namespace Robomongo
+{
+    struct SchemaAnalyzer::Node
+    {
+        explicit Node(const std::string &name) : name(name), distinct(SketchPrecision) {}
+
+        Node *child(const std::string &childName)
+        {
+            auto const it = childByName.find(childName);
+            if (it != childByName.end())
+                return it->second;
+
+            children.emplace_back(new Node(childName));
+            Node *const node = children.back().get();
+            childByName[childName] = node;
+            return node;
+        }
+
+        std::string const name;
+        std::map<int, long long> types;     // BSON type to number of values
+        long long documents = 0;
+        long long lastDocument = 0;         // document which was counted last, to count each one once
+        HyperLogLog distinct;
+        mongo::BSONObj min;                 // { "": <value> }
+        mongo::BSONObj max;
+        long long arrays = 0;
+        long long minArrayLength = 0;
+        long long maxArrayLength = 0;
+        long long totalArrayLength = 0;
+        std::vector<std::unique_ptr<Node>> children;
+        std::unordered_map<std::string, Node *> childByName;
+    };
+
+    SchemaAnalyzer::SchemaAnalyzer() :
+        _root(new Node(std::string())) {}
+
+    SchemaAnalyzer::~SchemaAnalyzer() {}
+
+    void SchemaAnalyzer::add(const mongo::BSONObj &document)
+    {
+        ++_documents;
+        addObject(_root.get(), document);
+    }
+
+    void SchemaAnalyzer::addObject(Node *node, const mongo::BSONObj &obj)
+    {
+        for (mongo::BSONObjIterator it(obj); it.more(); ) {
+            mongo::BSONElement const elem = it.next();
+            addValue(node->child(elem.fieldName()), elem);
+        }
+    }
+
+    void SchemaAnalyzer::addValue(Node *node, const mongo::BSONElement &elem)
+    {
+        if (node->lastDocument != _documents) {
+            node->lastDocument = _documents;
+            ++node->documents;
+        }
+        ++node->types[elem.type()];
+
+        if (elem.type() == mongo::Object) {
+            addObject(node, elem.Obj());
+        }
+        else if (elem.type() == mongo::Array) {
+            // As in queries, fields of documents in array share path of the array
+            // and scalar items are values of the array path
+            long long length = 0;
+            for (mongo::BSONObjIterator it(elem.Obj()); it.more(); ++length) {
+                mongo::BSONElement const item = it.next();
+                if (item.type() == mongo::Object)
+                    addObject(node, item.Obj());
+                else if (item.type() != mongo::Array)
+                    addScalar(node, item);
+            }
+
+            if (node->arrays == 0 || length < node->minArrayLength)
+                node->minArrayLength = length;
+            if (node->arrays == 0 || length > node->maxArrayLength)
+                node->maxArrayLength = length;
+            node->totalArrayLength += length;
+            ++node->arrays;
+        }
+        else {
+            addScalar(node, elem);
+        }
+    }
+
+    void SchemaAnalyzer::addScalar(Node *node, const mongo::BSONElement &elem)
+    {
+        node->distinct.add(elem);
+
+        if (node->min.isEmpty() || elem.woCompare(node->min.firstElement(), false) < 0)
+            node->min = ownedValue(elem);
+        if (node->max.isEmpty() || elem.woCompare(node->max.firstElement(), false) > 0)
+            node->max = ownedValue(elem);
+    }
+
+    void SchemaAnalyzer::merge(const SchemaAnalyzer &other)
+    {
+        mergeNode(_root.get(), other._root.get());
+        _documents += other._documents;
+    }
+
+    void SchemaAnalyzer::mergeNode(Node *node, const Node *other)
+    {
+        for (auto const& type : other->types)
+            node->types[type.first] += type.second;
+
+        node->documents += other->documents;
+        node->distinct.merge(other->distinct);
+
+        if (!other->min.isEmpty() && 
+            (node->min.isEmpty() || other->min.firstElement().woCompare(node->min.firstElement(), false) < 0))
+            node->min = other->min;
+        if (!other->max.isEmpty() && 
+            (node->max.isEmpty() || other->max.firstElement().woCompare(node->max.firstElement(), false) > 0))
+            node->max = other->max;
+
+        if (other->arrays > 0) {
+            if (node->arrays == 0 || other->minArrayLength < node->minArrayLength)
+                node->minArrayLength = other->minArrayLength;
+            if (node->arrays == 0 || other->maxArrayLength > node->maxArrayLength)
+                node->maxArrayLength = other->maxArrayLength;
+            node->totalArrayLength += other->totalArrayLength;
+            node->arrays += other->arrays;
+        }
+
+        for (auto const& otherChild : other->children)
+            mergeNode(node->child(otherChild->name), otherChild.get());
+    }
+
+    std::vector<SchemaFieldStats> SchemaAnalyzer::fields() const
+    {
+        std::vector<SchemaFieldStats> fields;
+        for (auto const& child : _root->children)
+            collect(child.get(), std::string(), fields);
+
+        return fields;
+    }
+
+    void SchemaAnalyzer::collect(const Node *node, const std::string &prefix, 
+                                 std::vector<SchemaFieldStats> &fields) const
+    {
+        SchemaFieldStats stats;
+        stats.path = prefix.empty() ? node->name : prefix + "." + node->name;
+        stats.documents = node->documents;
+        stats.presence = _documents > 0 ? static_cast<double>(node->documents) / _documents : 0;
+
+        for (auto const& type : node->types)
+            stats.types.emplace_back(mongo::typeName(static_cast<mongo::BSONType>(type.first)), type.second);
+        std::stable_sort(stats.types.begin(), stats.types.end(), 
+            [](const std::pair<std::string, long long> &a, const std::pair<std::string, long long> &b) {
+                return a.second > b.second;
+            });
+
+        if (!node->min.isEmpty()) {
+            stats.distinctValues = node->distinct.estimate();
+
+            mongo::BSONObjBuilder minMax;
+            minMax.appendAs(node->min.firstElement(), "min");
+            minMax.appendAs(node->max.firstElement(), "max");
+            stats.minMax = minMax.obj();
+        }
+
+        stats.arrays = node->arrays;
+        if (node->arrays > 0) {
+            stats.minArrayLength = node->minArrayLength;
+            stats.maxArrayLength = node->maxArrayLength;
+            stats.avgArrayLength = static_cast<double>(node->totalArrayLength) / node->arrays;
+        }
+
+        fields.push_back(stats);
+
+        for (auto const& child : node->children)
+            collect(child.get(), stats.path, fields);
+    }
+
+    CollectionSchema SchemaAnalyzer::analyze(const std::string &ns, const std::vector<mongo::BSONObj> &documents,
+                                             unsigned threads /* = 0 */)
+    {
+        if (threads == 0)
+            threads = std::max(1u, std::thread::hardware_concurrency());
+
+        // Small samples are not worth starting threads
+        size_t const minDocumentsPerThread = 500;
+        threads = static_cast<unsigned>(std::max<size_t>(1, 
+            std::min<size_t>(threads, documents.size() / minDocumentsPerThread)));
+
+        std::vector<SchemaAnalyzer> analyzers(threads);
+        size_t const rangeSize = (documents.size() + threads - 1) / threads;
+        auto const analyzeRange = [&](unsigned index) {
+            size_t const end = std::min(documents.size(), (index + 1) * rangeSize);
+            for (size_t i = index * rangeSize; i < end; ++i)
+                analyzers[index].add(documents[i]);
+        };
+
+        std::vector<std::thread> workers;
+        for (unsigned i = 1; i < threads; ++i)
+            workers.emplace_back(analyzeRange, i);
+        analyzeRange(0);
+        for (auto &worker : workers)
+            worker.join();
+
+        for (unsigned i = 1; i < threads; ++i)
+            analyzers[0].merge(analyzers[i]);
+
+        CollectionSchema schema;
+        schema.ns = ns;
+        schema.sampledDocuments = analyzers[0].documents();
+        schema.fields = analyzers[0].fields();
+        return schema;
+    }
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <mongo/bson/bsonobj.h>
+
+#include "robomongo/core/events/MongoEventsInfo.h"
+
+namespace Robomongo
+{
+    /**
+     * @brief Infers field paths of documents with their type histogram, presence, 
+     *        distinct value estimate, min/max and array lengths.
+     *        Paths are kept in a trie, one node per field name. Analyzers filled from 
+     *        different threads can be merged into one.
+     */
+    class SchemaAnalyzer
+    {
+    public:
+        SchemaAnalyzer();
+        ~SchemaAnalyzer();
+
+        void add(const mongo::BSONObj &document);
+
+        /**
+         * @brief Adds statistics of 'other', paths unknown to this analyzer are appended
+         */
+        void merge(const SchemaAnalyzer &other);
+
+        long long documents() const { return _documents; }
+
+        /**
+         * @brief Statistics of all paths, parents before children, in order of first appearance
+         */
+        std::vector<SchemaFieldStats> fields() const;
+
+        /**
+         * @brief Analyzes 'documents' split into contiguous ranges, one per thread, 
+         *        and merges results in order of ranges.
+         * @param threads: number of threads, 0 for number of cores
+         */
+        static CollectionSchema analyze(const std::string &ns, const std::vector<mongo::BSONObj> &documents,
+                                        unsigned threads = 0);
+
+    private:
+        struct Node;
+
+        void addObject(Node *node, const mongo::BSONObj &obj);
+        void addValue(Node *node, const mongo::BSONElement &elem);
+        void addScalar(Node *node, const mongo::BSONElement &elem);
+        void collect(const Node *node, const std::string &prefix, std::vector<SchemaFieldStats> &fields) const;
+        static void mergeNode(Node *node, const Node *other);
+
+        std::unique_ptr<Node> _root;
+        long long _documents = 0;
+    };
+}
@@ -0,0 +1,111 @@
+#include "gtest/gtest.h"
+#include "robomongo/core/domain/SchemaAnalyzer.h"
+
+#include <mongo/bson/bsonobjbuilder.h>
+
+using namespace Robomongo;
+
+namespace
+{
+    const SchemaFieldStats *find(const std::vector<SchemaFieldStats> &fields, const std::string &path)
+    {
+        for (auto const& field : fields) {
+            if (field.path == path)
+                return &field;
+        }
+        return nullptr;
+    }
+}
+
+TEST(schema_analyzer_tests, fields_PathsInOrderOfFirstAppearance)
+{
+    SchemaAnalyzer analyzer;
+    analyzer.add(BSON("_id" << 1 << "address" << BSON("city" << "Oslo")));
+    analyzer.add(BSON("_id" << 2 << "name" << "b" << "address" << BSON("zip" << 10)));
+
+    auto const fields = analyzer.fields();
+    ASSERT_EQ(5u, fields.size());
+    EXPECT_EQ("_id", fields[0].path);
+    EXPECT_EQ("address", fields[1].path);
+    EXPECT_EQ("address.city", fields[2].path);
+    EXPECT_EQ("address.zip", fields[3].path);
+    EXPECT_EQ("name", fields[4].path);
+}
+
+TEST(schema_analyzer_tests, fields_TypesPresenceAndMinMax)
+{
+    SchemaAnalyzer analyzer;
+    analyzer.add(BSON("a" << 5));
+    analyzer.add(BSON("a" << "text"));
+    analyzer.add(BSON("a" << 2));
+    analyzer.add(BSON("b" << 1));
+
+    auto const fields = analyzer.fields();
+    const SchemaFieldStats *a = find(fields, "a");
+    ASSERT_TRUE(a);
+    EXPECT_EQ(3, a->documents);
+    EXPECT_DOUBLE_EQ(0.75, a->presence);
+    ASSERT_EQ(2u, a->types.size());
+    EXPECT_EQ(2, a->types[0].second);
+    EXPECT_EQ(1, a->types[1].second);
+    EXPECT_EQ(3, a->distinctValues);
+
+    // Numbers sort before strings
+    EXPECT_EQ(2, a->minMax.getField("min").numberInt());
+    EXPECT_EQ("text", a->minMax.getField("max").str());
+}
+
+TEST(schema_analyzer_tests, fields_ArraysShareElementPaths)
+{
+    SchemaAnalyzer analyzer;
+    analyzer.add(BSON("tags" << BSON_ARRAY("x" << "y") << 
+                      "items" << BSON_ARRAY(BSON("price" << 1) << BSON("price" << 3))));
+    analyzer.add(BSON("tags" << BSON_ARRAY("x" << "y" << "z" << "w") << "items" << mongo::BSONArray()));
+
+    auto const fields = analyzer.fields();
+    const SchemaFieldStats *tags = find(fields, "tags");
+    ASSERT_TRUE(tags);
+    EXPECT_EQ(2, tags->arrays);
+    EXPECT_EQ(2, tags->minArrayLength);
+    EXPECT_EQ(4, tags->maxArrayLength);
+    EXPECT_DOUBLE_EQ(3, tags->avgArrayLength);
+    EXPECT_EQ(4, tags->distinctValues);
+
+    // Counted once per document although two items have it
+    const SchemaFieldStats *price = find(fields, "items.price");
+    ASSERT_TRUE(price);
+    EXPECT_EQ(1, price->documents);
+    EXPECT_EQ(2, price->types[0].second);
+}
+
+TEST(schema_analyzer_tests, analyze_ThreadsGiveSameResultAsOneAnalyzer)
+{
+    std::vector<mongo::BSONObj> documents;
+    for (int i = 0; i < 5000; ++i) {
+        mongo::BSONObjBuilder builder;
+        builder.append("_id", i);
+        if (i % 2)
+            builder.append("odd", true);
+        if (i > 4000)
+            builder.append("late", BSON("value" << i % 7));
+        documents.push_back(builder.obj());
+    }
+
+    CollectionSchema const single = SchemaAnalyzer::analyze("db.coll", documents, 1);
+    CollectionSchema const parallel = SchemaAnalyzer::analyze("db.coll", documents, 4);
+
+    EXPECT_EQ("db.coll", parallel.ns);
+    EXPECT_EQ(5000, parallel.sampledDocuments);
+    ASSERT_EQ(single.fields.size(), parallel.fields.size());
+    for (size_t i = 0; i < single.fields.size(); ++i) {
+        EXPECT_EQ(single.fields[i].path, parallel.fields[i].path);
+        EXPECT_EQ(single.fields[i].documents, parallel.fields[i].documents);
+        EXPECT_EQ(single.fields[i].distinctValues, parallel.fields[i].distinctValues);
+        EXPECT_TRUE(single.fields[i].minMax.binaryEqual(parallel.fields[i].minMax));
+    }
+
+    const SchemaFieldStats *value = find(parallel.fields, "late.value");
+    ASSERT_TRUE(value);
+    EXPECT_EQ(999, value->documents);
+    EXPECT_EQ(7, value->distinctValues);
+}
@@ -0,0 +1,122 @@
+#include "robomongo/core/domain/ServerMetrics.h"
+
+#include <sstream>
+
+namespace
+{
+    long long counter(const mongo::BSONObj &status, const char *section, const char *name)
+    {
+        return status.getObjectField(section).getField(name).safeNumberLong();
+    }
+
+    long long optimeMs(const mongo::BSONObj &member)
+    {
+        mongo::BSONElement const date = member.getField("optimeDate");
+        return date.type() == mongo::Date ? date.date().toMillisSinceEpoch() : -1;
+    }
+}
+
+namespace Robomongo
+{
+    ServerMetrics::ServerMetrics(size_t capacity) :
+        _samples(capacity) {}
+
+    bool ServerMetrics::add(const mongo::BSONObj &serverStatus, double replicationLagSecs /* = -1 */)
+    {
+        mongo::BSONObj const previous = _previous;
+        _previous = serverStatus.getOwned();
+
+        // Uptime going backwards means restart, counters start from zero again
+        long long const intervalMs = serverStatus.getField("uptimeMillis").safeNumberLong() -
+                                     previous.getField("uptimeMillis").safeNumberLong();
+        if (previous.isEmpty() || intervalMs <= 0 || _samples.empty())
+            return false;
+
+        double const seconds = intervalMs / 1000.0;
+        auto rate = [&](const char *section, const char *name) {
+            long long const delta = counter(serverStatus, section, name) - counter(previous, section, name);
+            return delta > 0 ? delta / seconds : 0;
+        };
+
+        ServerMetricsSample sample;
+        mongo::BSONElement const localTime = serverStatus.getField("localTime");
+        sample.timeMs = localTime.type() == mongo::Date ? localTime.date().toMillisSinceEpoch() : 0;
+        sample.insertsPerSec = rate("opcounters", "insert");
+        sample.queriesPerSec = rate("opcounters", "query");
+        sample.updatesPerSec = rate("opcounters", "update");
+        sample.deletesPerSec = rate("opcounters", "delete");
+        sample.getmoresPerSec = rate("opcounters", "getmore");
+        sample.commandsPerSec = rate("opcounters", "command");
+        sample.bytesInPerSec = rate("network", "bytesIn");
+        sample.bytesOutPerSec = rate("network", "bytesOut");
+        sample.connections = counter(serverStatus, "connections", "current");
+        sample.replicationLagSecs = replicationLagSecs;
+
+        mongo::BSONObj const cache = serverStatus.getObjectField("wiredTiger").getObjectField("cache");
+        if (!cache.isEmpty()) {
+            sample.cacheUsedBytes = cache.getField("bytes currently in the cache").safeNumberLong();
+            sample.cacheMaxBytes = cache.getField("maximum bytes configured").safeNumberLong();
+        }
+
+        _samples[_next] = sample;
+        _next = (_next + 1) % _samples.size();
+        if (_size < _samples.size())
+            ++_size;
+
+        return true;
+    }
+
+    const ServerMetricsSample &ServerMetrics::at(size_t index) const
+    {
+        // Oldest sample is overwritten next once buffer is full
+        size_t const oldest = _size < _samples.size() ? 0 : _next;
+        return _samples[(oldest + index) % _samples.size()];
+    }
+
+    void ServerMetrics::clear()
+    {
+        _next = 0;
+        _size = 0;
+        _previous = mongo::BSONObj();
+    }
+
+    std::string ServerMetrics::toCsv() const
+    {
+        std::ostringstream csv;
+        csv << "time,inserts/s,queries/s,updates/s,deletes/s,getmores/s,commands/s,"
+               "bytes in/s,bytes out/s,cache used bytes,cache max bytes,connections,replication lag s\n";
+
+        for (size_t i = 0; i < _size; ++i) {
+            ServerMetricsSample const& s = at(i);
+            csv << mongo::Date_t::fromMillisSinceEpoch(s.timeMs).toString() << ','
+                << s.insertsPerSec << ',' << s.queriesPerSec << ',' << s.updatesPerSec << ','
+                << s.deletesPerSec << ',' << s.getmoresPerSec << ',' << s.commandsPerSec << ','
+                << s.bytesInPerSec << ',' << s.bytesOutPerSec << ','
+                << s.cacheUsedBytes << ',' << s.cacheMaxBytes << ',' << s.connections << ','
+                << s.replicationLagSecs << '\n';
+        }
+
+        return csv.str();
+    }
+
+    double ServerMetrics::replicationLag(const mongo::BSONObj &replSetStatus)
+    {
+        if (!replSetStatus.getField("members").isABSONObj())
+            return -1;
+
+        long long primaryOptime = -1;
+        long long selfOptime = -1;
+        for (auto const& memberElem : replSetStatus.getField("members").Array()) {
+            mongo::BSONObj const member = memberElem.Obj();
+            if (std::string(member.getStringField("stateStr")) == "PRIMARY")
+                primaryOptime = optimeMs(member);
+            if (member.getField("self").trueValue())
+                selfOptime = optimeMs(member);
+        }
+
+        if (primaryOptime < 0 || selfOptime < 0)
+            return -1;
+
+        return primaryOptime > selfOptime ? (primaryOptime - selfOptime) / 1000.0 : 0;
+    }
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <mongo/bson/bsonobj.h>
+
+namespace Robomongo
+{
+    /**
+     * @brief Server load between two consecutive serverStatus samples. Rates are per second.
+     */
+    struct ServerMetricsSample
+    {
+        long long timeMs = 0;               // Server 'localTime' of the sample, ms since epoch
+        double insertsPerSec = 0;
+        double queriesPerSec = 0;
+        double updatesPerSec = 0;
+        double deletesPerSec = 0;
+        double getmoresPerSec = 0;
+        double commandsPerSec = 0;
+        double bytesInPerSec = 0;
+        double bytesOutPerSec = 0;
+        long long cacheUsedBytes = -1;      // -1 if storage engine is not WiredTiger
+        long long cacheMaxBytes = -1;
+        long long connections = 0;
+        double replicationLagSecs = -1;     // -1 if server is not a replica set member
+
+        double opsPerSec() const
+        {
+            return insertsPerSec + queriesPerSec + updatesPerSec + deletesPerSec + getmoresPerSec + commandsPerSec;
+        }
+    };
+
+    /**
+     * @brief Time series of server load computed from serverStatus results. Keeps at most 
+     *        'capacity' newest samples in a ring buffer, so memory use does not grow with time.
+     */
+    class ServerMetrics
+    {
+    public:
+        explicit ServerMetrics(size_t capacity);
+
+        /**
+         * @brief Adds sample with deltas of 'serverStatus' counters against previous status.
+         *        First status (and status after server restart) is only remembered as baseline.
+         * @return true if sample was added
+         */
+        bool add(const mongo::BSONObj &serverStatus, double replicationLagSecs = -1);
+
+        size_t size() const { return _size; }
+        size_t capacity() const { return _samples.size(); }
+
+        /**
+         * @brief Sample 'index', 0 is the oldest one
+         */
+        const ServerMetricsSample &at(size_t index) const;
+
+        void clear();
+
+        /**
+         * @brief All samples, oldest first, with header line
+         */
+        std::string toCsv() const;
+
+        /**
+         * @brief Seconds the member that ran 'replSetGetStatus' is behind primary, 
+         *        0 for primary, -1 if it cannot be determined
+         */
+        static double replicationLag(const mongo::BSONObj &replSetStatus);
+
+    private:
+        std::vector<ServerMetricsSample> _samples;
+        size_t _next = 0;
+        size_t _size = 0;
+        mongo::BSONObj _previous;
+    };
+}
@@ -0,0 +1,71 @@
+#include "gtest/gtest.h"
+#include "robomongo/core/domain/ServerMetrics.h"
+
+#include <mongo/bson/bsonobjbuilder.h>
+
+using namespace Robomongo;
+
+namespace
+{
+    mongo::BSONObj serverStatus(long long uptimeMs, long long inserts, long long bytesIn, int connections = 5)
+    {
+        return BSON("uptimeMillis" << uptimeMs << 
+                    "opcounters" << BSON("insert" << inserts << "query" << 0 << "command" << 10) <<
+                    "network" << BSON("bytesIn" << bytesIn << "bytesOut" << 0LL) <<
+                    "connections" << BSON("current" << connections) <<
+                    "wiredTiger" << BSON("cache" << BSON("bytes currently in the cache" << 100LL <<
+                                                         "maximum bytes configured" << 1000LL)));
+    }
+}
+
+TEST(server_metrics_tests, add_ComputesRatesFromDeltas)
+{
+    ServerMetrics metrics(10);
+    EXPECT_FALSE(metrics.add(serverStatus(1000, 100, 0)));
+    EXPECT_EQ(0u, metrics.size());
+
+    EXPECT_TRUE(metrics.add(serverStatus(3000, 300, 4096, 7), 1.5));
+    ASSERT_EQ(1u, metrics.size());
+
+    ServerMetricsSample const& sample = metrics.at(0);
+    EXPECT_DOUBLE_EQ(100, sample.insertsPerSec);
+    EXPECT_DOUBLE_EQ(0, sample.commandsPerSec);
+    EXPECT_DOUBLE_EQ(2048, sample.bytesInPerSec);
+    EXPECT_DOUBLE_EQ(100, sample.opsPerSec());
+    EXPECT_EQ(7, sample.connections);
+    EXPECT_EQ(100, sample.cacheUsedBytes);
+    EXPECT_EQ(1000, sample.cacheMaxBytes);
+    EXPECT_DOUBLE_EQ(1.5, sample.replicationLagSecs);
+}
+
+TEST(server_metrics_tests, add_RestartBecomesBaseline)
+{
+    ServerMetrics metrics(10);
+    metrics.add(serverStatus(5000, 500, 0));
+    EXPECT_FALSE(metrics.add(serverStatus(1000, 10, 0)));
+    EXPECT_TRUE(metrics.add(serverStatus(2000, 20, 0)));
+    EXPECT_DOUBLE_EQ(10, metrics.at(0).insertsPerSec);
+}
+
+TEST(server_metrics_tests, ringBuffer_KeepsNewestSamples)
+{
+    ServerMetrics metrics(3);
+    for (int i = 0; i <= 5; ++i)
+        metrics.add(serverStatus(1000 * (i + 1), 0, 0, i));
+
+    ASSERT_EQ(3u, metrics.size());
+    EXPECT_EQ(3, metrics.at(0).connections);
+    EXPECT_EQ(4, metrics.at(1).connections);
+    EXPECT_EQ(5, metrics.at(2).connections);
+}
+
+TEST(server_metrics_tests, replicationLag)
+{
+    auto const status = BSON("members" << BSON_ARRAY(
+        BSON("stateStr" << "PRIMARY" << "optimeDate" << mongo::Date_t::fromMillisSinceEpoch(10000)) <<
+        BSON("stateStr" << "SECONDARY" << "self" << true << 
+             "optimeDate" << mongo::Date_t::fromMillisSinceEpoch(7500))));
+
+    EXPECT_DOUBLE_EQ(2.5, ServerMetrics::replicationLag(status));
+    EXPECT_DOUBLE_EQ(-1, ServerMetrics::replicationLag(BSON("ok" << 0)));
+}
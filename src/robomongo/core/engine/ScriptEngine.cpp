@@ -156,6 +156,9 @@ namespace Robomongo
             "__robomongoAggregatePipeline = null;"
             "__robomongoAggregateOptions = null;"
             "DBCollection.prototype.aggregate = function(pipeline, options) { "
+            "   if (__robomongoMaxTimeMS > 0 && Array.isArray(pipeline) && !(options && options.maxTimeMS)) {"
+            "       options = Object.extend({ maxTimeMS: __robomongoMaxTimeMS }, options || {});"
+            "   }"
             "   __robomongoAggregateUsed = true;"
             "   __robomongoAggregatePipeline = pipeline;"
             "   __robomongoAggregateOptions = options;"
@@ -164,11 +167,65 @@ namespace Robomongo
 
         _scope->exec(aggregateInterceptor, "", false, false, false);
 
+        // Apply tab's time limit to queries, explicit cursor.maxTimeMS() called later overrides it
+        std::string const findInterceptor =
+            "__robomongoMaxTimeMS = 0;"
+            "__robomongoFind = DBCollection.prototype.find;"
+            "DBCollection.prototype.find = function() { "
+            "   var cursor = __robomongoFind.apply(this, arguments);"
+            "   if (__robomongoMaxTimeMS > 0) {"
+            "       cursor.maxTimeMS(__robomongoMaxTimeMS);"
+            "   }"
+            "   return cursor;"
+            "}";
+
+        _scope->exec(findInterceptor, "", false, false, false);
+
+        // watch() does not block the shell: it returns description of change stream, which is 
+        // opened and tailed by result view when it is the result of a statement. Cursor methods 
+        // open the stream with the original watch() on first use, so scripts can still iterate it.
+        std::string const watchInterceptor =
+            "__robomongoCollectionWatch = DBCollection.prototype.watch;"
+            "__robomongoDbWatch = DB.prototype.watch;"
+            "__RobomongoChangeStream = function(db, collectionName, pipeline, options) { "
+            "   this._db = db;"
+            "   this._collName = collectionName;"
+            "   this._pipeline = pipeline || [];"
+            "   this._options = options || {};"
+            "   this._cursor = null;"
+            "};"
+            "__RobomongoChangeStream.prototype.shellPrint = function() { "
+            "   print('Watching changes of ' + this._db.getName() + (this._collName ? '.' + this._collName : ''));"
+            "};"
+            "__RobomongoChangeStream.prototype.openCursor = function() { "
+            "   if (!this._cursor) {"
+            "       this._cursor = this._collName "
+            "           ? __robomongoCollectionWatch.call(this._db.getCollection(this._collName), this._pipeline, this._options)"
+            "           : __robomongoDbWatch.call(this._db, this._pipeline, this._options);"
+            "   }"
+            "   return this._cursor;"
+            "};"
+            "['hasNext', 'next', 'tryNext', 'forEach', 'map', 'toArray', 'itcount', 'isExhausted', 'isClosed', "
+            " 'close', 'getResumeToken', 'objsLeftInBatch'].forEach(function(method) { "
+            "   __RobomongoChangeStream.prototype[method] = function() { "
+            "       var cursor = this.openCursor();"
+            "       return cursor[method].apply(cursor, arguments);"
+            "   };"
+            "});"
+            "DBCollection.prototype.watch = function(pipeline, options) { "
+            "   return new __RobomongoChangeStream(this._db, this._shortName, pipeline, options);"
+            "};"
+            "DB.prototype.watch = function(pipeline, options) { "
+            "   return new __RobomongoChangeStream(this, '', pipeline, options);"
+            "}";
+
+        _scope->exec(watchInterceptor, "", false, false, false);
+
         _initialized = true;
     }
 
     MongoShellExecResult ScriptEngine::exec(const std::string &originalScript, const std::string &dbName, 
-                                            AggrInfo aggrInfo /* = AggrInfo() */)
+                                            AggrInfo aggrInfo /* = AggrInfo() */, int maxTimeMS /* = 0 */)
     {
         QMutexLocker lock(&_mutex);
 
@@ -177,6 +234,40 @@ namespace Robomongo
             return MongoShellExecResult(true, "Connection error. Uninitialized mongo scope.");
         }
 
+        _interrupted = false;
+        {
+            QMutexLocker interruptLock(&_interruptMutex);
+            _isExecuting = true;
+        }
+
+        MongoShellExecResult result;
+        try {
+            result = execStatements(originalScript, dbName, aggrInfo, maxTimeMS);
+        }
+        catch (...) {
+            QMutexLocker interruptLock(&_interruptMutex);
+            _isExecuting = false;
+            throw;
+        }
+
+        {
+            QMutexLocker interruptLock(&_interruptMutex);
+            _isExecuting = false;
+        }
+
+        // Killed scope refuses to run anything until it is reset, globals are kept
+        if (_interrupted) {
+            _clientAddressStale = true;
+            _scope->reset();
+            return MongoShellExecResult(true, "Script execution was stopped.");
+        }
+
+        return result;
+    }
+
+    MongoShellExecResult ScriptEngine::execStatements(const std::string &originalScript, const std::string &dbName,
+                                                      AggrInfo aggrInfo, int maxTimeMS)
+    {
         // robomongo shell timeout
         bool timeoutReached = false;
 
@@ -205,8 +296,13 @@ namespace Robomongo
         std::vector<MongoShellResult> results;
 
         use(dbName);
+        updateClientAddress();
+        _scope->setNumber("__robomongoMaxTimeMS", maxTimeMS);
 
         for (auto const& statement : statements) {
+            if (_interrupted)
+                break;
+
             // clear global objects
             __objects.clear();
             __type = "";
@@ -234,6 +330,10 @@ namespace Robomongo
                     std::string answer = logs.c_str();
                     std::string type = __type.c_str();
 
+                    // Connection is reconnected by the shell after network errors
+                    if (failed || timeoutReached)
+                        _clientAddressStale = true;
+
                     if (failed && !timeoutReached)
                         return MongoShellExecResult(true, answer);
 
@@ -255,11 +355,38 @@ namespace Robomongo
 
     void ScriptEngine::interrupt()
     {
-        // This operation crash Robomongo
-        // static_cast<mongo::mozjs::MozJSImplScope*>(_scope)->kill();
+        QMutexLocker lock(&_interruptMutex);
+
+        // Killing idle scope would fail the next script, scope is reset only after execution
+        if (!_isExecuting)
+            return;
 
-        // v0.9
-        //mongo::Scope::_interruptFlag = true;
+        _interrupted = true;
+        _scope->kill();
+    }
+
+    std::string ScriptEngine::clientAddress() const
+    {
+        QMutexLocker lock(&_interruptMutex);
+        return _clientAddress;
+    }
+
+    void ScriptEngine::updateClientAddress()
+    {
+        // Changes only when shell reconnects, which may happen after a failure
+        if (!_clientAddressStale)
+            return;
+
+        _scope->exec(
+            "__robomongoClientAddress = '';"
+            "try { __robomongoClientAddress = db.runCommand({ whatsmyuri: 1 }).you || ''; } catch (e) {}",
+            "(whatsmyuri)", false, false, false, 3000);
+
+        std::string const address = getString("__robomongoClientAddress");
+        _clientAddressStale = address.empty();
+
+        QMutexLocker lock(&_interruptMutex);
+        _clientAddress = address;
     }
 
     void ScriptEngine::use(const std::string &dbName)
@@ -295,7 +422,8 @@ namespace Robomongo
             return;
 
         QMutexLocker lock(&_mutex);
-        _scope->exec("if (db) { db.runCommand({ping:1}); }", "(ping)", false, false, false, 3000);
+        if (!_scope->exec("if (db) { db.runCommand({ping:1}); }", "(ping)", false, false, false, 3000))
+            _clientAddressStale = true;
     }
 
     QStringList ScriptEngine::complete(const std::string &prefix, const AutocompletionMode mode)
@@ -338,6 +466,7 @@ namespace Robomongo
         const char *script =
             "__robomongoQuery = false; \n"
             "__robomongoIsAggregate = false; \n"
+            "__robomongoIsChangeStream = false; \n"
             "__robomongoDbName = '[invalid database]'; \n"
             "__robomongoServerAddress = '[invalid connection]'; \n"
             "__robomongoCollectionName = '[invalid collection]'; \n"
@@ -364,11 +493,20 @@ namespace Robomongo
             "    __robomongoServerAddress = __robomongoLastRes._db._mongo.host; \n"
             "    __robomongoCollectionName = __robomongoLastRes._collName; \n"
             "} \n"
+            "else if (typeof __robomongoLastRes == 'object' && __robomongoLastRes != null \n"
+            "         && __robomongoLastRes instanceof __RobomongoChangeStream) { \n"
+            "    __robomongoIsChangeStream = true; \n"
+            "    __robomongoDbName = __robomongoLastRes._db.getName();\n "
+            "    __robomongoCollectionName = __robomongoLastRes._collName; \n"
+            "    __robomongoWatchPipeline = __robomongoLastRes._pipeline; \n"
+            "    __robomongoWatchOptions = __robomongoLastRes._options; \n"
+            "} \n"
             ;
 
         _scope->exec(script, "(getresultinfo)", false, false, false);
         bool const isQuery = _scope->getBoolean("__robomongoQuery");
         bool const isAggregate = _scope->getBoolean("__robomongoIsAggregate");
+        bool const isChangeStream = _scope->getBoolean("__robomongoIsChangeStream");
 
         if (isQuery) {
             std::string serverAddress = getString("__robomongoServerAddress");
@@ -406,6 +544,13 @@ namespace Robomongo
             AggrInfo const newAggrInfo { collectionName, skip, batchSize, origPipeline, options, resultIndex };
             return MongoShellResult(type, output, objects, MongoQueryInfo(), statement, elapsedms, newAggrInfo);
         }
+        else if (isChangeStream) {
+            ChangeStreamInfo const info { getString("__robomongoDbName"), getString("__robomongoCollectionName"),
+                                          _scope->getObject("__robomongoWatchPipeline"), 
+                                          _scope->getObject("__robomongoWatchOptions") };
+            return MongoShellResult("changeStream", output, objects, MongoQueryInfo(), statement, elapsedms, 
+                                    AggrInfo(), info);
+        }
         return MongoShellResult(type, output, objects, MongoQueryInfo(), statement, elapsedms);
     }
 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+
 #include <QObject>
 #include <QMutex>
 #include <mongo/scripting/engine.h>
@@ -21,10 +23,30 @@ namespace Robomongo
         ~ScriptEngine();
 
         void init(bool isLoadMongoJs, const std::string& serverAddr = "", const std::string& dbName = "");
+        /**
+         * @param maxTimeMS: if positive, applied to every find() and aggregate() of the script
+         *        that does not set its own limit
+         */
         MongoShellExecResult exec(const std::string &script, const std::string &dbName = std::string(),
-                                  AggrInfo aggrInfo = AggrInfo());
+                                  AggrInfo aggrInfo = AggrInfo(), int maxTimeMS = 0);
+
+        /**
+         * @brief Stops running script. Can be called from other threads, does nothing
+         *        if no script is running.
+         */
         void interrupt();
 
+        /**
+         * @brief True if the last exec() was stopped by interrupt()
+         */
+        bool interrupted() const { return _interrupted; }
+
+        /**
+         * @brief Address of the shell connection as seen by server ('whatsmyuri'), empty if unknown.
+         *        Can be called from other threads.
+         */
+        std::string clientAddress() const;
+
         void use(const std::string &dbName);
         void setBatchSize(int batchSize);
         void ping();
@@ -46,6 +68,10 @@ namespace Robomongo
         MongoShellExecResult prepareExecResult(
             const std::vector<MongoShellResult> &results, bool timeoutReached = false);
 
+        MongoShellExecResult execStatements(const std::string &script, const std::string &dbName,
+                                            AggrInfo aggrInfo, int maxTimeMS);
+        void updateClientAddress();
+
         std::string loadFile(const QString &path, bool throwOnError);
         std::string getString(const char *fieldName);
         bool statementize(
@@ -57,5 +83,15 @@ namespace Robomongo
         bool _failedScope = false;
         QMutex _mutex;
         bool _initialized;
+
+        // Guards state used by interrupt() from other threads, _mutex is held by exec()
+        mutable QMutex _interruptMutex;
+        bool _isExecuting = false;
+        std::string _clientAddress;
+
+        // Set when shell connection may have been reconnected (failed statement or ping, stopped script),
+        // address is asked again before the next execution. Guarded by _mutex.
+        bool _clientAddressStale = true;
+        std::atomic<bool> _interrupted { false };
     };
 }
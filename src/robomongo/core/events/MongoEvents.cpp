@@ -14,6 +14,7 @@ namespace Robomongo
     R_REGISTER_EVENT(LoadDatabaseNamesResponse)
     R_REGISTER_EVENT(LoadCollectionNamesRequest)
     R_REGISTER_EVENT(LoadCollectionNamesResponse)
+    R_REGISTER_EVENT(CollectionStatsLoadedEvent)
     R_REGISTER_EVENT(LoadUsersRequest)
     R_REGISTER_EVENT(LoadCollectionIndexesRequest)
     R_REGISTER_EVENT(LoadCollectionIndexesResponse)
@@ -29,8 +30,13 @@ namespace Robomongo
     R_REGISTER_EVENT(ConnectionEstablishedEvent)
     R_REGISTER_EVENT(DatabaseListLoadedEvent)
     R_REGISTER_EVENT(OpeningShellEvent)
+    R_REGISTER_EVENT(OpeningServerMonitorEvent)
     R_REGISTER_EVENT(ExecuteQueryRequest)
     R_REGISTER_EVENT(ExecuteQueryResponse)
+    R_REGISTER_EVENT(ReleaseQueryCursorsRequest)
+    R_REGISTER_EVENT(ExplainQueryRequest)
+    R_REGISTER_EVENT(ExplainQueryResponse)
+    R_REGISTER_EVENT(QueryExplainedEvent)
     R_REGISTER_EVENT(DocumentListLoadedEvent)
     R_REGISTER_EVENT(ExecuteScriptRequest)
     R_REGISTER_EVENT(ExecuteScriptResponse)
@@ -40,6 +46,8 @@ namespace Robomongo
     R_REGISTER_EVENT(ScriptExecutingEvent)
     R_REGISTER_EVENT(InsertDocumentRequest)
     R_REGISTER_EVENT(InsertDocumentResponse)
+    R_REGISTER_EVENT(BulkWriteRequest)
+    R_REGISTER_EVENT(BulkWriteResponse)
     R_REGISTER_EVENT(RemoveDocumentRequest)
     R_REGISTER_EVENT(RemoveDocumentResponse)
     R_REGISTER_EVENT(CreateDatabaseRequest)
@@ -56,6 +64,28 @@ namespace Robomongo
     R_REGISTER_EVENT(DuplicateCollectionResponse)
     R_REGISTER_EVENT(CopyCollectionToDiffServerRequest)
     R_REGISTER_EVENT(CopyCollectionToDiffServerResponse)
+    R_REGISTER_EVENT(CopyCollectionProgressEvent)
+    R_REGISTER_EVENT(ProfilingLevelRequest)
+    R_REGISTER_EVENT(ProfilingLevelResponse)
+    R_REGISTER_EVENT(AnalyzeProfileRequest)
+    R_REGISTER_EVENT(ProfileAnalyzedEvent)
+    R_REGISTER_EVENT(AdviseIndexesRequest)
+    R_REGISTER_EVENT(AdviseIndexesResponse)
+    R_REGISTER_EVENT(AnalyzeSchemaRequest)
+    R_REGISTER_EVENT(SchemaAnalyzedEvent)
+    R_REGISTER_EVENT(PreviewPipelineRequest)
+    R_REGISTER_EVENT(PipelineStagePreviewEvent)
+    R_REGISTER_EVENT(PipelineExplainedEvent)
+    R_REGISTER_EVENT(CurrentOpsRequest)
+    R_REGISTER_EVENT(CurrentOpsResponse)
+    R_REGISTER_EVENT(KillOpRequest)
+    R_REGISTER_EVENT(KillOpResponse)
+    R_REGISTER_EVENT(ServerStatusRequest)
+    R_REGISTER_EVENT(ServerStatusResponse)
+    R_REGISTER_EVENT(WatchChangesRequest)
+    R_REGISTER_EVENT(ChangeStreamGetMoreRequest)
+    R_REGISTER_EVENT(CloseChangeStreamRequest)
+    R_REGISTER_EVENT(ChangeStreamResponse)
     R_REGISTER_EVENT(CreateUserRequest)
     R_REGISTER_EVENT(CreateUserResponse)
     R_REGISTER_EVENT(DropUserRequest)
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <atomic>
+#include <memory>
+
 #include <QMessageBox>
 #include <QString>
 #include <QStringList>
@@ -210,6 +213,25 @@ namespace Robomongo
         std::vector<MongoCollectionInfo> _collectionInfos;
     };
 
+    /**
+     * @brief Statistics of some collections of 'databaseName', published in batches
+     *        after LoadCollectionNamesResponse.
+     */
+    class CollectionStatsLoadedEvent : public Event
+    {
+        R_EVENT
+
+    public:
+        CollectionStatsLoadedEvent(QObject *sender, const std::string &databaseName,
+                                   const std::vector<MongoCollectionInfo> &collectionInfos) :
+            Event(sender),
+            databaseName(databaseName),
+            collectionInfos(collectionInfos) {}
+
+        std::string const databaseName;
+        std::vector<MongoCollectionInfo> const collectionInfos;
+    };
+
     class LoadCollectionIndexesRequest : public Event
     {
         R_EVENT
@@ -427,6 +449,59 @@ namespace Robomongo
             Event(sender, error) {}
     };
 
+    /**
+     * @brief BulkWrite: inserts (or saves, if 'overwrite' is set) many documents with
+     *        a few write commands and replies with single aggregated result
+     */
+
+    class BulkWriteRequest : public Event
+    {
+        R_EVENT
+
+    public:
+        BulkWriteRequest(QObject *sender, const std::vector<mongo::BSONObj> &docs, const MongoNamespace &ns, 
+                         bool overwrite = false, bool ordered = true) :
+            Event(sender),
+            _docs(docs),
+            _ns(ns),
+            _overwrite(overwrite),
+            _ordered(ordered) {}
+
+        std::vector<mongo::BSONObj> const& docs() const { return _docs; }
+        MongoNamespace ns() const { return _ns; }
+        bool overwrite() const { return _overwrite; }
+        bool ordered() const { return _ordered; }
+
+    private:
+        std::vector<mongo::BSONObj> const _docs;
+        const MongoNamespace _ns;
+        bool _overwrite;
+        bool _ordered;
+    };
+
+    class BulkWriteResponse : public Event
+    {
+        R_EVENT
+
+    public:
+        BulkWriteResponse(QObject *sender, const BulkWriteResult &result, int nDocs, bool overwrite) :
+            Event(sender),
+            result(result),
+            nDocs(nDocs),
+            overwrite(overwrite) {}
+
+        BulkWriteResponse(QObject *sender, const BulkWriteResult &result, int nDocs, bool overwrite, 
+                          EventError const& error) :
+            Event(sender, error),
+            result(result),
+            nDocs(nDocs),
+            overwrite(overwrite) {}
+
+        BulkWriteResult const result;
+        int const nDocs;
+        bool const overwrite;
+    };
+
     /**
      * @brief Remove Document
      */
@@ -698,20 +773,46 @@ namespace Robomongo
         R_EVENT
 
     public:
-        CopyCollectionToDiffServerRequest(QObject *sender, MongoWorker *worker, const std::string &databaseFrom,
-            const std::string &collection, const std::string &databaseTo) :
+        /**
+         * @param source: copy of connection settings of the source server, read on the thread of target worker
+         * @param cancelled: set by the requester to stop the copy
+         */
+        CopyCollectionToDiffServerRequest(QObject *sender, const std::shared_ptr<ConnectionSettings> &source, 
+            const std::string &databaseFrom, const std::string &collection, const std::string &databaseTo, 
+            const std::shared_ptr<std::atomic<bool>> &cancelled, int readers = 1, int writers = 1) :
         Event(sender),
-            _worker(worker),
+            _source(source),
             _from(databaseFrom, collection),
-            _to(databaseTo, collection) {}
+            _to(databaseTo, collection),
+            _cancelled(cancelled),
+            _readers(readers),
+            _writers(writers) {}
 
-        MongoWorker *worker() const { return _worker; }
+        std::shared_ptr<ConnectionSettings> source() const { return _source; }
         MongoNamespace from() const { return _from; }
         MongoNamespace to() const { return _to; }
+        std::shared_ptr<std::atomic<bool>> cancelled() const { return _cancelled; }
+        int readers() const { return _readers; }
+        int writers() const { return _writers; }
     private:
-        MongoWorker *_worker;
+        std::shared_ptr<ConnectionSettings> const _source;
         const MongoNamespace _from;
         const MongoNamespace _to;
+        std::shared_ptr<std::atomic<bool>> const _cancelled;
+        int const _readers;
+        int const _writers;
+    };
+
+    class CopyCollectionProgressEvent : public Event
+    {
+        R_EVENT
+
+    public:
+        CopyCollectionProgressEvent(QObject *sender, const CollectionCopyProgress &progress) :
+            Event(sender),
+            progress(progress) {}
+
+        CollectionCopyProgress const progress;
     };
 
     class CopyCollectionToDiffServerResponse : public Event
@@ -719,11 +820,390 @@ namespace Robomongo
         R_EVENT
 
     public:
-        CopyCollectionToDiffServerResponse(QObject *sender) :
-            Event(sender) {}
+        CopyCollectionToDiffServerResponse(QObject *sender, const CollectionCopyProgress &result) :
+            Event(sender),
+            result(result) {}
 
         CopyCollectionToDiffServerResponse(QObject *sender, const EventError &error) :
             Event(sender, error) {}
+
+        CollectionCopyProgress const result;
+    };
+
+    /**
+     * @brief Sets profiling level of database 'databaseName', or only reads it if 'level' is -1
+     */
+    class ProfilingLevelRequest : public Event
+    {
+        R_EVENT
+
+    public:
+        ProfilingLevelRequest(QObject *sender, const std::string &databaseName, int level = -1, int slowMs = 100) :
+            Event(sender),
+            databaseName(databaseName),
+            level(level),
+            slowMs(slowMs) {}
+
+        std::string const databaseName;
+        int const level;
+        int const slowMs;
+    };
+
+    class ProfilingLevelResponse : public Event
+    {
+        R_EVENT
+
+    public:
+        ProfilingLevelResponse(QObject *sender, int level, int slowMs) :
+            Event(sender),
+            level(level),
+            slowMs(slowMs) {}
+
+        ProfilingLevelResponse(QObject *sender, const EventError &error) :
+            Event(sender, error) {}
+
+        int const level = 0;
+        int const slowMs = 0;
+    };
+
+    /**
+     * @brief Reads up to 'maxEntries' newest documents of 'system.profile' collection of 
+     *        database 'databaseName' and groups them by query shape
+     */
+    class AnalyzeProfileRequest : public Event
+    {
+        R_EVENT
+
+    public:
+        AnalyzeProfileRequest(QObject *sender, const std::string &databaseName, int maxEntries) :
+            Event(sender),
+            databaseName(databaseName),
+            maxEntries(maxEntries) {}
+
+        std::string const databaseName;
+        int const maxEntries;
+    };
+
+    /**
+     * @brief Statistics of entries analyzed so far, replied periodically while 
+     *        'system.profile' is read and once more with 'finished' set
+     */
+    class ProfileAnalyzedEvent : public Event
+    {
+        R_EVENT
+
+    public:
+        ProfileAnalyzedEvent(QObject *sender, long long entries, const std::vector<ProfileShapeStats> &shapes,
+                             bool finished) :
+            Event(sender),
+            entries(entries),
+            shapes(shapes),
+            finished(finished) {}
+
+        ProfileAnalyzedEvent(QObject *sender, const EventError &error) :
+            Event(sender, error) {}
+
+        long long const entries = 0;
+        std::vector<ProfileShapeStats> const shapes;
+        bool const finished = true;
+    };
+
+    /**
+     * @brief Suggests indexes for up to 'maxEntries' newest 'system.profile' entries of database
+     *        'databaseName' and flags redundant and unused indexes of its collections
+     */
+    class AdviseIndexesRequest : public Event
+    {
+        R_EVENT
+
+    public:
+        AdviseIndexesRequest(QObject *sender, const std::string &databaseName, int maxEntries) :
+            Event(sender),
+            databaseName(databaseName),
+            maxEntries(maxEntries) {}
+
+        std::string const databaseName;
+        int const maxEntries;
+    };
+
+    class AdviseIndexesResponse : public Event
+    {
+        R_EVENT
+
+    public:
+        AdviseIndexesResponse(QObject *sender, const std::vector<IndexAdvice> &advice) :
+            Event(sender),
+            advice(advice) {}
+
+        AdviseIndexesResponse(QObject *sender, const EventError &error) :
+            Event(sender, error) {}
+
+        std::vector<IndexAdvice> const advice;
+    };
+
+    /**
+     * @brief Infers fields of collection 'ns' from 'sampleSize' random documents
+     */
+    class AnalyzeSchemaRequest : public Event
+    {
+        R_EVENT
+
+    public:
+        AnalyzeSchemaRequest(QObject *sender, const MongoNamespace &ns, int sampleSize) :
+            Event(sender),
+            ns(ns),
+            sampleSize(sampleSize) {}
+
+        MongoNamespace const ns;
+        int const sampleSize;
+    };
+
+    class SchemaAnalyzedEvent : public Event
+    {
+        R_EVENT
+
+    public:
+        SchemaAnalyzedEvent(QObject *sender, const CollectionSchema &schema) :
+            Event(sender),
+            ns(schema.ns),
+            schema(schema) {}
+
+        SchemaAnalyzedEvent(QObject *sender, const std::string &ns, const EventError &error) :
+            Event(sender, error),
+            ns(ns) {}
+
+        std::string const ns;
+        CollectionSchema const schema;
+    };
+
+    /**
+     * @brief Runs each of 'prefixes' pipelines on collection 'ns', replying with PipelineStagePreviewEvent 
+     *        for every one of them, then explains 'explainPipeline' and replies with PipelineExplainedEvent
+     */
+    class PreviewPipelineRequest : public Event
+    {
+        R_EVENT
+
+    public:
+        PreviewPipelineRequest(QObject *sender, const MongoNamespace &ns, const std::vector<mongo::BSONObj> &prefixes,
+                               const mongo::BSONObj &explainPipeline) :
+            Event(sender),
+            ns(ns),
+            prefixes(prefixes),
+            explainPipeline(explainPipeline) {}
+
+        MongoNamespace const ns;
+        std::vector<mongo::BSONObj> const prefixes;
+        mongo::BSONObj const explainPipeline;
+    };
+
+    class PipelineStagePreviewEvent : public Event
+    {
+        R_EVENT
+
+    public:
+        PipelineStagePreviewEvent(QObject *sender, const std::string &ns, const mongo::BSONObj &pipeline,
+                                  const std::vector<mongo::BSONObj> &documents, qint64 elapsedMs) :
+            Event(sender),
+            ns(ns),
+            pipeline(pipeline),
+            documents(documents),
+            elapsedMs(elapsedMs) {}
+
+        PipelineStagePreviewEvent(QObject *sender, const std::string &ns, const mongo::BSONObj &pipeline,
+                                  const EventError &error) :
+            Event(sender, error),
+            ns(ns),
+            pipeline(pipeline) {}
+
+        std::string const ns;
+        mongo::BSONObj const pipeline;
+        std::vector<mongo::BSONObj> const documents;
+        qint64 const elapsedMs = 0;
+    };
+
+    class PipelineExplainedEvent : public Event
+    {
+        R_EVENT
+
+    public:
+        PipelineExplainedEvent(QObject *sender, const std::string &ns, const mongo::BSONObj &pipeline,
+                               const mongo::BSONObj &explain) :
+            Event(sender),
+            ns(ns),
+            pipeline(pipeline),
+            explain(explain) {}
+
+        PipelineExplainedEvent(QObject *sender, const std::string &ns, const mongo::BSONObj &pipeline,
+                               const EventError &error) :
+            Event(sender, error),
+            ns(ns),
+            pipeline(pipeline) {}
+
+        std::string const ns;
+        mongo::BSONObj const pipeline;
+        mongo::BSONObj const explain;
+    };
+
+    /**
+     * @brief Lists operations in progress of all users (currentOp) with fields shown by monitor
+     */
+    class CurrentOpsRequest : public Event
+    {
+        R_EVENT
+
+    public:
+        CurrentOpsRequest(QObject *sender) :
+            Event(sender) {}
+    };
+
+    class CurrentOpsResponse : public Event
+    {
+        R_EVENT
+
+    public:
+        CurrentOpsResponse(QObject *sender, const std::vector<mongo::BSONObj> &ops) :
+            Event(sender),
+            ops(ops) {}
+
+        CurrentOpsResponse(QObject *sender, const EventError &error) :
+            Event(sender, error) {}
+
+        std::vector<mongo::BSONObj> const ops;
+    };
+
+    /**
+     * @brief Kills operation, 'op' is currentOp document of the operation
+     */
+    class KillOpRequest : public Event
+    {
+        R_EVENT
+
+    public:
+        KillOpRequest(QObject *sender, const mongo::BSONObj &op) :
+            Event(sender),
+            op(op) {}
+
+        mongo::BSONObj const op;
+    };
+
+    /**
+     * @brief Samples serverStatus and, on replica set members, replication lag
+     */
+    class ServerStatusRequest : public Event
+    {
+        R_EVENT
+
+    public:
+        ServerStatusRequest(QObject *sender) :
+            Event(sender) {}
+    };
+
+    class ServerStatusResponse : public Event
+    {
+        R_EVENT
+
+    public:
+        ServerStatusResponse(QObject *sender, const mongo::BSONObj &status, double replicationLagSecs) :
+            Event(sender),
+            status(status),
+            replicationLagSecs(replicationLagSecs) {}
+
+        ServerStatusResponse(QObject *sender, const EventError &error) :
+            Event(sender, error) {}
+
+        mongo::BSONObj const status;
+        double const replicationLagSecs = -1;
+    };
+
+    /**
+     * @brief Opens change stream 'pipeline' on collection 'ns' (on database, if collection name 
+     *        is empty). 'watchId' tells which view the stream belongs to.
+     */
+    class WatchChangesRequest : public Event
+    {
+        R_EVENT
+
+    public:
+        WatchChangesRequest(QObject *sender, int watchId, const MongoNamespace &ns, 
+                            const mongo::BSONObj &pipeline) :
+            Event(sender),
+            watchId(watchId),
+            ns(ns),
+            pipeline(pipeline) {}
+
+        int const watchId;
+        MongoNamespace const ns;
+        mongo::BSONObj const pipeline;
+    };
+
+    /**
+     * @brief Waits for next events of change stream opened by WatchChangesRequest
+     */
+    class ChangeStreamGetMoreRequest : public Event
+    {
+        R_EVENT
+
+    public:
+        ChangeStreamGetMoreRequest(QObject *sender, int watchId, const MongoNamespace &ns, 
+                                   long long cursorId) :
+            Event(sender),
+            watchId(watchId),
+            ns(ns),
+            cursorId(cursorId) {}
+
+        int const watchId;
+        MongoNamespace const ns;
+        long long const cursorId;
+    };
+
+    /**
+     * @brief Kills cursor of change stream 'watchId'. Sent also while WatchChangesRequest is
+     *        in flight: worker handles it after the watch, when the cursor is known.
+     */
+    class CloseChangeStreamRequest : public Event
+    {
+        R_EVENT
+
+    public:
+        CloseChangeStreamRequest(QObject *sender, int watchId) :
+            Event(sender),
+            watchId(watchId) {}
+
+        int const watchId;
+    };
+
+    class ChangeStreamResponse : public Event
+    {
+        R_EVENT
+
+    public:
+        ChangeStreamResponse(QObject *sender, int watchId, const ChangeStreamBatch &batch) :
+            Event(sender),
+            watchId(watchId),
+            batch(batch) {}
+
+        ChangeStreamResponse(QObject *sender, int watchId, const EventError &error) :
+            Event(sender, error),
+            watchId(watchId) {}
+
+        int const watchId;
+        ChangeStreamBatch const batch;
+    };
+
+    class KillOpResponse : public Event
+    {
+        R_EVENT
+
+    public:
+        KillOpResponse(QObject *sender, const mongo::BSONObj &op) :
+            Event(sender),
+            op(op) {}
+
+        KillOpResponse(QObject *sender, const EventError &error) :
+            Event(sender, error) {}
+
+        mongo::BSONObj const op;
     };
 
     /**
@@ -892,28 +1372,83 @@ namespace Robomongo
         R_EVENT
 
     public:
-        ExecuteQueryRequest(QObject *sender, int resultIndex, const MongoQueryInfo &queryInfo) :
+        ExecuteQueryRequest(QObject *sender, int resultIndex, const MongoQueryInfo &queryInfo, 
+                            bool streamed = false) :
             Event(sender),
             _resultIndex(resultIndex),
-            _queryInfo(queryInfo) {}
+            _queryInfo(queryInfo),
+            _streamed(streamed) {}
 
         int resultIndex() const { return _resultIndex; }
         MongoQueryInfo queryInfo() const { return _queryInfo; }
+        bool streamed() const { return _streamed; }
 
     private:
         int _resultIndex; //external user data;
         MongoQueryInfo _queryInfo;
+        // If true, every server batch is replied as a separate ExecuteQueryResponse chunk
+        bool _streamed;
+    };
+
+    /**
+     * @brief Kills query cursors cached for paging of 'sender' results, 
+     *        sent when results are replaced by a new script execution
+     */
+    class ReleaseQueryCursorsRequest : public Event
+    {
+        R_EVENT
+
+        ReleaseQueryCursorsRequest(QObject *sender) :
+            Event(sender) {}
+    };
+
+    /**
+     * @brief Runs find described by 'queryInfo' or, if it is not valid, aggregation described
+     *        by 'aggrInfo' on database 'databaseName' with explain("executionStats")
+     */
+    class ExplainQueryRequest : public Event
+    {
+        R_EVENT
+
+        ExplainQueryRequest(QObject *sender, const std::string &databaseName, const MongoQueryInfo &queryInfo,
+                            const AggrInfo &aggrInfo) :
+            Event(sender),
+            databaseName(databaseName),
+            queryInfo(queryInfo),
+            aggrInfo(aggrInfo) {}
+
+        std::string const databaseName;
+        MongoQueryInfo const queryInfo;
+        AggrInfo const aggrInfo;
+    };
+
+    class ExplainQueryResponse : public Event
+    {
+        R_EVENT
+
+        ExplainQueryResponse(QObject *sender, const mongo::BSONObj &explain, qint64 elapsedMs) :
+            Event(sender), explain(explain), elapsedMs(elapsedMs) {}
+
+        ExplainQueryResponse(QObject *sender, const EventError &error) :
+            Event(sender, error) {}
+
+        mongo::BSONObj explain;
+        qint64 elapsedMs = 0;
     };
 
     class ExecuteQueryResponse : public Event
     {
         R_EVENT
 
-        ExecuteQueryResponse(QObject *sender, int resultIndex, const MongoQueryInfo &queryInfo, const std::vector<MongoDocumentPtr> &documents) :
+        ExecuteQueryResponse(QObject *sender, int resultIndex, const MongoQueryInfo &queryInfo, 
+                             const std::vector<MongoDocumentPtr> &documents, 
+                             bool firstChunk = true, bool lastChunk = true) :
             Event(sender),
             resultIndex(resultIndex),
             queryInfo(queryInfo),
-            documents(documents) { }
+            documents(documents),
+            firstChunk(firstChunk),
+            lastChunk(lastChunk) { }
 
         ExecuteQueryResponse(QObject *sender, const EventError &error) :
             Event(sender, error) {}
@@ -921,6 +1456,9 @@ namespace Robomongo
         int resultIndex;
         MongoQueryInfo queryInfo;
         std::vector<MongoDocumentPtr> documents;
+        // Non-streamed responses are always both the first and the last chunk
+        bool firstChunk = true;
+        bool lastChunk = true;
     };
 
     class AutocompleteRequest : public Event
@@ -962,11 +1500,12 @@ namespace Robomongo
         R_EVENT
 
         ExecuteScriptRequest(QObject *sender, const std::string &script, const std::string &dbName, 
-                             AggrInfo aggrInfo = AggrInfo(), int take = 0, int skip = 0) :
+                             AggrInfo aggrInfo = AggrInfo(), int maxTimeMS = 0, int take = 0, int skip = 0) :
             Event(sender),
             script(script),
             databaseName(dbName),
             aggrInfo(aggrInfo),
+            maxTimeMS(maxTimeMS),
             take(take),
             skip(skip)
             {}
@@ -976,6 +1515,7 @@ namespace Robomongo
         int take; //
         int skip;
         AggrInfo const aggrInfo;
+        int const maxTimeMS;    // time limit of queries issued by the script, 0 for no limit
     };
 
     class ExecuteScriptResponse : public Event
@@ -1015,6 +1555,20 @@ namespace Robomongo
         MongoShell *shell;
     };
 
+    /**
+     * @brief Server Monitor tab of 'server' is requested
+     */
+    class OpeningServerMonitorEvent : public Event
+    {
+        R_EVENT
+
+        OpeningServerMonitorEvent(QObject *sender, MongoServer *server) :
+            Event(sender),
+            server(server) {}
+
+        MongoServer *server;
+    };
+
     class ConnectionFailedEvent : public Event
     {
         R_EVENT
@@ -1072,17 +1626,37 @@ namespace Robomongo
         QList<MongoDatabase *> list;
     };
 
+    /**
+     * @brief Explain output of query of shell 'sender' is ready
+     */
+    class QueryExplainedEvent : public Event
+    {
+        R_EVENT
+
+        QueryExplainedEvent(QObject *sender, const mongo::BSONObj &explain, qint64 elapsedMs) :
+            Event(sender), explain(explain), elapsedMs(elapsedMs) {}
+
+        QueryExplainedEvent(QObject *sender, const EventError &error) :
+            Event(sender, error) {}
+
+        mongo::BSONObj explain;
+        qint64 elapsedMs = 0;
+    };
+
     class DocumentListLoadedEvent : public Event
     {
         R_EVENT
 
     public:
-        DocumentListLoadedEvent(QObject *sender, int resultIndex, const MongoQueryInfo &queryInfo, const std::string &query, const std::vector<MongoDocumentPtr> &docs) :
+        DocumentListLoadedEvent(QObject *sender, int resultIndex, const MongoQueryInfo &queryInfo, const std::string &query, const std::vector<MongoDocumentPtr> &docs,
+                                bool firstChunk = true, bool lastChunk = true) :
             Event(sender),
             _resultIndex(resultIndex),
             _queryInfo(queryInfo),
             _query(query),
-            _documents(docs) { }
+            _documents(docs),
+            _firstChunk(firstChunk),
+            _lastChunk(lastChunk) { }
 
         DocumentListLoadedEvent(QObject *sender, const EventError &error) :
             Event(sender, error) {}
@@ -1091,12 +1665,16 @@ namespace Robomongo
         MongoQueryInfo queryInfo() const { return _queryInfo; }
         std::vector<MongoDocumentPtr> documents() const { return _documents; }
         std::string query() const { return _query; }
+        bool firstChunk() const { return _firstChunk; }
+        bool lastChunk() const { return _lastChunk; }
 
     private:
         int _resultIndex;
         MongoQueryInfo _queryInfo;
         std::vector<MongoDocumentPtr> _documents;
         std::string _query;
+        bool _firstChunk = true;
+        bool _lastChunk = true;
     };
 
     class ScriptExecutedEvent : public Event
@@ -1295,11 +1873,17 @@ namespace Robomongo
         bool const informUser = false;
     };
 
+    /**
+     * @brief Stops script running in 'scriptWorker'. Handled by a worker of another lane,
+     *        because script worker is busy running the script.
+     */
     class StopScriptRequest : public Event
     {
     R_EVENT
 
-        StopScriptRequest(QObject *sender) :
-            Event(sender) {}
+        StopScriptRequest(QObject *sender, MongoWorker *scriptWorker) :
+            Event(sender), scriptWorker(scriptWorker) {}
+
+        MongoWorker *const scriptWorker;
     };
 }
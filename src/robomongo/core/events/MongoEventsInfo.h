@@ -1,5 +1,8 @@
 #pragma once
 #include <string>
+#include <utility>
+#include <vector>
+#include <mongo/bson/timestamp.h>
 #include "robomongo/core/domain/MongoCollectionInfo.h"
 
 namespace Robomongo
@@ -43,4 +46,112 @@ namespace Robomongo
         const std::string _storageEngineType;
         std::string const _uuid;
     };
+
+    struct CollectionCopyProgress
+    {
+        long long docsTotal = 0;    // estimated number of documents in the source collection
+        long long docsCopied = 0;
+        long long docsSkipped = 0;  // documents with _id already present in the target collection
+        long long bytesCopied = 0;
+        double docsPerSec = 0;
+        double mbPerSec = 0;
+        int etaSec = -1;            // -1 if unknown
+        bool indexing = false;      // documents are loaded, indexes are being created
+    };
+
+    /**
+     * @brief Statistics of profiled operations of the same query shape
+     */
+    struct ProfileShapeStats
+    {
+        std::string shape;          // command with literal values replaced by '?'
+        std::string op;             // "query", "update", "command" etc.
+        std::string ns;
+        std::string planSummary;    // most frequent plan summary of the shape
+        long long count = 0;
+        long long p50Millis = 0;
+        long long p95Millis = 0;
+        long long maxMillis = 0;
+        long long totalMillis = 0;
+        long long docsExamined = 0;
+        long long nReturned = 0;
+
+        /**
+         * @brief Documents examined per returned document, -1 if nothing was examined nor returned
+         */
+        double examinedPerReturned() const
+        {
+            if (docsExamined == 0 && nReturned == 0)
+                return -1;
+
+            return static_cast<double>(docsExamined) / (nReturned > 0 ? nReturned : 1);
+        }
+    };
+
+    /**
+     * @brief Index suggested for profiled queries, or existing index that may be dropped
+     */
+    struct IndexAdvice
+    {
+        enum Kind { Create, Redundant, Unused };
+
+        Kind kind = Create;
+        std::string ns;
+        std::string indexName;      // existing index, empty for Create
+        mongo::BSONObj keys;        // suggested or existing key pattern
+        std::string reason;
+        long long queries = 0;      // profiled operations that would use suggested index
+        long long totalMillis = 0;  // their total execution time
+    };
+
+    /**
+     * @brief Statistics of one field path over sampled documents of a collection
+     */
+    struct SchemaFieldStats
+    {
+        std::string path;           // dotted path, fields of documents inside arrays included
+        std::vector<std::pair<std::string, long long>> types;  // type name and count, most frequent first
+        long long documents = 0;    // sampled documents having the path
+        double presence = 0;        // 'documents' / sampled documents
+        long long distinctValues = 0;   // estimated number of distinct scalar values
+        mongo::BSONObj minMax;      // { min: <value>, max: <value> } of scalar values, empty if none
+        long long arrays = 0;       // number of array values
+        long long minArrayLength = 0;
+        long long maxArrayLength = 0;
+        double avgArrayLength = 0;
+    };
+
+    /**
+     * @brief Fields inferred from a random sample of documents of collection 'ns'
+     */
+    struct CollectionSchema
+    {
+        std::string ns;
+        long long sampledDocuments = 0;
+        std::vector<SchemaFieldStats> fields;   // in order of first appearance, parents before children
+    };
+
+    /**
+     * @brief Batch of change stream cursor. Cursor id is 0 if stream was closed by server.
+     */
+    struct ChangeStreamBatch
+    {
+        long long cursorId = 0;
+        std::vector<mongo::BSONObj> events;
+        mongo::BSONObj resumeToken;     // postBatchResumeToken, empty if server does not report it
+        mongo::Timestamp operationTime; // Of the reply that opened the stream, null for getMore replies
+    };
+
+    struct BulkWriteResult
+    {
+        struct WriteError
+        {
+            int index;  // index of the failed document in the request
+            int code;
+            std::string message;
+        };
+
+        int nWritten = 0;   // inserted, replaced or upserted documents
+        std::vector<WriteError> writeErrors;
+    };
 }
@@ -0,0 +1,362 @@
+#include "robomongo/core/mongodb/CollectionCopier.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#include <mongo/client/dbclient_cursor.h>
+
+#include "robomongo/core/mongodb/MongoClient.h"
+
+namespace
+{
+    // Batch taken by a writer at once, bulkWrite() splits it further if needed
+    size_t const COPY_BATCH_DOCS = 1000;
+    int const COPY_BATCH_BYTES = 8 * 1024 * 1024;
+
+    // Batches read ahead per writer, limits memory used when target is slower than source
+    size_t const COPY_QUEUE_BATCHES_PER_WRITER = 2;
+
+    std::chrono::milliseconds const COPY_PROGRESS_INTERVAL { 500 };
+
+    // Write error code of documents with _id (or other unique key) already present in target
+    int const DUPLICATE_KEY_ERROR = 11000;
+}
+
+namespace Robomongo
+{
+    CollectionCopier::CollectionCopier(ConnectionFactory const& openSource, ConnectionFactory const& openTarget,
+                                       MongoNamespace const& from, MongoNamespace const& to,
+                                       int readers, int writers, mongo::BSONObj const& writeConcern,
+                                       std::shared_ptr<std::atomic<bool>> const& cancelled) :
+        _openSource(openSource),
+        _openTarget(openTarget),
+        _from(from),
+        _to(to),
+        _readers(std::max(readers, 1)),
+        _writers(std::max(writers, 1)),
+        _writeConcern(writeConcern),
+        _cancelled(cancelled)
+    {}
+
+    CollectionCopyProgress CollectionCopier::run(ProgressHandler const& onProgress)
+    {
+        // All connections are opened upfront from this thread, the factories are not thread safe
+        std::unique_ptr<mongo::DBClientBase> source = _openSource();
+        std::unique_ptr<mongo::DBClientBase> target = _openTarget();
+
+        MongoClient sourceClient(source.get());
+        MongoClient targetClient(target.get(), _writeConcern);
+
+        mongo::BSONObj const sourceInfo = sourceClient.getCollectionInfo(_from);
+        if (std::string(sourceInfo.getStringField("type")) == "view")
+            throw std::runtime_error("Views cannot be copied.");
+
+        if (!target->exists(_to.toString()))
+            targetClient.createCollectionLike(_to, sourceInfo);
+
+        long long const docsTotal = countDocuments(source.get());
+        std::vector<mongo::BSONObj> const ranges = idRanges(source.get(), docsTotal);
+
+        std::vector<std::unique_ptr<mongo::DBClientBase>> connections;
+        std::vector<mongo::DBClientBase*> readerConnections { source.get() };
+        for (size_t i = 1; i < ranges.size(); ++i) {
+            connections.push_back(_openSource());
+            readerConnections.push_back(connections.back().get());
+        }
+
+        std::vector<mongo::DBClientBase*> writerConnections { target.get() };
+        for (int i = 1; i < _writers; ++i) {
+            connections.push_back(_openTarget());
+            writerConnections.push_back(connections.back().get());
+        }
+
+        _activeReaders = static_cast<int>(ranges.size());
+        _activeWriters = _writers;
+
+        // Threads are stopped and joined however run() is left, a joinable std::thread terminates the app
+        std::vector<std::thread> threads;
+        struct ThreadsJoiner
+        {
+            CollectionCopier *copier;
+            std::vector<std::thread> *threads;
+            ~ThreadsJoiner() { copier->stopAndJoin(*threads); }
+        } const joiner { this, &threads };
+
+        for (size_t i = 0; i < ranges.size(); ++i)
+            threads.emplace_back(&CollectionCopier::read, this, readerConnections[i], ranges[i]);
+
+        for (auto const& writerConnection : writerConnections)
+            threads.emplace_back(&CollectionCopier::write, this, writerConnection);
+
+        // Report progress until all writers are done
+        auto const started = std::chrono::steady_clock::now();
+        auto const elapsedSec = [&started]() {
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+        };
+
+        bool done = false;
+        while (!done) {
+            bool failed = false;
+            {
+                std::unique_lock<std::mutex> lock(_queueMutex);
+                done = _queueChanged.wait_for(lock, COPY_PROGRESS_INTERVAL, [this]() {
+                    return _activeWriters == 0;
+                });
+                failed = _failed;
+            }
+
+            // Readers and writers blocked on the queue are woken up by fail()
+            if (!failed && cancelled())
+                fail(std::make_exception_ptr(std::runtime_error("Copy was cancelled.")));
+
+            if (onProgress && !failed)
+                onProgress(progress(elapsedSec(), docsTotal));
+        }
+
+        stopAndJoin(threads);
+
+        if (_error)
+            std::rethrow_exception(_error);
+
+        throwIfCancelled();
+
+        // Indexes are built after documents are loaded, as it is faster than maintaining them on insert
+        CollectionCopyProgress result = progress(elapsedSec(), docsTotal);
+        result.indexing = true;
+        if (onProgress)
+            onProgress(result);
+
+        targetClient.createIndexes(_to, sourceClient.getIndexSpecs(_from));
+
+        result.indexing = false;
+        return result;
+    }
+
+    void CollectionCopier::stopAndJoin(std::vector<std::thread> &threads)
+    {
+        {
+            // Readers and writers still running give up at their next batch
+            std::lock_guard<std::mutex> lock(_queueMutex);
+            if (_activeReaders > 0 || _activeWriters > 0)
+                _failed = true;
+            _queueChanged.notify_all();
+        }
+
+        for (auto &thread : threads) {
+            if (thread.joinable())
+                thread.join();
+        }
+    }
+
+    bool CollectionCopier::cancelled() const
+    {
+        return _cancelled && *_cancelled;
+    }
+
+    void CollectionCopier::throwIfCancelled() const
+    {
+        if (cancelled())
+            throw std::runtime_error("Copy was cancelled.");
+    }
+
+    long long CollectionCopier::countDocuments(mongo::DBClientBase *source) const
+    {
+        // Count from collection metadata, used only for progress and range split
+        mongo::BSONObj result;
+        if (!source->runCommand(_from.databaseName(), BSON("count" << _from.collectionName()), result))
+            return 0;
+
+        return result.getField("n").numberLong();
+    }
+
+    std::vector<mongo::BSONObj> CollectionCopier::idRanges(mongo::DBClientBase *source, long long docsTotal) const
+    {
+        std::vector<mongo::BSONObj> const wholeCollection { mongo::BSONObj() };
+        if (_readers < 2 || docsTotal < static_cast<long long>(_readers * COPY_BATCH_DOCS))
+            return wholeCollection;
+
+        // Range predicates match values of single BSON type only: split only if the lowest
+        // and the highest _id (and so all _ids between them) are of the same type
+        mongo::BSONObj const idOnly = BSON("_id" << 1);
+        mongo::BSONObj const minId = source->findOne(_from.toString(), mongo::Query().sort("_id", 1), &idOnly);
+        mongo::BSONObj const maxId = source->findOne(_from.toString(), mongo::Query().sort("_id", -1), &idOnly);
+        if (minId.isEmpty() || maxId.isEmpty() ||
+            minId.firstElement().canonicalType() != maxId.firstElement().canonicalType())
+            return wholeCollection;
+
+        // Boundaries are found by skipping over _id index, documents themselves are not read
+        std::vector<mongo::BSONObj> boundaries;
+        for (int i = 1; i < _readers; ++i) {
+            std::unique_ptr<mongo::DBClientCursor> cursor = source->query(
+                mongo::NamespaceString(_from.databaseName(), _from.collectionName()),
+                mongo::Query().sort("_id", 1).hint(idOnly), 1,
+                static_cast<int>(docsTotal * i / _readers), &idOnly
+            );
+
+            if (!cursor || !cursor->more())
+                break;
+
+            mongo::BSONObj const boundary = cursor->next().getOwned();
+            if (boundaries.empty() || boundaries.back().woCompare(boundary) < 0)
+                boundaries.push_back(boundary);
+        }
+
+        if (boundaries.empty())
+            return wholeCollection;
+
+        // { _id: { $lt: b1 } }, { _id: { $gte: b1, $lt: b2 } }, ..., { _id: { $gte: bN } }
+        std::vector<mongo::BSONObj> ranges;
+        ranges.push_back(BSON("_id" << BSON("$lt" << boundaries.front().firstElement())));
+        for (size_t i = 1; i < boundaries.size(); ++i) {
+            ranges.push_back(BSON("_id" << BSON("$gte" << boundaries[i - 1].firstElement() <<
+                                                "$lt" << boundaries[i].firstElement())));
+        }
+        ranges.push_back(BSON("_id" << BSON("$gte" << boundaries.back().firstElement())));
+        return ranges;
+    }
+
+    CollectionCopyProgress CollectionCopier::progress(double elapsedSec, long long docsTotal) const
+    {
+        CollectionCopyProgress progress;
+        progress.docsTotal = docsTotal;
+        progress.docsCopied = _docsCopied;
+        progress.docsSkipped = _docsSkipped;
+        progress.bytesCopied = _bytesCopied;
+
+        if (elapsedSec > 0) {
+            progress.docsPerSec = (progress.docsCopied + progress.docsSkipped) / elapsedSec;
+            progress.mbPerSec = progress.bytesCopied / (1024.0 * 1024.0) / elapsedSec;
+        }
+
+        long long const docsLeft = docsTotal - progress.docsCopied - progress.docsSkipped;
+        if (progress.docsPerSec > 0 && docsLeft >= 0)
+            progress.etaSec = static_cast<int>(docsLeft / progress.docsPerSec);
+
+        return progress;
+    }
+
+    void CollectionCopier::read(mongo::DBClientBase *source, mongo::BSONObj const& filter)
+    {
+        try {
+            // Ranges are read in _id order, whole collection in natural order
+            mongo::Query query(filter);
+            if (!filter.isEmpty())
+                query.hint(BSON("_id" << 1));
+
+            std::unique_ptr<mongo::DBClientCursor> cursor = source->query(
+                mongo::NamespaceString(_from.databaseName(), _from.collectionName()), query
+            );
+
+            // Cursor may be NULL, it means we have connectivity problem
+            if (!cursor)
+                throw std::runtime_error("Network error while attempting to run query");
+
+            Batch batch;
+            int batchBytes = 0;
+            while (cursor->more()) {
+                mongo::BSONObj doc = cursor->next().getOwned();
+                batchBytes += doc.objsize();
+                batch.push_back(std::move(doc));
+
+                if (batch.size() < COPY_BATCH_DOCS && batchBytes < COPY_BATCH_BYTES)
+                    continue;
+
+                throwIfCancelled();
+
+                if (!push(std::move(batch)))
+                    break;  // Copy failed
+
+                batch = Batch();
+                batchBytes = 0;
+            }
+
+            throwIfCancelled();
+            if (!batch.empty())
+                push(std::move(batch));
+        }
+        catch (...) {
+            fail(std::current_exception());
+        }
+
+        std::lock_guard<std::mutex> lock(_queueMutex);
+        --_activeReaders;
+        _queueChanged.notify_all();
+    }
+
+    void CollectionCopier::write(mongo::DBClientBase *target)
+    {
+        try {
+            MongoClient client(target, _writeConcern);
+            Batch batch;
+            while (pop(batch)) {
+                throwIfCancelled();
+                BulkWriteResult const result = client.bulkWrite(batch, _to, false, false);
+
+                long long skipped = 0;
+                for (auto const& writeError : result.writeErrors) {
+                    if (writeError.code != DUPLICATE_KEY_ERROR)
+                        throw std::runtime_error(writeError.message);
+
+                    ++skipped;
+                }
+
+                long long bytes = 0;
+                for (auto const& doc : batch)
+                    bytes += doc.objsize();
+
+                _docsCopied += result.nWritten;
+                _docsSkipped += skipped;
+                _bytesCopied += bytes;
+            }
+        }
+        catch (...) {
+            fail(std::current_exception());
+        }
+
+        std::lock_guard<std::mutex> lock(_queueMutex);
+        --_activeWriters;
+        _queueChanged.notify_all();
+    }
+
+    bool CollectionCopier::push(Batch &&batch)
+    {
+        std::unique_lock<std::mutex> lock(_queueMutex);
+        _queueChanged.wait(lock, [this]() {
+            return _failed || _queue.size() < static_cast<size_t>(_writers) * COPY_QUEUE_BATCHES_PER_WRITER;
+        });
+
+        if (_failed)
+            return false;
+
+        _queue.push_back(std::move(batch));
+        _queueChanged.notify_all();
+        return true;
+    }
+
+    bool CollectionCopier::pop(Batch &batch)
+    {
+        std::unique_lock<std::mutex> lock(_queueMutex);
+        _queueChanged.wait(lock, [this]() {
+            return _failed || !_queue.empty() || _activeReaders == 0;
+        });
+
+        if (_failed || _queue.empty())
+            return false;
+
+        batch = std::move(_queue.front());
+        _queue.pop_front();
+        _queueChanged.notify_all();
+        return true;
+    }
+
+    void CollectionCopier::fail(std::exception_ptr error)
+    {
+        std::lock_guard<std::mutex> lock(_queueMutex);
+        if (!_failed) {
+            _failed = true;
+            _error = error;
+        }
+        _queueChanged.notify_all();
+    }
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <mongo/client/dbclient_base.h>
+
+#include "robomongo/core/domain/MongoNamespace.h"
+#include "robomongo/core/events/MongoEventsInfo.h"
+
+namespace Robomongo
+{
+    /**
+     * @brief Copies collection between two servers (or two databases of the same server).
+     *
+     *        Reader threads stream documents from source connections (one per _id range,
+     *        when partitioning is possible) into a bounded queue of batches, writer threads
+     *        take batches from the queue and write them to target with unordered insert commands.
+     *        Indexes of the source collection are recreated after documents are loaded.
+     *        Documents with _id already existing in target collection are skipped.
+     */
+    class CollectionCopier
+    {
+    public:
+        using ConnectionFactory = std::function<std::unique_ptr<mongo::DBClientBase>()>;
+        using ProgressHandler = std::function<void(CollectionCopyProgress const&)>;
+
+        /**
+         * @param openSource, openTarget: open new authenticated connection to source / target
+         *        server. Called only from the thread that calls run(), before copy starts.
+         * @param readers: number of parallel _id range reads of source collection
+         * @param writers: number of parallel writer connections to target server
+         * @param cancelled: set from any thread to stop the copy, may be NULL
+         */
+        CollectionCopier(ConnectionFactory const& openSource, ConnectionFactory const& openTarget,
+                         MongoNamespace const& from, MongoNamespace const& to,
+                         int readers, int writers, mongo::BSONObj const& writeConcern,
+                         std::shared_ptr<std::atomic<bool>> const& cancelled);
+
+        /**
+         * @brief Runs the copy, blocking the calling thread until it is done. 'onProgress' is
+         *        called from the calling thread periodically and once more when documents are loaded.
+         * @throws std::runtime_error, if copy failed or was cancelled
+         */
+        CollectionCopyProgress run(ProgressHandler const& onProgress);
+
+    private:
+        using Batch = std::vector<mongo::BSONObj>;
+
+        long long countDocuments(mongo::DBClientBase *source) const;
+
+        /**
+         * @brief Splits source collection into '_readers' _id ranges of about the same size.
+         * @return filters of the ranges, single empty filter if collection cannot be split
+         */
+        std::vector<mongo::BSONObj> idRanges(mongo::DBClientBase *source, long long docsTotal) const;
+        CollectionCopyProgress progress(double elapsedSec, long long docsTotal) const;
+
+        bool cancelled() const;
+        void throwIfCancelled() const;
+
+        void read(mongo::DBClientBase *source, mongo::BSONObj const& filter);
+        void write(mongo::DBClientBase *target);
+
+        // Bounded queue of batches, push blocks while queue is full
+        bool push(Batch &&batch);
+        bool pop(Batch &batch);
+        void fail(std::exception_ptr error);
+
+        /**
+         * @brief Makes running readers and writers stop (i.e. when run() is left by exception)
+         *        and joins all 'threads'
+         */
+        void stopAndJoin(std::vector<std::thread> &threads);
+
+        ConnectionFactory const _openSource;
+        ConnectionFactory const _openTarget;
+        MongoNamespace const _from;
+        MongoNamespace const _to;
+        int const _readers;
+        int const _writers;
+        mongo::BSONObj const _writeConcern;
+        std::shared_ptr<std::atomic<bool>> const _cancelled;
+
+        std::mutex _queueMutex;
+        std::condition_variable _queueChanged;
+        std::deque<Batch> _queue;
+        int _activeReaders = 0;
+        int _activeWriters = 0;
+        bool _failed = false;
+        std::exception_ptr _error;
+
+        std::atomic<long long> _docsCopied { 0 };
+        std::atomic<long long> _docsSkipped { 0 };
+        std::atomic<long long> _bytesCopied { 0 };
+    };
+}
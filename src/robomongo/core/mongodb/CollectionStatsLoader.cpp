@@ -0,0 +1,99 @@
+#include "robomongo/core/mongodb/CollectionStatsLoader.h"
+
+#include <algorithm>
+
+#include "robomongo/core/mongodb/MongoClient.h"
+
+namespace
+{
+    // Statistics of up to this number of collections are reported at once
+    size_t const COLL_STATS_BATCH = 16;
+}
+
+namespace Robomongo
+{
+    CollectionStatsLoader::CollectionStatsLoader(ConnectionFactory const& openConnection,
+                                                 StatsHandler const& onLoaded, int concurrency) :
+        _openConnection(openConnection),
+        _onLoaded(onLoaded),
+        _concurrency(std::max(concurrency, 1))
+    {}
+
+    CollectionStatsLoader::~CollectionStatsLoader()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_queueMutex);
+            _stopping = true;
+            _queue.clear();
+        }
+        _queueChanged.notify_all();
+
+        for (auto &thread : _threads)
+            thread.join();
+    }
+
+    void CollectionStatsLoader::load(const std::string &databaseName, const std::vector<std::string> &namespaces,
+                                     unsigned long long generation)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_queueMutex);
+            _queue.erase(std::remove_if(_queue.begin(), _queue.end(), [&databaseName](Request const& request) {
+                return request.ns.databaseName() == databaseName;
+            }), _queue.end());
+
+            for (auto const& ns : namespaces)
+                _queue.push_back({ MongoNamespace(ns), generation });
+        }
+        _queueChanged.notify_all();
+
+        // Threads are started on first use, connections are opened by the threads themselves
+        if (_threads.empty() && !namespaces.empty()) {
+            for (int i = 0; i < _concurrency; ++i)
+                _threads.emplace_back(&CollectionStatsLoader::run, this);
+        }
+    }
+
+    void CollectionStatsLoader::run()
+    {
+        std::unique_ptr<mongo::DBClientBase> connection;
+
+        while (true) {
+            // Take a batch of namespaces of the same database and generation
+            std::vector<MongoNamespace> batch;
+            unsigned long long generation = 0;
+            {
+                std::unique_lock<std::mutex> lock(_queueMutex);
+                _queueChanged.wait(lock, [this]() { return _stopping || !_queue.empty(); });
+                if (_stopping)
+                    return;
+
+                std::string const databaseName = _queue.front().ns.databaseName();
+                generation = _queue.front().generation;
+                while (!_queue.empty() && batch.size() < COLL_STATS_BATCH &&
+                       _queue.front().ns.databaseName() == databaseName &&
+                       _queue.front().generation == generation) {
+                    batch.push_back(_queue.front().ns);
+                    _queue.pop_front();
+                }
+            }
+
+            std::vector<MongoCollectionInfo> infos;
+            try {
+                if (!connection)
+                    connection = _openConnection();
+
+                MongoClient client(connection.get());
+                for (auto const& ns : batch)
+                    infos.push_back(client.runCollStatsCommand(ns.toString()));
+            }
+            catch (const std::exception &) {
+                // Statistics are optional, collections of the failed batch are left without them.
+                // Connection is opened again for the next batch.
+                connection.reset();
+                continue;
+            }
+
+            _onLoaded(batch.front().databaseName(), infos, generation);
+        }
+    }
+}
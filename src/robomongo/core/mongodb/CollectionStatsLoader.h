@@ -0,0 +1,74 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <mongo/client/dbclient_base.h>
+
+#include "robomongo/core/domain/MongoCollectionInfo.h"
+
+namespace Robomongo
+{
+    /**
+     * @brief Loads collStats of collections in background, so that list of collection 
+     *        names can be shown before statistics are known.
+     *
+     *        A fixed number of threads, each with its own connection, takes namespaces 
+     *        from a queue and reports statistics in small batches of the same database.
+     */
+    class CollectionStatsLoader
+    {
+    public:
+        using ConnectionFactory = std::function<std::unique_ptr<mongo::DBClientBase>()>;
+        using StatsHandler = std::function<void(const std::string &databaseName,
+                                                const std::vector<MongoCollectionInfo> &infos,
+                                                unsigned long long generation)>;
+
+        /**
+         * @param openConnection: opens new authenticated connection, called from loader threads
+         * @param onLoaded: called from loader threads with each batch of loaded statistics
+         * @param concurrency: number of loader threads (and connections)
+         */
+        CollectionStatsLoader(ConnectionFactory const& openConnection, StatsHandler const& onLoaded,
+                              int concurrency);
+
+        /**
+         * @brief Drops not started requests and waits for running ones to finish
+         */
+        ~CollectionStatsLoader();
+
+        /**
+         * @brief Queues loading of 'namespaces' statistics. Not yet started requests for 
+         *        'databaseName' are replaced, as they belong to previous listing of the database.
+         *        'generation' is passed back to onLoaded with the statistics, so that caller can
+         *        tell results requested before its cache was invalidated.
+         */
+        void load(const std::string &databaseName, const std::vector<std::string> &namespaces,
+                  unsigned long long generation);
+
+    private:
+        struct Request
+        {
+            MongoNamespace ns;
+            unsigned long long generation;
+        };
+
+        void run();
+
+        ConnectionFactory const _openConnection;
+        StatsHandler const _onLoaded;
+        int const _concurrency;
+
+        std::mutex _queueMutex;
+        std::condition_variable _queueChanged;
+        std::deque<Request> _queue;
+        bool _stopping = false;
+        std::vector<std::thread> _threads;
+    };
+}
@@ -1,5 +1,7 @@
 #include "robomongo/core/mongodb/MongoClient.h"
 
+#include <limits>
+
 #include "mongo/db/namespace_string.h"
 
 #include "robomongo/core/domain/MongoDocument.h"
@@ -8,6 +10,27 @@
 
 namespace
 {
+    // Write command is sent as a single BSON document, leave room for the command fields
+    int const BULK_WRITE_MAX_BATCH_BYTES = mongo::BSONObjMaxUserSize - 16 * 1024;
+    // maxWriteBatchSize of servers older than 3.6
+    size_t const BULK_WRITE_MAX_BATCH_COUNT = 1000;
+    // Operations read per round trip of $currentOp cursor
+    int const CURRENT_OPS_BATCH_SIZE = 1000;
+
+    // Update statement of "update" command which replaces (or inserts) document by its _id
+    mongo::BSONObj makeSaveStatement(const mongo::BSONObj &doc)
+    {
+        mongo::BSONObj obj = doc;
+        if (!obj.hasField("_id")) {
+            mongo::BSONObjBuilder withId;
+            withId.append("_id", mongo::OID::gen());
+            withId.appendElements(doc);
+            obj = withId.obj();
+        }
+
+        return BSON("q" << BSON("_id" << obj["_id"]) << "u" << obj << "upsert" << true);
+    }
+
     Robomongo::IndexInfo makeIndexInfoFromBsonObj(
         const Robomongo::MongoCollectionInfo &collection,
         const mongo::BSONObj &obj)
@@ -36,8 +59,11 @@ namespace
 
 namespace Robomongo
 {
-    MongoClient::MongoClient(mongo::DBClientBase *const dbclient) :
-        _dbclient(dbclient) { }
+    MongoClient::MongoClient(mongo::DBClientBase *const dbclient, 
+                             const mongo::BSONObj &writeConcern /* = mongo::BSONObj() */,
+                             ServerMetadataCache *metadataCache /* = nullptr */) :
+        _dbclient(dbclient), _writeConcern(writeConcern), 
+        _metadataCache(metadataCache ? metadataCache : &_ownMetadataCache) { }
 
     std::vector<std::string> MongoClient::getCollectionNamesWithDbname(const std::string &dbname) const
     {
@@ -56,27 +82,22 @@ namespace Robomongo
     // Todo: Remove this function
     float MongoClient::getVersion() const
     {
-        float result = 0.0f;
-        mongo::BSONObj resultObj;
-        _dbclient->runCommand("db", BSON("buildInfo" << "1"), resultObj);
-        std::string resultStr = BsonUtils::getField<mongo::String>(resultObj, "version");
-        result = atof(resultStr.c_str());
-        return result;
+        return atof(serverMetadata().version.c_str());
     }
 
     std::string MongoClient::dbVersionStr() const
     {
-        mongo::BSONObj resultObj;
-        _dbclient->runCommand("db", BSON("buildInfo" << "1"), resultObj);
-        std::string const resultStr = BsonUtils::getField<mongo::String>(resultObj, "version");
-        return resultStr;
+        return serverMetadata().version;
     }
 
     std::string MongoClient::getStorageEngineType() const
     {
-        mongo::BSONObj resultObj;
-        _dbclient->runCommand("db", BSON("serverStatus" << "1"), resultObj);
-        return resultObj.getObjectField("storageEngine").getStringField("name");
+        return serverMetadata().storageEngine;
+    }
+
+    const ServerMetadata &MongoClient::serverMetadata() const
+    {
+        return _metadataCache->get(_dbclient);
     }
 
     std::vector<std::string> MongoClient::getDatabaseNames() const
@@ -101,9 +122,10 @@ namespace Robomongo
             throw std::runtime_error(errStr);
         }
 
+        float const version = getVersion();
         std::vector<MongoUser> users;
         for (auto const& usr : result.getField("users").Array())
-            users.push_back(MongoUser(getVersion(), usr.embeddedObject()));
+            users.push_back(MongoUser(version, usr.embeddedObject()));
 
         return users;
     }
@@ -454,55 +476,116 @@ namespace Robomongo
     {
         MongoNamespace const newCollection(ns.databaseName(), newCollectionName);
 
-        if (!_dbclient->exists(newCollection.toString())) {
-            mongo::BSONObj result;
-            // todo: Issue #1258 : Duplicate Collection should support advanced collection options.
-            //       _dbclient->createCollection() should be called with properties of source collection
-            //       not with default parameters as below.
-            if (!_dbclient->createCollection(newCollection.toString(), 0, false, 0, &result)) {
-                std::string errStr = result.getStringField("errmsg");
-                if (errStr.empty())
-                    errStr = "Failed to get error message.";
-
-                throw std::runtime_error(errStr);
-            }
-        }
-        else {
+        if (_dbclient->exists(newCollection.toString()))
             throw std::runtime_error("Collection with same name already exists.");
-        }
 
-        std::unique_ptr<mongo::DBClientCursor> cursor {
-			_dbclient->query(mongo::NamespaceString(ns.databaseName(), ns.collectionName()), mongo::Query()) 
-		};
+        // New collection gets options of the source collection (capped, validator, collation...)
+        mongo::BSONObj const sourceInfo = getCollectionInfo(ns);
+        createCollectionLike(newCollection, sourceInfo);
 
-        // Cursor may be NULL, it means we have connectivity problem
-        if (!cursor)
-            throw std::runtime_error("Network error while attempting to run query");
+        // View has no documents and indexes of its own
+        if (std::string(sourceInfo.getStringField("type")) == "view")
+            return;
 
-        while (cursor->more()) {
-            mongo::BSONObj bsonObj = cursor->next();
-            _dbclient->insert(newCollection.toString(), bsonObj);
+        // Documents are copied on the server, unless server cannot do that
+        if (sourceInfo.getObjectField("options").getBoolField("capped") || 
+            !copyCollectionWithOut(ns, newCollectionName))
+            copyCollectionDocuments(ns, newCollection);
+
+        // Indexes are built after documents are copied, as it is faster than maintaining them on insert
+        createIndexes(newCollection, getIndexSpecs(ns));
+    }
+
+    mongo::BSONObj MongoClient::getCollectionInfo(const MongoNamespace &ns) const
+    {
+        std::list<mongo::BSONObj> const infos = 
+            _dbclient->getCollectionInfos(ns.databaseName(), BSON("name" << ns.collectionName()));
+        if (infos.empty())
+            throw std::runtime_error("Collection does not exist.");
+
+        return infos.front().getOwned();
+    }
+
+    void MongoClient::createCollectionLike(const MongoNamespace &ns, const mongo::BSONObj &collectionInfo)
+    {
+        mongo::BSONObjBuilder cmd;
+        cmd.append("create", ns.collectionName());
+        cmd.appendElements(collectionInfo.getObjectField("options"));
+        runCommandAndThrow(ns.databaseName(), cmd.obj());
+    }
+
+    std::list<mongo::BSONObj> MongoClient::getIndexSpecs(const MongoNamespace &ns) const
+    {
+        return _dbclient->getIndexSpecs(ns.toString());
+    }
+
+    void MongoClient::createIndexes(const MongoNamespace &ns, const std::list<mongo::BSONObj> &indexSpecs)
+    {
+        mongo::BSONArrayBuilder indexes;
+        bool hasIndexes = false;
+        for (auto const& spec : indexSpecs) {
+            if (std::string(spec.getStringField("name")) == "_id_")
+                continue;
+
+            // "ns" and "v" describe the source index, server fills them for the new one
+            indexes.append(spec.removeField("ns").removeField("v"));
+            hasIndexes = true;
         }
+
+        if (hasIndexes)
+            runCommandAndThrow(ns.databaseName(), 
+                BSON("createIndexes" << ns.collectionName() << "indexes" << indexes.arr()));
     }
 
-    void MongoClient::copyCollectionToDiffServer(mongo::DBClientBase *const fromServ, const MongoNamespace &from, 
-                                                 const MongoNamespace &to)
+    bool MongoClient::copyCollectionWithOut(const MongoNamespace &ns, const std::string &newCollectionName)
     {
-        if (!_dbclient->exists(to.toString()))
-            _dbclient->createCollection(to.toString());
+        // $out keeps options and indexes of the existing target collection
+        // { aggregate: "collection", pipeline: [{ $match: {} }, { $out: "newCollection" }], cursor: {} }
+        mongo::BSONObjBuilder cmd;
+        cmd.append("aggregate", ns.collectionName());
+        cmd.append("pipeline", BSON_ARRAY(BSON("$match" << mongo::BSONObj()) << 
+                                          BSON("$out" << newCollectionName)));
+        cmd.append("cursor", mongo::BSONObj());
+        cmd.append("bypassDocumentValidation", true);
+
+        mongo::BSONObj result;
+        if (_dbclient->runCommand(ns.databaseName(), cmd.obj(), result))
+            return true;
 
-        std::unique_ptr<mongo::DBClientCursor> cursor{fromServ->query(
-            mongo::NamespaceString(from.databaseName(), from.collectionName()),
-            mongo::Query()) 
-		};
+        // CommandNotFound, or "Unrecognized pipeline stage name" before and since 3.4
+        int const code = result.getIntField("code");
+        if (code == 59 || code == 16436 || code == 40324)
+            return false;
+
+        std::string errStr = result.getStringField("errmsg");
+        if (errStr.empty())
+            errStr = "Failed to get error message.";
+
+        throw std::runtime_error(errStr);
+    }
+
+    void MongoClient::copyCollectionDocuments(const MongoNamespace &from, const MongoNamespace &to)
+    {
+        std::unique_ptr<mongo::DBClientCursor> cursor {
+            _dbclient->query(mongo::NamespaceString(from.databaseName(), from.collectionName()), mongo::Query()) 
+        };
 
         // Cursor may be NULL, it means we have connectivity problem
         if (!cursor)
             throw std::runtime_error("Network error while attempting to run query");
 
+        // Every batch received from server is written back with as few insert commands as possible
+        std::vector<mongo::BSONObj> batch;
         while (cursor->more()) {
-            mongo::BSONObj bsonObj = cursor->next();
-            _dbclient->insert(to.toString(), bsonObj);
+            batch.push_back(cursor->next().getOwned());
+            if (cursor->objsLeftInBatch() > 0 && cursor->more())
+                continue;
+
+            BulkWriteResult const result = bulkWrite(batch, to, false);
+            if (!result.writeErrors.empty())
+                throw std::runtime_error(result.writeErrors.front().message);
+
+            batch.clear();
         }
     }
 
@@ -525,29 +608,85 @@ namespace Robomongo
 
     void MongoClient::insertDocument(const mongo::BSONObj &obj, const MongoNamespace &ns)
     {
-        _dbclient->insert(ns.toString(), obj);
-        checkLastErrorAndThrow(ns.databaseName());
+        mongo::BSONObjBuilder cmd;
+        cmd.append("insert", ns.collectionName());
+        cmd.appendArray("documents", BSON_ARRAY(obj));
+        throwOnWriteErrors(runWriteCommand(ns.databaseName(), cmd));
     }
 
     void MongoClient::saveDocument(const mongo::BSONObj &obj, const MongoNamespace &ns)
     {
-        mongo::BSONElement id = obj.getField("_id");
-        mongo::BSONObjBuilder builder;
-        builder.append(id);
-        mongo::BSONObj bsonQuery = builder.obj();
-        mongo::Query query(bsonQuery);
+        mongo::BSONObjBuilder cmd;
+        cmd.append("update", ns.collectionName());
+        cmd.appendArray("updates", BSON_ARRAY(makeSaveStatement(obj)));
+        throwOnWriteErrors(runWriteCommand(ns.databaseName(), cmd));
+    }
+
+    BulkWriteResult MongoClient::bulkWrite(const std::vector<mongo::BSONObj> &docs, const MongoNamespace &ns,
+                                           bool overwrite, bool ordered /* = true */)
+    {
+        BulkWriteResult result;
+
+        size_t first = 0;
+        while (first < docs.size()) {
+            // Take as many documents as fit into one command
+            mongo::BSONArrayBuilder statements;
+            int batchBytes = 0;
+            size_t last = first;
+            for (; last < docs.size() && last - first < BULK_WRITE_MAX_BATCH_COUNT; ++last) {
+                mongo::BSONObj const statement = overwrite ? makeSaveStatement(docs[last]) : docs[last];
+                if (last > first && batchBytes + statement.objsize() > BULK_WRITE_MAX_BATCH_BYTES)
+                    break;
+
+                statements.append(statement);
+                batchBytes += statement.objsize();
+            }
+
+            // { insert: "collection", documents: [...], ordered: true } or
+            // { update: "collection", updates: [{ q: { _id: .. }, u: {..}, upsert: true }, ...], ordered: true }
+            mongo::BSONObjBuilder cmd;
+            cmd.append(overwrite ? "update" : "insert", ns.collectionName());
+            cmd.appendArray(overwrite ? "updates" : "documents", statements.arr());
+            cmd.append("ordered", ordered);
+
+            mongo::BSONObj const response = runWriteCommand(ns.databaseName(), cmd);
+
+            // For update, "n" counts both replaced and upserted documents
+            result.nWritten += response.getIntField("n");
+
+            bool hasErrors = false;
+            if (response.hasField("writeErrors")) {
+                for (auto const& err : response.getField("writeErrors").Array()) {
+                    mongo::BSONObj const errObj = err.Obj();
+                    result.writeErrors.push_back({
+                        static_cast<int>(first) + errObj.getIntField("index"),
+                        errObj.getIntField("code"),
+                        errObj.getStringField("errmsg")
+                    });
+                    hasErrors = true;
+                }
+            }
+
+            if (ordered && hasErrors)
+                break;
+
+            first = last;
+        }
 
-        _dbclient->update(ns.toString(), query, obj, true, false);
-        checkLastErrorAndThrow(ns.databaseName());
+        return result;
     }
 
     void MongoClient::removeDocuments(const MongoNamespace &ns, mongo::Query query, bool justOne /*= true*/)
     {
-        _dbclient->remove(ns.toString(), query, justOne);        
-        checkLastErrorAndThrow(ns.databaseName());
+        // { delete: "collection", deletes: [{ q: {..}, limit: 1 }] }, limit 0 removes all matching
+        mongo::BSONObjBuilder cmd;
+        cmd.append("delete", ns.collectionName());
+        cmd.appendArray("deletes", BSON_ARRAY(BSON("q" << query.getFilter() << "limit" << (justOne ? 1 : 0))));
+        throwOnWriteErrors(runWriteCommand(ns.databaseName(), cmd));
     }
 
-    std::vector<MongoDocumentPtr> MongoClient::query(const MongoQueryInfo &info)
+    std::vector<MongoDocumentPtr> MongoClient::query(const MongoQueryInfo &info, 
+                                                     DocumentsBatchHandler const& onBatch /* = nullptr */)
     {
         MongoNamespace ns(info._info._ns);
 
@@ -568,10 +707,45 @@ namespace Robomongo
         if (!cursor)
             throw std::runtime_error("Network error while attempting to run query");
 
-        while (cursor->more()) {
+        return fetch(cursor.get(), std::numeric_limits<int>::max(), onBatch);
+    }
+
+    std::unique_ptr<mongo::DBClientCursor> MongoClient::openCursor(const MongoQueryInfo &info)
+    {
+        MongoNamespace ns(info._info._ns);
+
+        // nToReturn is 0: the cursor must stay open after the current page is read
+        std::unique_ptr<mongo::DBClientCursor> cursor = _dbclient->query(
+            mongo::NamespaceString(ns.databaseName(), ns.collectionName()),
+            info._query, 0, info._skip, info._fields.nFields() ? &info._fields : 0,
+            info._options, info._batchSize
+        );
+
+        // DBClientBase::query may return nullptr
+        if (!cursor)
+            throw std::runtime_error("Network error while attempting to run query");
+
+        return cursor;
+    }
+
+    std::vector<MongoDocumentPtr> MongoClient::fetch(mongo::DBClientCursor *cursor, int count, 
+                                                     DocumentsBatchHandler const& onBatch /* = nullptr */)
+    {
+        std::vector<MongoDocumentPtr> docs;
+        int fetched = 0;
+
+        while (fetched < count && cursor->more()) {
             mongo::BSONObj bsonObj = cursor->next();
             MongoDocumentPtr doc(new MongoDocument(bsonObj.getOwned()));
             docs.push_back(doc);
+            ++fetched;
+
+            // Current batch is drained, next more() call will issue getMore round trip.
+            // Hand over what we have so that UI can render it in the meantime.
+            if (onBatch && fetched < count && cursor->objsLeftInBatch() == 0 && !cursor->isDead()) {
+                onBatch(docs);
+                docs.clear();
+            }
         }
 
         return docs;
@@ -579,33 +753,300 @@ namespace Robomongo
 
     MongoCollectionInfo MongoClient::runCollStatsCommand(const std::string &ns)
     {
-        MongoCollectionInfo info(ns);
-        return info;
-
-/*      // Commented for now, to speedup load of collection names
         MongoNamespace mongons(ns);
 
-        mongo::BSONObjBuilder command; // { collStats: "db.collection", scale : 1 }
+        mongo::BSONObjBuilder command; // { collStats: "collection", scale : 1 }
         command.append("collStats", mongons.collectionName());
         command.append("scale", 1);
 
+        // Fails for views and without privileges, collection is shown without statistics then
         mongo::BSONObj result;
-        _dbclient->runCommand(mongons.databaseName(), command.obj(), result);
-        std::string isCV = result.toString();
-        MongoCollectionInfo newInfo(result);
-        return newInfo;
-        */
+        if (!_dbclient->runCommand(mongons.databaseName(), command.obj(), result))
+            return MongoCollectionInfo(ns);
+
+        return MongoCollectionInfo(ns, result);
     }
 
-    std::vector<MongoCollectionInfo> MongoClient::runCollStatsCommand(const std::vector<std::string> &namespaces)
+    std::vector<mongo::BSONObj> MongoClient::currentOps(const mongo::BSONObj &match, bool idleCursors /* = false */,
+                                                       const mongo::BSONObj &projection /* = mongo::BSONObj() */,
+                                                       bool allUsers /* = true */)
     {
-        std::vector<MongoCollectionInfo> infos;
-        for (auto const& ns : namespaces) {
-            MongoCollectionInfo info = runCollStatsCommand(ns);
-            if (info.ns().isValid()) 
-                infos.push_back(info);
+        // { aggregate: 1, pipeline: [{ $currentOp: { allUsers: true, idleCursors: true } },
+        //                            { $match: match }, { $project: projection }], cursor: {} }
+        mongo::BSONArrayBuilder pipeline;
+        pipeline.append(BSON("$currentOp" << (idleCursors ? BSON("allUsers" << allUsers << "idleCursors" << true)
+                                                          : BSON("allUsers" << allUsers))));
+        if (!match.isEmpty())
+            pipeline.append(BSON("$match" << match));
+        if (!projection.isEmpty())
+            pipeline.append(BSON("$project" << projection));
+
+        // Busy servers have more operations than fit the default first batch of 101 documents
+        mongo::BSONObj const cmd = BSON("aggregate" << 1 << "pipeline" << pipeline.arr() << 
+                                        "cursor" << BSON("batchSize" << CURRENT_OPS_BATCH_SIZE));
+
+        mongo::BSONObj result;
+        std::vector<mongo::BSONObj> ops;
+        if (readCommandCursor("admin", "$cmd.aggregate", cmd, CURRENT_OPS_BATCH_SIZE, ops, result))
+            return ops;
+
+        // $currentOp stage is not supported (before 3.6) or does not know idleCursors (before 4.2)
+        mongo::BSONObjBuilder fallback;
+        fallback.append("currentOp", 1);
+        if (!allUsers)
+            fallback.append("$ownOps", true);
+        fallback.appendElements(match);
+        if (!_dbclient->runCommand("admin", fallback.obj(), result)) {
+            std::string errStr = result.getStringField("errmsg");
+            if (errStr.empty())
+                errStr = "Failed to get error message.";
+
+            throw std::runtime_error(errStr);
         }
-        return infos;
+
+        for (auto const& op : result.getField("inprog").Array())
+            ops.push_back(op.Obj().getOwned());
+
+        return ops;
+    }
+
+    void MongoClient::killOp(const mongo::BSONElement &opid)
+    {
+        // Operation id is a number on mongod and "shard:opid" string on mongos
+        mongo::BSONObjBuilder cmd;
+        cmd.append("killOp", 1);
+        cmd.appendAs(opid, "op");
+        runCommandAndThrow("admin", cmd.obj());
+    }
+
+    mongo::BSONObj MongoClient::serverStatus()
+    {
+        mongo::BSONObj result;
+        if (!_dbclient->runCommand("admin", BSON("serverStatus" << 1 << "locks" << 0 << "metrics" << 0 <<
+                                                 "tcmalloc" << 0), result)) {
+            std::string errStr = result.getStringField("errmsg");
+            if (errStr.empty())
+                errStr = "Failed to get error message.";
+
+            throw std::runtime_error(errStr);
+        }
+
+        return result.getOwned();
+    }
+
+    mongo::BSONObj MongoClient::replicaSetStatus()
+    {
+        mongo::BSONObj result;
+        if (!_dbclient->runCommand("admin", BSON("replSetGetStatus" << 1), result))
+            return mongo::BSONObj();
+
+        return result.getOwned();
+    }
+
+    std::map<std::string, long long> MongoClient::indexStats(const MongoNamespace &ns)
+    {
+        mongo::BSONObj result;
+        std::map<std::string, long long> accesses;
+        if (!_dbclient->runCommand(ns.databaseName(), BSON("aggregate" << ns.collectionName() << 
+                                   "pipeline" << BSON_ARRAY(BSON("$indexStats" << mongo::BSONObj())) <<
+                                   "cursor" << mongo::BSONObj()), result))
+            return accesses;
+
+        for (auto const& index : result.getObjectField("cursor").getField("firstBatch").Array()) {
+            mongo::BSONObj const stats = index.Obj();
+            accesses[stats.getStringField("name")] = stats.getObjectField("accesses").getField("ops").safeNumberLong();
+        }
+
+        return accesses;
+    }
+
+    std::vector<mongo::BSONObj> MongoClient::sampleDocuments(const MongoNamespace &ns, int size)
+    {
+        return aggregate(ns, BSON_ARRAY(BSON("$sample" << BSON("size" << size))));
+    }
+
+    std::vector<mongo::BSONObj> MongoClient::aggregate(const MongoNamespace &ns, const mongo::BSONObj &pipeline)
+    {
+        // { aggregate: "collection", pipeline: pipeline, cursor: {} },
+        // then { getMore: cursorId, collection: "collection" } until cursor is exhausted
+        mongo::BSONObj result;
+        mongo::BSONObj const cmd = BSON("aggregate" << ns.collectionName() << "pipeline" << mongo::BSONArray(pipeline) <<
+                                        "cursor" << mongo::BSONObj() << "allowDiskUse" << true);
+
+        std::vector<mongo::BSONObj> documents;
+        if (!readCommandCursor(ns.databaseName(), ns.collectionName(), cmd, 0, documents, result)) {
+            std::string errStr = result.getStringField("errmsg");
+            if (errStr.empty())
+                errStr = "Failed to get error message.";
+
+            throw std::runtime_error(errStr);
+        }
+
+        return documents;
+    }
+
+    bool MongoClient::readCommandCursor(const std::string &dbName, const std::string &collection, 
+                                        const mongo::BSONObj &cmd, int batchSize,
+                                        std::vector<mongo::BSONObj> &documents, mongo::BSONObj &result)
+    {
+        if (!_dbclient->runCommand(dbName, cmd, result))
+            return false;
+
+        mongo::BSONObj cursor = result.getObjectField("cursor");
+        for (auto const& document : cursor.getField("firstBatch").Array())
+            documents.push_back(document.Obj().getOwned());
+
+        long long cursorId = cursor.getField("id").numberLong();
+        while (cursorId != 0) {
+            // { getMore: cursorId, collection: "collection", batchSize: batchSize }
+            mongo::BSONObjBuilder getMore;
+            getMore.append("getMore", cursorId);
+            getMore.append("collection", collection);
+            if (batchSize > 0)
+                getMore.append("batchSize", batchSize);
+
+            if (!_dbclient->runCommand(dbName, getMore.obj(), result)) {
+                std::string errStr = result.getStringField("errmsg");
+                if (errStr.empty())
+                    errStr = "Failed to get error message.";
+
+                // Cursor is not left open on the server until it times out
+                mongo::BSONObj killResult;
+                _dbclient->runCommand(dbName, BSON("killCursors" << collection << "cursors" << BSON_ARRAY(cursorId)),
+                                      killResult);
+                throw std::runtime_error(errStr);
+            }
+
+            cursor = result.getObjectField("cursor");
+            for (auto const& document : cursor.getField("nextBatch").Array())
+                documents.push_back(document.Obj().getOwned());
+
+            cursorId = cursor.getField("id").numberLong();
+        }
+
+        return true;
+    }
+
+    ChangeStreamBatch MongoClient::openChangeStream(const MongoNamespace &ns, const mongo::BSONObj &pipeline)
+    {
+        // { aggregate: "collection" or 1, pipeline: [ { $changeStream: {} }, ... ], cursor: {} }
+        mongo::BSONObjBuilder cmd;
+        if (ns.collectionName().empty())
+            cmd.append("aggregate", 1);
+        else
+            cmd.append("aggregate", ns.collectionName());
+        cmd.append("pipeline", mongo::BSONArray(pipeline));
+        cmd.append("cursor", mongo::BSONObj());
+
+        return changeStreamBatch(ns, cmd.obj(), "firstBatch");
+    }
+
+    ChangeStreamBatch MongoClient::changeStreamGetMore(const MongoNamespace &ns, long long cursorId, 
+                                                       int maxAwaitTimeMS)
+    {
+        // Cursor of database change stream belongs to "$cmd.aggregate" collection
+        std::string const collection = ns.collectionName().empty() ? "$cmd.aggregate" : ns.collectionName();
+        return changeStreamBatch(ns, BSON("getMore" << cursorId << "collection" << collection << 
+                                          "maxTimeMS" << maxAwaitTimeMS), "nextBatch");
+    }
+
+    void MongoClient::closeChangeStream(const MongoNamespace &ns, long long cursorId)
+    {
+        std::string const collection = ns.collectionName().empty() ? "$cmd.aggregate" : ns.collectionName();
+        mongo::BSONObj result;
+        _dbclient->runCommand(ns.databaseName(), BSON("killCursors" << collection << 
+                                                      "cursors" << BSON_ARRAY(cursorId)), result);
+    }
+
+    ChangeStreamBatch MongoClient::changeStreamBatch(const MongoNamespace &ns, const mongo::BSONObj &cmd,
+                                                     const char *batchField)
+    {
+        mongo::BSONObj result;
+        if (!_dbclient->runCommand(ns.databaseName(), cmd, result)) {
+            std::string errStr = result.getStringField("errmsg");
+            if (errStr.empty())
+                errStr = "Failed to get error message.";
+
+            throw std::runtime_error(errStr);
+        }
+
+        mongo::BSONObj const cursor = result.getObjectField("cursor");
+        ChangeStreamBatch batch;
+        batch.cursorId = cursor.getField("id").numberLong();
+        for (auto const& event : cursor.getField(batchField).Array())
+            batch.events.push_back(event.Obj().getOwned());
+        batch.resumeToken = cursor.getObjectField("postBatchResumeToken").getOwned();
+        // Stream opened without resume token starts at this time (replica sets and sharded clusters)
+        if (std::string(batchField) == "firstBatch" && result["operationTime"].type() == mongo::bsonTimestamp)
+            batch.operationTime = result["operationTime"].timestamp();
+        return batch;
+    }
+
+    int MongoClient::killClientOperations(const std::string &clientAddress)
+    {
+        int killed = 0;
+        // Shell connection runs as the same user, its own operations are listed without 'inprog' privilege
+        for (auto const& op : currentOps(BSON("client" << clientAddress), true, mongo::BSONObj(), false)) {
+            mongo::BSONObj killResult;
+
+            if (std::string(op.getStringField("type")) == "idleCursor") {
+                // { killCursors: "collection", cursors: [ cursorId ] }
+                MongoNamespace const ns(op.getStringField("ns"));
+                long long const cursorId = op.getObjectField("cursor").getField("cursorId").numberLong();
+                if (_dbclient->runCommand(ns.databaseName(), BSON("killCursors" << ns.collectionName() <<
+                                          "cursors" << BSON_ARRAY(cursorId)), killResult))
+                    ++killed;
+            }
+            else if (op.hasField("opid")) {
+                try {
+                    killOp(op.getField("opid"));
+                    ++killed;
+                }
+                catch (const std::exception &) {
+                    // Operation has already finished
+                }
+            }
+        }
+
+        return killed;
+    }
+
+    mongo::BSONObj MongoClient::explain(const std::string &dbName, const mongo::BSONObj &command)
+    {
+        mongo::BSONObj result;
+        for (char const *verbosity : { "executionStats", "queryPlanner" }) {
+            if (_dbclient->runCommand(dbName, BSON("explain" << command << "verbosity" << verbosity), result))
+                return result;
+        }
+
+        std::string errStr = result.getStringField("errmsg");
+        if (errStr.empty())
+            errStr = "Failed to get error message.";
+
+        throw std::runtime_error(errStr);
+    }
+
+    std::pair<int, int> MongoClient::setProfilingLevel(const std::string &dbName, int level, int slowMs)
+    {
+        mongo::BSONObjBuilder cmd;
+        cmd.append("profile", level);
+        if (level >= 0)
+            cmd.append("slowms", slowMs);
+
+        mongo::BSONObj result;
+        if (!_dbclient->runCommand(dbName, cmd.obj(), result)) {
+            std::string errStr = result.getStringField("errmsg");
+            if (errStr.empty())
+                errStr = "Failed to get error message.";
+
+            throw std::runtime_error(errStr);
+        }
+
+        // 'was' and 'slowms' are the settings before the command
+        if (level >= 0)
+            return std::make_pair(level, slowMs);
+
+        return std::make_pair(result.getField("was").numberInt(), result.getField("slowms").numberInt());
     }
 
     void MongoClient::done()
@@ -614,12 +1055,49 @@ namespace Robomongo
         //_scopedConnection->done();
     }
 
-    void MongoClient::checkLastErrorAndThrow(const std::string &db)
+    void MongoClient::runCommandAndThrow(const std::string &dbName, const mongo::BSONObj &cmd)
+    {
+        mongo::BSONObj result;
+        if (!_dbclient->runCommand(dbName, cmd, result)) {
+            std::string errStr = result.getStringField("errmsg");
+            if (errStr.empty())
+                errStr = "Failed to get error message.";
+
+            throw std::runtime_error(errStr);
+        }
+    }
+
+    mongo::BSONObj MongoClient::runWriteCommand(const std::string &dbName, mongo::BSONObjBuilder &cmd)
+    {
+        // Acknowledgement comes in the reply of the command itself, no getLastError round trip
+        if (!_writeConcern.isEmpty())
+            cmd.append("writeConcern", _writeConcern);
+
+        mongo::BSONObj response;
+        if (!_dbclient->runCommand(dbName, cmd.obj(), response)) {
+            std::string errStr = response.getStringField("errmsg");
+            if (errStr.empty())
+                errStr = "Failed to get error message.";
+
+            throw std::runtime_error(errStr);
+        }
+
+        if (response.hasField("writeConcernError")) {
+            std::string const errStr = response.getObjectField("writeConcernError").getStringField("errmsg");
+            throw std::runtime_error("Write concern error: " + errStr);
+        }
+
+        return response;
+    }
+
+    void MongoClient::throwOnWriteErrors(const mongo::BSONObj &response)
     {
-        std::string const lastError = _dbclient->getLastError(db);        
-        if (lastError.empty())
+        if (!response.hasField("writeErrors"))
             return;
 
-        throw std::runtime_error(lastError/*, mongo::ErrorCodes::InternalError*/);
+        // Statements are sent one per command, the first error is the only one
+        std::vector<mongo::BSONElement> const errors = response.getField("writeErrors").Array();
+        if (!errors.empty())
+            throw std::runtime_error(errors.front().Obj().getStringField("errmsg"));
     }
 }
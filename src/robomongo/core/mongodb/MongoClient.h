@@ -1,5 +1,9 @@
 #pragma once
 
+#include <functional>
+#include <list>
+#include <map>
+
 #include <mongo/client/dbclient_base.h>
 #include <mongo/bson/bsonobj.h>
 
@@ -8,19 +12,32 @@
 #include "robomongo/core/domain/MongoUser.h"
 #include "robomongo/core/domain/MongoFunction.h"
 #include "robomongo/core/events/MongoEventsInfo.h"
+#include "robomongo/core/mongodb/ServerMetadataCache.h"
 
 namespace Robomongo
 {
     class MongoClient
     {
     public:
-        MongoClient(mongo::DBClientBase *const scopedConnection);
+        // Called with the documents of every server batch as soon as the batch is drained
+        using DocumentsBatchHandler = std::function<void(std::vector<MongoDocumentPtr> const&)>;
+
+        /**
+         * @param writeConcern: write concern of document writes, i.e. { w: "majority" }.
+         *        Server default is used, if empty.
+         * @param metadataCache: server metadata shared by clients of the same connection.
+         *        If not provided, metadata is loaded once per this client.
+         */
+        MongoClient(mongo::DBClientBase *const scopedConnection, 
+                    const mongo::BSONObj &writeConcern = mongo::BSONObj(),
+                    ServerMetadataCache *metadataCache = nullptr);
 
         std::vector<std::string> getCollectionNamesWithDbname(const std::string &dbname) const;
         std::vector<std::string> getDatabaseNames() const;
         float getVersion() const;
         std::string dbVersionStr() const;
         std::string getStorageEngineType() const;
+        const ServerMetadata &serverMetadata() const;
 
         std::vector<MongoUser> getUsers(const std::string &dbName);
         void createUser(const std::string &dbName, const MongoUser &user);
@@ -45,20 +62,200 @@ namespace Robomongo
         void renameCollection(const MongoNamespace &ns, const std::string &newCollectionName);
         void duplicateCollection(const MongoNamespace &ns, const std::string &newCollectionName);
         void dropCollection(const MongoNamespace &ns);
-        void copyCollectionToDiffServer(mongo::DBClientBase *const, const MongoNamespace &from, const MongoNamespace &to);
+
+        /**
+         * @brief Returns listCollections entry ({ name, type, options... }) of existing collection
+         * @throws std::runtime_error, if collection does not exist
+         */
+        mongo::BSONObj getCollectionInfo(const MongoNamespace &ns) const;
+
+        /**
+         * @brief Creates collection 'ns' with options of 'collectionInfo' (see getCollectionInfo())
+         */
+        void createCollectionLike(const MongoNamespace &ns, const mongo::BSONObj &collectionInfo);
+
+        std::list<mongo::BSONObj> getIndexSpecs(const MongoNamespace &ns) const;
+
+        /**
+         * @brief Creates indexes described by 'indexSpecs' (i.e. taken from other collection 
+         *        with getIndexSpecs()) on 'ns' with single command. _id index is skipped.
+         */
+        void createIndexes(const MongoNamespace &ns, const std::list<mongo::BSONObj> &indexSpecs);
 
         void insertDocument(const mongo::BSONObj &obj, const MongoNamespace &ns);
         void saveDocument(const mongo::BSONObj &obj, const MongoNamespace &ns);
+        /**
+         * @brief Inserts 'docs' (or saves them, replacing documents with the same _id, if 'overwrite'
+         *        is true) with as few insert/update write commands as command size limits allow.
+         *        With 'ordered', writing stops at the first failed document.
+         *        Per document failures are reported in the result, not thrown.
+         * @throws std::runtime_error, if a write command fails as a whole
+         */
+        BulkWriteResult bulkWrite(const std::vector<mongo::BSONObj> &docs, const MongoNamespace &ns,
+                                  bool overwrite, bool ordered = true);
         void removeDocuments(const MongoNamespace &ns, mongo::Query query, bool justOne = true);
-        std::vector<MongoDocumentPtr> query(const MongoQueryInfo &info);
+        /**
+         * @brief Runs find query described by 'info'. 
+         *        If 'onBatch' is provided, documents are handed over batch by batch as they arrive
+         *        from server and only the documents of the last (possibly partial) batch are returned.
+         */
+        std::vector<MongoDocumentPtr> query(const MongoQueryInfo &info, 
+                                            DocumentsBatchHandler const& onBatch = nullptr);
+
+        /**
+         * @brief Opens cursor for query described by 'info' without limit, so that it can be kept 
+         *        open and consumed page by page with fetch(). Skip and batch size of 'info' are honored.
+         * @throws std::runtime_error, if cursor cannot be opened
+         */
+        std::unique_ptr<mongo::DBClientCursor> openCursor(const MongoQueryInfo &info);
 
+        /**
+         * @brief Reads at most 'count' documents from 'cursor', issuing getMore only when needed.
+         *        See query() for the meaning of 'onBatch'.
+         */
+        std::vector<MongoDocumentPtr> fetch(mongo::DBClientCursor *cursor, int count,
+                                            DocumentsBatchHandler const& onBatch = nullptr);
+
+        /**
+         * @brief Runs collStats for collection 'ns'. Returned info has no statistics
+         *        if the command failed (i.e. 'ns' is a view).
+         */
         MongoCollectionInfo runCollStatsCommand(const std::string &ns);
-        std::vector<MongoCollectionInfo> runCollStatsCommand(const std::vector<std::string> &namespaces);
+
+        /**
+         * @brief Operations in progress matching 'match', with idle cursors if 'idleCursors' is true
+         *        (MongoDB 4.2+). Operations of all users need 'inprog' privilege, operations of the
+         *        authenticated user only ('allUsers' false) need none. Runs $currentOp aggregation with
+         *        'projection' and reads all batches of its cursor, falls back to currentOp command
+         *        (without projection) on servers before 3.6.
+         * @throws std::runtime_error, if operations cannot be listed
+         */
+        std::vector<mongo::BSONObj> currentOps(const mongo::BSONObj &match, bool idleCursors = false,
+                                               const mongo::BSONObj &projection = mongo::BSONObj(),
+                                               bool allUsers = true);
+
+        /**
+         * @brief Kills operation 'opid' (number on mongod, "shard:opid" string on mongos)
+         * @throws std::runtime_error, if command failed
+         */
+        void killOp(const mongo::BSONElement &opid);
+
+        /**
+         * @brief Runs serverStatus without its largest sections (locks, metrics, tcmalloc)
+         * @throws std::runtime_error, if command failed
+         */
+        mongo::BSONObj serverStatus();
+
+        /**
+         * @brief Runs replSetGetStatus, returns empty object if server is not a replica set member
+         */
+        mongo::BSONObj replicaSetStatus();
+
+        /**
+         * @brief Number of operations that used each index of collection 'ns' since server start 
+         *        ($indexStats). Empty if server does not support $indexStats (before 3.2).
+         */
+        std::map<std::string, long long> indexStats(const MongoNamespace &ns);
+
+        /**
+         * @brief Reads 'size' random documents of collection 'ns' with $sample
+         * @throws std::runtime_error, if command failed
+         */
+        std::vector<mongo::BSONObj> sampleDocuments(const MongoNamespace &ns, int size);
+
+        /**
+         * @brief Runs aggregation 'pipeline' on collection 'ns' and reads all documents of its cursor
+         * @throws std::runtime_error, if command failed
+         */
+        std::vector<mongo::BSONObj> aggregate(const MongoNamespace &ns, const mongo::BSONObj &pipeline);
+
+        /**
+         * @brief Opens change stream 'pipeline' on collection 'ns', or on its database if 
+         *        collection name is empty. Returns the first batch without waiting for events.
+         * @throws std::runtime_error, if command failed
+         */
+        ChangeStreamBatch openChangeStream(const MongoNamespace &ns, const mongo::BSONObj &pipeline);
+
+        /**
+         * @brief Next batch of change stream cursor, waits at most 'maxAwaitTimeMS' for new events
+         * @throws std::runtime_error, if command failed
+         */
+        ChangeStreamBatch changeStreamGetMore(const MongoNamespace &ns, long long cursorId, int maxAwaitTimeMS);
+
+        /**
+         * @brief Kills cursor of change stream opened by openChangeStream()
+         */
+        void closeChangeStream(const MongoNamespace &ns, long long cursorId);
+
+        /**
+         * @brief Kills operations in progress and idle cursors of the connection that server knows
+         *        as 'clientAddress' (see 'whatsmyuri' command). Idle cursors are found only on 
+         *        MongoDB 4.2+ ($currentOp with idleCursors), older servers report active operations only.
+         * @return number of killed operations and cursors
+         * @throws std::runtime_error, if operations cannot be listed
+         */
+        int killClientOperations(const std::string &clientAddress);
+
+        /**
+         * @brief Runs { explain: 'command', verbosity: "executionStats" }. Falls back to "queryPlanner"
+         *        verbosity if server cannot run the command with execution statistics.
+         * @throws std::runtime_error, if command cannot be explained
+         */
+        mongo::BSONObj explain(const std::string &dbName, const mongo::BSONObj &command);
+
+        /**
+         * @brief Runs { profile: 'level', slowms: 'slowMs' } on database 'dbName'. 
+         *        Level -1 only reads current settings.
+         * @return profiling level and slow operation threshold in effect after the command
+         * @throws std::runtime_error, if command failed
+         */
+        std::pair<int, int> setProfilingLevel(const std::string &dbName, int level, int slowMs);
 
         void done();
 
     private:
         mongo::DBClientBase *const _dbclient;
-        void checkLastErrorAndThrow(const std::string &db);
+        mongo::BSONObj const _writeConcern;
+        mutable ServerMetadataCache _ownMetadataCache;
+        ServerMetadataCache *const _metadataCache;
+
+        /**
+         * @throws std::runtime_error with server error message, if command failed
+         */
+        void runCommandAndThrow(const std::string &dbName, const mongo::BSONObj &cmd);
+
+        /**
+         * @brief Copies all documents into existing collection on the server side with $out stage.
+         * @return false if server does not support $out
+         */
+        bool copyCollectionWithOut(const MongoNamespace &ns, const std::string &newCollectionName);
+
+        /**
+         * @brief Copies all documents through this client, batch by batch
+         */
+        void copyCollectionDocuments(const MongoNamespace &from, const MongoNamespace &to);
+
+        /**
+         * @brief Runs insert/update/delete command built in 'cmd' with the write concern of this client.
+         * @throws std::runtime_error, if command or write concern failed
+         */
+        mongo::BSONObj runWriteCommand(const std::string &dbName, mongo::BSONObjBuilder &cmd);
+        void throwOnWriteErrors(const mongo::BSONObj &response);
+
+        /**
+         * @brief Runs aggregate or getMore 'cmd' of change stream and reads its 'batchField'
+         * @throws std::runtime_error, if command failed
+         */
+        ChangeStreamBatch changeStreamBatch(const MongoNamespace &ns, const mongo::BSONObj &cmd, 
+                                            const char *batchField);
+
+        /**
+         * @brief Runs command 'cmd' of database 'dbName' which opens a cursor and reads all its documents,
+         *        the next batches with getMore of 'batchSize' (server default if 0) from 'collection'.
+         * @returns false if 'cmd' failed, its reply is in 'result' then
+         * @throws std::runtime_error, if getMore failed
+         */
+        bool readCommandCursor(const std::string &dbName, const std::string &collection, const mongo::BSONObj &cmd,
+                               int batchSize, std::vector<mongo::BSONObj> &documents, mongo::BSONObj &result);
     };
 }
@@ -14,10 +14,15 @@
 #include "robomongo/core/domain/App.h"
 #include "robomongo/core/domain/MongoShellResult.h"
 #include "robomongo/core/domain/MongoCollectionInfo.h"
+#include "robomongo/core/domain/IndexAdvisor.h"
+#include "robomongo/core/domain/SchemaAnalyzer.h"
+#include "robomongo/core/domain/ProfileAnalyzer.h"
+#include "robomongo/core/domain/ServerMetrics.h"
 #include "robomongo/core/events/MongoEvents.h"
 #include "robomongo/core/engine/ScriptEngine.h"
 #include "robomongo/core/EventBus.h"
 #include "robomongo/core/mongodb/MongoClient.h"
+#include "robomongo/core/mongodb/CollectionCopier.h"
 #include "robomongo/core/settings/ConnectionSettings.h"
 #include "robomongo/core/settings/ReplicaSetSettings.h"
 #include "robomongo/core/settings/CredentialSettings.h"
@@ -26,21 +31,127 @@
 #include "robomongo/core/utils/BsonUtils.h"
 #include "robomongo/core/utils/Logger.h"
 #include "robomongo/core/utils/QtUtils.h"
+#include "robomongo/shell/bson/json.h"
 #include "robomongo/utils/StringOperations.h"
 
+namespace
+{
+    // Cached query cursors idle longer than this are killed. MongoDB itself times out 
+    // idle cursors after 10 minutes by default.
+    constexpr int QUERY_CURSOR_IDLE_TIMEOUT_MSEC { 5 * 60 * 1000 };
+
+    // Collection statistics are shown from cache when not older than this
+    constexpr int COLL_STATS_CACHE_TTL_MSEC { 5 * 60 * 1000 };
+
+    // Number of collStats commands run in parallel (each on its own connection)
+    constexpr int COLL_STATS_CONCURRENCY { 2 };
+
+    // Page size of 'system.profile' reads and interval of partial profile statistics replies
+    constexpr int PROFILE_PAGE_SIZE { 1000 };
+    constexpr int PROFILE_PROGRESS_INTERVAL_MSEC { 500 };
+
+    // Change stream getMore waits this long for new events. Streams of a server share one lane,
+    // so it also bounds how long one stream delays the others.
+    constexpr int CHANGE_STREAM_AWAIT_MSEC { 500 };
+
+    // Returns true if cursor opened for 'cursorInfo' can serve next page of 'pageInfo'
+    bool isSameQuery(Robomongo::MongoQueryInfo const& cursorInfo, Robomongo::MongoQueryInfo const& pageInfo)
+    {
+        return cursorInfo._info._ns.toString() == pageInfo._info._ns.toString() &&
+               cursorInfo._query.binaryEqual(pageInfo._query) &&
+               cursorInfo._fields.binaryEqual(pageInfo._fields) &&
+               cursorInfo._options == pageInfo._options &&
+               cursorInfo._limit == pageInfo._limit &&
+               cursorInfo._batchSize == pageInfo._batchSize;
+    }
+
+    // { w: 0 } or { w: "majority" }. Empty when unset or left at default { w: 1 }, so that
+    // commands run with server (or replica set) default write concern.
+    mongo::BSONObj writeConcernObj(std::string const& w)
+    {
+        if (w.empty() || w == "1")
+            return mongo::BSONObj();
+
+        if (w == "majority")
+            return BSON("w" << w);
+
+        return BSON("w" << (w == "0" ? 0 : 1));
+    }
+
+    // Connections take TLS parameters from process-global mongo::sslGlobalParams, which are set by the
+    // worker that connects. Another server can be connected with them only if it needs the same ones.
+    bool sameGlobalSSLparams(Robomongo::SslSettings const& a, Robomongo::SslSettings const& b)
+    {
+        if (a.sslEnabled() != b.sslEnabled())
+            return false;
+
+        if (!a.sslEnabled())
+            return true;
+
+        return a.allowInvalidCertificates() == b.allowInvalidCertificates() && a.caFile() == b.caFile() &&
+               a.usePemFile() == b.usePemFile() && a.pemKeyFile() == b.pemKeyFile() &&
+               a.pemPassPhrase() == b.pemPassPhrase() && a.useAdvancedOptions() == b.useAdvancedOptions() &&
+               a.crlFile() == b.crlFile() && a.allowInvalidHostnames() == b.allowInvalidHostnames();
+    }
+
+    // { aggregate: <collection>, pipeline: [ ... ], cursor: {}, <options> } of unpaged aggregation
+    mongo::BSONObj aggregateCommand(Robomongo::AggrInfo const& aggrInfo)
+    {
+        mongo::BSONObjBuilder command;
+        command.append("aggregate", aggrInfo.collectionName);
+        command.appendArray("pipeline", aggrInfo.pipeline);
+        command.append("cursor", mongo::BSONObj());
+
+        mongo::BSONObjIterator it(aggrInfo.options);
+        while (it.more()) {
+            mongo::BSONElement const option = it.next();
+            if (option.fieldNameStringData() != "cursor" && option.fieldNameStringData() != "explain")
+                command.append(option);
+        }
+
+        return command.obj();
+    }
+
+    // Reads up to 'maxEntries' newest documents of 'system.profile' collection of 'dbName' with the 
+    // cursor paging of query results. 'onPage' is called with every page read.
+    void readProfile(Robomongo::MongoClient *client, std::string const& serverAddress, std::string const& dbName,
+                     long long maxEntries, std::function<void(std::vector<Robomongo::MongoDocumentPtr> const&)> const& onPage)
+    {
+        using namespace Robomongo;
+
+        MongoQueryInfo const info(CollectionInfo(serverAddress, dbName, "system.profile"),
+                                  BSON("query" << mongo::BSONObj() << "orderby" << BSON("$natural" << -1)),
+                                  mongo::BSONObj(), 0, 0, PROFILE_PAGE_SIZE, 0, true);
+        std::unique_ptr<mongo::DBClientCursor> cursor = client->openCursor(info);
+
+        long long read = 0;
+        while (read < maxEntries) {
+            int const pageSize = std::min<long long>(PROFILE_PAGE_SIZE, maxEntries - read);
+            auto const docs = client->fetch(cursor.get(), pageSize);
+            read += docs.size();
+            onPage(docs);
+
+            if (docs.size() < static_cast<size_t>(pageSize))
+                break;
+        }
+    }
+}
+
 namespace Robomongo
 {
     std::string const APP_VERSION = PROJECT_VERSION;
     std::string const APP_NAME_VERSION { "robo3t-" + APP_VERSION };
 
     MongoWorker::MongoWorker(ConnectionSettings *connection, bool isLoadMongoRcJs, int batchSize,
-                             double mongoTimeoutSec, int shellTimeoutSec, QObject *parent) 
+                             double mongoTimeoutSec, int shellTimeoutSec, WorkerLane lane, QObject *parent) 
         : QObject(parent),
+        _lane(lane),
         _scriptEngine(nullptr),
         _isLoadMongoRcJs(isLoadMongoRcJs),
         _batchSize(batchSize),
         _timerId(-1),
         _dbAutocompleteCacheTimerId(-1),
+        _queryCursorsTimerId(-1),
         _mongoTimeoutSec(mongoTimeoutSec),
         _shellTimeoutSec(shellTimeoutSec),
         _isQuiting(0),
@@ -64,10 +175,15 @@ namespace Robomongo
             return;
         }
 
-        if (_dbAutocompleteCacheTimerId == event->timerId() && !_scriptEngine) {
+        if (_dbAutocompleteCacheTimerId == event->timerId() && _scriptEngine) {
             _scriptEngine->invalidateDbCollectionsCache();
             return;
         }
+
+        if (_queryCursorsTimerId == event->timerId()) {
+            evictIdleQueryCursors();
+            return;
+        }
     }
 
     void MongoWorker::restartReplicaSetConnection()
@@ -86,6 +202,7 @@ namespace Robomongo
         };
 
         _dbclientRepSet.release();
+        _serverMetadata.invalidate();
         if(mongo::DBClientBase *conn = getConnection(true).first)
             conn->auth(authParams);
     }
@@ -112,13 +229,20 @@ namespace Robomongo
     void MongoWorker::init()
     {        
         try {
-            _scriptEngine.reset(new ScriptEngine(_connSettings, _shellTimeoutSec));
-            _scriptEngine->init(_isLoadMongoRcJs);
-            _scriptEngine->use(_connSettings->defaultDatabase());
-            _scriptEngine->setBatchSize(_batchSize);
+            if (_lane == WorkerLane::Script) {
+                _scriptEngine.reset(new ScriptEngine(_connSettings, _shellTimeoutSec));
+                _scriptEngine->init(_isLoadMongoRcJs);
+                _scriptEngine->use(_connSettings->defaultDatabase());
+                _scriptEngine->setBatchSize(_batchSize);
+            }
+            // Timers are started once, init() is called again with every reconnect
             constexpr int PING_INTERVAL_MSEC { 60 * 1000 };  // 60 seconds
-            _timerId = startTimer(PING_INTERVAL_MSEC);
-            _dbAutocompleteCacheTimerId = startTimer(30000);
+            if (_timerId == -1)
+                _timerId = startTimer(PING_INTERVAL_MSEC);
+            if (_dbAutocompleteCacheTimerId == -1)
+                _dbAutocompleteCacheTimerId = startTimer(30000);
+            if (_queryCursorsTimerId == -1)
+                _queryCursorsTimerId = startTimer(60 * 1000);
         } catch (const std::exception &ex) {
             auto const msg { "Failed to initialize MongoWorker. Reason: "};
             sendLog(this, LogEvent::RBM_ERROR, msg + std::string(ex.what()));
@@ -126,15 +250,17 @@ namespace Robomongo
         }
     }
 
-    void MongoWorker::interrupt() {
+    std::string MongoWorker::interrupt() {
         try {
             if (_isQuiting || !_scriptEngine)
-                return;
+                return "";
 
             _scriptEngine->interrupt();
+            return _scriptEngine->clientAddress();
         } catch(const std::exception &ex) {
             sendLog(this, LogEvent::RBM_ERROR, std::string(ex.what()));
         }
+        return "";
     }
 
     MongoWorker::~MongoWorker()
@@ -145,6 +271,15 @@ namespace Robomongo
         if (_dbAutocompleteCacheTimerId != -1)
             killTimer(_dbAutocompleteCacheTimerId);
 
+        if (_queryCursorsTimerId != -1)
+            killTimer(_queryCursorsTimerId);
+
+        // Tab is closed, free server-side cursors while connection is still alive
+        killQueryCursors();
+
+        // Loader threads use connection settings
+        _collStatsLoader.reset();
+
         delete _connSettings;
 
         // QThread "_thread" and MongoWorker itself will be deleted later
@@ -172,6 +307,9 @@ namespace Robomongo
         std::unique_ptr<ReplicaSet> repSetInfo(new ReplicaSet);
         auto errorCode = EventError::ErrorCode::Unknown;
 
+        // Metadata is loaded again for the new connection on first use
+        _serverMetadata.invalidate();
+
         try {
             auto const& connAndErrorStr = getConnection(true);
             mongo::DBClientBase *conn = connAndErrorStr.first;           
@@ -420,22 +558,94 @@ namespace Robomongo
     }
 
     /**
-     * @brief Load list of all collection names
+     * @brief Load list of all collection names. Statistics are taken from cache, 
+     * missing or expired ones are loaded in background (see CollectionStatsLoadedEvent).
      */
     void MongoWorker::handle(LoadCollectionNamesRequest *event)
     {
         try {
             boost::scoped_ptr<MongoClient> client(getClient());
             auto const& namespaces = client->getCollectionNamesWithDbname(event->databaseName());
-            std::vector<MongoCollectionInfo> const& collInfos = client->runCollStatsCommand(namespaces);
             client->done();
+
+            std::vector<MongoCollectionInfo> collInfos;
+            std::vector<std::string> staleNamespaces;
+            {
+                QMutexLocker lock(&_collStatsMutex);
+                for (auto const& ns : namespaces) {
+                    auto const cached = _collStatsCache.find(ns);
+                    if (cached != _collStatsCache.end() && 
+                        !cached->second.loaded.hasExpired(COLL_STATS_CACHE_TTL_MSEC)) {
+                        collInfos.push_back(cached->second.info);
+                    }
+                    else {
+                        collInfos.push_back(MongoCollectionInfo(ns));
+                        staleNamespaces.push_back(ns);
+                    }
+                }
+            }
+
             reply(event->sender(), new LoadCollectionNamesResponse(this, event->databaseName(), collInfos));
+            loadCollectionStats(event->databaseName(), staleNamespaces);
         } catch(const std::exception &ex) {
             reply(event->sender(), new LoadCollectionNamesResponse(this, EventError(ex.what())));
             // Logging handled in main thread
         }
     }
 
+    void MongoWorker::eraseCollectionStats(const std::vector<std::string> &namespaces)
+    {
+        QMutexLocker lock(&_collStatsMutex);
+        ++_collStatsGeneration;
+        for (auto const& ns : namespaces) {
+            _collStatsCache.erase(ns);
+            _collStatsErased[ns] = _collStatsGeneration;
+        }
+    }
+
+    void MongoWorker::loadCollectionStats(const std::string &databaseName, const std::vector<std::string> &namespaces)
+    {
+        // Loader threads connect with TLS parameters set here, on the thread of this worker
+        configureSSL();
+        if (!_collStatsLoader) {
+            auto const onLoaded = [this](const std::string &dbName, const std::vector<MongoCollectionInfo> &infos,
+                                         unsigned long long generation) {
+                std::vector<MongoCollectionInfo> current;
+                {
+                    QMutexLocker lock(&_collStatsMutex);
+                    for (auto const& info : infos) {
+                        // Collection was created, dropped or renamed after its statistics were requested
+                        auto const erased = _collStatsErased.find(info.fullName());
+                        if (erased != _collStatsErased.end() && erased->second > generation)
+                            continue;
+
+                        CachedCollectionStats &cached = _collStatsCache[info.fullName()];
+                        cached.info = info;
+                        cached.loaded.start();
+                        current.push_back(info);
+                    }
+                }
+
+                // Published (not replied), because requesting database may be already removed
+                if (!_isQuiting && !current.empty())
+                    AppRegistry::instance().bus()->publish(new CollectionStatsLoadedEvent(this, dbName, current));
+            };
+
+            _collStatsLoader.reset(new CollectionStatsLoader(
+                [this]() { return openConnection(); }, onLoaded, COLL_STATS_CONCURRENCY
+            ));
+        }
+
+        unsigned long long generation = 0;
+        {
+            QMutexLocker lock(&_collStatsMutex);
+            generation = _collStatsGeneration;
+        }
+
+        // Called even with empty list, to drop pending requests of previous listing
+        _collStatsLoader->load(databaseName, namespaces, generation);
+    }
+
     void MongoWorker::handle(LoadUsersRequest *event)
     {
         try {
@@ -507,7 +717,7 @@ namespace Robomongo
             client->done();
 
             // If list of functions from client is empty, try getting it with script engine
-            if (funcs.empty()) {
+            if (funcs.empty() && _scriptEngine) {
                 MongoShellExecResult const& result = _scriptEngine->exec("db.system.js.find()", event->databaseName());
                 std::vector<MongoFunction> functions;
                 if (!result.results().empty()) {
@@ -545,6 +755,42 @@ namespace Robomongo
         }
     }
 
+    void MongoWorker::handle(BulkWriteRequest *event)
+    {
+        int const nDocs = static_cast<int>(event->docs().size());
+        try {
+            boost::scoped_ptr<MongoClient> client(getClient());
+            BulkWriteResult const result = 
+                client->bulkWrite(event->docs(), event->ns(), event->overwrite(), event->ordered());
+            client->done();
+
+            if (result.writeErrors.empty()) {
+                reply(event->sender(), new BulkWriteResponse(this, result, nDocs, event->overwrite()));
+                return;
+            }
+
+            // Aggregated message, listing first few failed documents
+            size_t const maxListed = 10;
+            std::string errStr = "Failed to write " + std::to_string(result.writeErrors.size()) + 
+                                 " of " + std::to_string(nDocs) + " documents:";
+            for (size_t i = 0; i < result.writeErrors.size() && i < maxListed; ++i) {
+                auto const& writeError = result.writeErrors[i];
+                errStr += "\n  #" + std::to_string(writeError.index + 1) + ": " + writeError.message;
+            }
+            if (result.writeErrors.size() > maxListed)
+                errStr += "\n  ... and " + std::to_string(result.writeErrors.size() - maxListed) + " more";
+
+            reply(event->sender(), 
+                  new BulkWriteResponse(this, result, nDocs, event->overwrite(), EventError(errStr)));
+            sendLog(this, LogEvent::RBM_ERROR, errStr);
+        }
+        catch(const std::exception &ex) {
+            reply(event->sender(), 
+                  new BulkWriteResponse(this, BulkWriteResult(), nDocs, event->overwrite(), EventError(ex.what())));
+            sendLog(this, LogEvent::RBM_ERROR, ex.what());
+        }
+    }
+
     void MongoWorker::handle(RemoveDocumentRequest *event)
     {
         try {
@@ -567,10 +813,22 @@ namespace Robomongo
     {
         auto const executeQuery = [&]() {
             boost::scoped_ptr<MongoClient> client { getClient() };
-            std::vector<MongoDocumentPtr> docs = client->query(event->queryInfo());
+            bool firstChunk = true;
+            MongoClient::DocumentsBatchHandler onBatch = nullptr;
+            if (event->streamed()) {
+                onBatch = [&](std::vector<MongoDocumentPtr> const& batch) {
+                    reply(event->sender(), new ExecuteQueryResponse(
+                        this, event->resultIndex(), event->queryInfo(), batch, firstChunk, false)
+                    );
+                    firstChunk = false;
+                };
+            }
+
+            std::vector<MongoDocumentPtr> docs = queryPage(client.get(), event, onBatch);
             client->done();
             reply(event->sender(),
-                new ExecuteQueryResponse(this, event->resultIndex(), event->queryInfo(), docs)
+                new ExecuteQueryResponse(this, event->resultIndex(), event->queryInfo(), docs, 
+                                         firstChunk, true)
             );
         };
 
@@ -599,6 +857,155 @@ namespace Robomongo
         }
     }
 
+    std::vector<MongoDocumentPtr> MongoWorker::queryPage(MongoClient *client, ExecuteQueryRequest *event,
+                                                         MongoClient::DocumentsBatchHandler const& onBatch)
+    {
+        auto const key = std::make_pair(event->sender(), event->resultIndex());
+        MongoQueryInfo const& info = event->queryInfo();
+
+        if (info._limit == -1) { // it means that we do not need to load any documents
+            _queryCursors.erase(key);
+            return {};
+        }
+
+        // Documents handed over in streamed chunks also move the cursor position
+        int streamedCount = 0;
+        MongoClient::DocumentsBatchHandler countingOnBatch = nullptr;
+        if (onBatch) {
+            countingOnBatch = [&](std::vector<MongoDocumentPtr> const& batch) {
+                streamedCount += batch.size();
+                onBatch(batch);
+            };
+        }
+
+        auto it = _queryCursors.find(key);
+        if (it != _queryCursors.end()) {
+            QueryCursor &cached = it->second;
+            if (cached.nextSkip == info._skip && isSameQuery(cached.queryInfo, info)) {
+                try {
+                    auto docs = client->fetch(cached.cursor.get(), info._limit, countingOnBatch);
+                    cached.nextSkip += streamedCount + docs.size();
+                    cached.lastUsed.restart();
+                    return docs;
+                }
+                catch (const std::exception &ex) {
+                    // Most probably cursor was timed out on server, fall back to fresh query
+                    sendLog(this, LogEvent::RBM_WARN, 
+                        "Failed to reuse query cursor, re-running query. Reason: " + std::string(ex.what()));
+                }
+            }
+            _queryCursors.erase(it);
+        }
+
+        // Cursor of previous page is gone, continue after its last document if possible. 
+        // Cursor is cached with original query info, so that following pages reuse it.
+        MongoQueryInfo keysetInfo;
+        bool const keyset = !info._keysetAfter.isEmpty() && keysetPage(client, info, keysetInfo);
+
+        QueryCursor newCursor;
+        newCursor.cursor = client->openCursor(keyset ? keysetInfo : info);
+        newCursor.queryInfo = info;
+        streamedCount = 0;
+
+        auto docs = client->fetch(newCursor.cursor.get(), info._limit, countingOnBatch);
+        newCursor.nextSkip = info._skip + streamedCount + docs.size();
+        newCursor.lastUsed.start();
+
+        // Nothing left on server, no need to keep cursor
+        if (!newCursor.cursor->isDead() || newCursor.cursor->moreInCurrentBatch())
+            _queryCursors[key] = std::move(newCursor);
+
+        return docs;
+    }
+
+    bool MongoWorker::keysetPage(MongoClient *client, const MongoQueryInfo &info, MongoQueryInfo &page)
+    {
+        try {
+            mongo::BSONObj const userSort = info.keysetSortPattern(false);
+            if (userSort.isEmpty())
+                return false;
+
+            // Sort that is unique by itself (i.e. { _id: 1 } or keys of a unique index) needs no 
+            // _id tie breaker, which would stop a { key: 1 } index from serving { key: 1, _id: 1 }
+            bool uniqueSort = false;
+            bool servedSort = false;
+            mongo::BSONObj const tieBrokenSort = info.keysetSortPattern(true);
+            for (auto const& spec : client->getIndexSpecs(info._info._ns)) {
+                mongo::BSONObj const indexKey = spec.getObjectField("key");
+                bool const unique = spec["unique"].trueValue() || 
+                                    std::string(spec.getStringField("name")) == "_id_";
+                // Sparse and partial indexes do not hold every document, not unique over all of them
+                bool const complete = !spec["sparse"].trueValue() && !spec.hasField("partialFilterExpression");
+
+                if (unique && complete && indexKey.nFields() == userSort.nFields() &&
+                    MongoQueryInfo::indexServesSort(indexKey, userSort))
+                    uniqueSort = true;
+                if (MongoQueryInfo::indexServesSort(indexKey, tieBrokenSort))
+                    servedSort = true;
+            }
+
+            // Without index server would sort all remaining documents for each page
+            if (!uniqueSort && !servedSort)
+                return false;
+
+            // $gt/$lt match values of the same BSON type only: if the smallest and the largest 
+            // value of each sort key are of the same type, so are all values in between
+            mongo::BSONObj const sortPattern = info.keysetSortPattern(!uniqueSort);
+            mongo::BSONObjIterator keys(sortPattern);
+            while (keys.more()) {
+                std::string const key = keys.next().fieldName();
+                auto const first = client->query(info.keysetBoundary(key, 1));
+                auto const last = client->query(info.keysetBoundary(key, -1));
+                if (first.empty() || last.empty())
+                    return false;
+
+                mongo::BSONElement const min = first.front()->bsonObj().getFieldDotted(key);
+                mongo::BSONElement const max = last.front()->bsonObj().getFieldDotted(key);
+                if (min.eoo() || max.eoo() || min.type() == mongo::Array || max.type() == mongo::Array ||
+                    min.canonicalType() != max.canonicalType())
+                    return false;
+            }
+
+            return info.keysetNextPage(info._keysetAfter, info._limit, info._skip, page, !uniqueSort);
+        }
+        catch (const std::exception &ex) {
+            sendLog(this, LogEvent::RBM_WARN, 
+                "Failed to check keyset paging, using skip. Reason: " + std::string(ex.what()));
+            return false;
+        }
+    }
+
+    void MongoWorker::killQueryCursors(QObject *sender /* = nullptr */)
+    {
+        try {
+            for (auto it = _queryCursors.begin(); it != _queryCursors.end();) {
+                if (!sender || it->first.first == sender)
+                    it = _queryCursors.erase(it);   // ~DBClientCursor() issues killCursors
+                else
+                    ++it;
+            }
+        }
+        catch (const std::exception &ex) {
+            _queryCursors.clear();
+            sendLog(this, LogEvent::RBM_WARN, "Failed to kill query cursors. " + std::string(ex.what()));
+        }
+    }
+
+    void MongoWorker::evictIdleQueryCursors()
+    {
+        try {
+            for (auto it = _queryCursors.begin(); it != _queryCursors.end();) {
+                if (it->second.lastUsed.hasExpired(QUERY_CURSOR_IDLE_TIMEOUT_MSEC))
+                    it = _queryCursors.erase(it);
+                else
+                    ++it;
+            }
+        }
+        catch (const std::exception &ex) {
+            sendLog(this, LogEvent::RBM_WARN, "Failed to kill idle query cursors. " + std::string(ex.what()));
+        }
+    }
+
     /**
      * @brief Execute javascript
      */
@@ -626,13 +1033,24 @@ namespace Robomongo
                 }
             }
 
+            // New results replace all parts of the output, except for aggregation paging which 
+            // updates a single part
+            if (!event->aggrInfo.isValid)
+                killQueryCursors(event->sender());
+
             // todo: should we use dbName from event or _connSettings? 
             MongoShellExecResult result {
                 _scriptEngine->exec(
-                    event->script, _connSettings->defaultDatabase(), event->aggrInfo
+                    event->script, _connSettings->defaultDatabase(), event->aggrInfo, event->maxTimeMS
                 )
             };
 
+            // Stopped by user, script must not be re-run
+            if (result.error() && _scriptEngine->interrupted()) {
+                reply(event->sender(), new ExecuteScriptResponse(this, EventError(result.errorMessage())));
+                return;
+            }
+
             // To fix the problem where 'result' comes with old primary address.
             if (_connSettings->isReplicaSet()) 
                 result.setCurrentServer(
@@ -668,7 +1086,7 @@ namespace Robomongo
             mongodbClient->checkConnection();
 
         MongoShellExecResult const result {
-            _scriptEngine->exec(event->script, _connSettings->defaultDatabase())
+            _scriptEngine->exec(event->script, _connSettings->defaultDatabase(), AggrInfo(), event->maxTimeMS)
         };
         if (result.error()) {
             auto const error { EventError(result.errorMessage()) };
@@ -686,19 +1104,286 @@ namespace Robomongo
     /**
      * @brief Interrupt javascript execution
      */
-    void MongoWorker::handle(StopScriptRequest *)
+    void MongoWorker::handle(ReleaseQueryCursorsRequest *event)
+    {
+        killQueryCursors(event->sender());
+    }
+
+    void MongoWorker::handle(ExplainQueryRequest *event)
     {
         try {
-            if (!_scriptEngine) {
-                return;
+            bool const isFind = event->queryInfo._info.isValid();
+            if (!isFind && !event->aggrInfo.isValid)
+                throw std::runtime_error("Nothing to explain: result was not produced by find() or aggregate().");
+
+            std::string const dbName = isFind ? event->queryInfo._info._ns.databaseName() : event->databaseName;
+            mongo::BSONObj const command = isFind ? event->queryInfo.findCommand() 
+                                                  : aggregateCommand(event->aggrInfo);
+
+            QElapsedTimer timer;
+            timer.start();
+
+            boost::scoped_ptr<MongoClient> client(getClient());
+            mongo::BSONObj const explain = client->explain(dbName, command);
+            client->done();
+
+            reply(event->sender(), new ExplainQueryResponse(this, explain.getOwned(), timer.elapsed()));
+        } catch(const std::exception &ex) {
+            reply(event->sender(), new ExplainQueryResponse(this, EventError(ex.what())));
+            sendLog(this, LogEvent::RBM_ERROR, std::string(ex.what()));
+        }
+    }
+
+    void MongoWorker::handle(ProfilingLevelRequest *event)
+    {
+        try {
+            boost::scoped_ptr<MongoClient> client(getClient());
+            auto const profiling = client->setProfilingLevel(event->databaseName, event->level, event->slowMs);
+            client->done();
+
+            reply(event->sender(), new ProfilingLevelResponse(this, profiling.first, profiling.second));
+        } catch(const std::exception &ex) {
+            reply(event->sender(), new ProfilingLevelResponse(this, EventError(ex.what())));
+            sendLog(this, LogEvent::RBM_ERROR, std::string(ex.what()));
+        }
+    }
+
+    void MongoWorker::handle(AnalyzeProfileRequest *event)
+    {
+        try {
+            // Newest entries first. Shapes are computed here, GUI thread receives only the aggregated statistics.
+            boost::scoped_ptr<MongoClient> client(getClient());
+            ProfileAnalyzer analyzer;
+            QElapsedTimer sinceProgress;
+            sinceProgress.start();
+
+            readProfile(client.get(), _connSettings->getFullAddress(), event->databaseName, event->maxEntries,
+                [&](std::vector<MongoDocumentPtr> const& page) {
+                    for (auto const& doc : page)
+                        analyzer.add(doc->bsonObj());
+
+                    if (sinceProgress.elapsed() >= PROFILE_PROGRESS_INTERVAL_MSEC) {
+                        reply(event->sender(), new ProfileAnalyzedEvent(this, analyzer.entries(), analyzer.shapes(), false));
+                        sinceProgress.restart();
+                    }
+                });
+            client->done();
+
+            reply(event->sender(), new ProfileAnalyzedEvent(this, analyzer.entries(), analyzer.shapes(), true));
+        } catch(const std::exception &ex) {
+            reply(event->sender(), new ProfileAnalyzedEvent(this, EventError(ex.what())));
+            sendLog(this, LogEvent::RBM_ERROR, std::string(ex.what()));
+        }
+    }
+
+    void MongoWorker::handle(AdviseIndexesRequest *event)
+    {
+        try {
+            boost::scoped_ptr<MongoClient> client(getClient());
+            IndexAdvisor advisor;
+
+            readProfile(client.get(), _connSettings->getFullAddress(), event->databaseName, event->maxEntries,
+                [&advisor](std::vector<MongoDocumentPtr> const& page) {
+                    for (auto const& doc : page)
+                        advisor.addProfileEntry(doc->bsonObj());
+                });
+
+            for (auto const& ns : client->getCollectionNamesWithDbname(event->databaseName)) {
+                MongoCollectionInfo const collection(ns);
+                if (collection.ns().collectionName().compare(0, 7, "system.") == 0)
+                    continue;
+
+                try {
+                    std::map<std::string, long long> const accesses = client->indexStats(collection.ns());
+                    for (auto const& spec : client->getIndexSpecs(collection.ns())) {
+                        std::string const name = spec.getStringField("name");
+                        auto const indexAccesses = accesses.find(name);
+                        advisor.addIndex(ns, name, spec.getObjectField("key"), spec,
+                                         indexAccesses == accesses.end() ? -1 : indexAccesses->second);
+                    }
+                }
+                catch (const std::exception &) {
+                    // Views have no indexes
+                }
             }
+            client->done();
 
-            _scriptEngine->interrupt();
+            reply(event->sender(), new AdviseIndexesResponse(this, advisor.advise()));
+        } catch(const std::exception &ex) {
+            reply(event->sender(), new AdviseIndexesResponse(this, EventError(ex.what())));
+            sendLog(this, LogEvent::RBM_ERROR, std::string(ex.what()));
+        }
+    }
+
+    void MongoWorker::handle(AnalyzeSchemaRequest *event)
+    {
+        try {
+            boost::scoped_ptr<MongoClient> client(getClient());
+            std::vector<mongo::BSONObj> const documents = client->sampleDocuments(event->ns, event->sampleSize);
+            client->done();
+
+            reply(event->sender(), 
+                  new SchemaAnalyzedEvent(this, SchemaAnalyzer::analyze(event->ns.toString(), documents)));
+        } catch(const std::exception &ex) {
+            reply(event->sender(), new SchemaAnalyzedEvent(this, event->ns.toString(), EventError(ex.what())));
+            sendLog(this, LogEvent::RBM_ERROR, std::string(ex.what()));
+        }
+    }
+
+    void MongoWorker::handle(PreviewPipelineRequest *event)
+    {
+        std::string const ns = event->ns.toString();
+        try {
+            boost::scoped_ptr<MongoClient> client(getClient());
+
+            // A failed prefix does not stop the others, each one reports its own result
+            for (auto const& pipeline : event->prefixes) {
+                try {
+                    QElapsedTimer timer;
+                    timer.start();
+                    std::vector<mongo::BSONObj> const documents = client->aggregate(event->ns, pipeline);
+                    reply(event->sender(), new PipelineStagePreviewEvent(this, ns, pipeline, documents, timer.elapsed()));
+                } catch(const std::exception &ex) {
+                    reply(event->sender(), new PipelineStagePreviewEvent(this, ns, pipeline, EventError(ex.what())));
+                }
+            }
+
+            AggrInfo const aggrInfo(event->ns.collectionName(), 0, 0, event->explainPipeline, mongo::BSONObj(), -1);
+            mongo::BSONObj const explain = client->explain(event->ns.databaseName(), aggregateCommand(aggrInfo));
+            client->done();
+
+            reply(event->sender(), new PipelineExplainedEvent(this, ns, event->explainPipeline, explain.getOwned()));
         } catch(const std::exception &ex) {
+            reply(event->sender(), new PipelineExplainedEvent(this, ns, event->explainPipeline, EventError(ex.what())));
+        }
+    }
+
+    void MongoWorker::handle(CurrentOpsRequest *event)
+    {
+        try {
+            // Only fields shown by monitor are sent by server, sampling runs every few seconds for hours
+            static mongo::BSONObj const projection = BSON(
+                "opid" << 1 << "op" << 1 << "ns" << 1 << "client" << 1 << "appName" << 1 << "desc" << 1 <<
+                "secs_running" << 1 << "microsecs_running" << 1 << "planSummary" << 1 << 
+                "waitingForLock" << 1 << "command" << 1);
+
+            boost::scoped_ptr<MongoClient> client(getClient());
+            std::vector<mongo::BSONObj> const ops = client->currentOps(mongo::BSONObj(), false, projection);
+            client->done();
+
+            reply(event->sender(), new CurrentOpsResponse(this, ops));
+        } catch(const std::exception &ex) {
+            reply(event->sender(), new CurrentOpsResponse(this, EventError(ex.what())));
+        }
+    }
+
+    void MongoWorker::handle(KillOpRequest *event)
+    {
+        try {
+            boost::scoped_ptr<MongoClient> client(getClient());
+            client->killOp(event->op.getField("opid"));
+            client->done();
+
+            reply(event->sender(), new KillOpResponse(this, event->op));
+        } catch(const std::exception &ex) {
+            reply(event->sender(), new KillOpResponse(this, EventError(ex.what())));
             sendLog(this, LogEvent::RBM_ERROR, std::string(ex.what()));
         }
     }
 
+    void MongoWorker::handle(ServerStatusRequest *event)
+    {
+        try {
+            boost::scoped_ptr<MongoClient> client(getClient());
+            mongo::BSONObj const status = client->serverStatus();
+
+            // Replication lag is not in serverStatus, it is computed from optimes of members
+            double lag = -1;
+            if (status.getObjectField("repl").hasField("setName"))
+                lag = ServerMetrics::replicationLag(client->replicaSetStatus());
+            client->done();
+
+            reply(event->sender(), new ServerStatusResponse(this, status, lag));
+        } catch(const std::exception &ex) {
+            reply(event->sender(), new ServerStatusResponse(this, EventError(ex.what())));
+        }
+    }
+
+    void MongoWorker::handle(WatchChangesRequest *event)
+    {
+        try {
+            boost::scoped_ptr<MongoClient> client(getClient());
+            ChangeStreamBatch const batch = client->openChangeStream(event->ns, event->pipeline);
+            client->done();
+
+            if (batch.cursorId)
+                _changeStreams[event->watchId] = std::make_pair(event->ns, batch.cursorId);
+
+            reply(event->sender(), new ChangeStreamResponse(this, event->watchId, batch));
+        } catch(const std::exception &ex) {
+            reply(event->sender(), new ChangeStreamResponse(this, event->watchId, EventError(ex.what())));
+        }
+    }
+
+    void MongoWorker::handle(ChangeStreamGetMoreRequest *event)
+    {
+        try {
+            boost::scoped_ptr<MongoClient> client(getClient());
+            ChangeStreamBatch const batch = client->changeStreamGetMore(event->ns, event->cursorId, 
+                                                                        CHANGE_STREAM_AWAIT_MSEC);
+            client->done();
+
+            // Server closes the cursor when the stream is invalidated
+            if (!batch.cursorId)
+                _changeStreams.erase(event->watchId);
+
+            reply(event->sender(), new ChangeStreamResponse(this, event->watchId, batch));
+        } catch(const std::exception &ex) {
+            _changeStreams.erase(event->watchId);
+            reply(event->sender(), new ChangeStreamResponse(this, event->watchId, EventError(ex.what())));
+        }
+    }
+
+    void MongoWorker::handle(CloseChangeStreamRequest *event)
+    {
+        auto const it = _changeStreams.find(event->watchId);
+        if (it == _changeStreams.end())
+            return;
+
+        std::pair<MongoNamespace, long long> const cursor = it->second;
+        _changeStreams.erase(it);
+
+        try {
+            boost::scoped_ptr<MongoClient> client(getClient());
+            client->closeChangeStream(cursor.first, cursor.second);
+            client->done();
+        } catch(const std::exception &) {
+            // Server times out cursors that were not killed
+        }
+    }
+
+    void MongoWorker::handle(StopScriptRequest *event)
+    {
+        try {
+            // Scope is interrupted first, so that script does not go on when its operation is killed
+            std::string const clientAddress = event->scriptWorker->interrupt();
+            if (clientAddress.empty())
+                return;
+
+            // Operations and cursors of the shell connection are killed from connection of this lane
+            boost::scoped_ptr<MongoClient> client(getClient());
+            int const killed = client->killClientOperations(clientAddress);
+            client->done();
+
+            if (killed > 0) {
+                sendLog(this, LogEvent::RBM_INFO, 
+                        "Killed " + std::to_string(killed) + " operations and cursors of stopped script.");
+            }
+        } catch(const std::exception &ex) {
+            sendLog(this, LogEvent::RBM_ERROR, "Failed to stop script. " + std::string(ex.what()));
+        }
+    }
+
     void MongoWorker::handle(AutocompleteRequest *event)
     {
         try {
@@ -763,6 +1448,7 @@ namespace Robomongo
             client->createCollection(event->ns().toString(), event->getSize(), event->getCapped(),
                 event->getMaxDocNum(), event->getExtraOptions());
             client->done();
+            eraseCollectionStats({ event->ns().toString() });
 
             reply(event->sender(), new CreateCollectionResponse(this, collection));
         } catch(const std::exception &ex) {
@@ -781,6 +1467,7 @@ namespace Robomongo
             boost::scoped_ptr<MongoClient> client(getClient());
             client->dropCollection(event->ns());
             client->done();
+            eraseCollectionStats({ event->ns().toString() });
 
             reply(event->sender(), new DropCollectionResponse(this, collection));
         } catch(const std::exception &ex) {
@@ -797,6 +1484,8 @@ namespace Robomongo
             boost::scoped_ptr<MongoClient> client(getClient());
             client->renameCollection(event->ns(), event->newCollection());
             client->done();
+            eraseCollectionStats({ event->ns().toString(), 
+                                   MongoNamespace(event->ns().databaseName(), event->newCollection()).toString() });
 
             reply(event->sender(), new RenameCollectionResponse(this, event->ns().collectionName(),
                                                                 event->newCollection()));
@@ -814,6 +1503,7 @@ namespace Robomongo
             boost::scoped_ptr<MongoClient> client(getClient());
             client->duplicateCollection(event->ns(), event->newCollection());
             client->done();
+            eraseCollectionStats({ MongoNamespace(event->ns().databaseName(), event->newCollection()).toString() });
 
             reply(event->sender(), 
                 new DuplicateCollectionResponse(this, sourceCollection, event->newCollection())
@@ -830,14 +1520,26 @@ namespace Robomongo
     void MongoWorker::handle(CopyCollectionToDiffServerRequest *event)
     {
         try {
-            boost::scoped_ptr<MongoClient> client(getClient());
-            MongoWorker *cl = event->worker();
-            client->copyCollectionToDiffServer(
-                cl->_dbclient.get(), event->from(), event->to()
+            // All connections of the copy are opened on this thread with TLS parameters of this server
+            std::shared_ptr<ConnectionSettings> const source = event->source();
+            if (!sameGlobalSSLparams(*source->sslSettings(), *_connSettings->sslSettings()))
+                throw std::runtime_error("Collections can be copied only between servers with the same SSL settings.");
+
+            configureSSL();
+            double const mongoTimeoutSec = _mongoTimeoutSec;
+            CollectionCopier copier(
+                [source, mongoTimeoutSec]() { return openConnection(*source, mongoTimeoutSec); },
+                [this]() { return openConnection(); },
+                event->from(), event->to(), event->readers(), event->writers(),
+                writeConcernObj(_connSettings->writeConcern()), event->cancelled()
             );
-            client->done();
 
-            reply(event->sender(), new CopyCollectionToDiffServerResponse(this));
+            QObject *sender = event->sender();
+            CollectionCopyProgress const result = copier.run([this, sender](CollectionCopyProgress const& progress) {
+                reply(sender, new CopyCollectionProgressEvent(this, progress));
+            });
+
+            reply(event->sender(), new CopyCollectionToDiffServerResponse(this, result));
         } catch(const std::exception &ex) {
             reply(event->sender(), 
                 new CopyCollectionToDiffServerResponse(this, EventError(ex.what()))
@@ -953,14 +1655,24 @@ namespace Robomongo
 
             // Step-2: Try connect to replica set with set name
             auto const& membersHostsAndPorts = _connSettings->replicaSetSettings()->membersToHostAndPort();
+            _serverMetadata.invalidate();
             _dbclientRepSet.reset(new mongo::DBClientReplicaSet {
                  setName, membersHostsAndPorts, APP_NAME_VERSION, _mongoTimeoutSec                 
             });
                 
-            if (!_dbclientRepSet->connect()) 
+            if (!_dbclientRepSet->connect()) {
+                if (_lane != WorkerLane::Script) {
+                    _dbclientRepSet.reset();
+                    throw std::runtime_error("Failed to connect to replica set " + setName);
+                }
                 return { nullptr, "Connect failed" };
-            else 
-                return { _dbclientRepSet.get(), "" };
+            }
+
+            // Script lane authenticates in EstablishConnectionRequest, other lanes never receive it
+            if (_lane != WorkerLane::Script)
+                authenticate(_dbclientRepSet.get(), *_connSettings);
+
+            return { _dbclientRepSet.get(), "" };
         }
         else {  // connection to single server
             if(_dbclient)
@@ -968,8 +1680,20 @@ namespace Robomongo
             
             // Timeout for operations
             // Connect timeout is fixed, but short, at 5 seconds (see headers for DBClientConnection)
+            _serverMetadata.invalidate();
             _dbclient.reset(new mongo::DBClientConnection { true, _mongoTimeoutSec });
             mongo::Status const& status = _dbclient->connect(_connSettings->hostAndPort(), APP_NAME_VERSION);
+
+            // Script lane authenticates in EstablishConnectionRequest, other lanes never receive it
+            if (_lane != WorkerLane::Script) {
+                if (!status.isOK()) {
+                    _dbclient.reset();
+                    throw std::runtime_error(status.reason());
+                }
+                authenticate(_dbclient.get(), *_connSettings);
+                init();
+            }
+
             if (!status.isOK() && mayReturnNull) 
                 return { nullptr, status.reason() };
             else 
@@ -977,9 +1701,63 @@ namespace Robomongo
         }
     }
 
+    std::unique_ptr<mongo::DBClientBase> MongoWorker::openConnection()
+    {
+        return openConnection(*_connSettings, _mongoTimeoutSec);
+    }
+
+    std::unique_ptr<mongo::DBClientBase> MongoWorker::openConnection(const ConnectionSettings &settings, 
+                                                                     double mongoTimeoutSec)
+    {
+        std::unique_ptr<mongo::DBClientBase> conn;
+        if (settings.isReplicaSet()) {
+            std::string setName = settings.replicaSetSettings()->setNameUserEntered();
+            if (setName.empty())
+                setName = settings.replicaSetSettings()->cachedSetName();
+
+            auto repSetConn = std::make_unique<mongo::DBClientReplicaSet>(
+                setName, settings.replicaSetSettings()->membersToHostAndPort(), 
+                APP_NAME_VERSION, mongoTimeoutSec
+            );
+            if (!repSetConn->connect())
+                throw std::runtime_error("Failed to connect to replica set " + setName);
+
+            conn = std::move(repSetConn);
+        }
+        else {
+            auto singleConn = std::make_unique<mongo::DBClientConnection>(true, mongoTimeoutSec);
+            mongo::Status const status = singleConn->connect(settings.hostAndPort(), APP_NAME_VERSION);
+            if (!status.isOK())
+                throw std::runtime_error(status.reason());
+
+            conn = std::move(singleConn);
+        }
+
+        authenticate(conn.get(), settings);
+        return conn;
+    }
+
+    void MongoWorker::authenticate(mongo::DBClientBase *conn, const ConnectionSettings &settings)
+    {
+        if (!settings.hasEnabledPrimaryCredential())
+            return;
+
+        CredentialSettings const * const credentials = settings.primaryCredential();
+        mongo::BSONObj const authParams {
+            mongo::BSONObjBuilder()
+            .append("user", credentials->userName())
+            .append("db", credentials->databaseName())
+            .append("pwd", credentials->userPassword())
+            .append("mechanism", credentials->mechanism())
+            .obj()
+        };
+        conn->auth(authParams);
+    }
+
     MongoClient *MongoWorker::getClient()
     {
-        return new MongoClient(getConnection().first);
+        return new MongoClient(getConnection().first, writeConcernObj(_connSettings->writeConcern()), 
+                               &_serverMetadata);
     }
 
     void MongoWorker::configureSSL()
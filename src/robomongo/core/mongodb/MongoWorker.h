@@ -2,11 +2,16 @@
 
 #include <QObject>
 #include <QMutex>
+#include <QElapsedTimer>
+#include <map>
 #include <unordered_set>
 
 #include <mongo/client/dbclient_rs.h> 
+#include <mongo/client/dbclient_cursor.h>
 
 #include "robomongo/core/events/MongoEvents.h"
+#include "robomongo/core/mongodb/MongoClient.h"
+#include "robomongo/core/mongodb/CollectionStatsLoader.h"
 
 QT_BEGIN_NAMESPACE
 class QThread;
@@ -15,23 +20,64 @@ QT_END_NAMESPACE
 
 namespace Robomongo
 {
-    class MongoClient;
     class ScriptEngine;
     class ConnectionSettings;
 
+    /**
+     * @brief Independent request queues of one server. Each lane is served by its own
+     *        MongoWorker (thread and connection), see MongoServer::send().
+     */
+    enum class WorkerLane
+    {
+        Script,     // Shell scope: scripts, autocomplete and all requests not routed to other lanes
+        Query,      // Pages of query results
+        Metadata,   // Explorer: lists of databases, collections, users, functions and indexes.
+                    // Also stops scripts of Script lane.
+        Monitor,    // Periodic serverStatus samples of Server Monitor
+        ChangeStream,   // Change streams being watched, each getMore waits for new events
+        Copy            // Collection copies between servers, each may run for hours
+    };
+
     class MongoWorker : public QObject
     {
         Q_OBJECT
 
     public:        
+        /**
+         * @param lane: only Script lane worker creates shell scope. Workers of other lanes 
+         *        connect and authenticate on first request.
+         */
         explicit MongoWorker(ConnectionSettings *connection, bool isLoadMongoRcJs, int batchSize,
-                             double mongoTimeoutSec, int shellTimeoutSec, QObject *parent = nullptr);
+                             double mongoTimeoutSec, int shellTimeoutSec, 
+                             WorkerLane lane = WorkerLane::Script, QObject *parent = nullptr);
 
         ~MongoWorker();
-        void interrupt();
+        WorkerLane lane() const { return _lane; }
+
+        /**
+         * @brief Interrupts script running in shell scope. Can be called from other threads.
+         * @return address of the shell connection as seen by server, to find its operations
+         */
+        std::string interrupt();
         void stopAndDelete();
         void changeTimeout(int newTimeout);
 
+        /**
+         * @brief Opens new authenticated connection with the settings of this worker. Connection is
+         *        owned by the caller and is not used by the worker. Can be called from other threads.
+         *        Global SSL parameters are not changed, they are set by configureSSL() of the worker.
+         * @throws std::runtime_error, if connection failed
+         */
+        std::unique_ptr<mongo::DBClientBase> openConnection();
+
+        /**
+         * @brief Opens new authenticated connection with 'settings', like openConnection() of a worker
+         *        with these settings
+         * @throws std::runtime_error, if connection failed
+         */
+        static std::unique_ptr<mongo::DBClientBase> openConnection(const ConnectionSettings &settings,
+                                                                   double mongoTimeoutSec);
+
     protected Q_SLOTS:
 
         void init();
@@ -93,6 +139,11 @@ namespace Robomongo
          */
         void handle(InsertDocumentRequest *event);
 
+        /**
+         * @brief Inserts or saves many documents at once
+         */
+        void handle(BulkWriteRequest *event);
+
         /**
          * @brief Remove documents
          */
@@ -102,6 +153,19 @@ namespace Robomongo
          * @brief Load list of all collection names
          */
         void handle(ExecuteQueryRequest *event);
+        void handle(ReleaseQueryCursorsRequest *event);
+        void handle(ExplainQueryRequest *event);
+        void handle(ProfilingLevelRequest *event);
+        void handle(AnalyzeProfileRequest *event);
+        void handle(AdviseIndexesRequest *event);
+        void handle(AnalyzeSchemaRequest *event);
+        void handle(PreviewPipelineRequest *event);
+        void handle(CurrentOpsRequest *event);
+        void handle(KillOpRequest *event);
+        void handle(ServerStatusRequest *event);
+        void handle(WatchChangesRequest *event);
+        void handle(ChangeStreamGetMoreRequest *event);
+        void handle(CloseChangeStreamRequest *event);
 
         /**
          * @brief Execute javascript
@@ -118,7 +182,7 @@ namespace Robomongo
         void handle(DropCollectionRequest *event);
         void handle(RenameCollectionRequest *event);
         void handle(DuplicateCollectionRequest *event);       
-        void handle(CopyCollectionToDiffServerRequest *event); // todo: unused? remove
+        void handle(CopyCollectionToDiffServerRequest *event);
  
         void handle(CreateUserRequest *event);
         void handle(DropUserRequest *event);
@@ -141,6 +205,11 @@ namespace Robomongo
         std::vector<std::string> getDatabaseNamesSafe(EstablishConnectionRequest* event = nullptr);
         std::string getAuthBase() const;
 
+        /**
+         * @brief Authenticates 'conn' with primary credential of 'settings', if it is enabled
+         */
+        static void authenticate(mongo::DBClientBase *conn, const ConnectionSettings &settings);
+
         // Returns a pair of DBClientBase* connection and error string
         std::pair<mongo::DBClientBase*, std::string> getConnection(bool mayReturnNull = false);
         MongoClient *getClient();
@@ -178,8 +247,60 @@ namespace Robomongo
         */
         void pingDatabase(mongo::DBClientBase *dbclient) const;
 
+        /**
+         * @brief Returns next page of query result part, reusing server-side cursor 
+         *        opened for previous page when possible (see _queryCursors)
+         */
+        std::vector<MongoDocumentPtr> queryPage(MongoClient *client, ExecuteQueryRequest *event,
+                                                MongoClient::DocumentsBatchHandler const& onBatch);
+
+        /**
+         * @brief Builds keyset query of the page that follows 'info._keysetAfter' (see 
+         *        MongoQueryInfo::keysetNextPage()) if an index serves its sort and all values of 
+         *        sort keys are of the same type, otherwise returns false and 'info' is run with skip.
+         */
+        bool keysetPage(MongoClient *client, const MongoQueryInfo &info, MongoQueryInfo &page);
+
+        /**
+         * @brief Kills cached cursors of 'sender', or all cached cursors if 'sender' is null
+         */
+        void killQueryCursors(QObject *sender = nullptr);
+
+        /**
+         * @brief Kills cached cursors that were not used during QUERY_CURSOR_IDLE_TIMEOUT_MSEC
+         */
+        void evictIdleQueryCursors();
+
+        /**
+         * @brief Removes cached statistics of 'namespaces', so that next listing loads them again
+         */
+        void eraseCollectionStats(const std::vector<std::string> &namespaces);
+
+        /**
+         * @brief Loads statistics of 'namespaces' in background, see _collStatsLoader
+         */
+        void loadCollectionStats(const std::string &databaseName, const std::vector<std::string> &namespaces);
+
+        /**
+         * @brief Server-side cursor kept open between pages of a query result part
+         */
+        struct QueryCursor
+        {
+            std::unique_ptr<mongo::DBClientCursor> cursor;
+            MongoQueryInfo queryInfo;   // Query this cursor was opened for
+            int nextSkip = 0;           // Absolute position of the next document in the result set
+            QElapsedTimer lastUsed;
+        };
+
+        struct CachedCollectionStats
+        {
+            MongoCollectionInfo info;
+            QElapsedTimer loaded;
+        };
+
         QThread *_thread;
         QMutex _firstConnectionMutex;
+        const WorkerLane _lane;
 
         std::unique_ptr<ScriptEngine> _scriptEngine;
 
@@ -187,6 +308,7 @@ namespace Robomongo
         const int _batchSize;
         int _timerId;
         int _dbAutocompleteCacheTimerId;
+        int _queryCursorsTimerId;
         double _mongoTimeoutSec;
         int _shellTimeoutSec;
         QAtomicInteger<int> _isQuiting;
@@ -194,8 +316,34 @@ namespace Robomongo
         std::unique_ptr<mongo::DBClientConnection> _dbclient;
         std::unique_ptr<mongo::DBClientReplicaSet> _dbclientRepSet;
 
+        // buildInfo, serverStatus and isMaster results shared by all clients of the connection
+        ServerMetadataCache _serverMetadata;
+
+        // Open cursors of paged query results, keyed by (sender shell, result index).
+        // "Next page" is served with getMore on these cursors instead of re-running query with 
+        // larger skip. Declared after connections in order to be destroyed (killed) before them.
+        std::map<std::pair<QObject*, int>, QueryCursor> _queryCursors;
+
+        // Cursors of open change streams by watch id (ChangeStream lane only), so that stream closed
+        // while its WatchChangesRequest is in flight is killed once the request is handled
+        std::map<int, std::pair<MongoNamespace, long long>> _changeStreams;
+
         ConnectionSettings *_connSettings;
 
+        // Statistics of collections by full namespace, so that listing of recently expanded 
+        // database does not run collStats again. Updated from _collStatsLoader threads.
+        QMutex _collStatsMutex;
+        std::map<std::string, CachedCollectionStats> _collStatsCache;
+
+        // Incremented by eraseCollectionStats(), which records it for erased namespaces. 
+        // Statistics requested at lower generation than the one namespace was erased at 
+        // are stale and discarded when loaded. Guarded by _collStatsMutex.
+        unsigned long long _collStatsGeneration = 0;
+        std::map<std::string, unsigned long long> _collStatsErased;
+
+        // Runs collStats on its own connections, publishing CollectionStatsLoadedEvent
+        std::unique_ptr<CollectionStatsLoader> _collStatsLoader;
+
         // Collection of created databases.
         // Starting from 3.0, MongoDB drops empty databases.
         // It means, we did not find a way to create "empty" database.
@@ -0,0 +1,46 @@
+#include "robomongo/core/mongodb/ServerMetadataCache.h"
+
+namespace Robomongo
+{
+    ServerMetadata ServerMetadata::load(mongo::DBClientBase *dbclient)
+    {
+        ServerMetadata metadata;
+
+        mongo::BSONObj buildInfo;
+        if (dbclient->runCommand("admin", BSON("buildInfo" << 1), buildInfo))
+            metadata.version = buildInfo.getStringField("version");
+
+        mongo::BSONObj serverStatus;
+        if (dbclient->runCommand("admin", BSON("serverStatus" << 1), serverStatus))
+            metadata.storageEngine = serverStatus.getObjectField("storageEngine").getStringField("name");
+
+        mongo::BSONObj isMaster;
+        if (dbclient->runCommand("admin", BSON("isMaster" << 1), isMaster)) {
+            metadata.maxWireVersion = isMaster.getIntField("maxWireVersion");
+
+            if (std::string(isMaster.getStringField("msg")) == "isdbgrid")
+                metadata.topology = "sharded";
+            else if (isMaster.hasField("setName"))
+                metadata.topology = "replicaSet";
+            else
+                metadata.topology = "standalone";
+        }
+
+        return metadata;
+    }
+
+    ServerMetadataCache::ServerMetadataCache(int ttlSec /* = 10 * 60 */) :
+        _ttlMsec(ttlSec * 1000)
+    {}
+
+    const ServerMetadata &ServerMetadataCache::get(mongo::DBClientBase *dbclient)
+    {
+        if (_isLoaded && !_loadedTimer.hasExpired(_ttlMsec))
+            return _metadata;
+
+        _metadata = ServerMetadata::load(dbclient);
+        _isLoaded = true;
+        _loadedTimer.start();
+        return _metadata;
+    }
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <string>
+
+#include <QElapsedTimer>
+#include <mongo/client/dbclient_base.h>
+
+namespace Robomongo
+{
+    /**
+     * @brief Server properties which normally do not change while connection is open
+     */
+    struct ServerMetadata
+    {
+        std::string version;        // i.e. "4.0.12"
+        std::string storageEngine;  // i.e. "wiredTiger", empty if unknown
+        int maxWireVersion = 0;
+        std::string topology;       // "standalone", "replicaSet" or "sharded"
+
+        /**
+         * @brief Loads metadata with buildInfo, serverStatus and isMaster commands.
+         *        Properties which cannot be read (i.e. because of missing privileges) are left empty.
+         */
+        static ServerMetadata load(mongo::DBClientBase *dbclient);
+    };
+
+    /**
+     * @brief ServerMetadata of a connection: loaded on first use and loaded again after
+     *        invalidate() or when older than 'ttlSec'.
+     *        Not thread safe, it is used only from the thread of owning MongoWorker.
+     */
+    class ServerMetadataCache
+    {
+    public:
+        explicit ServerMetadataCache(int ttlSec = 10 * 60);
+
+        const ServerMetadata &get(mongo::DBClientBase *dbclient);
+        void invalidate() { _isLoaded = false; }
+
+    private:
+        int const _ttlMsec;
+        ServerMetadata _metadata;
+        bool _isLoaded = false;
+        QElapsedTimer _loadedTimer;
+    };
+}
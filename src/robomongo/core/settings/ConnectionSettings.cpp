@@ -79,6 +79,8 @@ namespace Robomongo
         setServerHost(QtUtils::toStdString(map.value("serverHost").toString().left(maxLength)));
         setServerPort(map.value("serverPort").toInt());
         setDefaultDatabase(QtUtils::toStdString(map.value("defaultDatabase").toString()));
+        if (map.contains("writeConcern"))
+            setWriteConcern(QtUtils::toStdString(map.value("writeConcern").toString()));
         setReplicaSet(map.value("isReplicaSet").toBool());       
         
         QVariantList list = map.value("credentials").toList();
@@ -140,6 +142,7 @@ namespace Robomongo
         setServerHost(source->serverHost());
         setServerPort(source->serverPort());
         setDefaultDatabase(source->defaultDatabase());
+        setWriteConcern(source->writeConcern());
         setImported(source->imported());
         setReplicaSet(source->isReplicaSet());
 
@@ -168,6 +171,7 @@ namespace Robomongo
         map.insert("serverHost", QtUtils::toQString(serverHost()));
         map.insert("serverPort", serverPort());
         map.insert("defaultDatabase", QtUtils::toQString(defaultDatabase()));
+        map.insert("writeConcern", QtUtils::toQString(writeConcern()));
         map.insert("isReplicaSet", isReplicaSet());
         if (isReplicaSet())
             map.insert("replicaSet", _replicaSetSettings->toVariant());
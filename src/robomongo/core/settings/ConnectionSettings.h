@@ -80,6 +80,12 @@ namespace Robomongo
         std::string defaultDatabase() const { return _defaultDatabase; }
         void setDefaultDatabase(const std::string &defaultDatabase) { _defaultDatabase = defaultDatabase; }
 
+        /**
+         * @brief Write concern of document inserts, updates and removes: "0", "1" or "majority"
+         */
+        std::string writeConcern() const { return _writeConcern; }
+        void setWriteConcern(const std::string &writeConcern) { _writeConcern = writeConcern; }
+
         /**
          * Was this connection imported from somewhere?
          */
@@ -158,6 +164,7 @@ namespace Robomongo
         std::string _host;
         int _port;
         std::string _defaultDatabase;
+        std::string _writeConcern = "1";
         mutable QList<CredentialSettings *> _credentials;
         std::unique_ptr<SshSettings> _sshSettings;
         std::unique_ptr<SslSettings> _sslSettings;
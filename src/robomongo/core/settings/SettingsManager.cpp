@@ -262,6 +262,13 @@ namespace Robomongo
         if (_batchSize == 0)
             _batchSize = 50;
 
+        _streamQueryResults = map.contains("streamQueryResults") ? 
+                              map.value("streamQueryResults").toBool() : true;
+
+        _keysetPaging = map.contains("keysetPaging") ? map.value("keysetPaging").toBool() : false;
+        _warmShellConnections = map.contains("warmShellConnections") ? 
+                                map.value("warmShellConnections").toBool() : false;
+
         if (map.contains("checkForUpdates"))
             _checkForUpdates = map.value("checkForUpdates").toBool();
 
@@ -365,6 +372,9 @@ namespace Robomongo
 
         // 9. Save batchSize
         map.insert("batchSize", _batchSize);
+        map.insert("streamQueryResults", _streamQueryResults);
+        map.insert("keysetPaging", _keysetPaging);
+        map.insert("warmShellConnections", _warmShellConnections);
         map.insert("checkForUpdates", _checkForUpdates);
         map.insert("mongoTimeoutSec", _mongoTimeoutSec);
         map.insert("shellTimeoutSec", _shellTimeoutSec);
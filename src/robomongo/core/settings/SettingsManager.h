@@ -142,6 +142,19 @@ namespace Robomongo
         void setBatchSize(int batchSize) { _batchSize = batchSize; }
         int batchSize() const { return _batchSize; }
 
+        // When enabled, paged query results are shown batch by batch as they arrive from server
+        void setStreamQueryResults(bool stream) { _streamQueryResults = stream; }
+        bool streamQueryResults() const { return _streamQueryResults; }
+
+        // When enabled, next page of query results is loaded by range query on sort key (or _id)
+        // following the last document of the current page, instead of using skip
+        void setKeysetPaging(bool keysetPaging) { _keysetPaging = keysetPaging; }
+        bool keysetPaging() const { return _keysetPaging; }
+
+        // When enabled, a connection for the next shell tab is opened in advance (one per server)
+        void setWarmShellConnections(bool warm) { _warmShellConnections = warm; }
+        bool warmShellConnections() const { return _warmShellConnections; }
+
         QString currentStyle() const { return _currentStyle; }
         void setCurrentStyle(const QString& style);
 
@@ -224,6 +237,9 @@ namespace Robomongo
         QSet<QString> _acceptedEulaVersions;
         QSet<QString> _dbVersionsConnected;
         int _batchSize;
+        bool _streamQueryResults = true;
+        bool _keysetPaging = false;
+        bool _warmShellConnections = false;
         bool _checkForUpdates = true;
         QString _currentStyle;
         QString _textFontFamily;
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <algorithm>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+namespace Robomongo
+{
+    /**
+     * @brief Keeps at most 'capacity' values, the least recently used value is evicted first
+     */
+    template <typename Key, typename Value>
+    class LruCache
+    {
+    public:
+        explicit LruCache(size_t capacity) :
+            _capacity(std::max<size_t>(capacity, 1)) {}
+
+        /**
+         * @returns cached value marked as the most recently used one, or NULL if there is none.
+         *          Pointer is valid until the next insert() or clear().
+         */
+        const Value *find(const Key &key)
+        {
+            auto const it = _index.find(key);
+            if (it == _index.end())
+                return NULL;
+
+            _items.splice(_items.begin(), _items, it->second);
+            return &it->second->second;
+        }
+
+        /**
+         * @brief Caches 'value' as the most recently used one, replacing value cached for 'key'
+         */
+        const Value &insert(const Key &key, const Value &value)
+        {
+            auto const it = _index.find(key);
+            if (it != _index.end()) {
+                _items.erase(it->second);
+                _index.erase(it);
+            }
+            else if (_items.size() >= _capacity) {
+                _index.erase(_items.back().first);
+                _items.pop_back();
+            }
+
+            _items.emplace_front(key, value);
+            _index[key] = _items.begin();
+            return _items.front().second;
+        }
+
+        void clear()
+        {
+            _items.clear();
+            _index.clear();
+        }
+
+        size_t size() const { return _items.size(); }
+        size_t capacity() const { return _capacity; }
+
+    private:
+        typedef std::list<std::pair<Key, Value>> ItemsType;
+
+        size_t const _capacity;
+        ItemsType _items;
+        std::unordered_map<Key, typename ItemsType::iterator> _index;
+    };
+}
@@ -0,0 +1,50 @@
+#include "gtest/gtest.h"
+#include "robomongo/core/utils/LruCache.h"
+
+#include <string>
+
+using namespace Robomongo;
+
+TEST(lru_cache_tests, find_ReturnsInsertedValue)
+{
+    LruCache<int, std::string> cache(2);
+    cache.insert(1, "one");
+
+    ASSERT_TRUE(cache.find(1) != nullptr);
+    EXPECT_EQ("one", *cache.find(1));
+    EXPECT_TRUE(cache.find(2) == nullptr);
+}
+
+TEST(lru_cache_tests, insert_EvictsLeastRecentlyUsedValue)
+{
+    LruCache<int, std::string> cache(2);
+    cache.insert(1, "one");
+    cache.insert(2, "two");
+    cache.find(1);
+    cache.insert(3, "three");
+
+    EXPECT_EQ(2u, cache.size());
+    EXPECT_TRUE(cache.find(1) != nullptr);
+    EXPECT_TRUE(cache.find(2) == nullptr);
+    EXPECT_TRUE(cache.find(3) != nullptr);
+}
+
+TEST(lru_cache_tests, insert_ReplacesValueOfSameKey)
+{
+    LruCache<int, std::string> cache(2);
+    cache.insert(1, "one");
+    cache.insert(1, "uno");
+
+    EXPECT_EQ(1u, cache.size());
+    EXPECT_EQ("uno", *cache.find(1));
+}
+
+TEST(lru_cache_tests, clear_RemovesAllValues)
+{
+    LruCache<int, std::string> cache(2);
+    cache.insert(1, "one");
+    cache.clear();
+
+    EXPECT_EQ(0u, cache.size());
+    EXPECT_TRUE(cache.find(1) == nullptr);
+}
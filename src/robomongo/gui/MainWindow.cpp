@@ -74,6 +74,18 @@ namespace
         Robomongo::AppRegistry::instance().settingsManager()->save();
     }
     
+    void saveKeysetPaging(bool keysetPaging)
+    {
+        Robomongo::AppRegistry::instance().settingsManager()->setKeysetPaging(keysetPaging);
+        Robomongo::AppRegistry::instance().settingsManager()->save();
+    }
+
+    void saveWarmShellConnections(bool warm)
+    {
+        Robomongo::AppRegistry::instance().settingsManager()->setWarmShellConnections(warm);
+        Robomongo::AppRegistry::instance().settingsManager()->save();
+    }
+
     void saveAutoExec(bool isAutoExec)
     {
         Robomongo::AppRegistry::instance().settingsManager()->setAutoExec(isAutoExec);
@@ -284,6 +296,22 @@ namespace Robomongo
         _stopAction->setDisabled(true);
         VERIFY(connect(_stopAction, SIGNAL(triggered()), SLOT(stopScript())));
 
+        // Explain action
+        QAction *explainAction = new QAction(this);
+        explainAction->setData("Explain");
+        explainAction->setIcon(GuiRegistry::instance().visualIcon());
+        explainAction->setShortcut(Qt::SHIFT + Qt::Key_F5);
+        explainAction->setToolTip("Explain the last find() or aggregate() query of current tab: show winning plan with execution statistics <b>(Shift + F5)</b>");
+        VERIFY(connect(explainAction, SIGNAL(triggered()), SLOT(explainQuery())));
+
+        // Pipeline builder action
+        QAction *pipelineAction = new QAction(this);
+        pipelineAction->setData("Pipeline");
+        pipelineAction->setIcon(GuiRegistry::instance().treeIcon());
+        pipelineAction->setShortcut(Qt::CTRL + Qt::SHIFT + Qt::Key_A);
+        pipelineAction->setToolTip("Open the last aggregate() query of current tab in pipeline builder: preview output and timing of every stage <b>(Ctrl + Shift + A)</b>");
+        VERIFY(connect(pipelineAction, SIGNAL(triggered()), SLOT(buildPipeline())));
+
         // Refresh action
         QAction *refreshAction = new QAction("Refresh", this);
         refreshAction->setIcon(qApp->style()->standardIcon(QStyle::SP_BrowserReload));
@@ -419,6 +447,18 @@ namespace Robomongo
         VERIFY(connect(autoExpand, SIGNAL(triggered()), this, SLOT(toggleAutoExpand())));
         optionsMenu->addAction(autoExpand);
 
+        QAction *keysetPaging = new QAction("Range Based Paging (Keyset)", this);
+        keysetPaging->setCheckable(true);
+        keysetPaging->setChecked(AppRegistry::instance().settingsManager()->keysetPaging());
+        VERIFY(connect(keysetPaging, SIGNAL(triggered()), this, SLOT(toggleKeysetPaging())));
+        optionsMenu->addAction(keysetPaging);
+
+        QAction *warmShellConnections = new QAction("Open Shell Connections In Advance", this);
+        warmShellConnections->setCheckable(true);
+        warmShellConnections->setChecked(AppRegistry::instance().settingsManager()->warmShellConnections());
+        VERIFY(connect(warmShellConnections, SIGNAL(triggered()), this, SLOT(toggleWarmShellConnections())));
+        optionsMenu->addAction(warmShellConnections);
+
         QAction *showLineNumbers = new QAction("Show Line Numbers By Default", this);
         showLineNumbers->setCheckable(true);
         showLineNumbers->setChecked(AppRegistry::instance().settingsManager()->lineNumbers());
@@ -567,6 +607,8 @@ namespace Robomongo
         _execToolBar->setToolButtonStyle(Qt::ToolButtonIconOnly);
         _execToolBar->addAction(_executeAction);
         _execToolBar->addAction(_stopAction);
+        _execToolBar->addAction(explainAction);
+        _execToolBar->addAction(pipelineAction);
         _execToolBar->addAction(_orientationAction);
         _execToolBar->setShortcutEnabled(1, true);
         _execToolBar->setMovable(false);
@@ -929,6 +971,18 @@ namespace Robomongo
         saveAutoExpand(send->isChecked());
     }
     
+    void MainWindow::toggleKeysetPaging()
+    {
+        QAction *send = qobject_cast<QAction*>(sender());
+        saveKeysetPaging(send->isChecked());
+    }
+
+    void MainWindow::toggleWarmShellConnections()
+    {
+        QAction *send = qobject_cast<QAction*>(sender());
+        saveWarmShellConnections(send->isChecked());
+    }
+
     void MainWindow::toggleAutoExec()
     {
         QAction *send = qobject_cast<QAction*>(sender());
@@ -972,6 +1026,24 @@ namespace Robomongo
         widget->stop();
     }
 
+    void MainWindow::explainQuery()
+    {
+        QueryWidget *widget = _workArea->currentQueryWidget();
+        if (!widget)
+            return;
+
+        widget->explain();
+    }
+
+    void MainWindow::buildPipeline()
+    {
+        QueryWidget *widget = _workArea->currentQueryWidget();
+        if (!widget)
+            return;
+
+        widget->buildPipeline();
+    }
+
     void MainWindow::toggleFullScreen2()
     {
         if (windowState() == Qt::WindowFullScreen)
@@ -1304,6 +1376,7 @@ namespace Robomongo
     {
         _workArea = new WorkAreaTabWidget(this);
         AppRegistry::instance().bus()->subscribe(_workArea, OpeningShellEvent::Type);
+        AppRegistry::instance().bus()->subscribe(_workArea, OpeningServerMonitorEvent::Type);
         VERIFY(connect(_workArea, SIGNAL(currentChanged(int)), this, SLOT(updateMenus())));
         VERIFY(connect(_workArea, SIGNAL(currentChanged(int)), this, SLOT(on_tabChange())));
 
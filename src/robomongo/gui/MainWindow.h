@@ -48,10 +48,14 @@ namespace Robomongo
         void enterTableMode();
         void enterCustomMode();
         void toggleAutoExpand();
+        void toggleKeysetPaging();
+        void toggleWarmShellConnections();
         void toggleAutoExec();
         void toggleLineNumbers();
         void executeScript();
         void stopScript();
+        void explainQuery();
+        void buildPipeline();
         void toggleFullScreen2();
         void selectNextTab();
         void selectPrevTab();
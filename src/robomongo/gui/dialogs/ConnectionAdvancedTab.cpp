@@ -3,6 +3,7 @@
 #include <QLabel>
 #include <QGridLayout>
 #include <QLineEdit>
+#include <QComboBox>
 /* --- Disabling unfinished export URI connection string feature 
 #include <QPushButton>
 #include <QMessageBox>
@@ -69,15 +70,32 @@ namespace Robomongo
         defaultDbLabel->setMaximumWidth(140); // Linux
 #endif
 
+        _writeConcern = new QComboBox;
+        _writeConcern->addItem("w: 1 (acknowledged by primary)", "1");
+        _writeConcern->addItem("w: majority (acknowledged by majority of replica set)", "majority");
+        _writeConcern->addItem("w: 0 (unacknowledged)", "0");
+        int const writeConcernIndex = _writeConcern->findData(QtUtils::toQString(_settings->writeConcern()));
+        _writeConcern->setCurrentIndex(writeConcernIndex >= 0 ? writeConcernIndex : 0);
+        auto writeConcernDescriptionLabel = new QLabel(
+            "Acknowledgement requested for documents inserted, edited or removed from result views. "
+            "With <code>w: 0</code> write errors are not reported.");
+        writeConcernDescriptionLabel->setWordWrap(true);
+        writeConcernDescriptionLabel->setContentsMargins(0, -2, 0, 20);
+        auto writeConcernLabel = new QLabel("Write Concern:");
+        writeConcernLabel->setMaximumWidth(defaultDbLabel->maximumWidth());
+
         auto mainLayout = new QGridLayout;
         mainLayout->setAlignment(Qt::AlignTop);
         mainLayout->addWidget(defaultDbLabel,                           1, 0);
         mainLayout->addWidget(_defaultDatabaseName,                     1, 1, 1, 2);
         mainLayout->addWidget(defaultDatabaseDescriptionLabel,          2, 1, 1, 2);
+        mainLayout->addWidget(writeConcernLabel,                        3, 0);
+        mainLayout->addWidget(_writeConcern,                            3, 1, 1, 2);
+        mainLayout->addWidget(writeConcernDescriptionLabel,             4, 1, 1, 2);
         /* --- Disabling unfinished export URI connection string feature
-        mainLayout->addWidget(new QLabel{ "URI Connection String:" },   3, 0);
-        mainLayout->addWidget(_uriString,                               3, 1);
-        mainLayout->addLayout(hlay,                                     4, 1);
+        mainLayout->addWidget(new QLabel{ "URI Connection String:" },   5, 0);
+        mainLayout->addWidget(_uriString,                               5, 1);
+        mainLayout->addLayout(hlay,                                     6, 1);
         */
         setLayout(mainLayout);
     }
@@ -85,6 +103,7 @@ namespace Robomongo
     void ConnectionAdvancedTab::accept()
     {
         _settings->setDefaultDatabase(QtUtils::toStdString(_defaultDatabaseName->text()));
+        _settings->setWriteConcern(QtUtils::toStdString(_writeConcern->currentData().toString()));
     }
 
     void ConnectionAdvancedTab::setDefaultDb(const QString& defaultDb)
@@ -4,6 +4,7 @@
 
 QT_BEGIN_NAMESPACE
 class QLineEdit;
+class QComboBox;
 class QCheckBox;
 class QPushButton;
 QT_END_NAMESPACE
@@ -30,6 +31,7 @@ namespace Robomongo
 
     private:
         QLineEdit *_defaultDatabaseName;
+        QComboBox *_writeConcern;
 
         /* --- Disabling unfinished export URI connection string feature
         QLineEdit *_uriString;
@@ -1,5 +1,7 @@
 #include "robomongo/gui/dialogs/CopyCollectionDialog.h"
 
+#include <algorithm>
+
 #include <QPushButton>
 #include <QHBoxLayout>
 #include <QVBoxLayout>
@@ -7,10 +9,15 @@
 #include <QComboBox>
 #include <QDialogButtonBox>
 #include <QLabel>
+#include <QSpinBox>
+#include <QProgressBar>
+#include <QFormLayout>
 
 #include "robomongo/core/domain/MongoServer.h"
 #include "robomongo/core/settings/ConnectionSettings.h"
 #include "robomongo/core/AppRegistry.h"
+#include "robomongo/core/EventBus.h"
+#include "robomongo/core/domain/MongoDatabase.h"
 #include "robomongo/core/utils/QtUtils.h"
 #include "robomongo/gui/widgets/workarea/IndicatorLabel.h"
 #include "robomongo/gui/GuiRegistry.h"
@@ -20,11 +27,13 @@ namespace Robomongo
 {
     const QSize CopyCollection::minimumSize = QSize(300, 150);
 
-    CopyCollection::CopyCollection(const QString &serverName, const QString &database,
+    CopyCollection::CopyCollection(MongoServer *sourceServer, const QString &database,
                                                const QString &collection, QWidget *parent) :
         QDialog(parent),
-        _currentServerName(serverName),
-        _currentDatabase(database)
+        _sourceServer(sourceServer),
+        _currentServerName(QtUtils::toQString(sourceServer->connectionRecord()->getFullAddress())),
+        _currentDatabase(database),
+        _collection(collection)
     {
         QSet<QString> uniqueConnectionsNames;
         for (auto const& server : AppRegistry::instance().app()->getServers()) {
@@ -85,11 +94,35 @@ namespace Robomongo
         VERIFY(connect(_serverComboBox, SIGNAL(currentIndexChanged(int)), this, SLOT(updateDatabaseComboBox(int))));
 
         _serverComboBox->addItems(uniqueConnectionsNames.toList());
+
+        // Parallel _id range reads help only for large collections, writers are usually the bottleneck
+        _readersSpinBox = new QSpinBox();
+        _readersSpinBox->setRange(1, 8);
+        _readersSpinBox->setValue(1);
+        _readersSpinBox->setToolTip("Number of _id ranges of the collection read in parallel");
+        _writersSpinBox = new QSpinBox();
+        _writersSpinBox->setRange(1, 16);
+        _writersSpinBox->setValue(4);
+        _writersSpinBox->setToolTip("Number of connections inserting documents in parallel");
+
+        QFormLayout *parallelLayout = new QFormLayout();
+        parallelLayout->setContentsMargins(0, 0, 0, 7);
+        parallelLayout->addRow("Parallel readers:", _readersSpinBox);
+        parallelLayout->addRow("Parallel writers:", _writersSpinBox);
+
+        _progressBar = new QProgressBar();
+        _progressBar->setVisible(false);
+        _progressLabel = new QLabel();
+        _progressLabel->setVisible(false);
+
         QVBoxLayout *layout = new QVBoxLayout();
         layout->addLayout(vlayout);
         layout->addWidget(hline);
         layout->addLayout(serverlayout);
         layout->addLayout(databaselayout);
+        layout->addLayout(parallelLayout);
+        layout->addWidget(_progressBar);
+        layout->addWidget(_progressLabel);
         layout->addLayout(hlayout);
         setLayout(layout);
     }
@@ -127,9 +160,91 @@ namespace Robomongo
 
     void CopyCollection::accept()
     {
-        if (!selectedDatabase())
+        MongoDatabase *database = selectedDatabase();
+        if (!database || _copying)
+            return;
+
+        AppRegistry::instance().bus()->subscribe(this, CopyCollectionProgressEvent::Type, database);
+        AppRegistry::instance().bus()->subscribe(this, CopyCollectionToDiffServerResponse::Type, database);
+
+        _cancelled = database->copyCollection(_sourceServer, QtUtils::toStdString(_currentDatabase), 
+                                              QtUtils::toStdString(_collection), 
+                                              _readersSpinBox->value(), _writersSpinBox->value());
+        setCopying(true);
+    }
+
+    void CopyCollection::reject()
+    {
+        // Cancel button and closing of dialog stop the running copy, documents copied so far are kept
+        if (_copying) {
+            *_cancelled = true;
+            AppRegistry::instance().bus()->unsubscibe(this);
+            _copying = false;
+        }
+
+        QDialog::reject();
+    }
+
+    void CopyCollection::handle(CopyCollectionProgressEvent *event)
+    {
+        CollectionCopyProgress const& progress = event->progress;
+        long long const docsDone = progress.docsCopied + progress.docsSkipped;
+
+        if (progress.docsTotal > 0) {
+            // Scaled to thousandths, QProgressBar range is int
+            _progressBar->setRange(0, 1000);
+            _progressBar->setValue(static_cast<int>(std::min(docsDone * 1000 / progress.docsTotal, 1000LL)));
+        }
+        else {
+            _progressBar->setRange(0, 0);  // busy indicator
+        }
+
+        if (progress.indexing) {
+            _progressLabel->setText("Documents copied. Creating indexes...");
+            return;
+        }
+
+        QString text = QString("%1 of %2 documents, %3 docs/s, %4 MB/s")
+            .arg(docsDone).arg(progress.docsTotal)
+            .arg(static_cast<long long>(progress.docsPerSec))
+            .arg(progress.mbPerSec, 0, 'f', 1);
+
+        if (progress.etaSec >= 0)
+            text += QString(", %1:%2 left").arg(progress.etaSec / 60).arg(progress.etaSec % 60, 2, 10, QChar('0'));
+
+        if (progress.docsSkipped > 0)
+            text += QString(" (%1 existing skipped)").arg(progress.docsSkipped);
+
+        _progressLabel->setText(text);
+    }
+
+    void CopyCollection::handle(CopyCollectionToDiffServerResponse *event)
+    {
+        AppRegistry::instance().bus()->unsubscibe(this);
+
+        // Error is reported by MongoDatabase, user can change settings and try again
+        if (event->isError()) {
+            setCopying(false);
+            _progressLabel->setText("Copy failed.");
+            _progressLabel->setVisible(true);
             return;
+        }
 
         QDialog::accept();
     }
+
+    void CopyCollection::setCopying(bool copying)
+    {
+        _copying = copying;
+        _serverComboBox->setEnabled(!copying);
+        _databaseComboBox->setEnabled(!copying);
+        _readersSpinBox->setEnabled(!copying);
+        _writersSpinBox->setEnabled(!copying);
+        _buttonBox->button(QDialogButtonBox::Save)->setEnabled(!copying);
+
+        _progressBar->setVisible(copying);
+        _progressBar->setRange(0, 0);
+        _progressLabel->setVisible(copying);
+        _progressLabel->setText("Starting...");
+    }
 }
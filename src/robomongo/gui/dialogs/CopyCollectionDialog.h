@@ -1,15 +1,23 @@
 #pragma once
 
+#include <atomic>
+#include <memory>
+
 #include <QDialog>
 #include "robomongo/core/domain/App.h"
 QT_BEGIN_NAMESPACE
 class QDialogButtonBox;
 class QComboBox;
+class QSpinBox;
+class QProgressBar;
+class QLabel;
 QT_END_NAMESPACE
 
 namespace Robomongo
 {
     class MongoDatabase;
+    class CopyCollectionProgressEvent;
+    class CopyCollectionToDiffServerResponse;
 
     class CopyCollection : public QDialog
     {
@@ -18,20 +26,34 @@ namespace Robomongo
     public:
         static const QSize minimumSize;
 
-        explicit CopyCollection(const QString &serverName,
+        explicit CopyCollection(MongoServer *sourceServer,
                                       const QString &database,
                                       const QString &collection, QWidget *parent = 0);
 
     public Q_SLOTS:
         virtual void accept();
+        virtual void reject();
         void updateDatabaseComboBox(int index);
         MongoDatabase *selectedDatabase();
+        void handle(CopyCollectionProgressEvent *event);
+        void handle(CopyCollectionToDiffServerResponse *event);
+
     private:
+        void setCopying(bool copying);
+
         std::vector<MongoServer*> _servers;
+        MongoServer *const _sourceServer;
         const QString _currentServerName;
         const QString _currentDatabase;
+        const QString _collection;
         QComboBox *_serverComboBox;
         QComboBox *_databaseComboBox;
+        QSpinBox *_readersSpinBox;
+        QSpinBox *_writersSpinBox;
+        QProgressBar *_progressBar;
+        QLabel *_progressLabel;
         QDialogButtonBox *_buttonBox;
+        bool _copying = false;
+        std::shared_ptr<std::atomic<bool>> _cancelled;
     };
 }
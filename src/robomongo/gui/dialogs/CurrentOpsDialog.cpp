@@ -0,0 +1,300 @@
+#include "robomongo/gui/dialogs/CurrentOpsDialog.h"
+
+#include <QAction>
+#include <QCheckBox>
+#include <QComboBox>
+#include <QDateTime>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QLineEdit>
+#include <QMessageBox>
+#include <QPushButton>
+#include <QSpinBox>
+#include <QTimer>
+#include <QTreeWidget>
+#include <QVBoxLayout>
+
+#include "robomongo/core/AppRegistry.h"
+#include "robomongo/core/EventBus.h"
+#include "robomongo/core/domain/MongoDatabase.h"
+#include "robomongo/core/utils/QtUtils.h"
+#include "robomongo/gui/widgets/workarea/IndicatorLabel.h"
+#include "robomongo/gui/GuiRegistry.h"
+
+namespace
+{
+    enum OpColumn { OpId, Op, Namespace, Client, SecsRunning, Plan, Command };
+
+    // Longer commands are cut, full command is in tool tip
+    constexpr int COMMAND_TEXT_LIMIT { 300 };
+
+    // Sorts running time by microseconds rather than by text
+    class OpTreeItem : public QTreeWidgetItem
+    {
+    public:
+        using QTreeWidgetItem::QTreeWidgetItem;
+
+        bool operator<(const QTreeWidgetItem &other) const override
+        {
+            int const column = treeWidget() ? treeWidget()->sortColumn() : 0;
+            if (column == SecsRunning)
+                return data(column, Qt::UserRole).toLongLong() < other.data(column, Qt::UserRole).toLongLong();
+
+            return QTreeWidgetItem::operator<(other);
+        }
+    };
+
+    // Sets text only when it differs, unchanged cells are not repainted
+    void setCellText(QTreeWidgetItem *item, int column, const QString &text)
+    {
+        if (item->text(column) != text)
+            item->setText(column, text);
+    }
+}
+
+namespace Robomongo
+{
+    const QSize CurrentOpsDialog::minimumSize = QSize(900, 500);
+
+    CurrentOpsDialog::CurrentOpsDialog(MongoDatabase *database, QWidget *parent) :
+        QDialog(parent),
+        _database(database)
+    {
+        setWindowTitle("Current Operations");
+        setWindowFlags(windowFlags() & ~Qt::WindowContextHelpButtonHint); // Remove help button (?)
+        setAttribute(Qt::WA_DeleteOnClose);
+        setMinimumSize(minimumSize);
+
+        _intervalSpinBox = new QSpinBox();
+        _intervalSpinBox->setRange(1, 300);
+        _intervalSpinBox->setValue(2);
+        _intervalSpinBox->setSuffix(" sec");
+
+        _pauseCheckBox = new QCheckBox("Pause");
+        VERIFY(connect(_pauseCheckBox, SIGNAL(toggled(bool)), this, SLOT(togglePause(bool))));
+
+        _killButton = new QPushButton("Kill Operation...");
+        _killButton->setEnabled(false);
+        VERIFY(connect(_killButton, SIGNAL(clicked()), this, SLOT(killSelected())));
+
+        QHBoxLayout *controlsLayout = new QHBoxLayout();
+        controlsLayout->addWidget(new Indicator(GuiRegistry::instance().databaseIcon(),
+                                                QtUtils::toQString(database->name())));
+        controlsLayout->addSpacing(10);
+        controlsLayout->addWidget(new QLabel("Refresh every:"));
+        controlsLayout->addWidget(_intervalSpinBox);
+        controlsLayout->addWidget(_pauseCheckBox);
+        controlsLayout->addStretch(1);
+        controlsLayout->addWidget(_killButton);
+
+        _nsFilter = new QLineEdit(QtUtils::toQString(database->name()) + ".");
+        _nsFilter->setPlaceholderText("Namespace");
+        VERIFY(connect(_nsFilter, SIGNAL(textChanged(const QString &)), this, SLOT(applyFilter())));
+
+        _opFilter = new QComboBox();
+        _opFilter->addItem("All operations", QString());
+        for (char const *op : { "query", "getmore", "insert", "update", "remove", "command", "none" })
+            _opFilter->addItem(op, QString(op));
+        VERIFY(connect(_opFilter, SIGNAL(currentIndexChanged(int)), this, SLOT(applyFilter())));
+
+        _clientFilter = new QLineEdit();
+        _clientFilter->setPlaceholderText("Client");
+        VERIFY(connect(_clientFilter, SIGNAL(textChanged(const QString &)), this, SLOT(applyFilter())));
+
+        QHBoxLayout *filterLayout = new QHBoxLayout();
+        filterLayout->addWidget(new QLabel("Filter:"));
+        filterLayout->addWidget(_nsFilter, 2);
+        filterLayout->addWidget(_opFilter);
+        filterLayout->addWidget(_clientFilter, 1);
+
+        _opsTree = new QTreeWidget();
+        _opsTree->setRootIsDecorated(false);
+        _opsTree->setAlternatingRowColors(true);
+        _opsTree->setSortingEnabled(true);
+        _opsTree->setUniformRowHeights(true);
+        _opsTree->setHeaderLabels(QStringList() << "Op Id" << "Op" << "Namespace" << "Client" << "Secs Running" 
+                                                << "Plan" << "Command");
+        _opsTree->sortByColumn(SecsRunning, Qt::DescendingOrder);
+        _opsTree->setContextMenuPolicy(Qt::ActionsContextMenu);
+        VERIFY(connect(_opsTree, SIGNAL(itemSelectionChanged()), this, SLOT(updateKillButton())));
+
+        QAction *killAction = new QAction("Kill Operation...", _opsTree);
+        VERIFY(connect(killAction, SIGNAL(triggered()), this, SLOT(killSelected())));
+        _opsTree->addAction(killAction);
+
+        _statusLabel = new QLabel();
+
+        QVBoxLayout *layout = new QVBoxLayout();
+        layout->addLayout(controlsLayout);
+        layout->addLayout(filterLayout);
+        layout->addWidget(_opsTree, 1);
+        layout->addWidget(_statusLabel);
+        setLayout(layout);
+
+        // Next sample is scheduled when previous one is received, so that slow server 
+        // is not flooded with overlapping currentOp commands
+        _timer = new QTimer(this);
+        _timer->setSingleShot(true);
+        VERIFY(connect(_timer, SIGNAL(timeout()), this, SLOT(sample())));
+
+        AppRegistry::instance().bus()->subscribe(this, CurrentOpsResponse::Type, _database);
+        AppRegistry::instance().bus()->subscribe(this, KillOpResponse::Type, _database);
+
+        sample();
+    }
+
+    void CurrentOpsDialog::sample()
+    {
+        if (_sampling)
+            return;
+
+        _sampling = true;
+        _database->loadCurrentOps();
+    }
+
+    void CurrentOpsDialog::togglePause(bool paused)
+    {
+        if (paused)
+            _timer->stop();
+        else
+            sample();
+    }
+
+    void CurrentOpsDialog::handle(CurrentOpsResponse *event)
+    {
+        // Responses to other monitors of the same database
+        if (!_sampling)
+            return;
+
+        _sampling = false;
+        if (!_pauseCheckBox->isChecked())
+            _timer->start(_intervalSpinBox->value() * 1000);
+
+        if (event->isError()) {
+            _statusLabel->setText(QtUtils::toQString(event->error().errorMessage()));
+            return;
+        }
+
+        CurrentOpsDiff const diff = _tracker.update(event->ops);
+        if (!diff.isEmpty()) {
+            // Resorting once after all changes instead of after every changed cell
+            _opsTree->setSortingEnabled(false);
+
+            for (auto const& key : diff.removed)
+                delete _items.take(QtUtils::toQString(key));
+
+            for (auto const& op : diff.changed) {
+                QTreeWidgetItem *item = _items.value(QtUtils::toQString(CurrentOpsTracker::opKey(op)));
+                fillItem(item, op);
+                item->setHidden(isFiltered(item));
+            }
+
+            for (auto const& op : diff.added) {
+                QString const key = QtUtils::toQString(CurrentOpsTracker::opKey(op));
+                auto item = new OpTreeItem();
+                item->setData(OpId, Qt::UserRole, key);
+                item->setText(OpId, key);
+                _opsTree->addTopLevelItem(item);
+                fillItem(item, op);
+                item->setHidden(isFiltered(item));
+                _items.insert(key, item);
+            }
+
+            _opsTree->setSortingEnabled(true);
+            updateKillButton();
+        }
+
+        _statusLabel->setText(QString("%1 operations, sampled at %2")
+            .arg(_tracker.size()).arg(QDateTime::currentDateTime().toString("HH:mm:ss")));
+    }
+
+    void CurrentOpsDialog::handle(KillOpResponse *event)
+    {
+        if (event->isError()) {
+            _statusLabel->setText(QtUtils::toQString(event->error().errorMessage()));
+            return;
+        }
+
+        _statusLabel->setText(QString("Operation %1 killed.")
+            .arg(QtUtils::toQString(CurrentOpsTracker::opKey(event->op))));
+    }
+
+    void CurrentOpsDialog::fillItem(QTreeWidgetItem *item, const mongo::BSONObj &op) const
+    {
+        setCellText(item, Op, QString::fromUtf8(op.getStringField("op")));
+        setCellText(item, Namespace, QString::fromUtf8(op.getStringField("ns")));
+
+        QString client = QString::fromUtf8(op.getStringField("client"));
+        if (op.hasField("appName"))
+            client += QString(" (%1)").arg(QString::fromUtf8(op.getStringField("appName")));
+        setCellText(item, Client, client);
+
+        long long const micros = op.hasField("microsecs_running") 
+            ? op.getField("microsecs_running").safeNumberLong()
+            : op.getField("secs_running").safeNumberLong() * 1000 * 1000;
+        item->setData(SecsRunning, Qt::UserRole, micros);
+        item->setTextAlignment(SecsRunning, Qt::AlignRight | Qt::AlignVCenter);
+        setCellText(item, SecsRunning, QString::number(micros / 1000000.0, 'f', 1));
+
+        QString plan = QString::fromUtf8(op.getStringField("planSummary"));
+        if (op.getField("waitingForLock").trueValue())
+            plan = plan.isEmpty() ? QString("waiting for lock") : "waiting for lock, " + plan;
+        setCellText(item, Plan, plan);
+
+        mongo::BSONObj const command = op.getObjectField("command");
+        if (!command.isEmpty()) {
+            QString const text = QtUtils::toQString(command.toString());
+            if (item->toolTip(Command) != text) {
+                item->setToolTip(Command, text);
+                setCellText(item, Command, text.left(COMMAND_TEXT_LIMIT));
+            }
+        }
+        else {
+            setCellText(item, Command, QString::fromUtf8(op.getStringField("desc")));
+        }
+    }
+
+    bool CurrentOpsDialog::isFiltered(QTreeWidgetItem *item) const
+    {
+        QString const op = _opFilter->currentData().toString();
+        return !item->text(Namespace).startsWith(_nsFilter->text()) ||
+               (!op.isEmpty() && item->text(Op) != op) ||
+               !item->text(Client).contains(_clientFilter->text(), Qt::CaseInsensitive);
+    }
+
+    void CurrentOpsDialog::applyFilter()
+    {
+        for (QTreeWidgetItem *item : _items)
+            item->setHidden(isFiltered(item));
+
+        updateKillButton();
+    }
+
+    void CurrentOpsDialog::updateKillButton()
+    {
+        QList<QTreeWidgetItem *> const selected = _opsTree->selectedItems();
+        _killButton->setEnabled(!selected.isEmpty() && !selected.first()->isHidden());
+    }
+
+    void CurrentOpsDialog::killSelected()
+    {
+        QList<QTreeWidgetItem *> const selected = _opsTree->selectedItems();
+        if (selected.isEmpty())
+            return;
+
+        std::string const key = QtUtils::toStdString(selected.first()->data(OpId, Qt::UserRole).toString());
+        mongo::BSONObj const op = _tracker.op(key);
+        if (op.isEmpty()) {
+            _statusLabel->setText("Operation has already finished.");
+            return;
+        }
+
+        int const answer = QMessageBox::question(this, "Kill Operation", 
+            QString("Kill operation <b>%1</b>?").arg(QtUtils::toQString(key)), QMessageBox::Yes, QMessageBox::No);
+        if (answer != QMessageBox::Yes)
+            return;
+
+        _database->killOp(op);
+    }
+}
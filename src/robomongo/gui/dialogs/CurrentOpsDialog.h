@@ -0,0 +1,68 @@
+#pragma once
+
+#include <QDialog>
+#include <QHash>
+
+#include "robomongo/core/domain/CurrentOpsTracker.h"
+
+QT_BEGIN_NAMESPACE
+class QComboBox;
+class QSpinBox;
+class QCheckBox;
+class QLineEdit;
+class QPushButton;
+class QLabel;
+class QTimer;
+class QTreeWidget;
+class QTreeWidgetItem;
+QT_END_NAMESPACE
+
+namespace Robomongo
+{
+    class MongoDatabase;
+    class CurrentOpsResponse;
+    class KillOpResponse;
+
+    /**
+     * @brief Live view of operations in progress on server, sampled periodically. 
+     *        Rows are updated from the difference between samples, not rebuilt.
+     */
+    class CurrentOpsDialog : public QDialog
+    {
+        Q_OBJECT
+
+    public:
+        static const QSize minimumSize;
+
+        explicit CurrentOpsDialog(MongoDatabase *database, QWidget *parent = 0);
+
+    public Q_SLOTS:
+        void handle(CurrentOpsResponse *event);
+        void handle(KillOpResponse *event);
+
+    private Q_SLOTS:
+        void sample();
+        void togglePause(bool paused);
+        void applyFilter();
+        void updateKillButton();
+        void killSelected();
+
+    private:
+        void fillItem(QTreeWidgetItem *item, const mongo::BSONObj &op) const;
+        bool isFiltered(QTreeWidgetItem *item) const;
+
+        MongoDatabase *const _database;
+        CurrentOpsTracker _tracker;
+        QHash<QString, QTreeWidgetItem *> _items;
+        QTimer *_timer;
+        bool _sampling = false;
+        QSpinBox *_intervalSpinBox;
+        QCheckBox *_pauseCheckBox;
+        QLineEdit *_nsFilter;
+        QComboBox *_opFilter;
+        QLineEdit *_clientFilter;
+        QPushButton *_killButton;
+        QLabel *_statusLabel;
+        QTreeWidget *_opsTree;
+    };
+}
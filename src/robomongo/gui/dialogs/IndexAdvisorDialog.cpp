@@ -0,0 +1,237 @@
+#include "robomongo/gui/dialogs/IndexAdvisorDialog.h"
+
+#include <QSpinBox>
+#include <QPushButton>
+#include <QLabel>
+#include <QTreeWidget>
+#include <QHeaderView>
+#include <QHBoxLayout>
+#include <QVBoxLayout>
+
+#include "robomongo/core/AppRegistry.h"
+#include "robomongo/core/EventBus.h"
+#include "robomongo/core/domain/MongoDatabase.h"
+#include "robomongo/core/utils/BsonUtils.h"
+#include "robomongo/core/utils/QtUtils.h"
+#include "robomongo/gui/widgets/workarea/IndicatorLabel.h"
+#include "robomongo/gui/GuiRegistry.h"
+
+namespace
+{
+    enum AdviceColumn { Advice, Namespace, Keys, Queries, Total, Reason };
+
+    const int AdviceIndexRole = Qt::UserRole + 1;
+
+    // Sorts numeric columns by value rather than by text
+    class AdviceTreeItem : public QTreeWidgetItem
+    {
+    public:
+        using QTreeWidgetItem::QTreeWidgetItem;
+
+        bool operator<(const QTreeWidgetItem &other) const override
+        {
+            int const column = treeWidget() ? treeWidget()->sortColumn() : 0;
+            if (column == Queries || column == Total)
+                return data(column, Qt::UserRole).toLongLong() < other.data(column, Qt::UserRole).toLongLong();
+
+            return QTreeWidgetItem::operator<(other);
+        }
+    };
+
+    void setNumber(QTreeWidgetItem *item, int column, long long value)
+    {
+        item->setText(column, value ? QString::number(value) : QString());
+        item->setData(column, Qt::UserRole, value);
+        item->setTextAlignment(column, Qt::AlignRight | Qt::AlignVCenter);
+    }
+
+    QString kindText(Robomongo::IndexAdvice::Kind kind)
+    {
+        switch (kind) {
+        case Robomongo::IndexAdvice::Create:    return "Create index";
+        case Robomongo::IndexAdvice::Redundant: return "Redundant";
+        case Robomongo::IndexAdvice::Unused:    return "Unused";
+        }
+        return QString();
+    }
+
+    // Name server would generate for index with key pattern 'keys', e.g. "a_1_b_-1"
+    std::string defaultIndexName(const mongo::BSONObj &keys)
+    {
+        std::string name;
+        for (mongo::BSONObjIterator it(keys); it.more(); ) {
+            mongo::BSONElement const elem = it.next();
+            if (!name.empty())
+                name += "_";
+
+            name += elem.fieldName();
+            name += "_";
+            name += elem.type() == mongo::String ? elem.str() : std::to_string(elem.numberInt());
+        }
+        return name;
+    }
+}
+
+namespace Robomongo
+{
+    const QSize IndexAdvisorDialog::minimumSize = QSize(900, 500);
+
+    IndexAdvisorDialog::IndexAdvisorDialog(MongoDatabase *database, QWidget *parent) :
+        QDialog(parent),
+        _database(database)
+    {
+        setWindowTitle("Index Advisor");
+        setWindowFlags(windowFlags() & ~Qt::WindowContextHelpButtonHint); // Remove help button (?)
+        setAttribute(Qt::WA_DeleteOnClose);
+        setMinimumSize(minimumSize);
+
+        _maxEntriesSpinBox = new QSpinBox();
+        _maxEntriesSpinBox->setRange(1000, 10 * 1000 * 1000);
+        _maxEntriesSpinBox->setSingleStep(10000);
+        _maxEntriesSpinBox->setValue(100 * 1000);
+
+        _analyzeButton = new QPushButton("Analyze");
+        VERIFY(connect(_analyzeButton, SIGNAL(clicked()), this, SLOT(analyze())));
+
+        _createButton = new QPushButton("Create Index");
+        _createButton->setEnabled(false);
+        VERIFY(connect(_createButton, SIGNAL(clicked()), this, SLOT(createIndex())));
+
+        QHBoxLayout *controlsLayout = new QHBoxLayout();
+        controlsLayout->addWidget(new Indicator(GuiRegistry::instance().databaseIcon(), 
+                                                QtUtils::toQString(database->name())));
+        controlsLayout->addStretch(1);
+        controlsLayout->addWidget(new QLabel("Newest profiled entries:"));
+        controlsLayout->addWidget(_maxEntriesSpinBox);
+        controlsLayout->addWidget(_analyzeButton);
+
+        _adviceTree = new QTreeWidget();
+        _adviceTree->setRootIsDecorated(false);
+        _adviceTree->setAlternatingRowColors(true);
+        _adviceTree->setSortingEnabled(true);
+        _adviceTree->setHeaderLabels(QStringList() << "Advice" << "Namespace" << "Keys" 
+                                                   << "Queries" << "Total ms" << "Reason");
+        _adviceTree->header()->resizeSection(Keys, 240);
+        _adviceTree->sortByColumn(Total, Qt::DescendingOrder);
+        VERIFY(connect(_adviceTree, SIGNAL(itemSelectionChanged()), this, SLOT(updateCreateButton())));
+
+        _statusLabel = new QLabel("Profiling should be enabled for the database to collect queries");
+
+        QHBoxLayout *bottomLayout = new QHBoxLayout();
+        bottomLayout->addWidget(_statusLabel, 1);
+        bottomLayout->addWidget(_createButton);
+
+        QVBoxLayout *layout = new QVBoxLayout();
+        layout->addLayout(controlsLayout);
+        layout->addWidget(_adviceTree, 1);
+        layout->addLayout(bottomLayout);
+        setLayout(layout);
+
+        AppRegistry::instance().bus()->subscribe(this, AdviseIndexesResponse::Type, _database);
+        AppRegistry::instance().bus()->subscribe(this, AddEditIndexResponse::Type, _database);
+    }
+
+    void IndexAdvisorDialog::analyze()
+    {
+        _analyzeButton->setEnabled(false);
+        _createButton->setEnabled(false);
+        _statusLabel->setText("Reading system.profile and index statistics...");
+        _database->adviseIndexes(_maxEntriesSpinBox->value());
+    }
+
+    void IndexAdvisorDialog::updateCreateButton()
+    {
+        QTreeWidgetItem *item = _adviceTree->currentItem();
+        bool const creatable = item && item->isSelected() && !item->isDisabled()
+            && _advice[item->data(Advice, AdviceIndexRole).toInt()].kind == IndexAdvice::Create;
+        _createButton->setEnabled(creatable);
+    }
+
+    void IndexAdvisorDialog::createIndex()
+    {
+        QTreeWidgetItem *item = _adviceTree->currentItem();
+        if (!item)
+            return;
+
+        IndexAdvice &advice = _advice[item->data(Advice, AdviceIndexRole).toInt()];
+        advice.indexName = defaultIndexName(advice.keys);
+        std::string const keys = BsonUtils::jsonString(advice.keys, mongo::TenGen, 1, DefaultEncoding, Utc);
+
+        item->setDisabled(true);
+        _createButton->setEnabled(false);
+        _statusLabel->setText(QString("Creating index %1...").arg(QtUtils::toQString(advice.indexName)));
+        _database->createIndex(IndexInfo(MongoCollectionInfo(advice.ns), advice.indexName, keys));
+    }
+
+    QTreeWidgetItem *IndexAdvisorDialog::itemOf(const std::string &ns, const std::string &indexName) const
+    {
+        for (int i = 0; i < _adviceTree->topLevelItemCount(); ++i) {
+            QTreeWidgetItem *item = _adviceTree->topLevelItem(i);
+            IndexAdvice const& advice = _advice[item->data(Advice, AdviceIndexRole).toInt()];
+            if (advice.kind == IndexAdvice::Create && advice.ns == ns && advice.indexName == indexName)
+                return item;
+        }
+        return NULL;
+    }
+
+    void IndexAdvisorDialog::handle(AdviseIndexesResponse *event)
+    {
+        _analyzeButton->setEnabled(true);
+        if (event->isError()) {
+            _statusLabel->setText(QtUtils::toQString(event->error().errorMessage()));
+            return;
+        }
+
+        _advice = event->advice;
+
+        _adviceTree->setSortingEnabled(false);
+        _adviceTree->clear();
+
+        QList<QTreeWidgetItem *> items;
+        int creates = 0;
+        for (size_t i = 0; i < _advice.size(); ++i) {
+            IndexAdvice const& advice = _advice[i];
+            auto item = new AdviceTreeItem();
+            item->setText(Advice, kindText(advice.kind));
+            item->setData(Advice, AdviceIndexRole, static_cast<int>(i));
+            item->setText(Namespace, QtUtils::toQString(advice.ns));
+            QString keys = QtUtils::toQString(advice.keys.toString());
+            if (!advice.indexName.empty())
+                keys += QString(" (%1)").arg(QtUtils::toQString(advice.indexName));
+            item->setText(Keys, keys);
+            item->setToolTip(Keys, keys);
+            setNumber(item, Queries, advice.queries);
+            setNumber(item, Total, advice.totalMillis);
+            QString const reason = QtUtils::toQString(advice.reason);
+            item->setText(Reason, reason);
+            item->setToolTip(Reason, reason);
+            items.append(item);
+
+            if (advice.kind == IndexAdvice::Create)
+                ++creates;
+        }
+        _adviceTree->addTopLevelItems(items);
+        _adviceTree->setSortingEnabled(true);
+
+        _statusLabel->setText(QString("%1 indexes suggested, %2 existing indexes flagged")
+            .arg(creates).arg(_advice.size() - creates));
+    }
+
+    void IndexAdvisorDialog::handle(AddEditIndexResponse *event)
+    {
+        QTreeWidgetItem *item = itemOf(event->newIndex_._collection.fullName(), event->newIndex_._name);
+        if (event->isError()) {
+            if (item)
+                item->setDisabled(false);
+
+            _statusLabel->setText(QtUtils::toQString(event->error().errorMessage()));
+            updateCreateButton();
+            return;
+        }
+
+        if (item)
+            item->setText(Advice, "Created");
+
+        _statusLabel->setText(QString("Index %1 created").arg(QtUtils::toQString(event->newIndex_._name)));
+    }
+}
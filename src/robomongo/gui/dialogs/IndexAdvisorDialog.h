@@ -0,0 +1,55 @@
+#pragma once
+
+#include <QDialog>
+#include <vector>
+
+#include "robomongo/core/events/MongoEventsInfo.h"
+
+QT_BEGIN_NAMESPACE
+class QSpinBox;
+class QPushButton;
+class QLabel;
+class QTreeWidget;
+class QTreeWidgetItem;
+QT_END_NAMESPACE
+
+namespace Robomongo
+{
+    class MongoDatabase;
+    class AdviseIndexesResponse;
+    struct AddEditIndexResponse;
+
+    /**
+     * @brief Suggests indexes for slow profiled queries and flags redundant or unused ones, 
+     *        suggested indexes can be created from dialog
+     */
+    class IndexAdvisorDialog : public QDialog
+    {
+        Q_OBJECT
+
+    public:
+        static const QSize minimumSize;
+
+        explicit IndexAdvisorDialog(MongoDatabase *database, QWidget *parent = 0);
+
+    public Q_SLOTS:
+        void handle(AdviseIndexesResponse *event);
+        void handle(AddEditIndexResponse *event);
+
+    private Q_SLOTS:
+        void analyze();
+        void createIndex();
+        void updateCreateButton();
+
+    private:
+        QTreeWidgetItem *itemOf(const std::string &ns, const std::string &indexName) const;
+
+        MongoDatabase *const _database;
+        std::vector<IndexAdvice> _advice;
+        QSpinBox *_maxEntriesSpinBox;
+        QPushButton *_analyzeButton;
+        QPushButton *_createButton;
+        QLabel *_statusLabel;
+        QTreeWidget *_adviceTree;
+    };
+}
@@ -0,0 +1,404 @@
+#include "robomongo/gui/dialogs/PipelineBuilderDialog.h"
+
+#include <algorithm>
+
+#include <QSpinBox>
+#include <QPushButton>
+#include <QLabel>
+#include <QTreeWidget>
+#include <QHeaderView>
+#include <QSplitter>
+#include <QHBoxLayout>
+#include <QVBoxLayout>
+#include <Qsci/qsciscintilla.h>
+
+#include "robomongo/core/AppRegistry.h"
+#include "robomongo/core/EventBus.h"
+#include "robomongo/core/domain/ExplainPlan.h"
+#include "robomongo/core/domain/MongoDatabase.h"
+#include "robomongo/core/utils/BsonUtils.h"
+#include "robomongo/core/utils/QtUtils.h"
+#include "robomongo/gui/editors/JSLexer.h"
+#include "robomongo/gui/editors/FindFrame.h"
+#include "robomongo/gui/editors/PlainJavaScriptEditor.h"
+#include "robomongo/gui/widgets/workarea/IndicatorLabel.h"
+#include "robomongo/gui/GuiRegistry.h"
+#include "robomongo/shell/bson/json.h"
+
+namespace
+{
+    enum StageColumn { Stage, Output, RunTime, ExplainTime };
+
+    Robomongo::FindFrame *createJsonFrame(QWidget *parent, bool readOnly)
+    {
+        const QFont &textFont = Robomongo::GuiRegistry::instance().font();
+        QsciLexerJavaScript *javaScriptLexer = new Robomongo::JSLexer(parent);
+        javaScriptLexer->setFont(textFont);
+        Robomongo::FindFrame *findFrame = new Robomongo::FindFrame(parent);
+        findFrame->sciScintilla()->setLexer(javaScriptLexer);
+        findFrame->sciScintilla()->setTabWidth(4);
+        findFrame->sciScintilla()->setAppropriateBraceMatching();
+        findFrame->sciScintilla()->setFont(textFont);
+        findFrame->sciScintilla()->setReadOnly(readOnly);
+        return findFrame;
+    }
+
+    QString jsonText(const mongo::BSONObj &obj)
+    {
+        return Robomongo::QtUtils::toQString(Robomongo::BsonUtils::jsonString(obj, mongo::TenGen, 1, 
+                                                                              Robomongo::DefaultEncoding, 
+                                                                              Robomongo::Utc));
+    }
+
+    void setTime(QTreeWidgetItem *item, int column, long long millis)
+    {
+        item->setText(column, millis < 0 ? QString() : QString::number(millis));
+        item->setTextAlignment(column, Qt::AlignRight | Qt::AlignVCenter);
+    }
+}
+
+namespace Robomongo
+{
+    const QSize PipelineBuilderDialog::minimumSize = QSize(1000, 600);
+
+    PipelineBuilderDialog::PipelineBuilderDialog(MongoDatabase *database, const std::string &collection, 
+                                                 const std::vector<mongo::BSONObj> &stages, QWidget *parent) :
+        QDialog(parent),
+        _database(database),
+        _collection(collection),
+        _ns(database->name() + "." + collection)
+    {
+        setWindowTitle("Aggregation Pipeline");
+        setWindowFlags(windowFlags() & ~Qt::WindowContextHelpButtonHint); // Remove help button (?)
+        setAttribute(Qt::WA_DeleteOnClose);
+        setMinimumSize(minimumSize);
+
+        _sampleSizeSpinBox = new QSpinBox();
+        _sampleSizeSpinBox->setRange(1, 10 * 1000 * 1000);
+        _sampleSizeSpinBox->setSingleStep(1000);
+        _sampleSizeSpinBox->setValue(1000);
+        _sampleSizeSpinBox->setToolTip("Number of collection documents every stage preview starts from ($limit)");
+
+        _previewSizeSpinBox = new QSpinBox();
+        _previewSizeSpinBox->setRange(1, 1000);
+        _previewSizeSpinBox->setValue(20);
+
+        _runButton = new QPushButton("Run");
+        _runButton->setShortcut(Qt::CTRL + Qt::Key_Return);
+        _runButton->setToolTip("Preview output of every stage <b>(Ctrl + Enter)</b>");
+        VERIFY(connect(_runButton, SIGNAL(clicked()), this, SLOT(run())));
+
+        QHBoxLayout *controlsLayout = new QHBoxLayout();
+        controlsLayout->addWidget(new Indicator(GuiRegistry::instance().collectionIcon(), QtUtils::toQString(_ns)));
+        controlsLayout->addStretch(1);
+        controlsLayout->addWidget(new QLabel("Sample documents:"));
+        controlsLayout->addWidget(_sampleSizeSpinBox);
+        controlsLayout->addWidget(new QLabel("Preview documents:"));
+        controlsLayout->addWidget(_previewSizeSpinBox);
+        controlsLayout->addWidget(_runButton);
+
+        _stagesTree = new QTreeWidget();
+        _stagesTree->setRootIsDecorated(false);
+        _stagesTree->setHeaderLabels(QStringList() << "Stage" << "Output" << "Run ms" << "Explain ms");
+        _stagesTree->header()->resizeSection(Stage, 260);
+        _stagesTree->header()->resizeSection(Output, 60);
+        _stagesTree->header()->resizeSection(RunTime, 60);
+        VERIFY(connect(_stagesTree, SIGNAL(itemSelectionChanged()), this, SLOT(selectStage())));
+
+        QPushButton *addButton = new QPushButton("Add");
+        VERIFY(connect(addButton, SIGNAL(clicked()), this, SLOT(addStage())));
+        QPushButton *removeButton = new QPushButton("Remove");
+        VERIFY(connect(removeButton, SIGNAL(clicked()), this, SLOT(removeStage())));
+        QPushButton *upButton = new QPushButton("Up");
+        VERIFY(connect(upButton, SIGNAL(clicked()), this, SLOT(moveStageUp())));
+        QPushButton *downButton = new QPushButton("Down");
+        VERIFY(connect(downButton, SIGNAL(clicked()), this, SLOT(moveStageDown())));
+
+        QHBoxLayout *stageButtonsLayout = new QHBoxLayout();
+        stageButtonsLayout->addWidget(addButton);
+        stageButtonsLayout->addWidget(removeButton);
+        stageButtonsLayout->addWidget(upButton);
+        stageButtonsLayout->addWidget(downButton);
+
+        QWidget *stagesWidget = new QWidget();
+        QVBoxLayout *stagesLayout = new QVBoxLayout();
+        stagesLayout->setContentsMargins(0, 0, 0, 0);
+        stagesLayout->addWidget(_stagesTree, 1);
+        stagesLayout->addLayout(stageButtonsLayout);
+        stagesWidget->setLayout(stagesLayout);
+
+        _stageEditor = createJsonFrame(this, false);
+        VERIFY(connect(_stageEditor->sciScintilla(), SIGNAL(textChanged()), this, SLOT(updateStageText())));
+        _outputView = createJsonFrame(this, true);
+
+        QSplitter *stageSplitter = new QSplitter(Qt::Vertical);
+        stageSplitter->addWidget(_stageEditor);
+        stageSplitter->addWidget(_outputView);
+        stageSplitter->setStretchFactor(1, 2);
+
+        QSplitter *splitter = new QSplitter(Qt::Horizontal);
+        splitter->addWidget(stagesWidget);
+        splitter->addWidget(stageSplitter);
+        splitter->setStretchFactor(1, 1);
+
+        _statusLabel = new QLabel();
+
+        QVBoxLayout *layout = new QVBoxLayout();
+        layout->addLayout(controlsLayout);
+        layout->addWidget(splitter, 1);
+        layout->addWidget(_statusLabel);
+        setLayout(layout);
+
+        AppRegistry::instance().bus()->subscribe(this, PipelineStagePreviewEvent::Type, _database);
+        AppRegistry::instance().bus()->subscribe(this, PipelineExplainedEvent::Type, _database);
+
+        for (auto const& stage : stages)
+            insertStage(_stagesTree->topLevelItemCount(), jsonText(stage));
+        if (stages.empty())
+            insertStage(0, "{ $match: {} }");
+
+        _stagesTree->setCurrentItem(_stagesTree->topLevelItem(0));
+    }
+
+    void PipelineBuilderDialog::insertStage(int index, const QString &text)
+    {
+        QTreeWidgetItem *item = new QTreeWidgetItem();
+        _stagesTree->insertTopLevelItem(index, item);
+        item->setData(Stage, Qt::UserRole, text);
+        item->setText(Stage, text.simplified().left(200));
+        item->setToolTip(Stage, text);
+    }
+
+    void PipelineBuilderDialog::swapStages(int first, int second)
+    {
+        QTreeWidgetItem *firstItem = _stagesTree->topLevelItem(first);
+        QTreeWidgetItem *secondItem = _stagesTree->topLevelItem(second);
+        if (!firstItem || !secondItem)
+            return;
+
+        QString const firstText = firstItem->data(Stage, Qt::UserRole).toString();
+        QString const secondText = secondItem->data(Stage, Qt::UserRole).toString();
+        delete firstItem;
+        delete secondItem;
+        insertStage(std::min(first, second), first < second ? secondText : firstText);
+        insertStage(std::max(first, second), first < second ? firstText : secondText);
+        _stagesTree->setCurrentItem(_stagesTree->topLevelItem(second));
+    }
+
+    void PipelineBuilderDialog::addStage()
+    {
+        int const index = _stagesTree->indexOfTopLevelItem(_stagesTree->currentItem()) + 1;
+        insertStage(index, "{ $match: {} }");
+        _stagesTree->setCurrentItem(_stagesTree->topLevelItem(index));
+    }
+
+    void PipelineBuilderDialog::removeStage()
+    {
+        delete _stagesTree->currentItem();
+    }
+
+    void PipelineBuilderDialog::moveStageUp()
+    {
+        int const index = _stagesTree->indexOfTopLevelItem(_stagesTree->currentItem());
+        if (index > 0)
+            swapStages(index, index - 1);
+    }
+
+    void PipelineBuilderDialog::moveStageDown()
+    {
+        int const index = _stagesTree->indexOfTopLevelItem(_stagesTree->currentItem());
+        if (index >= 0 && index + 1 < _stagesTree->topLevelItemCount())
+            swapStages(index, index + 1);
+    }
+
+    void PipelineBuilderDialog::selectStage()
+    {
+        QTreeWidgetItem *item = _stagesTree->currentItem();
+        _stageEditor->sciScintilla()->setText(item ? item->data(Stage, Qt::UserRole).toString() : QString());
+        showOutput();
+    }
+
+    void PipelineBuilderDialog::updateStageText()
+    {
+        QTreeWidgetItem *item = _stagesTree->currentItem();
+        if (!item)
+            return;
+
+        QString const text = _stageEditor->sciScintilla()->text();
+        item->setData(Stage, Qt::UserRole, text);
+        item->setText(Stage, text.simplified().left(200));
+        item->setToolTip(Stage, text);
+    }
+
+    mongo::BSONObj PipelineBuilderDialog::prefixPipeline(size_t count) const
+    {
+        return PipelinePreview::prefixPipeline(_stages, count, _sampleSizeSpinBox->value(), 
+                                               _previewSizeSpinBox->value());
+    }
+
+    void PipelineBuilderDialog::run()
+    {
+        // Edits made while pipeline runs are run once it is done
+        if (_running) {
+            _runPending = true;
+            return;
+        }
+
+        std::vector<mongo::BSONObj> stages;
+        for (int i = 0; i < _stagesTree->topLevelItemCount(); ++i) {
+            QTreeWidgetItem *item = _stagesTree->topLevelItem(i);
+            QString error;
+            try {
+                stages.push_back(mongo::Robomongo::fromjson(QtUtils::toStdString(item->data(Stage, Qt::UserRole).toString())));
+                if (stages.back().nFields() != 1)
+                    error = "stage must have exactly one field";
+            }
+            catch (const std::exception &ex) {
+                error = QtUtils::toQString(ex.what());
+            }
+
+            if (!error.isEmpty()) {
+                _stagesTree->setCurrentItem(item);
+                _statusLabel->setText(QString("Stage %1 is invalid: %2").arg(i + 1).arg(error));
+                return;
+            }
+        }
+
+        _stages = stages;
+        _explainTimes.assign(_stages.size(), -1);
+
+        // Prefixes whose output is cached are not run again, neither are stages writing to collections
+        size_t readStages = 0;
+        std::vector<mongo::BSONObj> prefixes;
+        for (; readStages < _stages.size() && !PipelinePreview::isWriteStage(_stages[readStages]); ++readStages) {
+            mongo::BSONObj const pipeline = prefixPipeline(readStages + 1);
+            if (!_cache.find(pipeline))
+                prefixes.push_back(pipeline);
+        }
+        _explainPipeline = PipelinePreview::prefixPipeline(_stages, readStages, _sampleSizeSpinBox->value());
+
+        _running = true;
+        _statusLabel->setText(QString("Running %1 of %2 stages...").arg(prefixes.size()).arg(readStages));
+        _database->previewPipeline(_collection, prefixes, _explainPipeline);
+        refreshStages();
+    }
+
+    void PipelineBuilderDialog::refreshStages()
+    {
+        for (int i = 0; i < _stagesTree->topLevelItemCount(); ++i) {
+            QTreeWidgetItem *item = _stagesTree->topLevelItem(i);
+            item->setText(Output, QString());
+            item->setToolTip(Output, QString());
+            item->setText(RunTime, QString());
+            item->setText(ExplainTime, QString());
+            if (i >= static_cast<int>(_stages.size()))
+                continue;
+
+            setTime(item, ExplainTime, _explainTimes[i]);
+
+            bool const writes = std::any_of(_stages.begin(), _stages.begin() + i + 1, PipelinePreview::isWriteStage);
+            if (writes) {
+                item->setText(Output, "-");
+                item->setToolTip(Output, "Stages writing to collections are not previewed");
+                continue;
+            }
+
+            const StagePreview *preview = _cache.find(prefixPipeline(i + 1));
+            if (!preview) {
+                item->setText(Output, "...");
+                continue;
+            }
+
+            if (!preview->error.empty()) {
+                item->setText(Output, "Error");
+                item->setToolTip(Output, QtUtils::toQString(preview->error));
+                continue;
+            }
+
+            int const count = static_cast<int>(preview->documents.size());
+            item->setText(Output, count < _previewSizeSpinBox->value() ? QString::number(count) 
+                                                                       : QString("%1+").arg(count));
+            item->setTextAlignment(Output, Qt::AlignRight | Qt::AlignVCenter);
+            setTime(item, RunTime, preview->elapsedMs);
+        }
+
+        showOutput();
+    }
+
+    void PipelineBuilderDialog::showOutput()
+    {
+        int const index = _stagesTree->indexOfTopLevelItem(_stagesTree->currentItem());
+        const StagePreview *preview = index >= 0 && index < static_cast<int>(_stages.size()) ?
+            _cache.find(prefixPipeline(index + 1)) : NULL;
+
+        QString text;
+        if (preview && !preview->error.empty()) {
+            text = QtUtils::toQString(preview->error);
+        }
+        else if (preview) {
+            QStringList documents;
+            for (auto const& document : preview->documents)
+                documents << jsonText(document);
+            text = documents.join("\n\n");
+        }
+
+        _outputView->sciScintilla()->setReadOnly(false);
+        _outputView->sciScintilla()->setText(text);
+        _outputView->sciScintilla()->setReadOnly(true);
+    }
+
+    void PipelineBuilderDialog::handle(PipelineStagePreviewEvent *event)
+    {
+        if (event->ns != _ns)
+            return;
+
+        // Outputs of earlier runs are kept too, pipeline may be edited back
+        StagePreview preview;
+        if (event->isError()) {
+            preview.error = event->error().errorMessage();
+        }
+        else {
+            preview.documents = event->documents;
+            preview.elapsedMs = event->elapsedMs;
+        }
+        _cache.insert(event->pipeline, preview);
+
+        refreshStages();
+    }
+
+    void PipelineBuilderDialog::handle(PipelineExplainedEvent *event)
+    {
+        if (event->ns != _ns || !event->pipeline.binaryEqual(_explainPipeline))
+            return;
+
+        _running = false;
+        if (event->isError()) {
+            _statusLabel->setText(QString("Failed to explain pipeline: %1")
+                .arg(QtUtils::toQString(event->error().errorMessage())));
+        }
+        else {
+            // Explained pipeline has sample $limit inserted before the first stage (or after 
+            // the stage which must be first)
+            std::vector<mongo::BSONObj> explained;
+            for (mongo::BSONObjIterator it(_explainPipeline); it.more(); )
+                explained.push_back(it.next().Obj());
+            size_t const limitIndex = !_stages.empty() && explained[0].binaryEqual(_stages[0]) ? 1 : 0;
+
+            std::vector<long long> const times = PipelinePreview::stageTimes(ExplainPlan::fromBson(event->explain), 
+                                                                              explained);
+            for (size_t i = 0; i + 1 < explained.size(); ++i)
+                _explainTimes[i] = times[i < limitIndex ? i : i + 1];
+
+            long long const sampleTime = times[limitIndex];
+            _statusLabel->setText(sampleTime < 0 ? QString("Done") 
+                : QString("Done, reading sample took %1 ms").arg(sampleTime));
+        }
+
+        refreshStages();
+
+        if (_runPending) {
+            _runPending = false;
+            run();
+        }
+    }
+}
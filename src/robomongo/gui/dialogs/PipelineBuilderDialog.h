@@ -0,0 +1,77 @@
+#pragma once
+
+#include <vector>
+
+#include <QDialog>
+#include <mongo/bson/bsonobj.h>
+
+#include "robomongo/core/domain/PipelinePreview.h"
+
+QT_BEGIN_NAMESPACE
+class QSpinBox;
+class QPushButton;
+class QLabel;
+class QTreeWidget;
+QT_END_NAMESPACE
+
+namespace Robomongo
+{
+    class MongoDatabase;
+    class FindFrame;
+    class PipelineStagePreviewEvent;
+    class PipelineExplainedEvent;
+
+    /**
+     * @brief Edits aggregation pipeline of a collection stage by stage. Output of every stage is 
+     *        previewed by running pipeline prefixes on a limited sample of documents. Outputs are 
+     *        cached by prefix, so after a stage is edited only that stage and the following ones 
+     *        are run again. Explain of the whole pipeline gives time spent in each stage.
+     */
+    class PipelineBuilderDialog : public QDialog
+    {
+        Q_OBJECT
+
+    public:
+        static const QSize minimumSize;
+
+        PipelineBuilderDialog(MongoDatabase *database, const std::string &collection, 
+                              const std::vector<mongo::BSONObj> &stages, QWidget *parent = 0);
+
+    public Q_SLOTS:
+        void handle(PipelineStagePreviewEvent *event);
+        void handle(PipelineExplainedEvent *event);
+
+    private Q_SLOTS:
+        void run();
+        void addStage();
+        void removeStage();
+        void moveStageUp();
+        void moveStageDown();
+        void selectStage();
+        void updateStageText();
+
+    private:
+        void insertStage(int index, const QString &text);
+        void swapStages(int first, int second);
+        void refreshStages();
+        void showOutput();
+        mongo::BSONObj prefixPipeline(size_t count) const;
+
+        MongoDatabase *const _database;
+        std::string const _collection;
+        std::string const _ns;
+        PipelinePreview _cache;
+        std::vector<mongo::BSONObj> _stages;    // stages of the last run
+        std::vector<long long> _explainTimes;   // per stage of the last run, -1 if not known
+        mongo::BSONObj _explainPipeline;
+        bool _running = false;
+        bool _runPending = false;
+        QSpinBox *_sampleSizeSpinBox;
+        QSpinBox *_previewSizeSpinBox;
+        QPushButton *_runButton;
+        QTreeWidget *_stagesTree;
+        FindFrame *_stageEditor;
+        FindFrame *_outputView;
+        QLabel *_statusLabel;
+    };
+}
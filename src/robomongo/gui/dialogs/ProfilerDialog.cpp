@@ -0,0 +1,183 @@
+#include "robomongo/gui/dialogs/ProfilerDialog.h"
+
+#include <QComboBox>
+#include <QSpinBox>
+#include <QPushButton>
+#include <QLabel>
+#include <QTreeWidget>
+#include <QHeaderView>
+#include <QHBoxLayout>
+#include <QVBoxLayout>
+
+#include "robomongo/core/AppRegistry.h"
+#include "robomongo/core/EventBus.h"
+#include "robomongo/core/domain/MongoDatabase.h"
+#include "robomongo/core/utils/QtUtils.h"
+#include "robomongo/gui/widgets/workarea/IndicatorLabel.h"
+#include "robomongo/gui/GuiRegistry.h"
+
+namespace
+{
+    enum ShapeColumn { Shape, Op, Namespace, Count, P50, P95, Max, Total, ExaminedPerReturned, Plan };
+
+    // Sorts numeric columns by value rather than by text
+    class ShapeTreeItem : public QTreeWidgetItem
+    {
+    public:
+        using QTreeWidgetItem::QTreeWidgetItem;
+
+        bool operator<(const QTreeWidgetItem &other) const override
+        {
+            int const column = treeWidget() ? treeWidget()->sortColumn() : 0;
+            if (column >= Count && column <= ExaminedPerReturned)
+                return data(column, Qt::UserRole).toDouble() < other.data(column, Qt::UserRole).toDouble();
+
+            return QTreeWidgetItem::operator<(other);
+        }
+    };
+
+    void setNumber(QTreeWidgetItem *item, int column, double value, const QString &text)
+    {
+        item->setText(column, text);
+        item->setData(column, Qt::UserRole, value);
+        item->setTextAlignment(column, Qt::AlignRight | Qt::AlignVCenter);
+    }
+}
+
+namespace Robomongo
+{
+    const QSize ProfilerDialog::minimumSize = QSize(900, 500);
+
+    ProfilerDialog::ProfilerDialog(MongoDatabase *database, QWidget *parent) :
+        QDialog(parent),
+        _database(database)
+    {
+        setWindowTitle("Profiler");
+        setWindowFlags(windowFlags() & ~Qt::WindowContextHelpButtonHint); // Remove help button (?)
+        setAttribute(Qt::WA_DeleteOnClose);
+        setMinimumSize(minimumSize);
+
+        _levelComboBox = new QComboBox();
+        _levelComboBox->addItem("Off", 0);
+        _levelComboBox->addItem("Slow operations", 1);
+        _levelComboBox->addItem("All operations", 2);
+
+        _slowMsSpinBox = new QSpinBox();
+        _slowMsSpinBox->setRange(0, 1000 * 1000);
+        _slowMsSpinBox->setValue(100);
+        _slowMsSpinBox->setSuffix(" ms");
+
+        _applyButton = new QPushButton("Apply");
+        VERIFY(connect(_applyButton, SIGNAL(clicked()), this, SLOT(applyLevel())));
+
+        _maxEntriesSpinBox = new QSpinBox();
+        _maxEntriesSpinBox->setRange(1000, 10 * 1000 * 1000);
+        _maxEntriesSpinBox->setSingleStep(10000);
+        _maxEntriesSpinBox->setValue(100 * 1000);
+
+        _analyzeButton = new QPushButton("Analyze");
+        VERIFY(connect(_analyzeButton, SIGNAL(clicked()), this, SLOT(analyze())));
+
+        QHBoxLayout *controlsLayout = new QHBoxLayout();
+        controlsLayout->addWidget(new Indicator(GuiRegistry::instance().databaseIcon(), 
+                                                QtUtils::toQString(database->name())));
+        controlsLayout->addSpacing(10);
+        controlsLayout->addWidget(new QLabel("Profiling:"));
+        controlsLayout->addWidget(_levelComboBox);
+        controlsLayout->addWidget(new QLabel("Slower than:"));
+        controlsLayout->addWidget(_slowMsSpinBox);
+        controlsLayout->addWidget(_applyButton);
+        controlsLayout->addStretch(1);
+        controlsLayout->addWidget(new QLabel("Newest entries:"));
+        controlsLayout->addWidget(_maxEntriesSpinBox);
+        controlsLayout->addWidget(_analyzeButton);
+
+        _shapesTree = new QTreeWidget();
+        _shapesTree->setRootIsDecorated(false);
+        _shapesTree->setAlternatingRowColors(true);
+        _shapesTree->setSortingEnabled(true);
+        _shapesTree->setHeaderLabels(QStringList() << "Shape" << "Op" << "Namespace" << "Count" << "p50 ms" 
+                                                   << "p95 ms" << "Max ms" << "Total ms" << "Examined/Returned" << "Plan");
+        _shapesTree->header()->resizeSection(Shape, 360);
+        _shapesTree->sortByColumn(Total, Qt::DescendingOrder);
+
+        _statusLabel = new QLabel();
+
+        QVBoxLayout *layout = new QVBoxLayout();
+        layout->addLayout(controlsLayout);
+        layout->addWidget(_shapesTree, 1);
+        layout->addWidget(_statusLabel);
+        setLayout(layout);
+
+        AppRegistry::instance().bus()->subscribe(this, ProfilingLevelResponse::Type, _database);
+        AppRegistry::instance().bus()->subscribe(this, ProfileAnalyzedEvent::Type, _database);
+
+        _applyButton->setEnabled(false);
+        _database->profilingLevel();
+    }
+
+    void ProfilerDialog::applyLevel()
+    {
+        _applyButton->setEnabled(false);
+        _database->profilingLevel(_levelComboBox->currentData().toInt(), _slowMsSpinBox->value());
+    }
+
+    void ProfilerDialog::analyze()
+    {
+        _analyzeButton->setEnabled(false);
+        _statusLabel->setText("Reading system.profile...");
+        _database->analyzeProfile(_maxEntriesSpinBox->value());
+    }
+
+    void ProfilerDialog::handle(ProfilingLevelResponse *event)
+    {
+        _applyButton->setEnabled(true);
+        if (event->isError()) {
+            _statusLabel->setText(QtUtils::toQString(event->error().errorMessage()));
+            return;
+        }
+
+        _levelComboBox->setCurrentIndex(_levelComboBox->findData(event->level));
+        _slowMsSpinBox->setValue(event->slowMs);
+    }
+
+    void ProfilerDialog::handle(ProfileAnalyzedEvent *event)
+    {
+        if (event->isError()) {
+            _analyzeButton->setEnabled(true);
+            _statusLabel->setText(QtUtils::toQString(event->error().errorMessage()));
+            return;
+        }
+
+        // Partial results replace previous ones, sorting is suspended while tree is refilled
+        _shapesTree->setSortingEnabled(false);
+        _shapesTree->clear();
+
+        QList<QTreeWidgetItem *> items;
+        for (auto const& stats : event->shapes) {
+            auto item = new ShapeTreeItem();
+            QString const shape = QtUtils::toQString(stats.shape);
+            item->setText(Shape, shape);
+            item->setToolTip(Shape, shape);
+            item->setText(Op, QtUtils::toQString(stats.op));
+            item->setText(Namespace, QtUtils::toQString(stats.ns));
+            setNumber(item, Count, stats.count, QString::number(stats.count));
+            setNumber(item, P50, stats.p50Millis, QString::number(stats.p50Millis));
+            setNumber(item, P95, stats.p95Millis, QString::number(stats.p95Millis));
+            setNumber(item, Max, stats.maxMillis, QString::number(stats.maxMillis));
+            setNumber(item, Total, stats.totalMillis, QString::number(stats.totalMillis));
+            double const ratio = stats.examinedPerReturned();
+            setNumber(item, ExaminedPerReturned, ratio, ratio < 0 ? "" : QString::number(ratio, 'f', 1));
+            item->setText(Plan, QtUtils::toQString(stats.planSummary));
+            items.append(item);
+        }
+        _shapesTree->addTopLevelItems(items);
+        _shapesTree->setSortingEnabled(true);
+
+        _statusLabel->setText(QString("%1 entries, %2 query shapes%3")
+            .arg(event->entries).arg(event->shapes.size()).arg(event->finished ? "" : ", reading..."));
+
+        if (event->finished)
+            _analyzeButton->setEnabled(true);
+    }
+}
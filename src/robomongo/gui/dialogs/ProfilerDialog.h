@@ -0,0 +1,50 @@
+#pragma once
+
+#include <QDialog>
+
+QT_BEGIN_NAMESPACE
+class QComboBox;
+class QSpinBox;
+class QPushButton;
+class QLabel;
+class QTreeWidget;
+QT_END_NAMESPACE
+
+namespace Robomongo
+{
+    class MongoDatabase;
+    class ProfilingLevelResponse;
+    class ProfileAnalyzedEvent;
+
+    /**
+     * @brief Changes profiling level of database and shows 'system.profile' entries 
+     *        grouped by query shape, slowest shapes first
+     */
+    class ProfilerDialog : public QDialog
+    {
+        Q_OBJECT
+
+    public:
+        static const QSize minimumSize;
+
+        explicit ProfilerDialog(MongoDatabase *database, QWidget *parent = 0);
+
+    public Q_SLOTS:
+        void handle(ProfilingLevelResponse *event);
+        void handle(ProfileAnalyzedEvent *event);
+
+    private Q_SLOTS:
+        void applyLevel();
+        void analyze();
+
+    private:
+        MongoDatabase *const _database;
+        QComboBox *_levelComboBox;
+        QSpinBox *_slowMsSpinBox;
+        QPushButton *_applyButton;
+        QSpinBox *_maxEntriesSpinBox;
+        QPushButton *_analyzeButton;
+        QLabel *_statusLabel;
+        QTreeWidget *_shapesTree;
+    };
+}
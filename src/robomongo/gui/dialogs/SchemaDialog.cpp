@@ -0,0 +1,185 @@
+#include "robomongo/gui/dialogs/SchemaDialog.h"
+
+#include <QSpinBox>
+#include <QPushButton>
+#include <QLabel>
+#include <QLineEdit>
+#include <QTreeWidget>
+#include <QHeaderView>
+#include <QHash>
+#include <QHBoxLayout>
+#include <QVBoxLayout>
+
+#include "robomongo/core/AppRegistry.h"
+#include "robomongo/core/EventBus.h"
+#include "robomongo/core/domain/MongoDatabase.h"
+#include "robomongo/core/utils/BsonUtils.h"
+#include "robomongo/core/utils/QtUtils.h"
+#include "robomongo/gui/widgets/workarea/IndicatorLabel.h"
+#include "robomongo/gui/GuiRegistry.h"
+
+namespace
+{
+    enum FieldColumn { Field, Types, Presence, Distinct, Min, Max, ArrayLength };
+
+    QString valueText(const mongo::BSONObj &minMax, const char *name)
+    {
+        if (minMax.isEmpty())
+            return QString();
+
+        std::string const json = Robomongo::BsonUtils::jsonString(minMax.getField(name), mongo::TenGen, false, 0,
+                                                                  Robomongo::DefaultEncoding, Robomongo::Utc);
+        return Robomongo::QtUtils::toQString(json).left(200);
+    }
+
+    // Field item stays visible when it or any of its children matches filter
+    bool filterItem(QTreeWidgetItem *item, const QString &text)
+    {
+        bool visible = text.isEmpty() || item->toolTip(Field).contains(text, Qt::CaseInsensitive);
+        for (int i = 0; i < item->childCount(); ++i) {
+            if (filterItem(item->child(i), text))
+                visible = true;
+        }
+        item->setHidden(!visible);
+        return visible;
+    }
+}
+
+namespace Robomongo
+{
+    const QSize SchemaDialog::minimumSize = QSize(900, 550);
+
+    SchemaDialog::SchemaDialog(MongoDatabase *database, const std::string &collection, QWidget *parent) :
+        QDialog(parent),
+        _database(database),
+        _collection(collection),
+        _ns(database->name() + "." + collection)
+    {
+        setWindowTitle("Schema");
+        setWindowFlags(windowFlags() & ~Qt::WindowContextHelpButtonHint); // Remove help button (?)
+        setAttribute(Qt::WA_DeleteOnClose);
+        setMinimumSize(minimumSize);
+
+        _sampleSizeSpinBox = new QSpinBox();
+        _sampleSizeSpinBox->setRange(100, 1000 * 1000);
+        _sampleSizeSpinBox->setSingleStep(1000);
+        _sampleSizeSpinBox->setValue(1000);
+
+        _analyzeButton = new QPushButton("Analyze");
+        VERIFY(connect(_analyzeButton, SIGNAL(clicked()), this, SLOT(analyze())));
+
+        _filterEdit = new QLineEdit();
+        _filterEdit->setPlaceholderText("Filter fields");
+        VERIFY(connect(_filterEdit, SIGNAL(textChanged(const QString&)), this, SLOT(applyFilter(const QString&))));
+
+        QHBoxLayout *controlsLayout = new QHBoxLayout();
+        controlsLayout->addWidget(new Indicator(GuiRegistry::instance().collectionIcon(), QtUtils::toQString(_ns)));
+        controlsLayout->addSpacing(10);
+        controlsLayout->addWidget(_filterEdit, 1);
+        controlsLayout->addWidget(new QLabel("Sample size:"));
+        controlsLayout->addWidget(_sampleSizeSpinBox);
+        controlsLayout->addWidget(_analyzeButton);
+
+        _fieldsTree = new QTreeWidget();
+        _fieldsTree->setAlternatingRowColors(true);
+        _fieldsTree->setHeaderLabels(QStringList() << "Field" << "Types" << "Presence" << "Distinct" 
+                                                   << "Min" << "Max" << "Array length");
+        _fieldsTree->header()->resizeSection(Field, 220);
+        _fieldsTree->header()->resizeSection(Types, 180);
+
+        _statusLabel = new QLabel();
+
+        QVBoxLayout *layout = new QVBoxLayout();
+        layout->addLayout(controlsLayout);
+        layout->addWidget(_fieldsTree, 1);
+        layout->addWidget(_statusLabel);
+        setLayout(layout);
+
+        AppRegistry::instance().bus()->subscribe(this, SchemaAnalyzedEvent::Type, _database);
+
+        // Schema analyzed before is shown until it is analyzed again
+        if (const CollectionSchema *schema = _database->schema(_collection))
+            showSchema(*schema);
+        else
+            analyze();
+    }
+
+    void SchemaDialog::analyze()
+    {
+        _analyzeButton->setEnabled(false);
+        _statusLabel->setText(QString("Sampling %1 documents...").arg(_sampleSizeSpinBox->value()));
+        _database->analyzeSchema(_collection, _sampleSizeSpinBox->value());
+    }
+
+    void SchemaDialog::applyFilter(const QString &text)
+    {
+        for (int i = 0; i < _fieldsTree->topLevelItemCount(); ++i)
+            filterItem(_fieldsTree->topLevelItem(i), text);
+
+        if (!text.isEmpty())
+            _fieldsTree->expandAll();
+    }
+
+    void SchemaDialog::handle(SchemaAnalyzedEvent *event)
+    {
+        // Database publishes results of all its collections
+        if (event->ns != _ns)
+            return;
+
+        _analyzeButton->setEnabled(true);
+        if (event->isError()) {
+            _statusLabel->setText(QtUtils::toQString(event->error().errorMessage()));
+            return;
+        }
+
+        showSchema(event->schema);
+    }
+
+    void SchemaDialog::showSchema(const CollectionSchema &schema)
+    {
+        _fieldsTree->clear();
+
+        // Parents come before their children, so parent item of a path is always known
+        QHash<QString, QTreeWidgetItem *> itemByPath;
+        for (auto const& field : schema.fields) {
+            QString const path = QtUtils::toQString(field.path);
+            int const dot = path.lastIndexOf('.');
+            QTreeWidgetItem *parent = dot < 0 ? NULL : itemByPath.value(path.left(dot));
+
+            auto item = parent ? new QTreeWidgetItem(parent) : new QTreeWidgetItem(_fieldsTree);
+            itemByPath[path] = item;
+
+            item->setText(Field, dot < 0 ? path : path.mid(dot + 1));
+            item->setToolTip(Field, path);
+
+            QStringList types;
+            for (auto const& type : field.types)
+                types << QString("%1 (%2)").arg(QtUtils::toQString(type.first)).arg(type.second);
+            item->setText(Types, types.join(", "));
+            item->setToolTip(Types, types.join("\n"));
+
+            item->setText(Presence, QString("%1%").arg(field.presence * 100, 0, 'f', 1));
+            item->setTextAlignment(Presence, Qt::AlignRight | Qt::AlignVCenter);
+            if (!field.minMax.isEmpty()) {
+                item->setText(Distinct, QString("~%1").arg(field.distinctValues));
+                item->setTextAlignment(Distinct, Qt::AlignRight | Qt::AlignVCenter);
+            }
+
+            QString const min = valueText(field.minMax, "min");
+            QString const max = valueText(field.minMax, "max");
+            item->setText(Min, min);
+            item->setToolTip(Min, min);
+            item->setText(Max, max);
+            item->setToolTip(Max, max);
+
+            if (field.arrays > 0) {
+                item->setText(ArrayLength, QString("%1 - %2, avg %3").arg(field.minArrayLength)
+                    .arg(field.maxArrayLength).arg(field.avgArrayLength, 0, 'f', 1));
+            }
+        }
+
+        applyFilter(_filterEdit->text());
+        _statusLabel->setText(QString("%1 sampled documents, %2 fields")
+            .arg(schema.sampledDocuments).arg(schema.fields.size()));
+    }
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <QDialog>
+
+QT_BEGIN_NAMESPACE
+class QSpinBox;
+class QPushButton;
+class QLabel;
+class QLineEdit;
+class QTreeWidget;
+QT_END_NAMESPACE
+
+namespace Robomongo
+{
+    class MongoDatabase;
+    class SchemaAnalyzedEvent;
+    struct CollectionSchema;
+
+    /**
+     * @brief Shows fields of a collection inferred from random sample of its documents: 
+     *        types, presence, distinct values, min/max and array lengths of every path
+     */
+    class SchemaDialog : public QDialog
+    {
+        Q_OBJECT
+
+    public:
+        static const QSize minimumSize;
+
+        SchemaDialog(MongoDatabase *database, const std::string &collection, QWidget *parent = 0);
+
+    public Q_SLOTS:
+        void handle(SchemaAnalyzedEvent *event);
+
+    private Q_SLOTS:
+        void analyze();
+        void applyFilter(const QString &text);
+
+    private:
+        void showSchema(const CollectionSchema &schema);
+
+        MongoDatabase *const _database;
+        std::string const _collection;
+        std::string const _ns;
+        QSpinBox *_sampleSizeSpinBox;
+        QPushButton *_analyzeButton;
+        QLineEdit *_filterEdit;
+        QLabel *_statusLabel;
+        QTreeWidget *_fieldsTree;
+    };
+}
@@ -10,11 +10,14 @@
 #include "robomongo/gui/dialogs/CreateDatabaseDialog.h"
 #include "robomongo/gui/dialogs/CopyCollectionDialog.h"
 #include "robomongo/gui/dialogs/DocumentTextEditor.h"
+#include "robomongo/gui/dialogs/SchemaDialog.h"
+#include "robomongo/gui/dialogs/PipelineBuilderDialog.h"
 #include "robomongo/gui/GuiRegistry.h"
 #include "robomongo/gui/utils/DialogUtils.h"
 
 #include "robomongo/core/settings/ConnectionSettings.h"
 #include "robomongo/core/domain/MongoCollection.h"
+#include "robomongo/core/domain/MongoUtils.h"
 #include "robomongo/core/domain/MongoServer.h"
 #include "robomongo/core/domain/App.h"
 #include "robomongo/core/utils/QtUtils.h"
@@ -25,10 +28,12 @@
 namespace
 {
     const char *tooltipTemplate =
-        "%s "
+        "%1 "
         "<table>"
-        "<tr><td>Count:</td> <td><b>&nbsp;&nbsp;%lld</b></td></tr>"
-        "<tr><td>Size:</td><td><b>&nbsp;&nbsp;%s</b></td></tr>"
+        "<tr><td>Count:</td> <td><b>&nbsp;&nbsp;%2</b></td></tr>"
+        "<tr><td>Size:</td><td><b>&nbsp;&nbsp;%3</b></td></tr>"
+        "<tr><td>Storage Size:</td><td><b>&nbsp;&nbsp;%4</b></td></tr>"
+        "<tr><td>Index Size:</td><td><b>&nbsp;&nbsp;%5</b></td></tr>"
         "</table>"
         ;
 }
@@ -63,6 +68,16 @@ namespace Robomongo
 
         QAction *totalSize = new QAction("Total Size", this);
         VERIFY(connect(totalSize, SIGNAL(triggered()), SLOT(ui_totalSize())));
+
+        QAction *analyzeSchema = new QAction("Analyze Schema...", this);
+        VERIFY(connect(analyzeSchema, SIGNAL(triggered()), SLOT(ui_analyzeSchema())));
+
+        QAction *aggregationPipeline = new QAction("Aggregation Pipeline...", this);
+        VERIFY(connect(aggregationPipeline, SIGNAL(triggered()), SLOT(ui_aggregationPipeline())));
+
+        QAction *watchChanges = new QAction("Watch Changes", this);
+        VERIFY(connect(watchChanges, SIGNAL(triggered()), SLOT(ui_watchChanges())));
+
         QAction *shardVersion = new QAction("Shard Version", this);
         VERIFY(connect(shardVersion, SIGNAL(triggered()), SLOT(ui_shardVersion())));
 
@@ -77,9 +92,8 @@ namespace Robomongo
         QAction *duplicateCollection = new QAction("Duplicate Collection...", this);
         VERIFY(connect(duplicateCollection, SIGNAL(triggered()), SLOT(ui_duplicateCollection())));
 
-        // Disabling for 0.8.5 release as this is currently a broken misfeature (see discussion on issue #398)
-        // QAction *copyCollectionToDiffrentServer = new QAction("Copy Collection to Database...", this);
-        // VERIFY(connect(copyCollectionToDiffrentServer, SIGNAL(triggered()), SLOT(ui_copyToCollectionToDiffrentServer())));
+        QAction *copyCollectionToDiffrentServer = new QAction("Copy Collection to Database...", this);
+        VERIFY(connect(copyCollectionToDiffrentServer, SIGNAL(triggered()), SLOT(ui_copyToCollectionToDiffrentServer())));
 
         QAction *viewCollection = new QAction("View Documents", this);
         VERIFY(connect(viewCollection, SIGNAL(triggered()), SLOT(ui_viewCollection())));
@@ -93,11 +107,13 @@ namespace Robomongo
         BaseClass::_contextMenu->addSeparator();
         BaseClass::_contextMenu->addAction(renameCollection);
         BaseClass::_contextMenu->addAction(duplicateCollection);
-        // Disabling for 0.8.5 release as this is currently a broken misfeature (see discussion on issue #398)
-        // BaseClass::_contextMenu->addAction(copyCollectionToDiffrentServer);
+        BaseClass::_contextMenu->addAction(copyCollectionToDiffrentServer);
         BaseClass::_contextMenu->addAction(dropCollection);
         BaseClass::_contextMenu->addSeparator();
         BaseClass::_contextMenu->addAction(collectionStats);
+        BaseClass::_contextMenu->addAction(analyzeSchema);
+        BaseClass::_contextMenu->addAction(aggregationPipeline);
+        BaseClass::_contextMenu->addAction(watchChanges);
         BaseClass::_contextMenu->addSeparator();
         BaseClass::_contextMenu->addAction(shardVersion);
         BaseClass::_contextMenu->addAction(shardDistribution);
@@ -106,10 +122,15 @@ namespace Robomongo
         AppRegistry::instance().bus()->subscribe(_databaseItem, AddEditIndexResponse::Type, this);
         AppRegistry::instance().bus()->subscribe(_databaseItem, DropCollectionIndexResponse::Type, this);
         AppRegistry::instance().bus()->subscribe(this, CollectionIndexesLoadingEvent::Type, this);
+        AppRegistry::instance().bus()->subscribe(this, CollectionStatsLoadedEvent::Type, _collection->database());
 
         setText(0, QtUtils::toQString(_collection->name()));
         setIcon(0, GuiRegistry::instance().collectionIcon());
 
+        // Statistics may be already known from the cache of the worker
+        if (_collection->info().hasStats())
+            setToolTip(0, buildToolTip(_collection->info()));
+
         _indexDir = new ExplorerCollectionIndexesDir(this);
         addChild(_indexDir);
 
@@ -212,12 +233,24 @@ namespace Robomongo
         _databaseItem->dropIndexFromCollection(this, QtUtils::toStdString(ind->text(0)));
     }
 
-    QString ExplorerCollectionTreeItem::buildToolTip(MongoCollection *collection)
+    void ExplorerCollectionTreeItem::handle(CollectionStatsLoadedEvent *event)
+    {
+        for (auto const& info : event->collectionInfos) {
+            if (info.fullName() == _collection->fullName() && info.hasStats()) {
+                setToolTip(0, buildToolTip(info));
+                return;
+            }
+        }
+    }
+
+    QString ExplorerCollectionTreeItem::buildToolTip(const MongoCollectionInfo &info) const
     {
-        // This function does not used now
-        char buff[2048] = {0};
-//        sprintf(buff,tooltipTemplate,collection->name().c_str(),collection->info().count(),collection->sizeString().c_str());
-        return buff;
+        return QString(tooltipTemplate)
+            .arg(QtUtils::toQString(info.name()).toHtmlEscaped())
+            .arg(info.count())
+            .arg(MongoUtils::buildNiceSizeString(info.sizeBytes()))
+            .arg(MongoUtils::buildNiceSizeString(info.storageSizeBytes()))
+            .arg(MongoUtils::buildNiceSizeString(info.totalIndexSizeBytes()));
     }
 
     void ExplorerCollectionTreeItem::ui_addDocument()
@@ -322,20 +355,27 @@ namespace Robomongo
         }
     }
 
+    void ExplorerCollectionTreeItem::ui_analyzeSchema()
+    {
+        auto dlg = new SchemaDialog(_collection->database(), _collection->name(), treeWidget());
+        dlg->show();
+    }
+
+    void ExplorerCollectionTreeItem::ui_aggregationPipeline()
+    {
+        auto dlg = new PipelineBuilderDialog(_collection->database(), _collection->name(), 
+                                             std::vector<mongo::BSONObj>(), treeWidget());
+        dlg->show();
+    }
+
     void ExplorerCollectionTreeItem::ui_copyToCollectionToDiffrentServer()
     {
         MongoDatabase *databaseFrom = _collection->database();
-        MongoServer *server = databaseFrom->server();
-        ConnectionSettings *settings = server->connectionRecord();
-
-        CopyCollection dlg(QtUtils::toQString(settings->getFullAddress()), QtUtils::toQString(databaseFrom->name()), QtUtils::toQString(_collection->name()) );
-        int result = dlg.exec();
 
-        if (result == QDialog::Accepted) {
-            MongoDatabase *databaseTo = dlg.selectedDatabase();
-            databaseTo->copyCollection(server, databaseFrom->name(), _collection->name());
-            databaseTo->loadCollections();
-        }
+        // Dialog starts the copy and stays open until it is done
+        CopyCollection dlg(databaseFrom->server(), QtUtils::toQString(databaseFrom->name()), 
+                           QtUtils::toQString(_collection->name()), treeWidget());
+        dlg.exec();
     }
 
     void ExplorerCollectionTreeItem::ui_renameCollection()
@@ -364,6 +404,11 @@ namespace Robomongo
         openCurrentCollectionShell("find({})", true, cp);
     }
 
+    void ExplorerCollectionTreeItem::ui_watchChanges()
+    {
+        openCurrentCollectionShell("watch([])");
+    }
+
     void ExplorerCollectionTreeItem::ui_storageSize()
     {
         openCurrentCollectionShell("storageSize()");
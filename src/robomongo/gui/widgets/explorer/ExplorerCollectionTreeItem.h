@@ -12,6 +12,7 @@ namespace Robomongo
     class LoadCollectionIndexesResponse;
     struct AddEditIndexResponse;
     class DropCollectionIndexResponse;
+    class CollectionStatsLoadedEvent;
     class ExplorerCollectionIndexesDir;
     class ExplorerDatabaseTreeItem;
 
@@ -38,12 +39,16 @@ namespace Robomongo
         void handle(AddEditIndexResponse *event);
         void handle(DropCollectionIndexResponse *event);
         void handle(CollectionIndexesLoadingEvent *event);
+        void handle(CollectionStatsLoadedEvent *event);
 
     private Q_SLOTS:
         void ui_addDocument();
         void ui_removeDocument();
         void ui_updateDocument();
         void ui_collectionStatistics();
+        void ui_analyzeSchema();
+        void ui_aggregationPipeline();
+        void ui_watchChanges();
         void ui_removeAllDocuments();
         void ui_storageSize();
         void ui_totalIndexSize();
@@ -57,7 +62,7 @@ namespace Robomongo
         void ui_viewCollection();
 
     private:
-        QString buildToolTip(MongoCollection *collection);
+        QString buildToolTip(const MongoCollectionInfo &info) const;
         ExplorerCollectionIndexesDir *_indexDir;
         MongoCollection *const _collection;
         ExplorerDatabaseTreeItem *const _databaseItem;
@@ -15,6 +15,9 @@
 #include "robomongo/core/AppRegistry.h"
 #include "robomongo/core/EventBus.h"
 
+#include "robomongo/gui/dialogs/CurrentOpsDialog.h"
+#include "robomongo/gui/dialogs/ProfilerDialog.h"
+#include "robomongo/gui/dialogs/IndexAdvisorDialog.h"
 #include "robomongo/gui/widgets/explorer/ExplorerCollectionTreeItem.h"
 #include "robomongo/gui/widgets/explorer/ExplorerDatabaseCategoryTreeItem.h"
 #include "robomongo/gui/widgets/explorer/ExplorerUserTreeItem.h"
@@ -61,12 +64,21 @@ namespace Robomongo
         QAction *dbStats = new QAction("Database Statistics", this);
         VERIFY(connect(dbStats, SIGNAL(triggered()), SLOT(ui_dbStatistics())));
 
-        QAction *dbCurrOps = new QAction("Current Operations", this);
+        QAction *dbCurrOps = new QAction("Current Operations...", this);
         VERIFY(connect(dbCurrOps, SIGNAL(triggered()), SLOT(ui_dbCurrentOps())));
 
         QAction *dbKillOp = new QAction("Kill Operation...", this);
         VERIFY(connect(dbKillOp, SIGNAL(triggered()), SLOT(ui_dbKillOp())));
 
+        QAction *dbProfiler = new QAction("Profiler...", this);
+        VERIFY(connect(dbProfiler, SIGNAL(triggered()), SLOT(ui_dbProfiler())));
+
+        QAction *dbIndexAdvisor = new QAction("Index Advisor...", this);
+        VERIFY(connect(dbIndexAdvisor, SIGNAL(triggered()), SLOT(ui_dbIndexAdvisor())));
+
+        QAction *dbWatchChanges = new QAction("Watch Changes", this);
+        VERIFY(connect(dbWatchChanges, SIGNAL(triggered()), SLOT(ui_dbWatchChanges())));
+
         QAction *dbDrop = new QAction("Drop Database...", this);
         VERIFY(connect(dbDrop, SIGNAL(triggered()), SLOT(ui_dbDrop())));
 
@@ -83,6 +95,9 @@ namespace Robomongo
         BaseClass::_contextMenu->addSeparator();
         BaseClass::_contextMenu->addAction(dbCurrOps);
         BaseClass::_contextMenu->addAction(dbKillOp);
+        BaseClass::_contextMenu->addAction(dbProfiler);
+        BaseClass::_contextMenu->addAction(dbIndexAdvisor);
+        BaseClass::_contextMenu->addAction(dbWatchChanges);
         BaseClass::_contextMenu->addSeparator();
         BaseClass::_contextMenu->addAction(dbRepair);
         BaseClass::_contextMenu->addAction(dbDrop);
@@ -123,7 +138,7 @@ namespace Robomongo
 
     void ExplorerDatabaseTreeItem::expandColection(ExplorerCollectionTreeItem *const item)
     {        
-         _bus->send(_database->server()->worker(), new LoadCollectionIndexesRequest(item, item->collection()->info()));
+         _database->server()->send(new LoadCollectionIndexesRequest(item, item->collection()->info()));
     }
 
     void ExplorerDatabaseTreeItem::dropIndexFromCollection(ExplorerCollectionTreeItem *const item, const std::string &indexName)
@@ -282,7 +297,13 @@ namespace Robomongo
 
     void ExplorerDatabaseTreeItem::ui_dbCurrentOps()
     {
-        openCurrentDatabaseShell(_database, "db.currentOp()");
+        auto dlg = new CurrentOpsDialog(_database, treeWidget());
+        dlg->show();
+    }
+
+    void ExplorerDatabaseTreeItem::ui_dbWatchChanges()
+    {
+        openCurrentDatabaseShell(_database, "db.watch([])");
     }
 
     void ExplorerDatabaseTreeItem::ui_dbKillOp()
@@ -290,6 +311,18 @@ namespace Robomongo
         openCurrentDatabaseShell(_database, "db.killOp()", false, CursorPosition(0, -1));
     }
 
+    void ExplorerDatabaseTreeItem::ui_dbProfiler()
+    {
+        auto dlg = new ProfilerDialog(_database, treeWidget());
+        dlg->show();
+    }
+
+    void ExplorerDatabaseTreeItem::ui_dbIndexAdvisor()
+    {
+        auto dlg = new IndexAdvisorDialog(_database, treeWidget());
+        dlg->show();
+    }
+
     void ExplorerDatabaseTreeItem::ui_dbDrop()
     {
         auto const& buff = QString("Drop <b>%1</b> database?").arg(QtUtils::toQString(_database->name()));
@@ -53,6 +53,9 @@ namespace Robomongo
         void ui_dbStatistics();
         void ui_dbCurrentOps();
         void ui_dbKillOp();
+        void ui_dbProfiler();
+        void ui_dbIndexAdvisor();
+        void ui_dbWatchChanges();
         void ui_dbDrop();
         void ui_dbRepair();
         void ui_dbOpenShell();
@@ -53,6 +53,9 @@ namespace Robomongo
         QAction *serverStatus = new QAction("Server Status", this);
         VERIFY(connect(serverStatus, SIGNAL(triggered()), SLOT(ui_serverStatus())));
 
+        QAction *serverMonitor = new QAction("Server Monitor", this);
+        VERIFY(connect(serverMonitor, SIGNAL(triggered()), SLOT(ui_serverMonitor())));
+
         QAction *serverVersion = new QAction("MongoDB Version", this);
         VERIFY(connect(serverVersion, SIGNAL(triggered()), SLOT(ui_serverVersion())));
 
@@ -71,6 +74,7 @@ namespace Robomongo
         BaseClass::_contextMenu->addSeparator();
         BaseClass::_contextMenu->addAction(createDatabase);
         BaseClass::_contextMenu->addAction(serverStatus);
+        BaseClass::_contextMenu->addAction(serverMonitor);
         BaseClass::_contextMenu->addAction(serverHostInfo);
         BaseClass::_contextMenu->addAction(serverVersion);
         BaseClass::_contextMenu->addSeparator();
@@ -259,6 +263,11 @@ namespace Robomongo
         openCurrentServerShell(_server, "db.serverStatus()");
     }
 
+    void ExplorerServerTreeItem::ui_serverMonitor()
+    {
+        AppRegistry::instance().app()->openServerMonitor(_server);
+    }
+
     void ExplorerServerTreeItem::ui_serverVersion()
     {
         openCurrentServerShell(_server, "db.version()");
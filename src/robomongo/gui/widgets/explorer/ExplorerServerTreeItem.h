@@ -51,6 +51,7 @@ namespace Robomongo
         void ui_createDatabase();
         void ui_serverHostInfo();
         void ui_serverStatus();
+        void ui_serverMonitor();
         void ui_serverVersion();
 
     private:
@@ -9,10 +9,11 @@
 
 namespace Robomongo
 {
-    BsonTableModelProxy::BsonTableModelProxy(QObject *parent) 
+    BsonTableModelProxy::BsonTableModelProxy(QObject *parent, const ColumnsValuesType &columns) 
         : BaseClass(parent)
     {
-       
+        for (auto const& col : columns)
+            addColumn(col);
     }
 
     int BsonTableModelProxy::rowCount(const QModelIndex &parent) const
@@ -34,16 +35,12 @@ namespace Robomongo
 
     QModelIndex BsonTableModelProxy::mapFromSource( const QModelIndex & sourceIndex ) const
     {
-        int row = sourceIndex.row();
-        int col = sourceIndex.column();
-
-        BsonTreeItem *node = QtUtils::item<BsonTreeItem *>(sourceIndex);
-        if (!node || _columns.size() <= col)
+        // Only top-level documents are rows of the table
+        BsonTreeItem const node = BsonTreeModel::item(sourceIndex);
+        if (!node.isValid() || !node.isSuperParent())
             return QModelIndex();
 
-        BsonTreeItem *child = node->childByKey(_columns[col]);
-
-        return createIndex( row, col, child );
+        return createCellIndex(sourceIndex.row(), sourceIndex.column(), node);
     }
 
     QModelIndex BsonTableModelProxy::sibling(int row, int column, const QModelIndex &idx) const
@@ -53,13 +50,35 @@ namespace Robomongo
 
     QModelIndex BsonTableModelProxy::index( int row, int col, const QModelIndex& parent ) const
     {
-        BsonTreeItem *node = QtUtils::item<BsonTreeItem *>(sourceModel()->index(row, 0, parent));
-        if (!node || _columns.size() <= col)
+        BsonTreeItem const node = BsonTreeModel::item(sourceModel()->index(row, 0, parent));
+        return createCellIndex(row, col, node);
+    }
+
+    QModelIndex BsonTableModelProxy::createCellIndex(int row, int col, const BsonTreeItem &document) const
+    {
+        if (!document.isValid() || _columns.size() <= col || _rows.size() <= row)
             return QModelIndex();
 
-        BsonTreeItem *child = node->childByKey(_columns[col]);
+        RowCellsType const& cells = rowCells(row, document);
+        return createIndex(row, col, col < cells.size() ? cells[col] : BsonNodeStore::NoNode);
+    }
 
-        return createIndex( row, col, child );
+    const BsonTableModelProxy::RowCellsType &BsonTableModelProxy::rowCells(int row, const BsonTreeItem &document) const
+    {
+        RowCellsType &cells = _rows[row];
+        if (!cells.empty() || _columns.empty())
+            return cells;
+
+        cells.assign(_columns.size(), BsonNodeStore::NoNode);
+        unsigned const count = document.childrenCount();
+        for (unsigned i = 0; i < count; ++i) {
+            BsonTreeItem const child = document.child(i);
+            auto const col = _columnsByName.find(child.key());
+            // The first one of duplicated fields, like lookup by key would find
+            if (col != _columnsByName.end() && cells[col.value()] == BsonNodeStore::NoNode)
+                cells[col.value()] = child.node();
+        }
+        return cells;
     }
 
     QModelIndex BsonTableModelProxy::mapToSource( const QModelIndex &proxyIndex ) const
@@ -70,13 +89,12 @@ namespace Robomongo
         Q_ASSERT( proxyIndex.model() == this );
 
         QModelIndex sourceIndex;
-        BsonTreeItem *child = static_cast<BsonTreeItem *>(proxyIndex.internalPointer());
-        if (child) {
+        BsonTreeItem const child = BsonTreeModel::item(proxyIndex);
+        if (child.isValid()) {
             QtUtils::HackQModelIndex* hack = reinterpret_cast<QtUtils::HackQModelIndex*>(&sourceIndex);
-            BsonTreeItem *parent = static_cast<BsonTreeItem *>(child->parent());
             hack->r = proxyIndex.row();
             hack->c = proxyIndex.column();
-            hack->i = parent;
+            hack->i = reinterpret_cast<void *>(static_cast<quintptr>(child.parent().node()));
             hack->m = sourceModel();
         }
         return sourceIndex;
@@ -85,24 +103,88 @@ namespace Robomongo
     void BsonTableModelProxy::setSourceModel( QAbstractItemModel* model )
     {
         if (model) {
-            BsonTreeItem *child = QtUtils::item<BsonTreeItem *>(model->index(0, 0));
-            if (child) {
-                _root = qobject_cast<BsonTreeItem *>(child->parent());
-                if (_root) {
-                    int count = _root->childrenCount();
-                    for (int i = 0; i < count; ++i) {
-                        BsonTreeItem *child = _root->child(i);
-                        int countc = child->childrenCount();
-                        for (int j = 0; j < countc; ++j) {
-                            addColumn(child->child(j)->key());
-                        }
-                    }
+            int const count = model->rowCount();
+            _rows.assign(count, RowCellsType());
+            for (int i = 0; i < count; ++i) {
+                BsonTreeItem const child = BsonTreeModel::item(model->index(i, 0));
+                unsigned const countc = child.isValid() ? child.childrenCount() : 0;
+                for (unsigned j = 0; j < countc; ++j) {
+                    addColumn(child.child(j).key());
                 }
             }
+            // Streamed query results are appended to source model batch by batch
+            VERIFY(connect(model, SIGNAL(rowsInserted(const QModelIndex&, int, int)), 
+                           this, SLOT(sourceRowsInserted(const QModelIndex&, int, int))));
+            // Live results drop their oldest documents
+            VERIFY(connect(model, SIGNAL(rowsAboutToBeRemoved(const QModelIndex&, int, int)), 
+                           this, SLOT(sourceRowsAboutToBeRemoved(const QModelIndex&, int, int))));
+            VERIFY(connect(model, SIGNAL(rowsRemoved(const QModelIndex&, int, int)), 
+                           this, SLOT(sourceRowsRemoved(const QModelIndex&, int, int))));
+            // Nodes are moved when source model compacts its node store
+            VERIFY(connect(model, SIGNAL(layoutAboutToBeChanged()), this, SLOT(sourceLayoutAboutToBeChanged())));
+            VERIFY(connect(model, SIGNAL(layoutChanged()), this, SLOT(sourceLayoutChanged())));
         }
         return BaseClass::setSourceModel(model);
     }
 
+    void BsonTableModelProxy::sourceRowsInserted(const QModelIndex &parent, int first, int last)
+    {
+        // Only top-level documents are rows of the table
+        if (parent.isValid())
+            return;
+
+        ColumnsValuesType newColumns;
+        for (int i = first; i <= last; ++i) {
+            BsonTreeItem const child = BsonTreeModel::item(sourceModel()->index(i, 0));
+            unsigned const countc = child.isValid() ? child.childrenCount() : 0;
+            for (unsigned j = 0; j < countc; ++j) {
+                QString const key = child.child(j).key();
+                if (!_columnsByName.contains(key)) {
+                    _columnsByName.insert(key, _columns.size() + newColumns.size());
+                    newColumns.push_back(key);
+                }
+            }
+        }
+
+        if (!newColumns.empty()) {
+            beginInsertColumns(QModelIndex(), _columns.size(), _columns.size() + newColumns.size() - 1);
+            _columns.insert(_columns.end(), newColumns.begin(), newColumns.end());
+            endInsertColumns();
+        }
+
+        beginInsertRows(QModelIndex(), first, last);
+        _rows.insert(_rows.begin() + first, last - first + 1, RowCellsType());
+        endInsertRows();
+    }
+
+    void BsonTableModelProxy::sourceRowsAboutToBeRemoved(const QModelIndex &parent, int first, int last)
+    {
+        if (!parent.isValid())
+            beginRemoveRows(QModelIndex(), first, last);
+    }
+
+    void BsonTableModelProxy::sourceRowsRemoved(const QModelIndex &parent, int first, int last)
+    {
+        if (!parent.isValid()) {
+            _rows.erase(_rows.begin() + first, _rows.begin() + last + 1);
+            endRemoveRows();
+        }
+    }
+
+    void BsonTableModelProxy::sourceLayoutAboutToBeChanged()
+    {
+        Q_EMIT layoutAboutToBeChanged();
+    }
+
+    void BsonTableModelProxy::sourceLayoutChanged()
+    {
+        // Rows and columns stay, only nodes of cells are moved
+        _rows.assign(_rows.size(), RowCellsType());
+        for (auto const& index : persistentIndexList())
+            changePersistentIndex(index, this->index(index.row(), index.column(), QModelIndex()));
+        Q_EMIT layoutChanged();
+    }
+
     QVariant BsonTableModelProxy::data(const QModelIndex &index, int role) const
     {
         QVariant result;
@@ -110,9 +192,9 @@ namespace Robomongo
         if (!index.isValid())
             return result;
 
-        BsonTreeItem *node = QtUtils::item<BsonTreeItem *>(index);
+        BsonTreeItem const node = BsonTreeModel::item(index);
 
-        if (!node) {
+        if (!node.isValid()) {
             if (role == Qt::BackgroundRole) {
                 return QBrush("#f5f3f2");
             }
@@ -120,12 +202,13 @@ namespace Robomongo
         }
 
         if (role == Qt::DisplayRole || role == Qt::ToolTipRole) {
-            bool isCut = node->type() == mongo::String ||  node->type() == mongo::Code || node->type() == mongo::CodeWScope;  
+            QString const& value = static_cast<const BsonTreeModel *>(sourceModel())->text(node).value;
+            bool isCut = node.type() == mongo::String ||  node.type() == mongo::Code || node.type() == mongo::CodeWScope;  
             if (role == Qt::ToolTipRole) {
-                result = isCut ? node->value() : node->value().left(500); 
+                result = isCut ? value : value.left(500); 
             }
             else{
-                result = isCut ? node->value() : node->value().simplified().left(300); 
+                result = isCut ? value : value.simplified().left(300); 
             }
         }
         else if (role == Qt::DecorationRole) {
@@ -152,22 +235,14 @@ namespace Robomongo
         return _columns[col];
     }
 
-    size_t BsonTableModelProxy::findIndexColumn(const QString &col) const
-    {
-        for (int i = 0; i < _columns.size(); ++i) {
-            if (_columns[i] == col) {
-                return i;
-            }
-        }
-        return _columns.size();
-    }
-
     size_t BsonTableModelProxy::addColumn(const QString &col)
     {
-        size_t column = findIndexColumn(col);
-        if (column == _columns.size()) {
-            _columns.push_back(col);
-        }
-        return column;
+        auto const it = _columnsByName.find(col);
+        if (it != _columnsByName.end())
+            return it.value();
+
+        _columnsByName.insert(col, _columns.size());
+        _columns.push_back(col);
+        return _columns.size() - 1;
     }
 }
@@ -1,12 +1,20 @@
 #pragma once
+#include <deque>
 #include <vector>
 
 #include <QAbstractProxyModel>
+#include <QHash>
 
 namespace Robomongo
 {
     class BsonTreeItem;
 
+    /**
+     * @brief Top-level documents of BsonTreeModel as rows, their fields as columns.
+     *        Internal id of index is node of the field, BsonNodeStore::NoNode if row has no such field.
+     *        Columns are found by name in hash, nodes of all cells of a row are found at once
+     *        when the row is shown first.
+     */
     class BsonTableModelProxy : public QAbstractProxyModel
     {
         Q_OBJECT
@@ -15,7 +23,10 @@ namespace Robomongo
         typedef QAbstractProxyModel BaseClass;
         typedef std::vector<QString> ColumnsValuesType;
 
-        explicit BsonTableModelProxy(QObject *parent = 0);
+        /**
+         * @param columns: columns shown first, in this order, whether documents have them or not
+         */
+        explicit BsonTableModelProxy(QObject *parent = 0, const ColumnsValuesType &columns = ColumnsValuesType());
         QVariant data(const QModelIndex &index, int role) const;
 
         int rowCount(const QModelIndex &parent = QModelIndex()) const;
@@ -28,12 +39,31 @@ namespace Robomongo
         virtual void setSourceModel( QAbstractItemModel* model );
         virtual QModelIndex parent( const QModelIndex& index ) const;
         virtual QModelIndex sibling(int row, int column, const QModelIndex &idx) const;
+
+    private Q_SLOTS:
+        void sourceRowsInserted(const QModelIndex &parent, int first, int last);
+        void sourceRowsAboutToBeRemoved(const QModelIndex &parent, int first, int last);
+        void sourceRowsRemoved(const QModelIndex &parent, int first, int last);
+        void sourceLayoutAboutToBeChanged();
+        void sourceLayoutChanged();
+
     private:
+        typedef std::vector<uint32_t> RowCellsType;
+
         QString column(int col) const;
         size_t addColumn(const QString &col);
-        size_t findIndexColumn(const QString &col) const;
+        QModelIndex createCellIndex(int row, int col, const BsonTreeItem &document) const;
+
+        /**
+         * @brief Node of every column of 'row', built with the first call.
+         *        Columns added after that are missing in the row.
+         */
+        const RowCellsType &rowCells(int row, const BsonTreeItem &document) const;
 
         ColumnsValuesType _columns;
-        BsonTreeItem *_root;
+        QHash<QString, size_t> _columnsByName;
+
+        // Cells of rows in order of source rows, empty until row is shown
+        mutable std::deque<RowCellsType> _rows;
     };
 }
@@ -5,7 +5,7 @@
 #include <QMenu>
 #include <QKeyEvent>
 
-#include "robomongo/gui/widgets/workarea/BsonTreeItem.h"
+#include "robomongo/gui/widgets/workarea/BsonTreeModel.h"
 #include "robomongo/gui/GuiRegistry.h"
 #include "robomongo/core/utils/QtUtils.h"
 
@@ -66,7 +66,7 @@ namespace Robomongo
         }
         else{
             QModelIndex selectedInd = selectedIndex();
-            BsonTreeItem *documentItem = QtUtils::item<BsonTreeItem*>(selectedInd);
+            BsonTreeItem const documentItem = BsonTreeModel::item(selectedInd);
             QMenu menu(this);
             _notifier.initMenu(&menu, documentItem);
             menu.exec(menuPoint);
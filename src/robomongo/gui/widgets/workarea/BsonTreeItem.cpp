@@ -1,157 +1,130 @@
 #include "robomongo/gui/widgets/workarea/BsonTreeItem.h"
-#include <mongo/client/dbclient_base.h>
 
-using namespace mongo;
+#include "robomongo/core/AppRegistry.h"
+#include "robomongo/core/settings/SettingsManager.h"
+#include "robomongo/core/utils/BsonUtils.h"
+#include "robomongo/core/utils/QtUtils.h"
+
 namespace
 {
-    struct removeIfFound
-    {
-        removeIfFound(Robomongo::BsonTreeItem *item) :_whatSearch(item) {}
-        bool operator()(const Robomongo::BsonTreeItem* item) const
-        {
-            if (item == _whatSearch) {
-                delete _whatSearch;
-                return true;
-            }
-            return false;
-        }
-        const Robomongo::BsonTreeItem *const _whatSearch;
-    };
+    QString arrayValue(int itemsCount) {
+        QString elements = itemsCount == 1 ? "element" : "elements";
+        return QString("[ %1 %2 ]").arg(itemsCount).arg(elements);
+    }
 
-    const Robomongo::BsonTreeItem *findSuperRoot(const Robomongo::BsonTreeItem *const item)
-    {
-        Robomongo::BsonTreeItem *parent = qobject_cast<Robomongo::BsonTreeItem *>(item->parent());
-        if (parent) {
-            Robomongo::BsonTreeItem *grParent = qobject_cast<Robomongo::BsonTreeItem *>(parent->parent());
-            if (grParent) {
-               return findSuperRoot(parent);
-            }
-        }
-        return item;
+    QString objectValue(int itemsCount) {
+        QString fields = itemsCount == 1 ? "field" : "fields";
+        return QString("{ %1 %2 }").arg(itemsCount).arg(fields);
     }
 }
+
 namespace Robomongo
 {
-    BsonTreeItem::BsonTreeItem(QObject *parent) 
-        :BaseClass(parent)
+    unsigned BsonTreeItem::childrenCount() const
     {
-       
+        return _store->node(_node).childrenCount;
     }
 
-    BsonTreeItem::BsonTreeItem(const mongo::BSONObj &bsonObjRoot, QObject *parent)
-        :BaseClass(parent),
-        _root(bsonObjRoot)
+    BsonTreeItem BsonTreeItem::child(unsigned pos) const
     {
+        if (pos >= childrenCount())
+            return BsonTreeItem();
 
+        return BsonTreeItem(_store, _store->child(_node, pos));
     }
 
-    unsigned BsonTreeItem::childrenCount() const
+    BsonTreeItem BsonTreeItem::childByKey(const QString &val) const
     {
-        return _items.size();
-    }
+        // Keys of array elements are their positions in square brackets
+        if (BsonUtils::isArray(type())) {
+            if (!val.startsWith('[') || !val.endsWith(']'))
+                return BsonTreeItem();
 
-    void BsonTreeItem::clear()
-    {
-        _items.clear();
-    }
-
-    void BsonTreeItem::addChild(BsonTreeItem *item)
-    {
-        _items.push_back(item);
-    }
+            bool ok = false;
+            unsigned const pos = val.mid(1, val.size() - 2).toUInt(&ok);
+            return ok ? child(pos) : BsonTreeItem();
+        }
 
-    BsonTreeItem* BsonTreeItem::child(unsigned pos) const
-    {
-        return _items[pos];
+        return BsonTreeItem(_store, _store->findChild(_node, QtUtils::toStdString(val).c_str()));
     }
 
-    BsonTreeItem* BsonTreeItem::childSafe(unsigned pos) const
+    BsonTreeItem BsonTreeItem::parent() const
     {
-        if (childrenCount() > pos) {
-            return _items[pos];
-        }
-        else {
-            return NULL;
-        }
+        return BsonTreeItem(_store, _store->node(_node).parent);
     }
 
-    BsonTreeItem* BsonTreeItem::childByKey(const QString &val)
+    BsonTreeItem BsonTreeItem::superParent() const
     {
-        for (unsigned i = 0; i < _items.size(); ++i) {
-            if (_items[i]->key() == val) {
-                return _items[i];
-            }
-        }
-        return NULL;
+        return BsonTreeItem(_store, _store->documentOf(_node));
     }
 
-    const BsonTreeItem *BsonTreeItem::superParent() const
+    mongo::BSONObj BsonTreeItem::object() const
     {
-        return findSuperRoot(this);
+        return _store->object(_node);
     }
 
     mongo::BSONObj BsonTreeItem::superRoot() const
     {
-        return superParent()->root();
+        return _store->document(_node);
     }
 
-    mongo::BSONObj BsonTreeItem::root() const
+    std::string BsonTreeItem::fieldName() const
     {
-        return _root;
-    }
+        if (isSuperParent())
+            return std::string();
 
-    int BsonTreeItem::indexOf(BsonTreeItem *item) const
-    {
-        for (unsigned i = 0; i < _items.size(); ++i) {
-            if (item == _items[i]) {
-                return i;
-            }
-        }
-        return -1;
+        return _store->element(_node).fieldName();
     }
 
     QString BsonTreeItem::key() const
     {
-        return _fields._key;
-    }
+        if (isSuperParent()) {
+            QString idValue;
+            BsonTreeItem const idItem = childByKey("_id");
+            if (idItem.isValid())
+                idValue = idItem.value();
 
-    QString BsonTreeItem::value() const
-    {
-        return _fields._value;
-    }
+            return QString("(%1) %2").arg(_store->documentNumber(_node) + 1).arg(idValue);
+        }
 
-    mongo::BSONType BsonTreeItem::type() const
-    {
-        return _fields._type;
-    }
+        QString const uiFieldName = QtUtils::toQString(fieldName());
 
-    void BsonTreeItem::setKey(const QString &key)
-    {
-        _fields._key = key;
-    }
+        // When we iterate array, show field names in square brackets
+        // In this case field names are numeric, starting from 0.
+        if (BsonUtils::isArray(parent().type()))
+            return "[" + uiFieldName + "]";
 
-    void BsonTreeItem::setValue(const QString &value)
-    {
-        _fields._value = value;
+        return uiFieldName;
     }
 
-    void BsonTreeItem::setType(mongo::BSONType type)
+    QString BsonTreeItem::value() const
     {
-       _fields._type = type;
+        return value(AppRegistry::instance().settingsManager()->uuidEncoding(), 
+                     AppRegistry::instance().settingsManager()->timeZone());
     }
 
-    mongo::BinDataType BsonTreeItem::binType() const
+    QString BsonTreeItem::value(UUIDEncoding uuidEncoding, SupportedTimes timeZone) const
     {
-        return _fields._binType;
+        if (BsonUtils::isArray(type()))
+            return arrayValue(_store->elementsCount(_node));
+
+        if (BsonUtils::isDocument(type()))
+            return objectValue(_store->elementsCount(_node));
+
+        mongo::BSONElement const element = _store->element(_node);
+
+        std::string result;
+        BsonUtils::buildJsonString(element, result, uuidEncoding, timeZone);
+        return QtUtils::toQString(result);
     }
 
-    void BsonTreeItem::setBinType(mongo::BinDataType type)
+    mongo::BSONType BsonTreeItem::type() const
     {
-        _fields._binType = type;
+        return static_cast<mongo::BSONType>(_store->node(_node).type);
     }
 
-    void BsonTreeItem::removeChild(BsonTreeItem *item)
+    mongo::BinDataType BsonTreeItem::binType() const
     {
-        _items.erase(std::remove_if(_items.begin(), _items.end(), removeIfFound(item)), _items.end());
+        return static_cast<mongo::BinDataType>(_store->node(_node).binType);
     }
 }
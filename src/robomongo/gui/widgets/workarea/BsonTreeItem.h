@@ -1,26 +1,22 @@
 #pragma once
 
-#include <vector>
-#include <QObject>
+#include <string>
+#include <QString>
 #include <mongo/bson/bsonobj.h>
 #include <mongo/bson/bsonelement.h>
 
+#include "robomongo/core/Enums.h"
+#include "robomongo/core/domain/BsonNodeStore.h"
+
 namespace Robomongo
 {
     /**
-     * @brief BSON tree item (represents array or object)
+     * @brief BSON tree item (document, field, array or object element).
+     *        Lightweight handle of a node of BsonNodeStore, passed by value.
+     *        Key and value are formatted from the element when asked.
      */
-    struct BsonItemFields
-    {
-        QString _key;
-        QString _value;
-        mongo::BSONType _type;
-        mongo::BinDataType _binType;
-    };
-
-    class BsonTreeItem : public QObject
+    class BsonTreeItem
     {
-        Q_OBJECT
     public:
         enum eColumn
         {
@@ -30,45 +26,54 @@ namespace Robomongo
             eCountColumns = 3
         };
 
-        typedef QObject BaseClass;
-        typedef std::vector<BsonTreeItem*> ChildContainerType;
+        BsonTreeItem() : _store(nullptr), _node(BsonNodeStore::NoNode) {}
+        BsonTreeItem(const BsonNodeStore *store, uint32_t node) : _store(store), _node(node) {}
 
-        explicit BsonTreeItem(QObject *parent = 0);
-        explicit BsonTreeItem(const mongo::BSONObj &bsonObjRoot, QObject *parent = 0);
+        bool isValid() const { return _store && _node != BsonNodeStore::NoNode; }
+        uint32_t node() const { return _node; }
 
         unsigned childrenCount() const;
-        void clear();
-        void addChild(BsonTreeItem *item);
-        void removeChild(BsonTreeItem *item);
-        BsonTreeItem* child(unsigned pos) const;
-        BsonTreeItem* childSafe(unsigned pos) const;
-        BsonTreeItem* childByKey(const QString &val);
-        int indexOf(BsonTreeItem *item) const;
 
-        const BsonTreeItem* superParent() const;
-        mongo::BSONObj root() const;
-        mongo::BSONObj superRoot() const;
+        /**
+         * @brief True when only a part of elements of this large object or array has items yet
+         */
+        bool hasMoreChildren() const { return _store->hasMoreChildren(_node); }
+        BsonTreeItem child(unsigned pos) const;
+        BsonTreeItem childByKey(const QString &val) const;
 
-        std::string fieldName() const { return _fieldName; };
-        void setFieldName(const std::string &fieldName) { _fieldName = fieldName; };
+        /**
+         * @brief Parent item, invalid item for top-level documents
+         */
+        BsonTreeItem parent() const;
 
-        QString key() const;
-        void setKey(const QString &key);
+        /**
+         * @brief Top-level document containing this item
+         */
+        BsonTreeItem superParent() const;
+        bool isSuperParent() const { return _store->isDocument(_node); }
 
-        QString value() const;
-        void setValue(const QString &value);
+        /**
+         * @brief Document itself, or embedded object or array of this element
+         */
+        mongo::BSONObj object() const;
+        mongo::BSONObj superRoot() const;
 
+        std::string fieldName() const;
+        QString key() const;
+        QString value() const;
+        QString value(UUIDEncoding uuidEncoding, SupportedTimes timeZone) const;
         mongo::BSONType type() const;
-        void setType(mongo::BSONType type);
-
         mongo::BinDataType binType() const;
-        void setBinType(mongo::BinDataType type);
 
-    protected:
+        bool operator==(const BsonTreeItem &other) const
+        {
+            return _store == other._store && _node == other._node;
+        }
+
+        bool operator!=(const BsonTreeItem &other) const { return !(*this == other); }
 
-        const mongo::BSONObj _root;
-        ChildContainerType _items;
-        BsonItemFields _fields;
-        std::string _fieldName;
+    private:
+        const BsonNodeStore *_store;
+        uint32_t _node;
     };
 }
@@ -1,67 +1,38 @@
 #include "robomongo/gui/widgets/workarea/BsonTreeModel.h"
 
+#include <algorithm>
+
+#include <QAbstractProxyModel>
+
 #include <mongo/client/dbclient_base.h>
 #include "robomongo/core/settings/SettingsManager.h"
 #include "robomongo/core/AppRegistry.h"
 #include "robomongo/core/utils/BsonUtils.h"
 #include "robomongo/core/domain/MongoDocument.h"
-#include "robomongo/gui/widgets/workarea/BsonTreeItem.h"
 #include "robomongo/core/utils/QtUtils.h"
 #include "robomongo/gui/GuiRegistry.h"
 
 namespace
 {
-    using namespace Robomongo;
+    // Strings of a few screens of rows of tree or cells of table
+    const size_t ITEM_TEXT_CACHE_SIZE = 4096;
 
-    QString arrayValue(int itemsCount) {
-        QString elements = itemsCount == 1 ? "element" : "elements";
-        return QString("[ %1 %2 ]").arg(itemsCount).arg(elements);
-    }
+    // Elements of large objects and arrays get items by windows, so one huge array
+    // does not make thousands of rows at once
+    const uint32_t CHILDREN_WINDOW = 1000;
 
-    QString objectValue(int itemsCount) {
-        QString fields = itemsCount == 1 ? "field" : "fields";
-        return QString("{ %1 %2 }").arg(itemsCount).arg(fields);
-    }
+    // Internal id of 'load more' row is node of its parent with this bit set.
+    // Missing cells of table have BsonNodeStore::NoNode id, which has it too.
+    const quintptr LOAD_MORE_FLAG = quintptr(1) << 31;
 
-    void parseDocument(BsonTreeItem *root, const mongo::BSONObj &doc, bool isArray)
-    {            
-            mongo::BSONObjIterator iterator(doc);
-            while (iterator.more())
-            {
-                mongo::BSONElement element = iterator.next();                
-                BsonTreeItem *childItemInner = new BsonTreeItem(doc, root);
-                std::string fieldName = std::string(element.fieldName());
-                childItemInner->setFieldName(fieldName);
-
-                QString uiFieldName = QtUtils::toQString(fieldName);
-                childItemInner->setKey(uiFieldName);
-
-                if (isArray) {
-                    // When we iterate array, show field names in square brackets
-                    // In this case field names are numeric, starting from 0.
-                    childItemInner->setKey("[" + uiFieldName + "]");
-                }
+    quintptr loadMoreId(uint32_t parent)
+    {
+        return parent | LOAD_MORE_FLAG;
+    }
 
-                if (BsonUtils::isArray(element)) {
-                    int itemsCount = element.Array().size();
-                    childItemInner->setValue(arrayValue(itemsCount));
-                }
-                else if (BsonUtils::isDocument(element)) {
-                    int count = BsonUtils::elementsCount(element.Obj());
-                    childItemInner->setValue(objectValue(count));
-                }
-                else {
-                    std::string result;
-                    BsonUtils::buildJsonString(element, result, AppRegistry::instance().settingsManager()->uuidEncoding(), AppRegistry::instance().settingsManager()->timeZone());
-                    childItemInner->setValue(QtUtils::toQString(result));
-                }
-                childItemInner->setType(element.type());
-                if (element.type() == mongo::BinData) {
-                    childItemInner->setBinType(element.binDataType());
-                }
-                root->addChild(childItemInner);
-                //root->setValue(QString("{ %1 fields }").arg(root->childrenCount()));
-            }            
+    uint32_t loadMoreParent(quintptr id)
+    {
+        return static_cast<uint32_t>(id & ~LOAD_MORE_FLAG);
     }
 }
 
@@ -69,67 +40,163 @@ namespace Robomongo
 {
     BsonTreeModel::BsonTreeModel(const std::vector<MongoDocumentPtr> &documents, QObject *parent) :
         BaseClass(parent),
-        _root(new BsonTreeItem(this))
+        _texts(ITEM_TEXT_CACHE_SIZE),
+        _textsUuidEncoding(AppRegistry::instance().settingsManager()->uuidEncoding()),
+        _textsTimeZone(AppRegistry::instance().settingsManager()->timeZone())
     {
-        for (int i = 0; i < documents.size(); ++i) {
-            MongoDocumentPtr doc = documents[i]; 
-            BsonTreeItem *child = new BsonTreeItem(doc->bsonObj(), _root);
-            parseDocument(child, doc->bsonObj(), doc->bsonObj().isArray());
-
-            QString idValue;
-            BsonTreeItem *idItem = child->childByKey("_id");
-            if (idItem) {
-                idValue = idItem->value();
-            }
+        for (auto const& doc : documents) {
+            _nodes.addDocument(doc->bsonObj());
+        }
+    }
+
+    BsonTreeItem BsonTreeModel::item(const QModelIndex &index)
+    {
+        // Missing cells of table and 'load more' rows have no items
+        if (!index.isValid() || (index.internalId() & LOAD_MORE_FLAG))
+            return BsonTreeItem();
 
-            child->setKey(QString("(%1) %2").arg(i + 1).arg(idValue));
+        const QAbstractItemModel *model = index.model();
+        if (const QAbstractProxyModel *proxy = qobject_cast<const QAbstractProxyModel *>(model))
+            model = proxy->sourceModel();
 
-            int count = BsonUtils::elementsCount(doc->bsonObj());
+        const BsonTreeModel *treeModel = qobject_cast<const BsonTreeModel *>(model);
+        if (!treeModel)
+            return BsonTreeItem();
 
-            if (doc->bsonObj().isArray()) {
-                child->setValue(arrayValue(count));
-                child->setType(mongo::Array);
-            } else {
-                child->setValue(objectValue(count));
-                child->setType(mongo::Object);
-            }
-            _root->addChild(child);
+        return BsonTreeItem(&treeModel->_nodes, index.internalId());
+    }
+
+    bool BsonTreeModel::isLoadMoreRow(const QModelIndex &index)
+    {
+        return index.isValid() && (index.internalId() & LOAD_MORE_FLAG) && index.internalId() != BsonNodeStore::NoNode
+            && qobject_cast<const BsonTreeModel *>(index.model());
+    }
+
+    void BsonTreeModel::appendDocuments(const std::vector<MongoDocumentPtr> &documents)
+    {
+        if (documents.empty())
+            return;
+
+        int const first = _nodes.documentsCount();
+        beginInsertRows(QModelIndex(), first, first + documents.size() - 1);
+        for (auto const& doc : documents) {
+            _nodes.addDocument(doc->bsonObj());
         }
+        endInsertRows();
+    }
+
+    void BsonTreeModel::removeFirstDocuments(int count)
+    {
+        count = std::min<int>(count, _nodes.documentsCount());
+        if (count <= 0)
+            return;
+
+        beginRemoveRows(QModelIndex(), 0, count - 1);
+        _nodes.removeFirstDocuments(count);
+        endRemoveRows();
+
+        compactNodes();
+    }
+
+    void BsonTreeModel::compactNodes()
+    {
+        if (!_nodes.needsCompaction())
+            return;
+
+        Q_EMIT layoutAboutToBeChanged();
+        std::vector<uint32_t> const moved = _nodes.compact();
+        _texts.clear();
+
+        std::unordered_set<uint32_t> loadMoreRows;
+        for (uint32_t const node : _loadMoreRows) {
+            if (moved[node] != BsonNodeStore::NoNode)
+                loadMoreRows.insert(moved[node]);
+        }
+        _loadMoreRows.swap(loadMoreRows);
+
+        for (auto const& index : persistentIndexList()) {
+            bool const isLoadMore = index.internalId() & LOAD_MORE_FLAG;
+            uint32_t const node = moved[isLoadMore ? loadMoreParent(index.internalId()) : index.internalId()];
+            if (node == BsonNodeStore::NoNode)
+                changePersistentIndex(index, QModelIndex());
+            else
+                changePersistentIndex(index, createIndex(index.row(), index.column(), isLoadMore ? loadMoreId(node) : node));
+        }
+        Q_EMIT layoutChanged();
     }
 
     void BsonTreeModel::fetchMore(const QModelIndex &parent)
     {
-        BsonTreeItem *node = QtUtils::item<BsonTreeItem*>(parent);
-        if (node) {
-            mongo::BSONElement elem = BsonUtils::indexOf(node->root(), parent.row());
-            if (!elem.isNull() && elem.isABSONObj()) {
-                parseDocument(node, elem.Obj(), elem.type() == mongo::Array);
-            }            
+        BsonTreeItem const parentItem = item(parent);
+        if (!parentItem.isValid() || !BsonUtils::isDocument(parentItem.type()))
+            return BaseClass::fetchMore(parent);
+
+        uint32_t const node = parentItem.node();
+        bool const isExpanded = _nodes.isExpanded(node);
+        if (isExpanded && !_nodes.hasMoreChildren(node))
+            return BaseClass::fetchMore(parent);
+
+        uint32_t const created = isExpanded ? _nodes.node(node).childrenCount : 0;
+        uint32_t const count = _nodes.elementsCount(node);
+        uint32_t const last = std::min(count, created + CHILDREN_WINDOW);
+
+        // The last window takes the place of 'load more' row
+        if (_loadMoreRows.count(node) && last == count) {
+            beginRemoveRows(parent, created, created);
+            _loadMoreRows.erase(node);
+            endRemoveRows();
         }
-        return BaseClass::fetchMore(parent);
+
+        bool const addsLoadMoreRow = last < count && !_loadMoreRows.count(node);
+        int const inserted = last - created + (addsLoadMoreRow ? 1 : 0);
+        if (inserted > 0)
+            beginInsertRows(parent, created, created + inserted - 1);
+
+        _nodes.expand(node, last);
+        if (addsLoadMoreRow)
+            _loadMoreRows.insert(node);
+
+        if (inserted > 0)
+            endInsertRows();
     }
 
     bool BsonTreeModel::canFetchMore(const QModelIndex &parent) const
     {
-        BsonTreeItem *node = QtUtils::item<BsonTreeItem*>(parent);
-        if (node && !node->childrenCount()) {
-            return BsonUtils::isDocument(node->type());
+        BsonTreeItem const node = item(parent);
+        if (node.isValid() && !_nodes.isExpanded(node.node())) {
+            return BsonUtils::isDocument(node.type());
         }
         return false;
     }
 
     bool BsonTreeModel::hasChildren(const QModelIndex &parent) const
     {
-        BsonTreeItem *node = QtUtils::item<BsonTreeItem*>(parent);
-        if (node) {
-            return BsonUtils::isDocument(node->type());
+        if (!parent.isValid())
+            return true;
+
+        BsonTreeItem const node = item(parent);
+        return node.isValid() && BsonUtils::isDocument(node.type());
+    }
+
+    const BsonTreeModel::ItemText &BsonTreeModel::text(const BsonTreeItem &item) const
+    {
+        SettingsManager const *settings = AppRegistry::instance().settingsManager();
+        if (settings->uuidEncoding() != _textsUuidEncoding || settings->timeZone() != _textsTimeZone) {
+            _texts.clear();
+            _textsUuidEncoding = settings->uuidEncoding();
+            _textsTimeZone = settings->timeZone();
         }
-        return true;
+
+        if (const ItemText *cached = _texts.find(item.node()))
+            return *cached;
+
+        ItemText const text = { item.key(), item.value(_textsUuidEncoding, _textsTimeZone) };
+        return _texts.insert(item.node(), text);
     }
 
-    const QIcon &BsonTreeModel::getIcon(BsonTreeItem *item)
+    const QIcon &BsonTreeModel::getIcon(const BsonTreeItem &item)
     {
-        switch(item->type()) {
+        switch(item.type()) {
         case mongo::NumberDouble: return GuiRegistry::instance().bsonDoubleIcon();
         case mongo::NumberDecimal: return GuiRegistry::instance().bsonNumberDecimalIcon();
         case mongo::String: return GuiRegistry::instance().bsonStringIcon();
@@ -158,9 +225,25 @@ namespace Robomongo
         if (!index.isValid())
             return result;
 
-        BsonTreeItem *node = QtUtils::item<BsonTreeItem*>(index);
+        if (isLoadMoreRow(index)) {
+            if (index.column() != BsonTreeItem::eKey)
+                return result;
+
+            if (role == Qt::DisplayRole) {
+                uint32_t const parent = loadMoreParent(index.internalId());
+                uint32_t const remaining = _nodes.elementsCount(parent) - _nodes.node(parent).childrenCount;
+                return QString("Load %1 more of %2 remaining...").arg(std::min(remaining, CHILDREN_WINDOW)).arg(remaining);
+            }
+
+            if (role == Qt::TextColorRole)
+                return QColor(Qt::gray);
+
+            return result;
+        }
 
-        if (!node)
+        BsonTreeItem const node = item(index);
+
+        if (!node.isValid())
             return result;  
 
         int col = index.column();        
@@ -176,20 +259,21 @@ namespace Robomongo
         if (role == Qt::DisplayRole || role == Qt::ToolTipRole) {
             if (col == BsonTreeItem::eKey) {
                 if (role == Qt::DisplayRole) {
-                    result = node->key();
+                    result = text(node).key;
                 }
             }
             else if (col == BsonTreeItem::eValue) {
-                bool isCut = node->type() == mongo::String ||  node->type() == mongo::Code || node->type() == mongo::CodeWScope;  
+                QString const& value = text(node).value;
+                bool isCut = node.type() == mongo::String ||  node.type() == mongo::Code || node.type() == mongo::CodeWScope;  
                 if (role == Qt::ToolTipRole) {
-                    result = isCut ? node->value().left(500) : node->value(); 
+                    result = isCut ? value.left(500) : value; 
                 }
                 else{
-                    result = isCut ? node->value().simplified().left(300) : node->value(); 
+                    result = isCut ? value.simplified().left(300) : value; 
                 }
             }
             else if (col == BsonTreeItem::eType) {
-                result = BsonUtils::BSONTypeToString(node->type(), node->binType(), AppRegistry::instance().settingsManager()->uuidEncoding());
+                result = BsonUtils::BSONTypeToString(node.type(), node.binType(), AppRegistry::instance().settingsManager()->uuidEncoding());
             }
         }       
 
@@ -199,7 +283,10 @@ namespace Robomongo
     Qt::ItemFlags BsonTreeModel::flags(const QModelIndex &index) const
     {
         Qt::ItemFlags result = 0;
-        if (index.isValid()) {
+        if (isLoadMoreRow(index)) {
+            result = Qt::ItemIsEnabled;
+        }
+        else if (index.isValid()) {
             result = Qt::ItemIsSelectable | Qt::ItemIsEnabled;
         }
         return result;
@@ -207,13 +294,14 @@ namespace Robomongo
 
     int BsonTreeModel::rowCount(const QModelIndex &parent) const
     {
-        const BsonTreeItem *parentItem = NULL;
-        if (parent.isValid())
-            parentItem = QtUtils::item<BsonTreeItem*>(parent);
-        else
-            parentItem = _root;
+        if (!parent.isValid())
+            return _nodes.documentsCount();
 
-        return parentItem->childrenCount();
+        BsonTreeItem const parentItem = item(parent);
+        if (!parentItem.isValid())
+            return 0;
+
+        return parentItem.childrenCount() + (_loadMoreRows.count(parentItem.node()) ? 1 : 0);
     }
 
     int BsonTreeModel::columnCount(const QModelIndex &parent) const
@@ -245,13 +333,10 @@ namespace Robomongo
     {
         QModelIndex result;
         if (index.isValid()) {
-            BsonTreeItem *const childItem = QtUtils::item<BsonTreeItem*const>(index);
-            BsonTreeItem *const parentItem = static_cast<BsonTreeItem*const>(childItem->parent());
-            if (parentItem && parentItem != _root) {
-                BsonTreeItem *const grandParent = static_cast<BsonTreeItem*const>(parentItem->parent());
-                int row = grandParent->indexOf(parentItem);
-                result = createIndex(row, 0, parentItem);
-            }
+            uint32_t const parentNode = isLoadMoreRow(index) ? loadMoreParent(index.internalId())
+                                                             : _nodes.node(index.internalId()).parent;
+            if (parentNode != BsonNodeStore::NoNode)
+                result = createIndex(_nodes.row(parentNode), 0, parentNode);
         }
         return result;
     }
@@ -260,39 +345,15 @@ namespace Robomongo
     {
         QModelIndex index;
         if (hasIndex(row, column, parent)) {
-            const BsonTreeItem * parentItem = NULL;
-            if (!parent.isValid()) {
-                parentItem = _root;
-            } else {
-                parentItem = QtUtils::item<BsonTreeItem*>(parent);
-            }
-
-            BsonTreeItem *childItem = parentItem->child(row);
-            if (childItem) {
-                index = createIndex(row, column, childItem);
-            }
+            if (!parent.isValid())
+                return createIndex(row, column, _nodes.documentNode(row));
+
+            uint32_t const parentNode = parent.internalId();
+            if (static_cast<uint32_t>(row) < _nodes.node(parentNode).childrenCount)
+                index = createIndex(row, column, _nodes.child(parentNode, row));
+            else
+                index = createIndex(row, column, loadMoreId(parentNode));
         }
         return index;
     }
-
-    void BsonTreeModel::insertItem(BsonTreeItem *parent, BsonTreeItem *children)
-    {
-        QModelIndex index = createIndex(0, 0, parent);
-        unsigned child_count = parent->childrenCount();
-        beginInsertRows(index, child_count, child_count);
-        parent->addChild(children);
-        endInsertRows();
-    }
-
-    void BsonTreeModel::removeitem(BsonTreeItem *children)
-    {
-        BsonTreeItem *parent = static_cast<BsonTreeItem *>(children->parent());
-        if (parent) {
-            QModelIndex index = createIndex(0, 0, parent);
-            int row = parent->indexOf(children);
-            beginRemoveRows(index, row, row);
-            parent->removeChild(children);
-            endRemoveRows();
-        }
-    }
 }
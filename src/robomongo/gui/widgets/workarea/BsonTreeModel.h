@@ -1,19 +1,39 @@
 #pragma once
+#include <unordered_set>
 #include <vector>
 #include <QAbstractItemModel>
 #include "robomongo/core/Core.h"
+#include "robomongo/core/Enums.h"
+#include "robomongo/core/domain/BsonNodeStore.h"
+#include "robomongo/core/utils/LruCache.h"
+#include "robomongo/gui/widgets/workarea/BsonTreeItem.h"
 
 namespace Robomongo
 {
-    class BsonTreeItem;
-
     class BsonTreeModel : public QAbstractItemModel
     {
         Q_OBJECT
 
     public:
         typedef QAbstractItemModel BaseClass;
-        static const QIcon &getIcon(BsonTreeItem *item);
+
+        /**
+         * @brief Display strings of an item, formatted when the item is shown
+         */
+        struct ItemText
+        {
+            QString key;
+            QString value;
+        };
+
+        static const QIcon &getIcon(const BsonTreeItem &item);
+
+        /**
+         * @brief Item of index of this model or of BsonTableModelProxy over it,
+         *        invalid item if index has no item (i.e. missing field of table row)
+         */
+        static BsonTreeItem item(const QModelIndex &index);
+
         explicit BsonTreeModel(const std::vector<MongoDocumentPtr> &documents, QObject *parent = 0);
         QVariant data(const QModelIndex &index, int role) const;
 
@@ -25,13 +45,58 @@ namespace Robomongo
         virtual QModelIndex index(int row, int column, const QModelIndex &parent = QModelIndex()) const;
         virtual QModelIndex parent(const QModelIndex& index) const;
 
-        void insertItem(BsonTreeItem *parent, BsonTreeItem *children);
-        void removeitem(BsonTreeItem *children);
+        /**
+         * @brief Appends top-level documents (i.e. next batch of streamed query)
+         */
+        void appendDocuments(const std::vector<MongoDocumentPtr> &documents);
+
+        /**
+         * @brief Removes 'count' oldest top-level documents (i.e. of bounded live results). 
+         *        Remaining documents keep their numbers.
+         */
+        void removeFirstDocuments(int count);
 
+        /**
+         * @brief Creates items of the next window of elements of object or array 'parent'.
+         *        When elements remain, 'load more' row follows the created ones.
+         */
         virtual void fetchMore(const QModelIndex &parent);
+
+        /**
+         * @brief True for not expanded objects and arrays. Next windows are loaded by 'load more' row only,
+         *        as views fetch more on every layout of expanded items.
+         */
         virtual bool canFetchMore(const QModelIndex &parent) const;
         virtual bool hasChildren(const QModelIndex &parent = QModelIndex()) const;
+
+        /**
+         * @brief True for row after the last created child of partly loaded object or array,
+         *        which loads the next window by fetchMore(index.parent())
+         */
+        static bool isLoadMoreRow(const QModelIndex &index);
+
+        /**
+         * @brief Key and value strings of 'item' of this model. Strings of recently shown items
+         *        are cached, cache is dropped when UUID encoding or time zone settings change.
+         */
+        const ItemText &text(const BsonTreeItem &item) const;
+
     protected:
-        BsonTreeItem *const _root;
+        /**
+         * @brief Moves nodes of remaining documents to a new arena when enough documents are
+         *        removed, indexes kept by views are moved with them
+         */
+        void compactNodes();
+
+        // Nodes of all documents, model indexes refer to nodes by their index in the store
+        BsonNodeStore _nodes;
+
+        // Partly loaded objects and arrays, which have 'load more' row after their children
+        std::unordered_set<uint32_t> _loadMoreRows;
+
+        // Strings of items being shown, keyed by node
+        mutable LruCache<uint32_t, ItemText> _texts;
+        mutable UUIDEncoding _textsUuidEncoding;
+        mutable SupportedTimes _textsTimeZone;
     };
 }
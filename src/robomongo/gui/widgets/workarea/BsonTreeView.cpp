@@ -7,9 +7,15 @@
 
 #include "robomongo/core/utils/QtUtils.h"
 #include "robomongo/gui/GuiRegistry.h"
-#include "robomongo/gui/widgets/workarea/BsonTreeItem.h"
+#include "robomongo/gui/widgets/workarea/BsonTreeModel.h"
 #include "robomongo/gui/widgets/workarea/OutputWidget.h"
 
+namespace
+{
+    // Objects and arrays expanded by one "Expand Recursively", so deeply nested documents do not hang the view
+    const int EXPAND_RECURSIVE_MAX = 5000;
+}
+
 namespace Robomongo
 {
     BsonTreeView::BsonTreeView(MongoShell *shell, const MongoQueryInfo &queryInfo, QWidget *parent)
@@ -24,6 +30,7 @@ namespace Robomongo
         setSelectionBehavior(QAbstractItemView::SelectRows);
         setContextMenuPolicy(Qt::CustomContextMenu);
         VERIFY(connect(this, SIGNAL(customContextMenuRequested(const QPoint&)), this, SLOT(showContextMenu(const QPoint&))));
+        VERIFY(connect(this, SIGNAL(clicked(const QModelIndex&)), this, SLOT(onItemClicked(const QModelIndex&))));
 
         _expandRecursive = new QAction("Expand Recursively", this);
         _expandRecursive->setShortcut(QKeySequence(Qt::ALT + Qt::Key_Right));
@@ -60,11 +67,11 @@ namespace Robomongo
         else {
 
             QModelIndex selectedInd = selectedIndex();
-            BsonTreeItem *documentItem = QtUtils::item<BsonTreeItem*>(selectedInd);
+            BsonTreeItem const documentItem = BsonTreeModel::item(selectedInd);
 
             QMenu menu(this);
             bool isSimple = false;
-            if (documentItem) {
+            if (documentItem.isValid()) {
                 isSimple = detail::isSimpleType(documentItem);
                 if (detail::isDocumentType(documentItem)) {
                     menu.addAction(_expandRecursive);
@@ -110,13 +117,22 @@ namespace Robomongo
 
     void BsonTreeView::expandNode(const QModelIndex &index)
     {
-        if (index.isValid()) {
+        int budget = EXPAND_RECURSIVE_MAX;
+        expandNode(index, budget);
+    }
+
+    void BsonTreeView::expandNode(const QModelIndex &index, int &budget)
+    {
+        if (index.isValid() && budget > 0) {
+            --budget;
             BaseClass::expand(index);
-            BsonTreeItem *item = QtUtils::item<BsonTreeItem*>(index);
-            for (unsigned i = 0; i < item->childrenCount(); ++i) {
-                BsonTreeItem *tritem = item->child(i);
-                if (tritem && detail::isDocumentType(tritem)) {
-                    expandNode(model()->index(i, 0, index));
+            BsonTreeItem const item = BsonTreeModel::item(index);
+            if (!item.isValid() || item.hasMoreChildren())
+                return;
+
+            for (unsigned i = 0; i < item.childrenCount() && budget > 0; ++i) {
+                if (detail::isDocumentType(item.child(i))) {
+                    expandNode(model()->index(i, 0, index), budget);
                 }
             }
         }
@@ -126,22 +142,28 @@ namespace Robomongo
     {
         if (index.isValid()) {
             BaseClass::collapse(index);
-            BsonTreeItem *item = QtUtils::item<BsonTreeItem*>(index);
-            for (unsigned i = 0; i < item->childrenCount(); ++i) {
-                BsonTreeItem *tritem = item->child(i);
-                if (tritem && detail::isDocumentType(tritem)) {
+            BsonTreeItem const item = BsonTreeModel::item(index);
+            for (unsigned i = 0; i < item.childrenCount(); ++i) {
+                if (detail::isDocumentType(item.child(i))) {
                     collapseNode(model()->index(i, 0, index));
                 }
             }
         }
     }
 
+    void BsonTreeView::onItemClicked(const QModelIndex &index)
+    {
+        if (BsonTreeModel::isLoadMoreRow(index))
+            model()->fetchMore(index.parent());
+    }
+
     void BsonTreeView::onExpandRecursive()
     {
         QModelIndexList indexes = selectedIndexes();
         if (detail::isMultiSelection(indexes)) {
+            int budget = EXPAND_RECURSIVE_MAX;
             for (int i = 0; i<indexes.count(); ++i)
-                expandNode(indexes[i]);
+                expandNode(indexes[i], budget);
         } else {
             expandNode(selectedIndex());
         }
@@ -159,7 +181,7 @@ namespace Robomongo
     }
 
     /**
-     * @returns selected BsonTreeItem, or NULL otherwise
+     * @returns index of selected item, or invalid index otherwise
      */
     QModelIndex BsonTreeView::selectedIndex() const
     {
@@ -22,6 +22,7 @@ namespace Robomongo
         void collapseNode(const QModelIndex &index);
         
     private Q_SLOTS:
+        void onItemClicked(const QModelIndex &index);
         void onExpandRecursive();
         void onCollapseRecursive();
         void showContextMenu(const QPoint &point);
@@ -31,6 +32,12 @@ namespace Robomongo
         virtual void keyPressEvent(QKeyEvent *event);
         
     private:
+        /**
+         * @brief Expands 'index' and its objects and arrays while 'budget' of expanded items lasts.
+         *        Children of partly loaded large objects and arrays are not expanded.
+         */
+        void expandNode(const QModelIndex &index, int &budget);
+
         Notifier _notifier;
         QAction *_expandRecursive;
         QAction *_collapseRecursive;
@@ -0,0 +1,89 @@
+#include "robomongo/gui/widgets/workarea/ExplainPlanTreeWidget.h"
+
+#include <QHeaderView>
+
+#include "robomongo/core/domain/ExplainPlan.h"
+#include "robomongo/core/utils/QtUtils.h"
+
+namespace
+{
+    enum Column { StageColumn, ReturnedColumn, DocsExaminedColumn, KeysExaminedColumn, TimeColumn, DetailsColumn };
+
+    QString statText(long long value)
+    {
+        return value < 0 ? QString() : QString::number(value);
+    }
+
+    void setStats(QTreeWidgetItem *item, long long nReturned, long long docsExamined, 
+                  long long keysExamined, long long timeMs)
+    {
+        item->setText(ReturnedColumn, statText(nReturned));
+        item->setText(DocsExaminedColumn, statText(docsExamined));
+        item->setText(KeysExaminedColumn, statText(keysExamined));
+        item->setText(TimeColumn, statText(timeMs));
+
+        for (int column = ReturnedColumn; column <= TimeColumn; ++column)
+            item->setTextAlignment(column, Qt::AlignRight | Qt::AlignVCenter);
+    }
+}
+
+namespace Robomongo
+{
+    ExplainPlanTreeWidget::ExplainPlanTreeWidget(const mongo::BSONObj &explain, QWidget *parent)
+        : QTreeWidget(parent)
+    {
+        QStringList columns;
+        columns << "Stage" << "Returned" << "Docs Examined" << "Keys Examined" << "Time (ms)" << "Details";
+        setHeaderLabels(columns);
+
+        setStyleSheet(
+            "QTreeWidget { border-left: 1px solid #c7c5c4; border-top: 1px solid #c7c5c4; }"
+        );
+
+        ExplainPlan const plan = ExplainPlan::fromBson(explain);
+
+        QTreeWidgetItem *total = new QTreeWidgetItem;
+        total->setText(StageColumn, "Total");
+        setStats(total, plan.nReturned, plan.docsExamined, plan.keysExamined, plan.timeMs);
+        QFont font = total->font(StageColumn);
+        font.setBold(true);
+        total->setFont(StageColumn, font);
+        addTopLevelItem(total);
+
+        for (auto const& stage : plan.stages)
+            addTopLevelItem(createItem(stage));
+
+        expandAll();
+        header()->resizeSections(QHeaderView::ResizeToContents);
+    }
+
+    QTreeWidgetItem *ExplainPlanTreeWidget::createItem(const ExplainStage &stage)
+    {
+        QTreeWidgetItem *item = new QTreeWidgetItem;
+        item->setText(StageColumn, QtUtils::toQString(stage.name));
+        item->setText(DetailsColumn, QtUtils::toQString(stage.details));
+        item->setToolTip(DetailsColumn, QtUtils::toQString(stage.details));
+        setStats(item, stage.nReturned, stage.docsExamined, stage.keysExamined, stage.timeMs);
+
+        QString warning;
+        if (stage.isCollectionScan())
+            warning = "Collection scan: every document of the collection is examined, no index is used.";
+        else if (stage.isInMemorySort())
+            warning = "In-memory sort: documents are sorted in memory, no index provides this order.";
+
+        if (stage.usedDisk)
+            warning += (warning.isEmpty() ? "" : "\n") + QString("Stage used temporary files on disk.");
+
+        if (!warning.isEmpty()) {
+            for (int column = StageColumn; column <= DetailsColumn; ++column) {
+                item->setBackground(column, QColor("#fde0dc"));
+                item->setToolTip(column, warning);
+            }
+        }
+
+        for (auto const& child : stage.children)
+            item->addChild(createItem(child));
+
+        return item;
+    }
+}
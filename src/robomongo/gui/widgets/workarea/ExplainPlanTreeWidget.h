@@ -0,0 +1,24 @@
+#pragma once
+
+#include <QTreeWidget>
+
+#include <mongo/bson/bsonobj.h>
+
+namespace Robomongo
+{
+    struct ExplainStage;
+
+    /**
+     * @brief Shows winning plan of explained query as a tree of stages with their
+     *        execution statistics. Collection scans and in-memory sorts are highlighted.
+     */
+    class ExplainPlanTreeWidget : public QTreeWidget
+    {
+        Q_OBJECT
+    public:
+        ExplainPlanTreeWidget(const mongo::BSONObj &explain, QWidget *parent = NULL);
+
+    private:
+        QTreeWidgetItem *createItem(const ExplainStage &stage);
+    };
+}
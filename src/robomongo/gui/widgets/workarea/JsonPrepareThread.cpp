@@ -8,10 +8,12 @@
 
 namespace Robomongo
 {
-    JsonPrepareThread::JsonPrepareThread(const std::vector<MongoDocumentPtr> &bsonObjects, UUIDEncoding uuidEncoding, SupportedTimes timeZone)
+    JsonPrepareThread::JsonPrepareThread(const std::vector<MongoDocumentPtr> &bsonObjects, UUIDEncoding uuidEncoding, SupportedTimes timeZone,
+                                         int firstPosition)
         :_bsonObjects(bsonObjects),
         _uuidEncoding(uuidEncoding),
         _timeZone(timeZone),
+        _firstPosition(firstPosition),
         _stop(false)
     {
     }
@@ -23,7 +25,7 @@ namespace Robomongo
 
     void JsonPrepareThread::run()
     {
-        int position = 1; // 1-based numbering to match tree & table views
+        int position = _firstPosition; // 1-based numbering to match tree & table views
         for (std::vector<MongoDocumentPtr>::const_iterator it = _bsonObjects.begin(); it != _bsonObjects.end(); ++it)
         {
             MongoDocumentPtr doc = *it;
@@ -20,7 +20,8 @@ namespace Robomongo
         /*
         ** Constructor
         */
-        JsonPrepareThread(const std::vector<MongoDocumentPtr> &bsonObjects, UUIDEncoding uuidEncoding, SupportedTimes timeZone);
+        JsonPrepareThread(const std::vector<MongoDocumentPtr> &bsonObjects, UUIDEncoding uuidEncoding, SupportedTimes timeZone,
+                          int firstPosition = 1);
         void stop();
    Q_SIGNALS:
         /**
@@ -46,6 +47,10 @@ namespace Robomongo
         const std::vector<MongoDocumentPtr> _bsonObjects;
         const UUIDEncoding _uuidEncoding;
         const SupportedTimes _timeZone;
+        /*
+        ** Number of the first document, greater than 1 when appending to already prepared parts
+        */
+        const int _firstPosition;
         volatile bool _stop;
     };
 }
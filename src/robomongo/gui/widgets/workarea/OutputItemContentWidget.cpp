@@ -1,13 +1,24 @@
 #include "robomongo/gui/widgets/workarea/OutputItemContentWidget.h"
 
 #include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QLineEdit>
+#include <QPushButton>
+#include <QTimer>
 #include <Qsci/qscilexerjavascript.h>
 
 #include "robomongo/core/AppRegistry.h"
+#include "robomongo/core/EventBus.h"
 #include "robomongo/core/settings/SettingsManager.h"
 #include "robomongo/core/utils/QtUtils.h"
 #include "robomongo/core/domain/MongoShell.h"
+#include "robomongo/core/domain/MongoServer.h"
+#include "robomongo/core/domain/MongoDatabase.h"
 #include "robomongo/core/domain/MongoAggregateInfo.h"
+#include "robomongo/core/domain/MongoDocument.h"
+#include "robomongo/core/domain/ChangeStreamBuffer.h"
+#include "robomongo/shell/bson/json.h"
 
 #include "robomongo/gui/widgets/workarea/OutputWidget.h"
 #include "robomongo/gui/widgets/workarea/OutputItemHeaderWidget.h"
@@ -18,10 +29,23 @@
 #include "robomongo/gui/widgets/workarea/BsonTableModel.h"
 #include "robomongo/gui/editors/PlainJavaScriptEditor.h"
 #include "robomongo/gui/widgets/workarea/CollectionStatsTreeWidget.h"
+#include "robomongo/gui/widgets/workarea/ExplainPlanTreeWidget.h"
 #include "robomongo/gui/GuiRegistry.h"
 #include "robomongo/gui/editors/JSLexer.h"
 #include "robomongo/gui/editors/FindFrame.h"
 
+namespace
+{
+    // Newest change events kept in live result
+    const size_t CHANGE_STREAM_CAPACITY = 1000;
+
+    // Received change events are shown at most ~30 times per second
+    const int CHANGE_STREAM_FLUSH_MSEC = 33;
+
+    // Responses of change streams are routed to the watching views by this id
+    int lastWatchId = 0;
+}
+
 namespace Robomongo
 {
     OutputItemContentWidget::OutputItemContentWidget(ViewMode viewMode, MongoShell *shell, 
@@ -89,6 +113,44 @@ namespace Robomongo
         setup(secs, multipleResults, tabbedResults, firstItem, lastItem);
     }
 
+    OutputItemContentWidget::OutputItemContentWidget(ViewMode viewMode, MongoShell *shell,
+                                                     const ChangeStreamInfo &changeStreamInfo,
+                                                     bool multipleResults, bool tabbedResults,
+                                                     bool firstItem, bool lastItem, QWidget *parent) :
+        BaseClass(parent),
+        _textView(NULL),
+        _bsonTreeview(NULL),
+        _thread(NULL),
+        _bsonTable(NULL),
+        _isTextModeSupported(false),
+        _isTreeModeSupported(true),
+        _isTableModeSupported(true),
+        _isCustomModeSupported(false),
+        _isTextModeInitialized(false),
+        _isTreeModeInitialized(false),
+        _isCustomModeInitialized(false),
+        _isTableModeInitialized(false),
+        _isFirstPartRendered(false),
+        _shell(shell),
+        _outputWidget(dynamic_cast<OutputWidget*>(parentWidget())),
+        _initialSkip(0),
+        _initialLimit(0),
+        _mod(NULL),
+        _viewMode(viewMode == Table ? Table : Tree), // Events arrive too often to render them as text
+        _changeStreamInfo(changeStreamInfo),
+        _changes(new ChangeStreamBuffer(CHANGE_STREAM_CAPACITY)),
+        _server(shell->server()),
+        _watchId(++lastWatchId)
+    {
+        setup(0, multipleResults, tabbedResults, firstItem, lastItem);
+        setupChangeStream();
+    }
+
+    OutputItemContentWidget::~OutputItemContentWidget()
+    {
+        closeChangeStream();
+    }
+
     void OutputItemContentWidget::setup(double secs, bool multipleResults, bool tabbedResults,
                                         bool firstItem, bool lastItem)
     {      
@@ -110,7 +172,8 @@ namespace Robomongo
             _header->paging()->setSkip(_aggrInfo.skip);
         }
 
-        _header->setTime(QString("%1 sec.").arg(secs, 0, 'g', 3));
+        if (!_changeStreamInfo.isValid)
+            _header->setTime(QString("%1 sec.").arg(secs, 0, 'g', 3));
 
         QVBoxLayout *layout = new QVBoxLayout();
         layout->setContentsMargins(0, 0, 0, 0);
@@ -154,10 +217,15 @@ namespace Robomongo
     void OutputItemContentWidget::paging_rightClicked(int skip, int limit)
     {
         skip += limit;
-        refresh(skip, limit);
+        loadPage(skip, limit, true);
     }
 
     void OutputItemContentWidget::refresh(int skip, int batchSize)
+    {
+        loadPage(skip, batchSize, false);
+    }
+
+    void OutputItemContentWidget::loadPage(int skip, int batchSize, bool nextPage)
     {
         // Cannot set skip lower than in the text query
         if (skip <  _initialSkip) {
@@ -183,6 +251,14 @@ namespace Robomongo
         info._limit = limit;
         info._skip = skip;
         info._batchSize = batchSize;
+
+        // Keyset paging: let query worker continue after the last document of the current page 
+        // instead of making server walk over 'skip' documents again. Worker falls back to skip 
+        // when the sort is not served by an index or sort keys have values of different types.
+        bool const keysetPaging = AppRegistry::instance().settingsManager()->keysetPaging();
+        if (keysetPaging && nextPage && !_aggrInfo.isValid && limit > 0 && !_documents.empty())
+            info._keysetAfter = _documents.back()->bsonObj();
+
         _outputWidget->showProgress();
                 
         _shell->setScriptExecutable(true);
@@ -216,7 +292,8 @@ namespace Robomongo
     void OutputItemContentWidget::updateWithInfo(const MongoQueryInfo &inf, 
                                                  const std::vector<MongoDocumentPtr> &documents)
     {
-        update(documents, inf._skip, inf._batchSize);
+        int const skip = inf._keysetPosition >= 0 ? inf._keysetPosition : inf._skip;
+        update(documents, skip, inf._batchSize);
     }
 
     void OutputItemContentWidget::updateWithInfo(const AggrInfo &aggrInfo, 
@@ -228,6 +305,8 @@ namespace Robomongo
     void OutputItemContentWidget::update(const std::vector<MongoDocumentPtr> &documents, int skip, int batchSize)
     {
         _documents = documents;
+        _pendingJsonDocuments.clear();
+        _isJsonPrepareRunning = false;
 
         _header->paging()->setSkip(skip);
         _header->paging()->setBatchSize(batchSize);
@@ -256,6 +335,52 @@ namespace Robomongo
         configureModel();
     }
 
+    void OutputItemContentWidget::appendDocuments(const std::vector<MongoDocumentPtr> &documents)
+    {
+        if (documents.empty())
+            return;
+
+        int const firstPosition = _documents.size() + 1;
+        _documents.insert(_documents.end(), documents.begin(), documents.end());
+
+        // Tree and table views follow the model
+        _mod->appendDocuments(documents);
+
+        if (!_isTextModeInitialized || !_textView)
+            return; // Text will be prepared from all documents when text mode is shown
+
+        if (_isJsonPrepareRunning)
+            _pendingJsonDocuments.insert(_pendingJsonDocuments.end(), documents.begin(), documents.end());
+        else
+            startJsonPrepare(documents, firstPosition);
+    }
+
+    void OutputItemContentWidget::startJsonPrepare(const std::vector<MongoDocumentPtr> &documents, 
+                                                   int firstPosition)
+    {
+        _thread = new JsonPrepareThread(documents, AppRegistry::instance().settingsManager()->uuidEncoding(),
+                                        AppRegistry::instance().settingsManager()->timeZone(), firstPosition);
+        VERIFY(connect(_thread, SIGNAL(partReady(const QString&)), this, SLOT(jsonPartReady(const QString&))));
+        VERIFY(connect(_thread, SIGNAL(done()), this, SLOT(jsonPrepared())));
+        VERIFY(connect(_thread, SIGNAL(finished()), _thread, SLOT(deleteLater())));
+        _isJsonPrepareRunning = true;
+        _thread->start();
+    }
+
+    void OutputItemContentWidget::jsonPrepared()
+    {
+        if (sender() != _thread)
+            return;
+
+        _isJsonPrepareRunning = false;
+        if (_pendingJsonDocuments.empty() || !_textView)
+            return;
+
+        std::vector<MongoDocumentPtr> documents;
+        documents.swap(_pendingJsonDocuments);
+        startJsonPrepare(documents, _documents.size() - documents.size() + 1);
+    }
+
     void OutputItemContentWidget::showText()
     {
         _viewMode = Text;
@@ -272,10 +397,8 @@ namespace Robomongo
             else {
                 if (_documents.size() > 0) {
                     _textView->sciScintilla()->setText("Loading...");
-                    _thread = new JsonPrepareThread(_documents, AppRegistry::instance().settingsManager()->uuidEncoding(), AppRegistry::instance().settingsManager()->timeZone());
-                    VERIFY(connect(_thread, SIGNAL(partReady(const QString&)), this, SLOT(jsonPartReady(const QString&))));
-                    VERIFY(connect(_thread, SIGNAL(finished()), _thread, SLOT(deleteLater())));
-                    _thread->start();
+                    _pendingJsonDocuments.clear();
+                    startJsonPrepare(_documents, 1);
                 }
             }
             _stack->addWidget(_textView);
@@ -329,12 +452,18 @@ namespace Robomongo
             if (_type == "collectionStats") {
                 _collectionStats = new CollectionStatsTreeWidget(_documents, NULL);
                 _stack->addWidget(_collectionStats);
-            }               
+            }
+            else if (_type == "explain" && !_documents.empty()) {
+                _explainPlan = new ExplainPlanTreeWidget(_documents.front()->bsonObj(), NULL);
+                _stack->addWidget(_explainPlan);
+            }
             _isCustomModeInitialized = true;
         }
 
         if (_collectionStats)
             _stack->setCurrentWidget(_collectionStats);
+        else if (_explainPlan)
+            _stack->setCurrentWidget(_explainPlan);
     }
 
     void OutputItemContentWidget::showTable()
@@ -350,7 +479,20 @@ namespace Robomongo
 
         if (!_isTableModeInitialized) {
             _bsonTable = new BsonTableView(_shell, _queryInfo);
-            BsonTableModelProxy *modp = new BsonTableModelProxy(_bsonTable);
+            // Fields of analyzed collection are columns in the same order on every page
+            BsonTableModelProxy::ColumnsValuesType columns;
+            MongoNamespace const& ns = _queryInfo._info._ns;
+            MongoDatabase *database = _shell && _queryInfo._info.isValid() && _queryInfo._fields.isEmpty() ?
+                _shell->server()->findDatabaseByName(ns.databaseName()) : NULL;
+            const CollectionSchema *schema = database ? database->schema(ns.collectionName()) : NULL;
+            if (schema) {
+                for (auto const& field : schema->fields) {
+                    if (field.path.find('.') == std::string::npos)
+                        columns.push_back(QtUtils::toQString(field.path));
+                }
+            }
+
+            BsonTableModelProxy *modp = new BsonTableModelProxy(_bsonTable, columns);
             modp->setSourceModel(_mod);
             _bsonTable->setModel(modp);
             _stack->addWidget(_bsonTable);
@@ -429,4 +571,151 @@ namespace Robomongo
         // _logText->sciScintilla()->setStyleSheet("QFrame {background-color: rgb(44, 50, 55); border: 1px solid #c7c5c4; border-radius: 0px; margin: 0px; padding: 0px;}");
         return _logText;
     }
+
+    void OutputItemContentWidget::setupChangeStream()
+    {
+        std::string const& name = _changeStreamInfo.collectionName.empty() ? _changeStreamInfo.dbName 
+                                                                            : _changeStreamInfo.collectionName;
+        _header->setCollection(QtUtils::toQString(name));
+
+        _changesFilter = new QLineEdit;
+        _changesFilter->setPlaceholderText("{ operationType: 'insert' }");
+        _changesFilter->setToolTip("$match stage applied to change events on the server, press Enter to apply");
+        _changesPauseButton = new QPushButton("Pause");
+        _changesPauseButton->setCheckable(true);
+        _changesStatus = new QLabel("Waiting for changes...");
+
+        QHBoxLayout *controls = new QHBoxLayout;
+        controls->setContentsMargins(2, 2, 2, 2);
+        controls->addWidget(new QLabel("Filter:"));
+        controls->addWidget(_changesFilter, 1);
+        controls->addWidget(_changesPauseButton);
+        controls->addWidget(_changesStatus);
+        qobject_cast<QVBoxLayout *>(layout())->insertLayout(1, controls);
+
+        _changesTimer = new QTimer(this);
+        _changesTimer->setSingleShot(true);
+        _changesTimer->setInterval(CHANGE_STREAM_FLUSH_MSEC);
+
+        VERIFY(connect(_changesTimer, SIGNAL(timeout()), this, SLOT(flushChanges())));
+        VERIFY(connect(_changesPauseButton, SIGNAL(toggled(bool)), this, SLOT(pauseChanges(bool))));
+        VERIFY(connect(_changesFilter, SIGNAL(returnPressed()), this, SLOT(applyChangesFilter())));
+
+        if (!_server)
+            return;
+
+        AppRegistry::instance().bus()->subscribe(this, ChangeStreamResponse::Type, _server);
+        startChangeStream();
+    }
+
+    void OutputItemContentWidget::startChangeStream()
+    {
+        if (!_server)
+            return;
+
+        _changeStreamWaiting = true;
+        _server->watchChanges(_watchId, MongoNamespace(_changeStreamInfo.dbName, _changeStreamInfo.collectionName),
+                              ChangeStreamBuffer::pipeline(_changeStreamInfo.pipeline, _changeStreamInfo.options,
+                                                           _changesMatch, _changes->resumeToken(),
+                                                           _changes->startTime()));
+    }
+
+    void OutputItemContentWidget::closeChangeStream()
+    {
+        // Cursor of in flight watchChanges() is not known yet, worker kills it when the watch is done
+        if (_server && (_changeStreamCursorId || _changeStreamWaiting))
+            _server->closeChangeStream(_watchId);
+
+        _changeStreamCursorId = 0;
+    }
+
+    void OutputItemContentWidget::handle(ChangeStreamResponse *event)
+    {
+        // Responses to other views watching changes on the same server
+        if (event->watchId != _watchId)
+            return;
+
+        _changeStreamWaiting = false;
+        if (event->isError()) {
+            _changeStreamCursorId = 0;
+            _changeStreamRestart = false;
+            _changesStatus->setText(QtUtils::toQString(event->error().errorMessage()));
+            return;
+        }
+
+        _changeStreamCursorId = event->batch.cursorId;
+        if (!event->batch.operationTime.isNull())
+            _changes->setStartTime(event->batch.operationTime);
+        _changes->push(event->batch.events, event->batch.resumeToken);
+        if (_changes->hasPending() && !_changesTimer->isActive())
+            _changesTimer->start();
+
+        if (_changeStreamRestart) {
+            _changeStreamRestart = false;
+            closeChangeStream();
+            if (!_changesPauseButton->isChecked())
+                startChangeStream();
+            return;
+        }
+
+        if (_changesPauseButton->isChecked()) {
+            closeChangeStream();
+            return;
+        }
+
+        if (!_changeStreamCursorId) {
+            _changesStatus->setText("Change stream is closed by server");
+            return;
+        }
+
+        _changeStreamWaiting = true;
+        _server->changeStreamGetMore(_watchId, 
+                                     MongoNamespace(_changeStreamInfo.dbName, _changeStreamInfo.collectionName),
+                                     _changeStreamCursorId);
+    }
+
+    void OutputItemContentWidget::flushChanges()
+    {
+        ChangeStreamFlush const flush = _changes->flush();
+        _mod->removeFirstDocuments(flush.dropped);
+        _mod->appendDocuments(MongoDocument::fromBsonObj(flush.appended));
+        _changesStatus->setText(QString("%1 changes received, %2 shown")
+                                .arg(_changes->received()).arg(_changes->size()));
+    }
+
+    void OutputItemContentWidget::pauseChanges(bool paused)
+    {
+        _changesPauseButton->setText(paused ? "Resume" : "Pause");
+
+        // Cursor is closed or reused when the in flight response arrives
+        if (_changeStreamWaiting)
+            return;
+
+        if (paused)
+            closeChangeStream();
+        else
+            startChangeStream();
+    }
+
+    void OutputItemContentWidget::applyChangesFilter()
+    {
+        QString const text = _changesFilter->text().trimmed();
+        try {
+            _changesMatch = text.isEmpty() ? mongo::BSONObj() 
+                                           : mongo::Robomongo::fromjson(QtUtils::toStdString(text)).getOwned();
+        }
+        catch (const std::exception &ex) {
+            _changesStatus->setText(QString("Invalid filter: %1").arg(QtUtils::toQString(ex.what())));
+            return;
+        }
+
+        // Stream is reopened from the last resume token (or the time it was opened at, before any
+        // token is received), so no change is missed
+        if (_changeStreamWaiting)
+            _changeStreamRestart = true;
+        else if (!_changesPauseButton->isChecked()) {
+            closeChangeStream();
+            startChangeStream();
+        }
+    }
 }
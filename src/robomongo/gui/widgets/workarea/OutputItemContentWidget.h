@@ -1,13 +1,23 @@
 #pragma once
 
 #include <QStackedWidget>
+#include <QPointer>
 
 #include "robomongo/core/Core.h"
 #include "robomongo/core/domain/MongoQueryInfo.h"
 #include "robomongo/core/domain/MongoAggregateInfo.h"
+#include "robomongo/core/domain/MongoChangeStreamInfo.h"
 #include "robomongo/core/Enums.h"
+#include <memory>
 #include <vector>
 
+QT_BEGIN_NAMESPACE
+class QLabel;
+class QLineEdit;
+class QPushButton;
+class QTimer;
+QT_END_NAMESPACE
+
 namespace Robomongo
 {
     class FindFrame;
@@ -16,9 +26,13 @@ namespace Robomongo
     class BsonTreeModel;
     class JsonPrepareThread;
     class CollectionStatsTreeWidget;
+    class ExplainPlanTreeWidget;
     class MongoShell;
     class OutputItemHeaderWidget;
     class OutputWidget;
+    class MongoServer;
+    class ChangeStreamBuffer;
+    class ChangeStreamResponse;
 
     class OutputItemContentWidget : public QWidget
     {
@@ -35,11 +49,22 @@ namespace Robomongo
                                 const MongoQueryInfo &queryInfo, double secs, bool multipleResults,
                                 bool tabbedResults, bool firstItem, bool lastItem, AggrInfo aggrInfo,
                                 QWidget *parent);
+
+        /**
+         * @brief Live result of watch(): change events are appended while they arrive,
+         *        only the newest ones are kept. Shown in tree or table mode.
+         */
+        OutputItemContentWidget(ViewMode viewMode, MongoShell *shell, const ChangeStreamInfo &changeStreamInfo,
+                                bool multipleResults, bool tabbedResults, bool firstItem, bool lastItem,
+                                QWidget *parent);
+        ~OutputItemContentWidget();
+
         int _initialSkip;
         int _initialLimit;
         void updateWithInfo(const MongoQueryInfo &inf, const std::vector<MongoDocumentPtr> &documents);
         void updateWithInfo(const AggrInfo &aggrInfo, const std::vector<MongoDocumentPtr> &documents);
         void update(const std::vector<MongoDocumentPtr> &documents, int skip, int batchSize);
+        void appendDocuments(const std::vector<MongoDocumentPtr> &documents);
         bool isTextModeSupported() const { return _isTextModeSupported; }
         bool isTreeModeSupported() const { return _isTreeModeSupported; }
         bool isCustomModeSupported() const { return _isCustomModeSupported; }
@@ -63,23 +88,38 @@ namespace Robomongo
         void showTree();        
         void showTable();
         void showCustom();
+        void handle(ChangeStreamResponse *event);
 
     private Q_SLOTS:
         void jsonPartReady(const QString &json);
+        void jsonPrepared();
         void refresh(int skip, int batchSize);
         void paging_rightClicked(int skip, int batchSize);
         void paging_leftClicked(int skip, int limit);      
+        void flushChanges();
+        void pauseChanges(bool paused);
+        void applyChangesFilter();
 
     private:
         void setup(double secs, bool multipleResults, bool tabbedResults, bool firstItem, bool lastItem);
+        void startJsonPrepare(const std::vector<MongoDocumentPtr> &documents, int firstPosition);
+        /**
+         * @brief Loads page of documents starting at 'skip'. When 'nextPage' is true and keyset
+         *        paging is enabled, page is loaded by range query following the last loaded document.
+         */
+        void loadPage(int skip, int batchSize, bool nextPage);
         FindFrame *configureLogText();
         BsonTreeModel *configureModel();
+        void setupChangeStream();
+        void startChangeStream();
+        void closeChangeStream();
 
         FindFrame *_textView;
         BsonTreeView *_bsonTreeview;
         BsonTableView *_bsonTable;
         BsonTreeModel *_mod;
-        CollectionStatsTreeWidget *_collectionStats;
+        CollectionStatsTreeWidget *_collectionStats = nullptr;
+        ExplainPlanTreeWidget *_explainPlan = nullptr;
 
         QString _text;
         QString _type; // type of request
@@ -87,8 +127,25 @@ namespace Robomongo
         MongoQueryInfo _queryInfo;
         AggrInfo _aggrInfo;
 
+        ChangeStreamInfo _changeStreamInfo;
+        std::unique_ptr<ChangeStreamBuffer> _changes;
+        // Server of the shell tab is deleted before result widgets of the tab
+        QPointer<MongoServer> _server;
+        int _watchId = 0;
+        long long _changeStreamCursorId = 0;
+        bool _changeStreamWaiting = false;      // request to the server is in flight
+        bool _changeStreamRestart = false;      // reopen with new filter when response arrives
+        mongo::BSONObj _changesMatch;
+        QTimer *_changesTimer = nullptr;
+        QLineEdit *_changesFilter = nullptr;
+        QPushButton *_changesPauseButton = nullptr;
+        QLabel *_changesStatus = nullptr;
+
         QStackedWidget *_stack;
         JsonPrepareThread *_thread;
+        // Streamed documents waiting for the running JsonPrepareThread to finish
+        std::vector<MongoDocumentPtr> _pendingJsonDocuments;
+        bool _isJsonPrepareRunning = false;
 
         MongoShell *_shell;
         OutputItemHeaderWidget *_header;
@@ -1,5 +1,7 @@
 #include "robomongo/gui/widgets/workarea/OutputWidget.h"
 
+#include <algorithm>
+
 #include <QHBoxLayout>
 #include <QSplitter>
 #include <QWidget>
@@ -66,11 +68,18 @@ namespace Robomongo
                 _prevViewModes.pop_back();
             }
 
+            // Explain output is shown as plan tree regardless of mode of other results
+            if (shellResult.type() == "explain")
+                viewMode = Custom;
+
             bool const firstItem = (0 == i);
             bool const lastItem = (RESULTS_SIZE-1 == i);
 
             OutputItemContentWidget* item = nullptr;
-            if (shellResult.documents().size() > 0) {
+            if (shellResult.changeStreamInfo().isValid) {
+                item = new OutputItemContentWidget(viewMode, shell, shellResult.changeStreamInfo(),
+                                                   multipleResults, _tabbedResults, firstItem, lastItem, this);
+            } else if (shellResult.documents().size() > 0) {
                 item = new OutputItemContentWidget(viewMode, shell, QtUtils::toQString(shellResult.type()),
                                                    shellResult.documents(), shellResult.queryInfo(), secs, 
                                                    multipleResults, _tabbedResults, firstItem, lastItem,
@@ -96,29 +105,39 @@ namespace Robomongo
         tryToMakeAllPartsEqualInSize();
     }
 
+    OutputItemContentWidget *OutputWidget::part(int partIndex) const
+    {
+        if (partIndex < 0 || partIndex >= static_cast<int>(_outputItemContentWidgets.size()))
+            return nullptr;
+
+        return _outputItemContentWidgets[partIndex];
+    }
+
     void OutputWidget::updatePart(int partIndex, const MongoQueryInfo &queryInfo, 
                                   const std::vector<MongoDocumentPtr> &documents)
     {
-        if (!_tabbedResults && partIndex >= _splitter->count())
+        OutputItemContentWidget *outputItemContentWidget = part(partIndex);
+        if (!outputItemContentWidget)
             return;
-
-        OutputItemContentWidget* outputItemContentWidget = nullptr;
-        if(_tabbedResults)
-            outputItemContentWidget = qobject_cast<OutputItemContentWidget*>(currentWidget());
-        else
-            outputItemContentWidget = qobject_cast<OutputItemContentWidget*>(_splitter->widget(partIndex));
         
         outputItemContentWidget->updateWithInfo(queryInfo, documents);
         outputItemContentWidget->refreshOutputItem();
     }
 
+    void OutputWidget::appendToPart(int partIndex, const std::vector<MongoDocumentPtr> &documents)
+    {
+        OutputItemContentWidget *outputItemContentWidget = part(partIndex);
+        if (outputItemContentWidget)
+            outputItemContentWidget->appendDocuments(documents);
+    }
+
     void OutputWidget::updatePart(int partIndex, const AggrInfo &agrrInfo, 
                                   const std::vector<MongoDocumentPtr> &documents)
     {
-        if (partIndex >= _splitter->count())
+        OutputItemContentWidget *outputItemContentWidget = part(partIndex);
+        if (!outputItemContentWidget)
             return;
 
-        auto outputItemContentWidget = qobject_cast<OutputItemContentWidget*>(_splitter->widget(partIndex));
         outputItemContentWidget->updateWithInfo(agrrInfo, documents);
         outputItemContentWidget->refreshOutputItem();
     }
@@ -200,7 +219,10 @@ namespace Robomongo
 
     int OutputWidget::resultIndex(OutputItemContentWidget *result)
     {
-        return _splitter->indexOf(result);
+        // Position among presented results, it does not change when a result tab is closed
+        auto const it = std::find(_outputItemContentWidgets.begin(), _outputItemContentWidgets.end(), result);
+        return it == _outputItemContentWidgets.end() ? -1 
+                                                     : static_cast<int>(it - _outputItemContentWidgets.begin());
     }
 
     void OutputWidget::showProgress()
@@ -26,6 +26,7 @@ namespace Robomongo
                         const std::vector<MongoDocumentPtr> &documents);
         void updatePart(int partIndex, const AggrInfo &agrrInfo,
                         const std::vector<MongoDocumentPtr> &documents);
+        void appendToPart(int partIndex, const std::vector<MongoDocumentPtr> &documents);
         void toggleOrientation();
 
         void switchMode(std::function<void(OutputItemContentWidget*)> modeFunc);
@@ -54,6 +55,11 @@ namespace Robomongo
         QString buildStyleSheet();
         void tryToMakeAllPartsEqualInSize();
 
+        /**
+         * @brief Result widget with 'partIndex' (see resultIndex()), or null if there is none
+         */
+        OutputItemContentWidget *part(int partIndex) const;
+
         bool _tabbedResults;
         std::vector<ViewMode> _prevViewModes;
         int _prevResultsCount;
@@ -1,5 +1,8 @@
 #include "robomongo/gui/widgets/workarea/QueryWidget.h"
 
+#include <algorithm>
+#include <limits>
+
 #include <QObject>
 #include <QPushButton>
 #include <QApplication>
@@ -7,6 +10,7 @@
 #include <QFileInfo>
 #include <QVBoxLayout>
 #include <QMessageBox>
+#include <QInputDialog>
 #include <QMainWindow>
 #include <QDockWidget>
 #include <Qsci/qsciscintilla.h>
@@ -28,6 +32,7 @@
 #include "robomongo/core/utils/Logger.h"
 
 #include "robomongo/gui/GuiRegistry.h"
+#include "robomongo/gui/dialogs/PipelineBuilderDialog.h"
 #include "robomongo/gui/widgets/workarea/OutputWidget.h"
 #include "robomongo/gui/widgets/workarea/ScriptWidget.h"
 #include "robomongo/gui/widgets/workarea/OutputItemContentWidget.h"
@@ -50,6 +55,7 @@ namespace Robomongo
         AppRegistry::instance().bus()->subscribe(this, DocumentListLoadedEvent::Type, shell);
         AppRegistry::instance().bus()->subscribe(this, ScriptExecutedEvent::Type, shell);
         AppRegistry::instance().bus()->subscribe(this, AutocompleteResponse::Type, shell);
+        AppRegistry::instance().bus()->subscribe(this, QueryExplainedEvent::Type, shell);
 
         // Make QMessageBox text selectable
         // setStyleSheet("QMessageBox { messagebox-text-interaction-flags: 5; }");
@@ -139,6 +145,58 @@ namespace Robomongo
         _shell->stop();
     }
 
+    void QueryWidget::explain()
+    {
+        // The last result that was produced by find() or aggregate()
+        auto const& results = _currentResult.results();
+        auto const explainable = std::find_if(results.rbegin(), results.rend(), [](MongoShellResult const& result) {
+            return result.queryInfo()._info.isValid() || result.aggrInfo().isValid;
+        });
+
+        if (explainable == results.rend()) {
+            QMessageBox::information(this, "Explain", 
+                "There is no find() or aggregate() result to explain. Please execute the query first.");
+            return;
+        }
+
+        _explainedStatement = explainable->statement();
+        showProgress();
+        _shell->explain(_currentResult.currentDatabase(), explainable->queryInfo(), explainable->aggrInfo());
+    }
+
+    void QueryWidget::buildPipeline()
+    {
+        // The last result that was produced by aggregate()
+        auto const& results = _currentResult.results();
+        auto const aggregated = std::find_if(results.rbegin(), results.rend(), [](MongoShellResult const& result) {
+            return result.aggrInfo().isValid;
+        });
+
+        if (aggregated == results.rend()) {
+            QMessageBox::information(this, "Aggregation Pipeline", 
+                "There is no aggregate() result to open in pipeline builder. Please execute the query first.");
+            return;
+        }
+
+        MongoDatabase *database = _shell->server()->findDatabaseByName(_currentResult.currentDatabase());
+        if (!database) {
+            QMessageBox::information(this, "Aggregation Pipeline", 
+                QString("Database %1 is not loaded yet.").arg(QtUtils::toQString(_currentResult.currentDatabase())));
+            return;
+        }
+
+        AggrInfo const& aggrInfo = aggregated->aggrInfo();
+        std::vector<mongo::BSONObj> stages;
+        for (mongo::BSONObjIterator it(aggrInfo.pipeline); it.more(); ) {
+            mongo::BSONElement const stage = it.next();
+            if (stage.isABSONObj())
+                stages.push_back(stage.Obj().getOwned());
+        }
+
+        auto dlg = new PipelineBuilderDialog(database, aggrInfo.collectionName, stages, this);
+        dlg->show();
+    }
+
     void QueryWidget::toggleOrientation()
     {
         _viewer->toggleOrientation();
@@ -207,6 +265,20 @@ namespace Robomongo
         openNewTab();
     }
 
+    void QueryWidget::changeQueryTimeLimit()
+    {
+        if (!_shell)
+            return;
+
+        bool ok = false;
+        int const maxTimeMS = QInputDialog::getInt(this, "Query Time Limit",
+            "Time limit of queries run in this tab, in milliseconds (0 for no limit):",
+            _shell->maxTimeMS(), 0, std::numeric_limits<int>::max(), 1000, &ok);
+
+        if (ok)
+            _shell->setMaxTimeMS(maxTimeMS);
+    }
+
     void QueryWidget::enterTreeMode()
     {
         _viewer->enterTreeMode();
@@ -250,9 +322,8 @@ namespace Robomongo
 
     void QueryWidget::handle(DocumentListLoadedEvent *event)
     {
-        hideProgress();
-
         if (event->isError()) {
+            hideProgress();
             QString message = QString("Failed to load documents.\n\nError:\n%1")
                 .arg(QtUtils::toQString(event->error().errorMessage()));
             QMessageBox::information(this, "Error", message);
@@ -260,7 +331,14 @@ namespace Robomongo
         }
 
         // this should be in viewer, subscribed to ScriptExecutedEvent
-        _viewer->updatePart(event->resultIndex(), event->queryInfo(), event->documents()); 
+        if (event->firstChunk())
+            _viewer->updatePart(event->resultIndex(), event->queryInfo(), event->documents()); 
+        else    // Streamed query: rest of the batches are appended to already shown ones
+            _viewer->appendToPart(event->resultIndex(), event->documents());
+
+        // Streamed query is still running until its last chunk arrives
+        if (event->lastChunk())
+            hideProgress();
     }
 
     void QueryWidget::handle(ScriptExecutedEvent *event)
@@ -323,6 +401,26 @@ namespace Robomongo
         _scriptWidget->setScriptFocus();
     }
 
+    void QueryWidget::handle(QueryExplainedEvent *event)
+    {
+        hideProgress();
+
+        if (event->isError()) {
+            QString const message = QString("Failed to explain query.\n\nError:\n%1")
+                .arg(QtUtils::toQString(event->error().errorMessage()));
+            QMessageBox::critical(this, "Error", message);
+            return;
+        }
+
+        std::vector<MongoDocumentPtr> const documents { MongoDocumentPtr(new MongoDocument(event->explain)) };
+        std::vector<MongoShellResult> const results { 
+            MongoShellResult("explain", "", documents, MongoQueryInfo(), _explainedStatement, event->elapsedMs) 
+        };
+
+        _outputLabel->setVisible(false);
+        _viewer->present(_shell, results);
+    }
+
     void QueryWidget::handle(AutocompleteResponse *event)
     {
         if (event->isError()) {
@@ -21,6 +21,7 @@ namespace Robomongo
     class DocumentListLoadedEvent;
     class ScriptExecutedEvent;
     class AutocompleteResponse;
+    class QueryExplainedEvent;
     class OutputWidget;
     class ScriptWidget;
     class MongoShell;
@@ -41,6 +42,11 @@ namespace Robomongo
         void openNewTab();
         void reload();
         void duplicate();
+
+        /**
+         * @brief Asks user for maxTimeMS applied to queries of this tab
+         */
+        void changeQueryTimeLimit();
         void enterTreeMode();
         void enterTextMode();
         void enterTableMode();
@@ -64,6 +70,17 @@ namespace Robomongo
         void execute();
         void stop();
 
+        /**
+         * @brief Shows winning plan and execution statistics of the last find() or aggregate()
+         *        result of this tab
+         */
+        void explain();
+
+        /**
+         * @brief Opens pipeline of the last aggregate() result of this tab in pipeline builder
+         */
+        void buildPipeline();
+
         void saveToFile();
         void savebToFileAs();
         void openFile();
@@ -74,6 +91,7 @@ namespace Robomongo
         void handle(DocumentListLoadedEvent *event);
         void handle(ScriptExecutedEvent *event);
         void handle(AutocompleteResponse *event);
+        void handle(QueryExplainedEvent *event);
 
     private Q_SLOTS:
         // Make adjustments between output window dock/undock events
@@ -97,6 +115,7 @@ namespace Robomongo
         QVBoxLayout *_mainLayout;
 
         MongoShellExecResult _currentResult;
+        std::string _explainedStatement;
         bool _isTextChanged;
     };
 
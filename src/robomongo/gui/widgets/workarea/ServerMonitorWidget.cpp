@@ -0,0 +1,190 @@
+#include "robomongo/gui/widgets/workarea/ServerMonitorWidget.h"
+
+#include <QCheckBox>
+#include <QDateTime>
+#include <QFile>
+#include <QFileDialog>
+#include <QGridLayout>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QMessageBox>
+#include <QPushButton>
+#include <QSpinBox>
+#include <QTimer>
+#include <QVBoxLayout>
+
+#include "robomongo/core/AppRegistry.h"
+#include "robomongo/core/EventBus.h"
+#include "robomongo/core/domain/MongoServer.h"
+#include "robomongo/core/settings/ConnectionSettings.h"
+#include "robomongo/core/utils/QtUtils.h"
+#include "robomongo/gui/widgets/workarea/IndicatorLabel.h"
+#include "robomongo/gui/widgets/workarea/SparklineWidget.h"
+#include "robomongo/gui/GuiRegistry.h"
+
+namespace
+{
+    // One hour of samples with default interval
+    constexpr size_t SAMPLES_CAPACITY { 720 };
+
+    QString formatBytes(double bytes)
+    {
+        char const *units[] = { "B", "KB", "MB", "GB", "TB" };
+        int unit = 0;
+        while (bytes >= 1024 && unit < 4) {
+            bytes /= 1024;
+            ++unit;
+        }
+        return QString("%1 %2").arg(bytes, 0, 'f', unit == 0 ? 0 : 1).arg(units[unit]);
+    }
+}
+
+namespace Robomongo
+{
+    ServerMonitorWidget::ServerMonitorWidget(MongoServer *server, QWidget *parent) :
+        QWidget(parent),
+        _server(server),
+        _metrics(SAMPLES_CAPACITY)
+    {
+        _intervalSpinBox = new QSpinBox();
+        _intervalSpinBox->setRange(1, 60);
+        _intervalSpinBox->setValue(5);
+        _intervalSpinBox->setSuffix(" sec");
+
+        _pauseCheckBox = new QCheckBox("Pause");
+        VERIFY(connect(_pauseCheckBox, SIGNAL(toggled(bool)), this, SLOT(togglePause(bool))));
+
+        QPushButton *exportButton = new QPushButton("Export CSV...");
+        VERIFY(connect(exportButton, SIGNAL(clicked()), this, SLOT(exportCsv())));
+
+        QHBoxLayout *controlsLayout = new QHBoxLayout();
+        controlsLayout->addWidget(new Indicator(GuiRegistry::instance().serverIcon(),
+                                                QtUtils::toQString(server->connectionRecord()->getFullAddress())));
+        controlsLayout->addSpacing(10);
+        controlsLayout->addWidget(new QLabel("Sample every:"));
+        controlsLayout->addWidget(_intervalSpinBox);
+        controlsLayout->addWidget(_pauseCheckBox);
+        controlsLayout->addStretch(1);
+        controlsLayout->addWidget(exportButton);
+
+        _opsChart = new SparklineWidget("Operations/s");
+        _bytesInChart = new SparklineWidget("Network in/s");
+        _bytesOutChart = new SparklineWidget("Network out/s");
+        _cacheChart = new SparklineWidget("WiredTiger cache");
+        _connectionsChart = new SparklineWidget("Connections");
+        _replicationLagChart = new SparklineWidget("Replication lag");
+
+        QGridLayout *chartsLayout = new QGridLayout();
+        chartsLayout->addWidget(_opsChart, 0, 0);
+        chartsLayout->addWidget(_connectionsChart, 0, 1);
+        chartsLayout->addWidget(_bytesInChart, 1, 0);
+        chartsLayout->addWidget(_bytesOutChart, 1, 1);
+        chartsLayout->addWidget(_cacheChart, 2, 0);
+        chartsLayout->addWidget(_replicationLagChart, 2, 1);
+
+        _statusLabel = new QLabel("Waiting for first samples...");
+
+        QVBoxLayout *layout = new QVBoxLayout();
+        layout->addLayout(controlsLayout);
+        layout->addLayout(chartsLayout);
+        layout->addStretch(1);
+        layout->addWidget(_statusLabel);
+        setLayout(layout);
+
+        // Next sample is scheduled when previous one is received, samples never overlap
+        _timer = new QTimer(this);
+        _timer->setSingleShot(true);
+        VERIFY(connect(_timer, SIGNAL(timeout()), this, SLOT(sample())));
+
+        AppRegistry::instance().bus()->subscribe(this, ServerStatusResponse::Type, server);
+        sample();
+    }
+
+    void ServerMonitorWidget::sample()
+    {
+        if (_sampling)
+            return;
+
+        if (!_server) {
+            _statusLabel->setText("Disconnected from server.");
+            return;
+        }
+
+        _sampling = true;
+        _server->sampleServerStatus();
+    }
+
+    void ServerMonitorWidget::togglePause(bool paused)
+    {
+        if (paused)
+            _timer->stop();
+        else
+            sample();
+    }
+
+    void ServerMonitorWidget::handle(ServerStatusResponse *event)
+    {
+        // Responses to other monitors of the same server
+        if (!_sampling)
+            return;
+
+        _sampling = false;
+        if (!_pauseCheckBox->isChecked())
+            _timer->start(_intervalSpinBox->value() * 1000);
+
+        if (event->isError()) {
+            _statusLabel->setText(QtUtils::toQString(event->error().errorMessage()));
+            return;
+        }
+
+        if (!_metrics.add(event->status, event->replicationLagSecs))
+            return;
+
+        updateCharts();
+        _statusLabel->setText(QString("%1 samples, last at %2")
+            .arg(_metrics.size()).arg(QDateTime::currentDateTime().toString("HH:mm:ss")));
+    }
+
+    void ServerMonitorWidget::updateCharts()
+    {
+        size_t const size = _metrics.size();
+        std::vector<double> ops(size), bytesIn(size), bytesOut(size), cache(size), connections(size), lag(size);
+        for (size_t i = 0; i < size; ++i) {
+            ServerMetricsSample const& sample = _metrics.at(i);
+            ops[i] = sample.opsPerSec();
+            bytesIn[i] = sample.bytesInPerSec;
+            bytesOut[i] = sample.bytesOutPerSec;
+            cache[i] = sample.cacheUsedBytes;
+            connections[i] = sample.connections;
+            lag[i] = sample.replicationLagSecs;
+        }
+
+        ServerMetricsSample const& last = _metrics.at(size - 1);
+        _opsChart->setValues(ops, QString::number(last.opsPerSec(), 'f', 1));
+        _bytesInChart->setValues(bytesIn, formatBytes(last.bytesInPerSec));
+        _bytesOutChart->setValues(bytesOut, formatBytes(last.bytesOutPerSec));
+        _cacheChart->setValues(cache, last.cacheUsedBytes < 0 ? "n/a" : 
+            QString("%1 of %2").arg(formatBytes(last.cacheUsedBytes)).arg(formatBytes(last.cacheMaxBytes)));
+        _connectionsChart->setValues(connections, QString::number(last.connections));
+        _replicationLagChart->setValues(lag, last.replicationLagSecs < 0 ? "n/a" : 
+            QString("%1 s").arg(last.replicationLagSecs, 0, 'f', 1));
+    }
+
+    void ServerMonitorWidget::exportCsv()
+    {
+        QString const path = QFileDialog::getSaveFileName(this, "Export CSV", "server-monitor.csv",
+                                                          "CSV files (*.csv)");
+        if (path.isEmpty())
+            return;
+
+        QFile file(path);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+            QMessageBox::warning(this, "Export CSV", QString("Cannot write file %1: %2")
+                .arg(path).arg(file.errorString()));
+            return;
+        }
+
+        std::string const csv = _metrics.toCsv();
+        file.write(csv.data(), csv.size());
+    }
+}
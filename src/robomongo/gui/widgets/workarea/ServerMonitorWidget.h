@@ -0,0 +1,60 @@
+#pragma once
+
+#include <QPointer>
+#include <QWidget>
+
+#include "robomongo/core/domain/ServerMetrics.h"
+
+QT_BEGIN_NAMESPACE
+class QCheckBox;
+class QLabel;
+class QSpinBox;
+class QTimer;
+QT_END_NAMESPACE
+
+namespace Robomongo
+{
+    class MongoServer;
+    class ServerStatusResponse;
+    class SparklineWidget;
+
+    /**
+     * @brief Server Monitor tab: samples serverStatus of explorer server periodically
+     *        and charts operations, network, cache, connections and replication lag
+     */
+    class ServerMonitorWidget : public QWidget
+    {
+        Q_OBJECT
+
+    public:
+        explicit ServerMonitorWidget(MongoServer *server, QWidget *parent = 0);
+
+        MongoServer *server() const { return _server; }
+
+    public Q_SLOTS:
+        void handle(ServerStatusResponse *event);
+
+    private Q_SLOTS:
+        void sample();
+        void togglePause(bool paused);
+        void exportCsv();
+
+    private:
+        void updateCharts();
+
+        // Server is owned by explorer and is deleted on disconnect
+        QPointer<MongoServer> _server;
+        ServerMetrics _metrics;
+        QTimer *_timer;
+        bool _sampling = false;
+        QSpinBox *_intervalSpinBox;
+        QCheckBox *_pauseCheckBox;
+        QLabel *_statusLabel;
+        SparklineWidget *_opsChart;
+        SparklineWidget *_bytesInChart;
+        SparklineWidget *_bytesOutChart;
+        SparklineWidget *_cacheChart;
+        SparklineWidget *_connectionsChart;
+        SparklineWidget *_replicationLagChart;
+    };
+}
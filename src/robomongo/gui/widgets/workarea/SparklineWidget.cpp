@@ -0,0 +1,71 @@
+#include "robomongo/gui/widgets/workarea/SparklineWidget.h"
+
+#include <algorithm>
+
+#include <QPainter>
+#include <QPainterPath>
+
+namespace Robomongo
+{
+    SparklineWidget::SparklineWidget(const QString &title, QWidget *parent) :
+        QWidget(parent),
+        _title(title)
+    {
+        setMinimumHeight(70);
+        setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Preferred);
+    }
+
+    void SparklineWidget::setValues(const std::vector<double> &values, const QString &currentText)
+    {
+        _values = values;
+        _currentText = currentText;
+        update();
+    }
+
+    QSize SparklineWidget::sizeHint() const
+    {
+        return QSize(240, 90);
+    }
+
+    void SparklineWidget::paintEvent(QPaintEvent *)
+    {
+        QPainter painter(this);
+        painter.setRenderHint(QPainter::Antialiasing);
+
+        QRect const textRect = rect().adjusted(4, 2, -4, 0);
+        painter.setPen(palette().color(QPalette::WindowText));
+        painter.drawText(textRect, Qt::AlignLeft | Qt::AlignTop, _title);
+        painter.drawText(textRect, Qt::AlignRight | Qt::AlignTop, _currentText);
+
+        int const textHeight = fontMetrics().height() + 4;
+        QRectF const chart = QRectF(rect()).adjusted(4, textHeight, -4, -4);
+        painter.setPen(QColor("#dddddd"));
+        painter.drawRect(chart);
+
+        if (_values.size() < 2)
+            return;
+
+        double const maxValue = *std::max_element(_values.begin(), _values.end());
+        double const scale = maxValue > 0 ? (chart.height() - 2) / maxValue : 0;
+        double const step = chart.width() / (_values.size() - 1);
+
+        QPainterPath line;
+        bool drawing = false;
+        for (size_t i = 0; i < _values.size(); ++i) {
+            if (_values[i] < 0) {
+                drawing = false;
+                continue;
+            }
+
+            QPointF const point(chart.left() + i * step, chart.bottom() - 1 - _values[i] * scale);
+            if (drawing)
+                line.lineTo(point);
+            else
+                line.moveTo(point);
+            drawing = true;
+        }
+
+        painter.setPen(QPen(QColor("#3b7dd8"), 1.5));
+        painter.drawPath(line);
+    }
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <vector>
+
+#include <QWidget>
+
+namespace Robomongo
+{
+    /**
+     * @brief Small line chart of a time series with title and current value. 
+     *        Negative values are unknown and leave a gap in the line.
+     */
+    class SparklineWidget : public QWidget
+    {
+        Q_OBJECT
+
+    public:
+        explicit SparklineWidget(const QString &title, QWidget *parent = 0);
+
+        void setValues(const std::vector<double> &values, const QString &currentText);
+
+        QSize sizeHint() const override;
+
+    protected:
+        void paintEvent(QPaintEvent *event) override;
+
+    private:
+        QString const _title;
+        QString _currentText;
+        std::vector<double> _values;
+    };
+}
@@ -25,6 +25,7 @@ namespace Robomongo
         _duplicateShellAction = new QAction("&Duplicate Query In New Tab", _menu);
         _duplicateShellAction->setShortcut(Qt::CTRL + Qt::SHIFT + Qt::Key_T);
         _pinShellAction = new QAction("&Pin Shell", _menu);
+        _queryTimeLimitAction = new QAction("Query &Time Limit...", _menu);
         _closeShellAction = new QAction("&Close Shell", _menu);
         _closeShellAction->setShortcut(Qt::CTRL + Qt::Key_W);
         _closeOtherShellsAction = new QAction("Close &Other Shells", _menu);
@@ -34,6 +35,7 @@ namespace Robomongo
         _menu->addSeparator();
         _menu->addAction(_reloadShellAction);
         _menu->addAction(_duplicateShellAction);
+        _menu->addAction(_queryTimeLimitAction);
         _menu->addSeparator();
         _menu->addAction(_closeShellAction);
         _menu->addAction(_closeOtherShellsAction);
@@ -123,6 +125,8 @@ namespace Robomongo
             emit duplicateTabRequested(tabIndex);
         else if (action == _pinShellAction)
             emit pinTabRequested(tabIndex);
+        else if (action == _queryTimeLimitAction)
+            emit queryTimeLimitRequested(tabIndex);
         else if (action == _closeShellAction)
             emit tabCloseRequested(tabIndex);
         else if (action == _closeOtherShellsAction)
@@ -45,6 +45,12 @@ namespace Robomongo
          */
         void pinTabRequested(int tabIndex);
 
+        /**
+         * @brief Emitted when user requests to change query time limit of tab.
+         * @param tabIndex: index of tab on which context menu was called.
+         */
+        void queryTimeLimitRequested(int tabIndex);
+
         /**
          * @brief Emitted when user requests to close all other tabs.
          * @param tabIndex: index of tab, that should be left opened.
@@ -107,6 +113,7 @@ namespace Robomongo
         QAction *_reloadShellAction;
         QAction *_duplicateShellAction;
         QAction *_pinShellAction;
+        QAction *_queryTimeLimitAction;
         QAction *_closeShellAction;
         QAction *_closeOtherShellsAction;
         QAction *_closeShellsToTheRightAction;
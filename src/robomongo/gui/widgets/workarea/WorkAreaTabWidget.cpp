@@ -7,10 +7,13 @@
 #include "robomongo/core/utils/QtUtils.h"
 #include "robomongo/core/KeyboardManager.h"
 #include "robomongo/core/domain/MongoShell.h"
+#include "robomongo/core/domain/MongoServer.h"
+#include "robomongo/core/settings/ConnectionSettings.h"
 #include "robomongo/core/settings/SettingsManager.h"
 
 #include "robomongo/gui/widgets/workarea/WorkAreaTabBar.h"
 #include "robomongo/gui/widgets/workarea/QueryWidget.h"
+#include "robomongo/gui/widgets/workarea/ServerMonitorWidget.h"
 #include "robomongo/gui/widgets/workarea/WelcomeTab.h"
 #include "robomongo/gui/GuiRegistry.h"
 
@@ -63,6 +66,7 @@ namespace Robomongo
         VERIFY(connect(tab, SIGNAL(newTabRequested(int)), SLOT(ui_newTabRequested(int))));
         VERIFY(connect(tab, SIGNAL(reloadTabRequested(int)), SLOT(ui_reloadTabRequested(int))));
         VERIFY(connect(tab, SIGNAL(duplicateTabRequested(int)), SLOT(ui_duplicateTabRequested(int))));
+        VERIFY(connect(tab, SIGNAL(queryTimeLimitRequested(int)), SLOT(ui_queryTimeLimitRequested(int))));
         VERIFY(connect(tab, SIGNAL(closeOtherTabsRequested(int)), SLOT(ui_closeOtherTabsRequested(int))));
         VERIFY(connect(tab, SIGNAL(closeTabsToTheRightRequested(int)), SLOT(ui_closeTabsToTheRightRequested(int))));
 
@@ -86,9 +90,12 @@ namespace Robomongo
     {
         if (index >= 0)
         {
-            QueryWidget *tabWidget = queryWidget(index);
+            QWidget *tabWidget = widget(index);
             removeTab(index);
-            delete tabWidget;
+
+            // Welcome tab is kept for openWelcomeTab()
+            if (qobject_cast<QueryWidget *>(tabWidget) || qobject_cast<ServerMonitorWidget *>(tabWidget))
+                delete tabWidget;
         }
     }
 
@@ -243,6 +250,12 @@ namespace Robomongo
             query->duplicate();
     }
 
+    void WorkAreaTabWidget::ui_queryTimeLimitRequested(int index)
+    {
+        if (QueryWidget *query = queryWidget(index))
+            query->changeQueryTimeLimit();
+    }
+
     void WorkAreaTabWidget::ui_closeOtherTabsRequested(int index)
     {
         tabBar()->moveTab(index, 0);
@@ -315,5 +328,22 @@ namespace Robomongo
 
         queryWidget->showProgress();
     }
-}
 
+    void WorkAreaTabWidget::handle(OpeningServerMonitorEvent *event)
+    {
+        // One monitor per server
+        for (int i = 0; i < count(); ++i) {
+            auto monitor = qobject_cast<ServerMonitorWidget *>(widget(i));
+            if (monitor && monitor->server() == event->server) {
+                setCurrentIndex(i);
+                return;
+            }
+        }
+
+        auto monitor = new ServerMonitorWidget(event->server, this);
+        addTab(monitor, "Server Monitor");
+        setCurrentIndex(count() - 1);
+        setTabToolTip(count() - 1, QString("Server Monitor of %1")
+            .arg(QtUtils::toQString(event->server->connectionRecord()->connectionName())));
+    }
+}
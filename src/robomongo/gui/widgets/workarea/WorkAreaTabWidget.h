@@ -6,6 +6,7 @@ namespace Robomongo
 {
     class QueryWidget;
     class OpeningShellEvent;
+    class OpeningServerMonitorEvent;
     class WelcomeTab;
 
     /**
@@ -33,10 +34,12 @@ namespace Robomongo
 
     public Q_SLOTS:
         void handle(OpeningShellEvent *event);
+        void handle(OpeningServerMonitorEvent *event);
         void tabBar_tabCloseRequested(int index);
         void ui_newTabRequested(int index);
         void ui_reloadTabRequested(int index);
         void ui_duplicateTabRequested(int index);
+        void ui_queryTimeLimitRequested(int index);
         void ui_closeOtherTabsRequested(int index);
         void ui_closeTabsToTheRightRequested(int index);
         void ui_currentChanged(int index);